@@ -0,0 +1,257 @@
+#!/usr/bin/env python3
+"""Compile a behavior program for the hub's BehaviorVm.
+
+A program is a text file with one statement per line. Blank lines and anything after
+a # are ignored, and a line "name:" labels the next statement.
+
+    motor left|right SPEED     turn the head at SPEED (0-255)
+    motor stop                 stop the head
+    eye active|rainbow|sleep   set the eye mode
+    eye next                   move on to the next active color
+    eye blink MS               blink once for MS milliseconds (10-2550)
+    sound N|random             play sound N, or a random one
+    dome LEVEL                 set the dome LED level (0-255)
+    wait MS                    wait MS milliseconds (0-65535)
+    wait MIN..MAX              wait a random time between MIN and MAX milliseconds
+    goto LABEL                 continue at LABEL
+    if [not] SENSOR goto LABEL continue at LABEL if SENSOR is (not) active
+    until [not] SENSOR         wait until SENSOR is (not) active
+    end                        stop the program
+
+SENSOR is one of pir, left, right (the hall sensors), rectangle or circle (the buttons).
+A program that runs off its last line ends as if it said end.
+
+The program is written as a header (lib/BehaviorData/behavior_<name>.h by default)
+that keeps it in flash, as a raw binary with --binary, or sent to a running hub over
+USB serial with --port, where it replaces the running program at once. --stop sends
+an empty program, which hands the head back to the built-in behaviors. See
+lib/BehaviorVm/BehaviorVm.h for the instruction encoding.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+OPCODES = {"end": 0, "motor": 1, "eye": 2, "sound": 3, "dome": 4, "wait": 5,
+           "wait_random": 6, "goto": 7, "if": 8, "until": 9}
+SIZES = {0: 1, 1: 3, 2: 3, 3: 2, 4: 2, 5: 3, 6: 5, 7: 3, 8: 4, 9: 2}
+EYE_MODES = {"active": 0, "rainbow": 1, "sleep": 2, "blink": 3, "next": 4}
+SENSORS = {"pir": 0, "left": 1, "right": 2, "rectangle": 3, "circle": 4}
+SENSOR_NOT = 0x80
+RANDOM_SOUND = 0xFF
+MAX_PROGRAM_SIZE = 512
+SYNC = b"\xb5\x5b"
+BYTES_PER_LINE = 12
+
+
+class CompileError(Exception):
+    pass
+
+
+def number(text, low, high, what):
+    if not re.fullmatch(r"\d+", text):
+        raise CompileError(f"{what} '{text}' is not a number")
+    value = int(text)
+    if not low <= value <= high:
+        raise CompileError(f"{what} {value} is outside {low}-{high}")
+    return value
+
+
+def sensor(words):
+    negate = 0
+    if words and words[0] == "not":
+        negate = SENSOR_NOT
+        words = words[1:]
+    if len(words) != 1 or words[0] not in SENSORS:
+        raise CompileError(f"expected a sensor ({', '.join(SENSORS)})")
+    return SENSORS[words[0]] | negate
+
+
+def parse_statement(words):
+    """Return the opcode, its operand bytes and the label it jumps to, if any."""
+    op, args = words[0], words[1:]
+    if op == "end" and not args:
+        return OPCODES["end"], b"", None
+    if op == "motor":
+        if args == ["stop"]:
+            return OPCODES["motor"], struct.pack("<bB", 0, 0), None
+        if len(args) == 2 and args[0] in ("left", "right"):
+            direction = -1 if args[0] == "left" else 1
+            return OPCODES["motor"], struct.pack("<bB", direction,
+                                                 number(args[1], 0, 255, "speed")), None
+        raise CompileError("expected: motor left|right SPEED, or motor stop")
+    if op == "eye":
+        if len(args) == 2 and args[0] == "blink":
+            ms = number(args[1], 10, 2550, "blink length")
+            return OPCODES["eye"], bytes((EYE_MODES["blink"], ms // 10)), None
+        if len(args) == 1 and args[0] in EYE_MODES and args[0] != "blink":
+            return OPCODES["eye"], bytes((EYE_MODES[args[0]], 0)), None
+        raise CompileError("expected: eye active|rainbow|sleep|next, or eye blink MS")
+    if op == "sound" and len(args) == 1:
+        index = RANDOM_SOUND if args[0] == "random" else number(args[0], 0, 254, "sound")
+        return OPCODES["sound"], bytes((index,)), None
+    if op == "dome" and len(args) == 1:
+        return OPCODES["dome"], bytes((number(args[0], 0, 255, "level"),)), None
+    if op == "wait" and len(args) == 1:
+        if ".." in args[0]:
+            low, high = args[0].split("..", 1)
+            low = number(low, 0, 65535, "wait")
+            high = number(high, 0, 65535, "wait")
+            if low > high:
+                raise CompileError(f"wait range {low}..{high} is backwards")
+            return OPCODES["wait_random"], struct.pack("<HH", low, high), None
+        return OPCODES["wait"], struct.pack("<H", number(args[0], 0, 65535, "wait")), None
+    if op == "goto" and len(args) == 1:
+        return OPCODES["goto"], b"", args[0]
+    if op == "if" and len(args) >= 3 and args[-2] == "goto":
+        return OPCODES["if"], bytes((sensor(args[:-2]),)), args[-1]
+    if op == "until":
+        return OPCODES["until"], bytes((sensor(args),)), None
+    raise CompileError(f"cannot read '{' '.join(words)}'")
+
+
+def compile_program(text, source="<input>"):
+    """Compile program text to bytecode, exiting with the line of the first error."""
+    statements = []
+    labels = {}
+    address = 0
+    for line_no, line in enumerate(text.splitlines(), start=1):
+        words = line.split("#", 1)[0].lower().split()
+        if not words:
+            continue
+        where = f"{source}:{line_no}"
+        if len(words) == 1 and words[0].endswith(":"):
+            label = words[0][:-1]
+            if not re.fullmatch(r"[a-z_][a-z0-9_]*", label):
+                sys.exit(f"Error: {where}: '{label}' is not a valid label")
+            if label in labels:
+                sys.exit(f"Error: {where}: label '{label}' is defined twice")
+            labels[label] = address
+            continue
+        try:
+            opcode, operands, target = parse_statement(words)
+        except CompileError as error:
+            sys.exit(f"Error: {where}: {error}")
+        statements.append((opcode, operands, target, where))
+        address += SIZES[opcode]
+
+    code = bytearray()
+    for opcode, operands, target, where in statements:
+        code.append(opcode)
+        if target is not None:
+            if target not in labels:
+                sys.exit(f"Error: {where}: no label '{target}'")
+            if labels[target] >= address:
+                sys.exit(f"Error: {where}: label '{target}' is past the last statement")
+            operands += struct.pack("<H", labels[target])
+        code += operands
+    if len(code) > MAX_PROGRAM_SIZE:
+        sys.exit(f"Error: {source}: program is {len(code)} bytes, the limit is "
+                 f"{MAX_PROGRAM_SIZE}")
+    return bytes(code)
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def encode_message(code):
+    body = struct.pack("<H", len(code)) + code
+    return SYNC + body + bytes((crc8(body),))
+
+
+def write_header(code, name, source, output_dir):
+    os.makedirs(output_dir, exist_ok=True)
+    output_file = os.path.relpath(os.path.join(output_dir, f"{name}.h"))
+    guard = f"{name.upper()}_H"
+    lines = [
+        f"// Auto-generated from {source}",
+        f"#ifndef {guard}",
+        f"#define {guard}",
+        "",
+        "#include <Arduino.h>",
+        "#include <BehaviorVm.h>",
+        "",
+        f"// {len(code)} bytes of behavior program",
+        f"const uint8_t {name}_data[] PROGMEM = {{",
+    ]
+    for offset in range(0, len(code), BYTES_PER_LINE):
+        chunk = code[offset:offset + BYTES_PER_LINE]
+        lines.append("    " + ", ".join(f"0x{b:02x}" for b in chunk) + ",")
+    lines += [
+        "};",
+        "",
+        "// Program descriptor: code, length",
+        f"const BehaviorProgram {name} = {{{name}_data, sizeof({name}_data)}};",
+        "",
+        f"#endif // {guard}",
+    ]
+    with open(output_file, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    return output_file
+
+
+def send(port_name, message):
+    try:
+        import serial
+    except ImportError:
+        sys.exit("Error: pyserial is required (pip install pyserial)")
+    with serial.Serial(port_name, 115200, timeout=1) as port:
+        port.write(message)
+        port.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", help="behavior program (.bvs)")
+    parser.add_argument("--name", help="program name (default: from the input file name)")
+    parser.add_argument("--output-dir",
+                        help="directory for the header (default: lib/BehaviorData)")
+    parser.add_argument("--binary", help="write the bytecode to this file instead of a header")
+    parser.add_argument("--port", help="send the program to the hub on this serial port, "
+                                       "e.g. /dev/ttyACM0 or COM5")
+    parser.add_argument("--stop", action="store_true",
+                        help="with --port, stop the running program instead")
+    args = parser.parse_args()
+
+    if args.stop:
+        if not args.port:
+            sys.exit("Error: --stop needs --port")
+        send(args.port, encode_message(b""))
+        print(f"Stopped the behavior program on {args.port}")
+        return
+    if not args.input:
+        parser.error("the input program is required")
+
+    with open(args.input) as f:
+        code = compile_program(f.read(), args.input)
+    if not code:
+        sys.exit(f"Error: {args.input}: program is empty")
+
+    if args.port:
+        send(args.port, encode_message(code))
+        print(f"Sent {args.input} to {args.port}: {len(code)} bytes")
+    elif args.binary:
+        with open(args.binary, "wb") as f:
+            f.write(code)
+        print(f"Generated {args.binary}: {len(code)} bytes")
+    else:
+        base = args.name or os.path.splitext(os.path.basename(args.input))[0]
+        base = re.sub(r"[^a-z0-9_]", "", base.lower().replace(" ", "_"))
+        output_dir = args.output_dir or os.path.join(os.path.dirname(__file__), "..", "lib",
+                                                     "BehaviorData")
+        output_file = write_header(code, f"behavior_{base}", os.path.basename(args.input),
+                                   output_dir)
+        print(f"Generated {output_file}: {len(code)} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+"""Capture the input trace from the hub over USB serial.
+
+Sends the dump request (see lib/InputTrace/InputTrace.h) and saves everything from the
+TRACE header to the END line, which `make replay` feeds back through the firmware on
+the host. Log lines the hub prints in between are dropped.
+
+Requires pyserial (pip install pyserial).
+"""
+
+import argparse
+import re
+import sys
+import time
+
+REQUEST = b"!trace\n"
+RECORDS = re.compile(r"^[0-9A-F]{4}( [0-9A-F]{4})*$")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="serial port of the hub, e.g. /dev/ttyACM0 or COM5")
+    parser.add_argument("output", help="file to save the trace to")
+    parser.add_argument("--timeout", type=float, default=5, help="seconds to wait (default: 5)")
+    args = parser.parse_args()
+
+    try:
+        import serial
+    except ImportError:
+        sys.exit("Error: pyserial is required (pip install pyserial)")
+
+    lines = []
+    with serial.Serial(args.port, 115200, timeout=0.1) as port:
+        port.reset_input_buffer()
+        port.write(REQUEST)
+        deadline = time.monotonic() + args.timeout
+        while time.monotonic() < deadline:
+            line = port.readline().decode(errors="replace").strip()
+            if line.startswith("TRACE "):
+                lines = [line]
+            elif lines and line == "END":
+                lines.append(line)
+                break
+            elif lines and RECORDS.match(line):
+                lines.append(line)
+        else:
+            sys.exit("Error: no complete trace received")
+
+    with open(args.output, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print(f"Saved {lines[0]} to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+"""Convert an eye animation into a delta-encoded sprite clip header.
+
+Input is either a CSV file or an image strip:
+
+- CSV: one frame per row, one color per column as RRGGBB hex (a leading 0x is
+  allowed). Blank lines and lines starting with # are comments.
+- Image strip (.ppm, or .png/.bmp/.gif with Pillow installed): one frame per row of
+  pixels, one LED per column.
+
+The generated header (lib/SpriteData/sprite_<name>.h by default) holds the encoded
+frames in PROGMEM and an EyeSpriteClip describing them. See lib/EyeSprite/EyeSprite.h
+for the encoding.
+"""
+
+import argparse
+import csv
+import os
+import re
+import sys
+
+OP_SKIP = 0x00
+OP_RUN = 0x40
+OP_LITERAL = 0x80
+OP_END = 0xFF
+MAX_OP_PIXELS = 64
+BYTES_PER_LINE = 12
+
+
+def parse_color(text, where):
+    value = text.strip().lower()
+    if value.startswith("0x"):
+        value = value[2:]
+    if not re.fullmatch(r"[0-9a-f]{1,6}", value):
+        sys.exit(f"Error: {where}: '{text.strip()}' is not an RRGGBB color")
+    return int(value, 16)
+
+
+def read_csv(path):
+    frames = []
+    with open(path, newline="") as f:
+        for line_no, row in enumerate(csv.reader(f), start=1):
+            cells = [cell for cell in row if cell.strip()]
+            if not cells or cells[0].lstrip().startswith("#"):
+                continue
+            frames.append([parse_color(c, f"{path}:{line_no}") for c in cells])
+    return frames
+
+
+def read_ppm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    # Header fields are whitespace separated and may be interleaved with comments
+    fields = []
+    pos = 0
+    while len(fields) < 4:
+        match = re.compile(rb"\s*(#[^\n]*\n\s*)*(\S+)").match(data, pos)
+        if not match:
+            sys.exit(f"Error: {path}: truncated PPM header")
+        fields.append(match.group(2))
+        pos = match.end()
+    magic, width, height, maxval = fields[0], int(fields[1]), int(fields[2]), int(fields[3])
+    if maxval != 255:
+        sys.exit(f"Error: {path}: only 8-bit PPM images are supported")
+    if magic == b"P6":
+        raw = data[pos + 1:pos + 1 + width * height * 3]
+        values = list(raw)
+    elif magic == b"P3":
+        values = [int(v) for v in data[pos:].split()[:width * height * 3]]
+    else:
+        sys.exit(f"Error: {path}: not a PPM (P3/P6) image")
+    if len(values) != width * height * 3:
+        sys.exit(f"Error: {path}: truncated PPM pixel data")
+    colors = [(values[i] << 16) | (values[i + 1] << 8) | values[i + 2]
+              for i in range(0, len(values), 3)]
+    return [colors[row * width:(row + 1) * width] for row in range(height)]
+
+
+def read_image(path):
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit(f"Error: {path}: Pillow is required for this image type (or use .ppm/.csv)")
+    image = Image.open(path).convert("RGB")
+    width, height = image.size
+    pixels = image.load()
+    return [[(r << 16) | (g << 8) | b for r, g, b in (pixels[x, y] for x in range(width))]
+            for y in range(height)]
+
+
+def encode_frame(previous, frame):
+    """Encode one frame as SKIP/RUN/LITERAL operations relative to the previous one."""
+    out = []
+    i = 0
+    count = len(frame)
+    while i < count:
+        # Unchanged pixels
+        start = i
+        while i < count and frame[i] == previous[i] and i - start < MAX_OP_PIXELS:
+            i += 1
+        if i > start:
+            if i == count:
+                break  # The end of frame already leaves the rest unchanged
+            out.append(OP_SKIP | (i - start - 1))
+            continue
+
+        # A color repeated over two or more changed pixels
+        run = 1
+        while (i + run < count and run < MAX_OP_PIXELS and frame[i + run] == frame[i]
+               and frame[i + run] != previous[i + run]):
+            run += 1
+        if run >= 2:
+            out.append(OP_RUN | (run - 1))
+            out += color_bytes(frame[i])
+            i += run
+            continue
+
+        # Changed pixels up to the next unchanged pixel or repeated color
+        start = i
+        while (i < count and i - start < MAX_OP_PIXELS and frame[i] != previous[i]
+               and not (i > start and i + 1 < count and frame[i + 1] == frame[i]
+                        and frame[i + 1] != previous[i + 1])):
+            i += 1
+        out.append(OP_LITERAL | (i - start - 1))
+        for color in frame[start:i]:
+            out += color_bytes(color)
+    out.append(OP_END)
+    return out
+
+
+def color_bytes(color):
+    return [(color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF]
+
+
+def encode_clip(frames):
+    previous = [0] * len(frames[0])
+    data = []
+    for frame in frames:
+        data += encode_frame(previous, frame)
+        previous = frame
+    return data
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="CSV file or image strip")
+    parser.add_argument("--frame-ms", type=int, default=40,
+                        help="duration of each frame in milliseconds (default: 40)")
+    parser.add_argument("--name", help="clip name (default: from the input file name)")
+    parser.add_argument("--output-dir", help="directory for the header (default: lib/SpriteData)")
+    args = parser.parse_args()
+
+    ext = os.path.splitext(args.input)[1].lower()
+    if ext == ".csv":
+        frames = read_csv(args.input)
+    elif ext in (".ppm", ".pnm"):
+        frames = read_ppm(args.input)
+    else:
+        frames = read_image(args.input)
+
+    if not frames:
+        sys.exit(f"Error: {args.input}: no frames found")
+    num_pixels = len(frames[0])
+    for index, frame in enumerate(frames):
+        if len(frame) != num_pixels:
+            sys.exit(f"Error: {args.input}: frame {index} has {len(frame)} pixels, "
+                     f"expected {num_pixels}")
+    if num_pixels > 255 or len(frames) > 65535 or not 0 < args.frame_ms <= 65535:
+        sys.exit(f"Error: {args.input}: clip is too large for an EyeSpriteClip")
+
+    base = args.name or os.path.splitext(os.path.basename(args.input))[0]
+    base = re.sub(r"[^a-z0-9_]", "", base.lower().replace(" ", "_"))
+    name = f"sprite_{base}"
+    output_dir = args.output_dir or os.path.join(os.path.dirname(__file__), "..", "lib",
+                                                 "SpriteData")
+    os.makedirs(output_dir, exist_ok=True)
+    output_file = os.path.relpath(os.path.join(output_dir, f"{name}.h"))
+
+    data = encode_clip(frames)
+    guard = f"{name.upper()}_H"
+    lines = [
+        f"// Auto-generated from {os.path.basename(args.input)}",
+        f"#ifndef {guard}",
+        f"#define {guard}",
+        "",
+        "#include <Arduino.h>",
+        "#include <EyeSprite.h>",
+        "",
+        f"// {len(frames)} frames of {num_pixels} pixels, {len(data)} bytes "
+        f"({len(frames) * num_pixels * 3} raw)",
+        f"const uint8_t {name}_data[] PROGMEM = {{",
+    ]
+    for offset in range(0, len(data), BYTES_PER_LINE):
+        chunk = data[offset:offset + BYTES_PER_LINE]
+        lines.append("    " + ", ".join(f"0x{b:02x}" for b in chunk) + ",")
+    lines += [
+        "};",
+        "",
+        "// Clip descriptor: data, size, frames, ms per frame, pixels per frame",
+        f"const EyeSpriteClip {name} = {{",
+        f"    {name}_data, sizeof({name}_data), {len(frames)}, {args.frame_ms}, {num_pixels}}};",
+        "",
+        f"#endif // {guard}",
+    ]
+    with open(output_file, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+    print(f"Generated {output_file}: {len(frames)} frames, {len(data)} bytes "
+          f"({100 * len(data) // (len(frames) * num_pixels * 3)}% of raw)")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""Stream eye frames from a PC to the hub over USB serial.
+
+Sends FrameStream messages (see lib/FrameStream/FrameStream.h) at a fixed rate. Frames
+come from a sprite CSV (the same format as sprite_to_header.py, looped) or, without
+one, a rainbow spinning around the ring. The eye returns to its own animation half a
+second after the stream stops.
+
+Requires pyserial (pip install pyserial).
+"""
+
+import argparse
+import colorsys
+import csv
+import struct
+import sys
+import time
+
+SYNC = b"\xa5\x5a"
+MAX_PIXELS = 17
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def encode(sequence, host_time_us, pixels):
+    body = struct.pack("<BHI", len(pixels), sequence & 0xFFFF, host_time_us & 0xFFFFFFFF)
+    for color in pixels:
+        body += bytes(((color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF))
+    return SYNC + body + bytes((crc8(body),))
+
+
+def read_csv(path):
+    frames = []
+    with open(path, newline="") as f:
+        for row in csv.reader(f):
+            cells = [cell.strip() for cell in row if cell.strip()]
+            if cells and not cells[0].startswith("#"):
+                frames.append([int(c[2:] if c.lower().startswith("0x") else c, 16)
+                               for c in cells][:MAX_PIXELS])
+    return frames
+
+
+def rainbow(index):
+    pixels = []
+    for i in range(MAX_PIXELS - 1):
+        r, g, b = colorsys.hsv_to_rgb(((index + i * 4) % 64) / 64, 1.0, 1.0)
+        pixels.append((int(r * 255) << 16) | (int(g * 255) << 8) | int(b * 255))
+    return pixels + [0xFFFFFF]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="serial port of the hub, e.g. /dev/ttyACM0 or COM5")
+    parser.add_argument("--csv", help="sprite CSV to loop (default: rainbow)")
+    parser.add_argument("--fps", type=float, default=60, help="frames per second (default: 60)")
+    parser.add_argument("--seconds", type=float, default=0, help="stop after this long")
+    args = parser.parse_args()
+
+    try:
+        import serial
+    except ImportError:
+        sys.exit("Error: pyserial is required (pip install pyserial)")
+
+    frames = read_csv(args.csv) if args.csv else None
+    if frames == []:
+        sys.exit(f"Error: {args.csv}: no frames found")
+
+    period = 1.0 / args.fps
+    with serial.Serial(args.port, 115200, timeout=0) as port:
+        start = time.monotonic()
+        sequence = 0
+        while not args.seconds or time.monotonic() - start < args.seconds:
+            now = time.monotonic()
+            pixels = frames[sequence % len(frames)] if frames else rainbow(sequence)
+            port.write(encode(sequence, int((now - start) * 1e6), pixels))
+            sequence += 1
+
+            # Echo the hub's log, which includes the stream statistics
+            log = port.read(port.in_waiting or 0)
+            if log:
+                sys.stdout.write(log.decode(errors="replace"))
+            time.sleep(max(0.0, start + sequence * period - time.monotonic()))
+
+
+if __name__ == "__main__":
+    main()
@@ -14,14 +14,21 @@
 // System includes
 #include <Arduino.h>
 #include <algorithm>
+#include <cmath>
 
 // Project includes
 #include "Animation.h"
 #include "../Logger/Logger.h"
+#include <Random.h>
 
 Animation::Animation(EyeAnimation* eye, AudioPlayer* audio, const AnimationPins& pins)
-    : m_eyeAnimation(eye), m_audioPlayer(audio), m_pins(pins)
+    : m_audioPlayer(audio),
+      m_pins(pins),
+      m_neckMotorIn1(pins.neckMotorIn1),
+      m_neckMotorIn2(pins.neckMotorIn2),
+      m_domeLedOutput(pins.domeLedGreen)
 {
+    addEye(eye);
     m_currentTime = 0;
     m_randomRotateTimer = m_currentTime;
     m_randomDirectionTimer = m_currentTime;
@@ -34,7 +41,6 @@ Animation::Animation(EyeAnimation* eye, AudioPlayer* audio, const AnimationPins&
     m_inputButtonRectangle = HIGH;
     m_inputButtonCircle = HIGH;
     m_motorDirection = MotorDirection::Stop;
-    m_isInMovementCycle = false;
     m_ledFadeDirection = true;
     m_currentLedBrightness = AnimationConstants::kLedMinBrightness;
     m_lastFadeTime = m_currentTime;
@@ -42,16 +48,92 @@ Animation::Animation(EyeAnimation* eye, AudioPlayer* audio, const AnimationPins&
 
 void Animation::update(const AnimationInputs& inputs)
 {
-    // Update sensor states
-    setInputSensorLeft(inputs.sensorLeft);
-    setInputSensorRight(inputs.sensorRight);
-    setInputPIRSensor(inputs.pirSensor);
-    setInputButtonRectangle(inputs.buttonRectangle);
-    setInputButtonCircle(inputs.buttonCircle);
+    // Update sensor states, unless the snapshot says none of them changed and no edge
+    // was latched over them
+    if (inputs.changed != 0 || m_inputsLatched)
+    {
+        m_inputsLatched = false;
+        setInputSensorLeft(inputs.sensorLeft);
+        setInputSensorRight(inputs.sensorRight);
+        setInputPIRSensor(inputs.pirSensor);
+        setInputButtonRectangle(inputs.buttonRectangle);
+        setInputButtonCircle(inputs.buttonCircle);
+    }
     setCurrentTime(inputs.currentTime);
 
+    // The motor ran at the last commanded duty since the previous update, or as far as
+    // the driver actually took it
+    if (m_headEstimator != nullptr && (m_motionPlanner != nullptr || m_motorDriver != nullptr))
+    {
+        const int32_t travel = m_motionPlanner != nullptr ? m_motionPlanner->takeTravel()
+                                                          : m_motorDriver->takeTravel();
+        m_headEstimator->updateTravel(inputs.currentTime, travel, inputs.sensorLeft == LOW,
+                                      inputs.sensorRight == LOW);
+    }
+    else if (m_headEstimator != nullptr)
+    {
+        m_headEstimator->update(inputs.currentTime, m_motorDuty, inputs.sensorLeft == LOW,
+                                inputs.sensorRight == LOW);
+    }
+
+    // A hall sensor ahead of the planner is a hard limit: stop there without a ramp
+    if (m_motionPlanner != nullptr)
+    {
+        const int16_t duty = m_motionPlanner->getOutput();
+        if ((duty < 0 && inputs.sensorLeft == LOW) || (duty > 0 && inputs.sensorRight == LOW))
+        {
+            m_motionPlanner->halt(MotorStop::Brake);
+        }
+    }
+
     // Update eye animation time
-    m_eyeAnimation->setCurrentTime(inputs.currentTime);
+    for (uint8_t i = 0; i < m_numEyes; i++)
+    {
+        m_eyes[i]->setCurrentTime(inputs.currentTime);
+    }
+}
+
+uint8_t Animation::consumeInputEvents(InputEventQueue& queue)
+{
+    uint8_t count = 0;
+    InputEvent event;
+    while (queue.pop(event))
+    {
+        count++;
+        m_inputsLatched = true;
+        if (event.pin == m_pins.sensorLeft && event.level == LOW)
+        {
+            setInputSensorLeft(LOW);
+        }
+        else if (event.pin == m_pins.sensorRight && event.level == LOW)
+        {
+            setInputSensorRight(LOW);
+        }
+        else if (event.pin == m_pins.pirSensor && event.level == HIGH)
+        {
+            setInputPIRSensor(HIGH);
+        }
+        else if (event.pin == m_pins.buttonRectangle && event.level == LOW)
+        {
+            setInputButtonRectangle(LOW);
+        }
+        else if (event.pin == m_pins.buttonCircle && event.level == LOW)
+        {
+            setInputButtonCircle(LOW);
+        }
+    }
+    return count;
+}
+
+bool Animation::addEye(EyeAnimation* eye)
+{
+    if (eye == nullptr || m_numEyes >= AnimationConstants::kMaxEyes)
+    {
+        Log.error("Cannot add eye %d of %d", m_numEyes + 1, AnimationConstants::kMaxEyes);
+        return false;
+    }
+    m_eyes[m_numEyes++] = eye;
+    return true;
 }
 
 void Animation::rotate(uint8_t speed, MotorDirection direction)
@@ -68,13 +150,37 @@ void Animation::rotate(uint8_t speed, MotorDirection direction)
     switch (direction)
     {
         case MotorDirection::Right:
-            analogWrite(m_pins.neckMotorIn2, effectiveSpeed);
-            analogWrite(m_pins.neckMotorIn1, LOW);
+            if (m_motionPlanner != nullptr)
+            {
+                m_motionPlanner->setSpeed(effectiveSpeed);
+            }
+            else if (m_motorDriver != nullptr)
+            {
+                m_motorDriver->drive(effectiveSpeed);
+            }
+            else
+            {
+                m_neckMotorIn1.write(LOW);
+                m_neckMotorIn2.write(effectiveSpeed);
+            }
+            m_motorDuty = effectiveSpeed;
             break;
 
         case MotorDirection::Left:
-            analogWrite(m_pins.neckMotorIn1, effectiveSpeed);
-            analogWrite(m_pins.neckMotorIn2, LOW);
+            if (m_motionPlanner != nullptr)
+            {
+                m_motionPlanner->setSpeed(-effectiveSpeed);
+            }
+            else if (m_motorDriver != nullptr)
+            {
+                m_motorDriver->drive(-effectiveSpeed);
+            }
+            else
+            {
+                m_neckMotorIn2.write(LOW);
+                m_neckMotorIn1.write(effectiveSpeed);
+            }
+            m_motorDuty = -effectiveSpeed;
             break;
 
         case MotorDirection::Stop:
@@ -91,17 +197,35 @@ void Animation::rotate(uint8_t speed, MotorDirection direction)
     }
 }
 
-void Animation::stop()
+void Animation::stop(MotorStop rest)
 {
     // Only update if we're not already stopped
     if (m_motorDirection != MotorDirection::Stop)
     {
-        // Set both motor control pins to LOW to stop the motor
-        analogWrite(m_pins.neckMotorIn1, LOW);
-        analogWrite(m_pins.neckMotorIn2, LOW);
+        // Ramp down through the planner, rest through the driver, or set both motor
+        // control pins LOW to coast and HIGH to brake
+        if (m_motionPlanner != nullptr && rest == MotorStop::Brake)
+        {
+            m_motionPlanner->halt(MotorStop::Brake);
+        }
+        else if (m_motionPlanner != nullptr)
+        {
+            m_motionPlanner->setSpeed(0);
+        }
+        else if (m_motorDriver != nullptr)
+        {
+            m_motorDriver->stop(rest);
+        }
+        else
+        {
+            const uint8_t level = rest == MotorStop::Brake ? MotorDriverConstants::FULL_DUTY : LOW;
+            m_neckMotorIn1.write(level);
+            m_neckMotorIn2.write(level);
+        }
 
         // Update motor state
         m_motorDirection = MotorDirection::Stop;
+        m_motorDuty = 0;
         Log.info("Motor stopped");
     }
 }
@@ -129,11 +253,6 @@ void Animation::setRotationDirection()
         m_lastLeftTurnTime = m_currentTime;
         return;
     }
-    if (!m_isInMovementCycle)
-    {
-        // not in movement cycle, no need to set direction
-        return;
-    }
 
     // If no sensor is triggered, handle random direction changes
     if (m_randomDirectionTimer == 0)
@@ -175,7 +294,7 @@ void Animation::setRotationDirection()
 
         // Calculate total bias and make weighted random decision
         const float totalBias = leftBias + rightBias;
-        const float randomValue = random(1000) / 1000.0f * totalBias;
+        const float randomValue = Rng.below(1000) / 1000.0f * totalBias;
         // Select direction based on weighted random value
         if (randomValue < leftBias)
         {
@@ -191,8 +310,8 @@ void Animation::setRotationDirection()
         }
 
         // Set timer for next direction change
-        m_randomDirectionTimer = m_currentTime + random(AnimationConstants::kMinRotateInterval,
-                                                        AnimationConstants::kMaxRotateInterval);
+        m_randomDirectionTimer = m_currentTime + Rng.range(AnimationConstants::kMinRotateInterval,
+                                                           AnimationConstants::kMaxRotateInterval);
         Log.debug("[Animation] Direction timer set for %dms",
                   m_randomDirectionTimer - m_currentTime);
     }
@@ -210,40 +329,104 @@ void Animation::setRotationDirection()
 /**
  * @brief Controls the motor rotation based on sensor input and timing
  *
- * This method handles the main rotation logic, including:
- * - Motion detection via PIR sensor
- * - Speed ramping for smooth operation
- * - Inactivity timeout
- * - Sound effects for state changes
+ * This method feeds the behavior machine its events:
+ * - Motion starting or stopping at the PIR sensor
+ * - Reaching the hall sensor the head is moving toward
+ * - Closing on a limit faster than the head estimator allows
+ * - The deadline of the active state passing
+ *
+ * Everything else, from timing movement cycles to the speed and sound effects, is
+ * done by the actions of the states and transitions the events lead to.
  */
 void Animation::performRotate()
 {
-    // Handle PIR sensor state
-    if (m_inputPIRSensor == HIGH)
+    // The head estimator's calibration sweep owns the motor until it has measured the travel
+    if (m_headEstimator != nullptr && m_headEstimator->isCalibrating())
     {
-        // Motion detected
-        updateLedFade();
-        handlePirTriggered();
-        setRotationDirection();
+        rotate(HeadEstimatorConstants::CALIBRATION_DUTY,
+               static_cast<MotorDirection>(m_headEstimator->getCalibrationDirection()));
+        return;
+    }
 
-        // Apply movement based on current direction
-        if (m_motorDirection != MotorDirection::Stop && m_isInMovementCycle)
+    // A show owns the head until its timeline ends, pointing it with gazes
+    if (m_show.isPlaying())
+    {
+        if (m_show.update(m_currentTime))
+        {
+            updateGaze();
+        }
+        else
         {
-            // TODO: smooth variable speed while triggered
-            rotate(AnimationConstants::kMaxMotorSpeed, m_motorDirection);
+            endShow();
         }
+        return;
     }
-    else
+
+    // A gaze holds the head where it was pointed
+    if (m_gaze != GazeState::Idle)
     {
-        // No motion detected
-        analogWrite(m_pins.domeLedGreen, 0);
-        handlePirInactive();
+        updateGaze();
+        return;
+    }
 
-        // Stop motor when no motion is detected
-        if (m_motorDirection != MotorDirection::Stop)
+    // A behavior program owns the head until it ends, but never drives into a hall sensor
+    if (m_program.isRunning())
+    {
+        m_program.tick(m_currentTime);
+        if ((m_motorDirection == MotorDirection::Left && m_inputSensorLeft == LOW) ||
+            (m_motorDirection == MotorDirection::Right && m_inputSensorRight == LOW))
         {
-            stop();
+            stop(MotorStop::Brake);
         }
+        return;
+    }
+
+    // Only the moving states keep the head turning once a calibration sweep, gaze or
+    // program ends
+    if (m_motorDirection != MotorDirection::Stop && !m_behavior.isIn(BehaviorState::Scanning) &&
+        !m_behavior.isIn(BehaviorState::Reacting))
+    {
+        stop();
+    }
+
+    // Edges of the PIR sensor
+    if (m_inputPIRSensor != m_lastPIRState)
+    {
+        if (m_inputPIRSensor == HIGH)
+        {
+            handlePirTriggered();
+        }
+        else
+        {
+            handlePirInactive();
+        }
+    }
+
+    // The hall sensor ahead of the head
+    if ((m_motorDirection == MotorDirection::Left && m_inputSensorLeft == LOW) ||
+        (m_motorDirection == MotorDirection::Right && m_inputSensorRight == LOW))
+    {
+        m_behavior.dispatch(BehaviorEvent::Limit);
+    }
+    // Faster than the head estimator allows this close to the limit ahead, driven or still
+    // spinning down after a stop
+    else if (m_headEstimator != nullptr)
+    {
+        const int16_t duty = m_motorDirection != MotorDirection::Stop ? m_motorDuty
+                                                                       : getMotorDuty();
+        if (std::abs(duty) > AnimationConstants::kMinSpeed &&
+            m_headEstimator->isNearLimit(duty < 0 ? -1 : 1))
+        {
+            m_behavior.dispatch(BehaviorEvent::Approach);
+        }
+    }
+
+    m_behavior.poll(m_currentTime);
+
+    // Without a DomeLed driver the breathing is stepped from here on its own interval
+    if (m_domeLed == nullptr && m_behavior.isIn(BehaviorState::Alert))
+    {
+        updateLedFade();
     }
 }
 
@@ -252,60 +435,161 @@ void Animation::performRotate()
  */
 void Animation::handlePirTriggered()
 {
-    if (m_currentTime - m_lastPIRTimer < 1000)
-    {
-        return;  // Debounce PIR
-    }
-
     // Check for rising edge of PIR sensor (LOW -> HIGH)
     if (m_lastPIRState == LOW)
     {
-        // This is a new motion detection event
-        Log.info("Motion detected, starting rotation");
+        Log.info("Motion detected");
+    }
 
-        // Reset timers for fresh movement
-        m_randomDirectionTimer = 0;
-        m_isInMovementCycle = true;
-        m_randomRotateTimer = m_currentTime + random(AnimationConstants::kMinMovementDuration,
-                                                     AnimationConstants::kMaxMovementDuration);
+    // Update PIR state and the time motion was last seen
+    m_lastPIRState = HIGH;
+    m_lastPIRTimer = m_currentTime;
+    m_behavior.dispatch(BehaviorEvent::PirRise);
+}
 
-        // Occasionally play a random sound based on probability
-        if (m_audioPlayer != nullptr &&
-            random(100) < AnimationConstants::kSoundOnMovementProbability)
-        {
-            m_audioPlayer->playRandomSound();
-        }
+/**
+ * @brief Handles logic when PIR sensor is inactive
+ */
+void Animation::handlePirInactive()
+{
+    // Check for falling edge of PIR sensor (HIGH -> LOW)
+    if (m_lastPIRState == HIGH)
+    {
+        Log.info("Motion no longer detected");
     }
 
-    // Update PIR state and reset the inactivity timer
-    m_lastPIRState = HIGH;
+    // Update PIR state; sleep is timed from the last motion
+    m_lastPIRState = LOW;
     m_lastPIRTimer = m_currentTime;
+    m_behavior.dispatch(BehaviorEvent::PirFall);
+}
 
-    if (m_isInMovementCycle && m_currentTime >= m_randomRotateTimer)
+void Animation::runBehaviorAction(BehaviorAction action)
+{
+    switch (action)
     {
-        Log.info("Exceeded movement duration, ending rotation");
-        // End the movement cycle
-        m_isInMovementCycle = false;
-        // set timer until we evaluate if we should move again
-        m_randomRotateTimer = m_currentTime + random(AnimationConstants::kMinMovementInterval,
-                                                     AnimationConstants::kMaxMovementInterval);
-        stop();
-        return;
+        case BehaviorAction::Doze:
+            Log.info("No motion for %lu ms, going to sleep", m_currentTime - m_lastPIRTimer);
+            break;
+
+        case BehaviorAction::Notice:
+            if (m_domeLed != nullptr)
+            {
+                m_domeLed->breathe();
+            }
+
+            // Occasionally play a random sound based on probability
+            if (m_audioPlayer != nullptr &&
+                Rng.below(100) < AnimationConstants::kSoundOnMovementProbability)
+            {
+                m_audioPlayer->playRandomSound();
+            }
+            break;
+
+        case BehaviorAction::Calm:
+            if (m_domeLed != nullptr)
+            {
+                m_domeLed->off();
+            }
+            else
+            {
+                m_domeLedOutput.write(0);
+            }
+            break;
+
+        case BehaviorAction::StartCycle:
+            m_randomRotateTimer =
+                m_currentTime + Rng.range(AnimationConstants::kMinMovementDuration,
+                                          AnimationConstants::kMaxMovementDuration);
+            Log.info("Starting rotation for %lu ms", m_randomRotateTimer - m_currentTime);
+            break;
+
+        case BehaviorAction::StartRest:
+            m_randomRotateTimer =
+                m_currentTime + Rng.range(AnimationConstants::kMinMovementInterval,
+                                          AnimationConstants::kMaxMovementInterval);
+            Log.info("Ending rotation, resting for %lu ms", m_randomRotateTimer - m_currentTime);
+            break;
+
+        case BehaviorAction::Turn:
+            m_randomDirectionTimer = 0;  // Pick a new direction now
+            setRotationDirection();
+            steer();
+            break;
+
+        case BehaviorAction::Steer:
+            steer();
+            break;
+
+        case BehaviorAction::Reverse:
+            setRotationDirection();
+            steer();
+            break;
+
+        case BehaviorAction::Halt:
+            stop();
+            break;
+
+        case BehaviorAction::Brake:
+            if (m_motionPlanner != nullptr)
+            {
+                m_motionPlanner->halt(MotorStop::Brake);
+            }
+            else if (m_motorDriver != nullptr)
+            {
+                m_motorDriver->stop(MotorStop::Brake);
+            }
+            break;
+
+        case BehaviorAction::None:
+        default:
+            break;
+    }
+}
+
+bool Animation::checkBehaviorGuard(BehaviorGuard guard) const
+{
+    switch (guard)
+    {
+        case BehaviorGuard::CycleOver:
+            return m_currentTime >= m_randomRotateTimer;
+        case BehaviorGuard::TurnDue:
+            return m_currentTime >= m_randomDirectionTimer;
+        case BehaviorGuard::Always:
+        default:
+            return true;
+    }
+}
+
+unsigned long Animation::getBehaviorTimer(BehaviorTimer timer) const
+{
+    switch (timer)
+    {
+        case BehaviorTimer::Sleep:
+            return m_lastPIRTimer + AnimationConstants::kEyeResetInterval;
+        case BehaviorTimer::Cycle:
+            return m_randomRotateTimer;
+        case BehaviorTimer::Turn:
+            return m_randomDirectionTimer;
+        case BehaviorTimer::Steer:
+        default:
+            return m_nextSteerTime;
     }
-    else if (!m_isInMovementCycle && m_currentTime < m_randomRotateTimer)
+}
+
+void Animation::steer()
+{
+    m_nextSteerTime = m_currentTime + AnimationConstants::kSteerInterval;
+    if (m_motorDirection == MotorDirection::Stop)
     {
-        // Wait for the movement cycle to start
         return;
     }
-    else if (!m_isInMovementCycle &&
-             m_currentTime - m_randomRotateTimer > AnimationConstants::kMinMovementInterval)
+
+    // The planner's S-curve ramps already ease in and out of every move
+    if (m_motionPlanner != nullptr)
     {
-        Log.info("Movement interval exceeded, starting rotation");
-        // Start a new movement cycle
-        m_isInMovementCycle = true;
-        // set timer for how long to evaluate if we should stop moving
-        m_randomRotateTimer = m_currentTime + random(AnimationConstants::kMinMovementDuration,
-                                                     AnimationConstants::kMaxMovementDuration);
+        rotate(limitApproachSpeed(AnimationConstants::kMaxMotorSpeed), m_motorDirection);
+        return;
     }
 
     // Calculate how long we've been moving in the current direction
@@ -313,13 +597,6 @@ void Animation::handlePirTriggered()
     const uint32_t directionDuration =
         m_currentTime - (isMovingLeft ? m_lastLeftTurnTime : m_lastRightTurnTime);
 
-    // If we've been going in one direction too long, force a direction change
-    if (directionDuration > AnimationConstants::kMaxDirectionTime)
-    {
-        Log.debug("Forcing direction change after %lums", directionDuration);
-        m_randomDirectionTimer = 0;  // Trigger direction change on next update
-    }
-
     // Calculate speed with bell curve biasing (slow at start/end, faster in middle)
     const float t = std::min(directionDuration, AnimationConstants::kSpeedRampTime) /
                     static_cast<float>(AnimationConstants::kSpeedRampTime);
@@ -332,62 +609,344 @@ void Animation::handlePirTriggered()
     // Apply some random variation to the speed for more natural movement
     // Ensure we don't exceed maximum motor speed
     const int randomSpeed =
-        random(AnimationConstants::kMinSpeed,
-               std::min(biasedSpeed + 1, static_cast<int>(AnimationConstants::kMaxMotorSpeed)));
+        Rng.range(AnimationConstants::kMinSpeed,
+                  std::min(biasedSpeed + 1, static_cast<int>(AnimationConstants::kMaxMotorSpeed)));
 
-    rotate(static_cast<uint8_t>(randomSpeed), m_motorDirection);
+    rotate(limitApproachSpeed(static_cast<uint8_t>(randomSpeed)), m_motorDirection);
 
     Log.debug("[Animation] Motor speed: %d (bias=%.2f, duration=%dms)", randomSpeed, speedBias,
               directionDuration);
 }
 
-/**
- * @brief Handles logic when PIR sensor is inactive
- */
-void Animation::handlePirInactive()
+bool Animation::lookAt(float position, unsigned long durationMs)
 {
-    // Check for falling edge of PIR sensor (HIGH -> LOW)
-    if (m_lastPIRState == HIGH)
+    if (m_motionPlanner == nullptr || m_headEstimator == nullptr ||
+        m_headEstimator->isCalibrating() || !m_headEstimator->isCalibrated())
     {
-        Log.info("Motion no longer detected, starting inactivity timer");
+        Log.error("Cannot look at %.2f without a calibrated head estimator and planner",
+                  position);
+        return false;
     }
 
-    // Update PIR state
-    m_lastPIRState = LOW;
+    m_gazeTarget = std::min(1.0f, std::max(0.0f, position));
+    m_gazeStartTime = m_currentTime;
+    const float offset = m_gazeTarget - m_headEstimator->getPosition();
+    if (std::fabs(offset) < AnimationConstants::kGazeTolerance)
+    {
+        m_motionPlanner->setSpeed(0);
+        m_motorDirection = MotorDirection::Stop;
+        m_gaze = GazeState::Moving;
+        return true;
+    }
+
+    // Cruise at the average duty that covers the distance in time
+    const int32_t distance = static_cast<int32_t>(offset * m_headEstimator->getTravelDutyMs());
+    const uint32_t magnitude = static_cast<uint32_t>(distance < 0 ? -distance : distance);
+    const uint32_t averageDuty = durationMs > 0 ? (magnitude + durationMs - 1) / durationMs
+                                                : AnimationConstants::kMaxMotorSpeed;
+    const uint8_t cruiseDuty = static_cast<uint8_t>(
+        std::min<uint32_t>(std::max<uint32_t>(averageDuty, AnimationConstants::kMinSpeed),
+                           AnimationConstants::kMaxMotorSpeed));
+    m_motionPlanner->moveBy(distance, cruiseDuty);
+    m_motorDirection = distance < 0 ? MotorDirection::Left : MotorDirection::Right;
+    m_gaze = GazeState::Moving;
+    Log.info("Looking at %.2f from %.2f at duty %d", m_gazeTarget,
+             m_headEstimator->getPosition(), cruiseDuty);
+    return true;
+}
 
-    // Check if we've been inactive too long and need to fully stop
-    const uint32_t inactiveTime = m_currentTime - m_lastPIRTimer;
-    if (inactiveTime >= AnimationConstants::kInactivityTimeout)
+void Animation::releaseGaze()
+{
+    m_gaze = GazeState::Idle;
+}
+
+void Animation::updateGaze()
+{
+    if (m_gaze != GazeState::Moving || !m_motionPlanner->isSettled())
     {
-        if (m_motorDirection != MotorDirection::Stop)
-        {
-            Log.info("Inactivity timeout reached, stopping motor");
-            stop();
-        }
+        return;
     }
+    m_motorDirection = MotorDirection::Stop;
+
+    // A hall sensor halts the move wherever it is, which only counts as arriving if the
+    // target was at that sensor
+    const float position = m_headEstimator->getPosition();
+    if (m_motionPlanner->getMode() == MotionMode::Halt &&
+        std::fabs(m_gazeTarget - position) >= AnimationConstants::kGazeTolerance)
+    {
+        m_gaze = GazeState::Blocked;
+        Log.warning("Blocked at %.2f on the way to %.2f after %lu ms", position, m_gazeTarget,
+                    m_currentTime - m_gazeStartTime);
+        return;
+    }
+    m_gaze = GazeState::Arrived;
+    Log.info("Arrived at %.2f (estimate %.2f) after %lu ms", m_gazeTarget, position,
+             m_currentTime - m_gazeStartTime);
 }
 
-void Animation::eyeBlink()
+bool Animation::runProgram(const uint8_t* code, uint16_t length)
+{
+    const bool wasRunning = m_program.isRunning();
+    if (!m_program.load(code, length))
+    {
+        Log.error("Behavior program of %u bytes is invalid", length);
+        return false;
+    }
+    m_programEye = VmEye::Active;
+    if (length > 0)
+    {
+        stop();
+        Log.info("Running a %u byte behavior program", length);
+    }
+    else if (wasRunning)
+    {
+        Log.info("Behavior program stopped");
+    }
+    return true;
+}
+
+void Animation::programMotor(int8_t direction, uint8_t speed)
+{
+    if (direction == 0)
+    {
+        stop();
+        return;
+    }
+    rotate(speed, direction < 0 ? MotorDirection::Left : MotorDirection::Right);
+}
+
+void Animation::programEye(VmEye mode, uint8_t argument)
+{
+    switch (mode)
+    {
+        case VmEye::Blink:
+            for (uint8_t i = 0; i < m_numEyes; i++)
+            {
+                m_eyes[i]->blink(argument * 10UL);
+            }
+            break;
+
+        case VmEye::NextColor:
+            for (uint8_t i = 0; i < m_numEyes; i++)
+            {
+                m_eyes[i]->rotateActiveColor();
+            }
+            break;
+
+        default:
+            m_programEye = mode;
+            break;
+    }
+}
+
+void Animation::programSound(uint8_t index)
 {
-    if (m_inputButtonRectangle == LOW)
+    if (m_audioPlayer == nullptr)
     {
-        m_eyeAnimation->rotateActiveColor();
+        return;
     }
+    if (index == BehaviorVmConstants::RANDOM_SOUND)
+    {
+        m_audioPlayer->playRandomSound();
+    }
+    else
+    {
+        m_audioPlayer->play(index);
+    }
+}
 
-    // Update the eye animation based on the current mode
-    if (m_inputButtonCircle == LOW)
+void Animation::programDome(uint8_t level)
+{
+    if (m_domeLed != nullptr)
     {
-        m_eyeAnimation->updateRainbowColor();
+        m_domeLed->setLevel(level);
     }
     else
     {
-        if (m_currentTime - m_lastPIRTimer > AnimationConstants::kEyeResetInterval)
+        m_domeLedOutput.write(level);
+    }
+}
+
+uint8_t Animation::getProgramSensors() const
+{
+    // Hall sensors and buttons are active low, the PIR sensor active high
+    const bool active[] = {m_inputPIRSensor == HIGH, m_inputSensorLeft == LOW,
+                           m_inputSensorRight == LOW, m_inputButtonRectangle == LOW,
+                           m_inputButtonCircle == LOW};
+    static_assert(sizeof(active) == static_cast<size_t>(VmSensor::Count),
+                  "One input per VmSensor, in VmSensor order");
+
+    uint8_t sensors = 0;
+    for (uint8_t i = 0; i < static_cast<uint8_t>(VmSensor::Count); i++)
+    {
+        sensors |= active[i] ? 1 << i : 0;
+    }
+    return sensors;
+}
+
+bool Animation::playShow(ShowTrigger trigger)
+{
+    if (m_headEstimator != nullptr && m_headEstimator->isCalibrating())
+    {
+        Log.error("Cannot play a show while the head is calibrating");
+        return false;
+    }
+    const Show* show = getShow(trigger);
+    if (!m_show.play(show, m_currentTime))
+    {
+        return false;
+    }
+
+    // The show starts from rest with the eyes and audio to itself
+    stop();
+    releaseGaze();
+    m_programEye = VmEye::Active;
+    if (m_audioPlayer != nullptr)
+    {
+        m_audioPlayer->stop();
+    }
+    Log.info("Playing the %s show", show->name);
+    m_show.update(m_currentTime);
+    return true;
+}
+
+void Animation::stopShow()
+{
+    if (m_show.isPlaying())
+    {
+        m_show.stop();
+        endShow();
+    }
+}
+
+void Animation::runShowCue(const ShowCue& cue)
+{
+    switch (cue.action)
+    {
+        case ShowAction::Look:
+            lookAt(cue.a / 255.0f, cue.b);
+            break;
+
+        case ShowAction::Release:
+            releaseGaze();
+            break;
+
+        case ShowAction::Blink:
+            for (uint8_t i = 0; i < m_numEyes; i++)
+            {
+                m_eyes[i]->blink(cue.b);
+            }
+            break;
+
+        case ShowAction::NextColor:
+            programEye(VmEye::NextColor, 0);
+            break;
+
+        case ShowAction::Rainbow:
+            m_programEye = VmEye::Rainbow;
+            break;
+
+        case ShowAction::Active:
+            m_programEye = VmEye::Active;
+            break;
+
+        case ShowAction::Sleep:
+            m_programEye = VmEye::Sleep;
+            break;
+
+        case ShowAction::DomeOff:
+            if (m_domeLed != nullptr)
+            {
+                m_domeLed->off();
+            }
+            else
+            {
+                m_domeLedOutput.write(0);
+            }
+            break;
+
+        case ShowAction::DomeLevel:
+            programDome(cue.a);
+            break;
+
+        case ShowAction::DomeBreathe:
+            if (m_domeLed != nullptr)
+            {
+                m_domeLed->breathe(DomeLedConstants::DEFAULT_LOW_LEVEL,
+                                   DomeLedConstants::DEFAULT_HIGH_LEVEL, cue.b);
+            }
+            else
+            {
+                m_domeLedOutput.write(AnimationConstants::kLedMaxBrightness);
+            }
+            break;
+
+        case ShowAction::Sound:
+            programSound(cue.a);
+            break;
+
+        default:
+            break;
+    }
+}
+
+bool Animation::getShowAudioClock(uint8_t sound, ShowAudioClock& clock) const
+{
+    if (m_audioPlayer == nullptr || !m_audioPlayer->isPlaying() ||
+        m_audioPlayer->getCurrentSoundIndex() != sound)
+    {
+        return false;
+    }
+    clock.samples = m_audioPlayer->getSamplesPlayed();
+    clock.sampleRate = m_audioPlayer->getSampleRate();
+    return true;
+}
+
+void Animation::endShow()
+{
+    releaseGaze();
+    m_programEye = VmEye::Active;
+    Log.info("The %s show is over, %u cues up to %lu us late", m_show.getShow()->name,
+             m_show.getCuesFired(), static_cast<unsigned long>(m_show.getMaxLatenessUs()));
+}
+
+uint8_t Animation::limitApproachSpeed(uint8_t speed) const
+{
+    if (m_headEstimator != nullptr &&
+        m_headEstimator->isNearLimit(static_cast<int8_t>(m_motorDirection)))
+    {
+        return AnimationConstants::kMinSpeed;
+    }
+    return speed;
+}
+
+void Animation::eyeBlink()
+{
+    for (uint8_t i = 0; i < m_numEyes; i++)
+    {
+        EyeAnimation* eye = m_eyes[i];
+        if (m_inputButtonRectangle == LOW)
+        {
+            eye->rotateActiveColor();
+        }
+
+        // Update the eye animation based on the current mode
+        const bool running = m_program.isRunning() || m_show.isPlaying();
+        if (m_inputButtonCircle == LOW || (running && m_programEye == VmEye::Rainbow))
         {
-            m_eyeAnimation->sleep();
+            eye->updateRainbowColor();
         }
         else
         {
-            m_eyeAnimation->updateActiveColor();
+            if (running ? m_programEye == VmEye::Sleep
+                        : m_behavior.getState() == BehaviorState::Sleep)
+            {
+                eye->sleep();
+            }
+            else
+            {
+                eye->updateActiveColor();
+            }
         }
     }
 }
@@ -445,5 +1004,5 @@ void Animation::updateLedFade()
     }
 
     // Apply the brightness
-    analogWrite(m_pins.domeLedGreen, m_currentLedBrightness);
+    m_domeLedOutput.write(m_currentLedBrightness);
 }
@@ -28,8 +28,17 @@
 // Project includes
 #include "AnimationInputs.h"
 #include "AnimationPins.h"
+#include <DomeLed.h>
 #include <EyeAnimation.h>
+#include <HeadEstimator.h>
+#include <InputEvents.h>
+#include <MotionPlanner.h>
+#include <MotorDriver.h>
+#include <PwmOutput.h>
 #include <AudioPlayer.h>
+#include <BehaviorMachine.h>
+#include <BehaviorVm.h>
+#include <Choreography.h>
 #include <Logger.h>
 
 /**
@@ -61,13 +70,13 @@ constexpr uint32_t kMaxRotateInterval = 1000;  ///< Maximum time (ms) between di
 constexpr uint32_t kMinDirectionTime = 500;  ///< Min time (ms) before considering direction change
 constexpr uint32_t kMaxDirectionTime =
     1500;  ///< Time (ms) after which direction is strongly preferred
+constexpr uint32_t kSteerInterval = 100;  ///< Time (ms) between speed updates while scanning
 /// @}
 
 /// @name PIR Sensor Timing
 /// @{
-constexpr uint32_t kInactivityTimeout = 5000;  ///< Time (ms) of inactivity before stopping
 constexpr uint32_t kEyeResetInterval =
-    300000;  ///< Time (ms) before eye animation reset (5 minutes)
+    300000;  ///< Time (ms) without motion before going to sleep (5 minutes)
 /// @}
 
 /// @name Direction Bias
@@ -85,6 +94,16 @@ constexpr uint8_t kLedMinBrightness = 64;   ///< Minimum LED brightness (0-255)
 constexpr uint8_t kLedMaxBrightness = 128;  ///< Maximum LED brightness (0-255)
 /// @}
 
+/// @name Gaze
+/// @{
+constexpr float kGazeTolerance = 0.02f;  ///< Gaze targets closer than this need no move
+/// @}
+
+/// @name Eyes
+/// @{
+constexpr uint8_t kMaxEyes = 4;  ///< Eyes one Animation can drive
+/// @}
+
 /// @name Sound Probability
 /// @{
 constexpr uint8_t kSoundOnMovementProbability =
@@ -194,11 +213,24 @@ public:
      *
      * Processes all inputs, updates the animation state, and controls outputs.
      * This method should be called regularly from the main program loop.
+     * Input states are only taken from the snapshot when it reports a change.
      *
      * @param[in] inputs Current state of all input devices
      */
     void update(const AnimationInputs& inputs);
 
+    /**
+     * @brief Apply the input edges captured since the previous call
+     *
+     * Call after update(). An edge to an input's active level (LOW for the hall sensors
+     * and buttons, HIGH for the PIR) holds that input active until the next update(),
+     * so a tap that starts and ends between two logic passes is still acted on.
+     *
+     * @param[in,out] queue Captured edges, drained
+     * @return uint8_t Number of edges taken from the queue
+     */
+    uint8_t consumeInputEvents(InputEventQueue& queue);
+
     /**
      * @brief Controls motor rotation with specified speed and direction
      *
@@ -213,9 +245,13 @@ public:
      * @brief Stops all motor movement
      *
      * Immediately stops the motor and cleans up any related state.
-     * This is a hard stop with no ramping.
+     * This is a hard stop with no ramping, unless a MotionPlanner is attached, which
+     * ramps the motor down to rest before coasting.
+     *
+     * @param[in] rest Coast (both inputs low) or brake (both inputs high); a brake is
+     *                 always immediate, even with a planner attached
      */
-    virtual void stop();
+    virtual void stop(MotorStop rest = MotorStop::Coast);
 
     /**
      * @brief Updates sound effects based on current state
@@ -233,6 +269,108 @@ public:
      */
     virtual void eyeBlink();
 
+    /**
+     * @brief Hand the dome LED over to a timer-driven driver
+     *
+     * @param[in] domeLed Pointer to a started DomeLed, or nullptr to fade from update calls
+     *
+     * @note With a driver attached performRotate() only selects its pattern; without one
+     *       the dome LED is stepped by updateLedFade() through a PwmOutput
+     */
+    void setDomeLed(DomeLed* domeLed) { m_domeLed = domeLed; }
+
+    /**
+     * @brief Track the head position with an estimator
+     *
+     * @param[in] estimator Pointer to a HeadEstimator, or nullptr to drive blind
+     *
+     * @note While the estimator's calibration sweep runs, performRotate() drives the sweep
+     *       instead of the normal behavior; afterwards moves slow down near the limits
+     */
+    void setHeadEstimator(HeadEstimator* estimator) { m_headEstimator = estimator; }
+
+    /**
+     * @brief Hand the neck motor over to a timer-driven motion planner
+     *
+     * @param[in] planner Pointer to a started MotionPlanner, or nullptr to write the PWM
+     *                    from update calls
+     *
+     * @note With a planner attached rotate() and stop() only set its target speed, and
+     *       its S-curve ramps replace the bell-curve speed of the Scanning state
+     */
+    void setMotionPlanner(MotionPlanner* planner) { m_motionPlanner = planner; }
+
+    /**
+     * @brief Hand the neck motor over to a timer-driven H-bridge driver
+     *
+     * @param[in] driver Pointer to a started MotorDriver, or nullptr to write the PWM from
+     *                   update calls
+     *
+     * @note A MotionPlanner takes precedence; without one rotate() and stop() command the
+     *       driver directly, which adds its slew limit and reversal dead time
+     */
+    void setMotorDriver(MotorDriver* driver) { m_motorDriver = driver; }
+
+    /// @name Gaze
+    /// @{
+    /**
+     * @brief Turn the head to a position and hold it there
+     *
+     * @param[in] position Target between the hall sensors, 0.0 left to 1.0 right
+     * @param[in] durationMs Time the move should take, 0 to move as fast as allowed
+     * @return true if the move was planned, false without a calibrated HeadEstimator
+     *         and a MotionPlanner
+     *
+     * @note The gaze owns the motor until releaseGaze(): the move decelerates into the
+     *       target and the head holds there, so behaviors driven by the PIR sensor pause.
+     *       The duty is limited to kMinSpeed..kMaxMotorSpeed, so the duration is a target.
+     */
+    bool lookAt(float position, unsigned long durationMs = 0);
+
+    /**
+     * @brief Hand the motor back to the behaviors after lookAt()
+     */
+    void releaseGaze();
+
+    /**
+     * @brief Check whether a gaze owns the motor
+     * @return true from lookAt() until releaseGaze(), false otherwise
+     */
+    bool isGazing() const { return m_gaze != GazeState::Idle; }
+
+    /**
+     * @brief Check whether the last lookAt() has reached its target
+     * @return true once the move has stopped at the target, false otherwise
+     */
+    bool hasArrived() const { return m_gaze == GazeState::Arrived; }
+
+    /**
+     * @brief Check whether the last lookAt() was stopped short of its target
+     * @return true once a hall sensor has halted the move away from the target, false
+     *         otherwise
+     *
+     * @note The head holds where it stopped until the next lookAt() or releaseGaze()
+     */
+    bool isBlocked() const { return m_gaze == GazeState::Blocked; }
+    /// @}
+
+    /**
+     * @brief Drive another eye alongside the one given to the constructor
+     *
+     * @param[in] eye Pointer to the EyeAnimation to add
+     * @return true if the eye was added, false if it is null or kMaxEyes are attached
+     *
+     * @note Every eye gets the same updates; use EyeAnimation::followBlinks() to tie
+     *       an eye's blinks to another one with a phase offset
+     */
+    bool addEye(EyeAnimation* eye);
+
+    /**
+     * @brief Get the number of eyes being driven
+     * @return Number of attached eyes
+     */
+    uint8_t getNumEyes() const { return m_numEyes; }
+
     /// @name Getters
     /// @{
     /**
@@ -246,6 +384,101 @@ public:
      * @return Current system time in milliseconds
      */
     unsigned long getCurrentTime() const { return m_currentTime; }
+
+    /**
+     * @brief Get the duty last written to the neck motor
+     * @return int16_t PWM duty, positive to the right, negative to the left
+     */
+    int16_t getMotorDuty() const
+    {
+        if (m_motionPlanner != nullptr)
+        {
+            return m_motionPlanner->getOutput();
+        }
+        return m_motorDriver != nullptr ? m_motorDriver->getOutput() : m_motorDuty;
+    }
+
+    /**
+     * @brief Get the innermost active behavior state
+     * @return BehaviorState Sleep, Idle, Alert, Scanning or Reacting
+     */
+    BehaviorState getBehaviorState() const { return m_behavior.getState(); }
+
+    /**
+     * @brief Get the next time performRotate() has work to do without a new event
+     * @return unsigned long Absolute time (ms), or BehaviorMachineConstants::NO_DEADLINE
+     */
+    unsigned long getNextDeadline() const { return m_behavior.getNextDeadline(); }
+
+    /**
+     * @brief Get the number of behavior events that ran a transition or an action
+     * @return uint32_t Events taken since construction
+     */
+    uint32_t getBehaviorEventCount() const { return m_behavior.getEventCount(); }
+    /// @}
+
+    /// @name Behavior Programs
+    /// @{
+    /**
+     * @brief Run a behavior program in place of the behavior machine
+     *
+     * @param[in] code Program bytes, which must stay valid while it runs
+     * @param[in] length Program length; 0 stops the running program
+     * @return true if the program was started or stopped, false if it is invalid
+     *
+     * @note The behavior machine takes over again when the program ends or is stopped
+     */
+    bool runProgram(const uint8_t* code, uint16_t length);
+
+    /**
+     * @brief Stop the running behavior program
+     */
+    void stopProgram() { runProgram(nullptr, 0); }
+
+    /**
+     * @brief Check whether a behavior program owns the head
+     * @return true while a program runs, false otherwise
+     */
+    bool isRunningProgram() const { return m_program.isRunning(); }
+
+    /**
+     * @brief Get the interpreter running the behavior programs
+     * @return const BehaviorVm& Interpreter
+     */
+    const BehaviorVm& getBehaviorVm() const { return m_program; }
+    /// @}
+
+    /// @name Shows
+    /// @{
+    /**
+     * @brief Play the authored show for a situation
+     *
+     * @param[in] trigger Situation
+     * @return true if the show started, false while the head is calibrating or for an
+     *         unknown trigger
+     *
+     * @note The show owns the head, eyes, dome LED and audio until its timeline ends,
+     *       taking over from the behaviors and any behavior program; a show already
+     *       playing is cut short
+     */
+    bool playShow(ShowTrigger trigger);
+
+    /**
+     * @brief Cut the playing show short and hand everything back
+     */
+    void stopShow();
+
+    /**
+     * @brief Check whether a show is playing
+     * @return true while a show plays, false otherwise
+     */
+    bool isPlayingShow() const { return m_show.isPlaying(); }
+
+    /**
+     * @brief Get the player running the shows
+     * @return const ShowPlayer& Player, with the timing of the current or last show
+     */
+    const ShowPlayer& getShowPlayer() const { return m_show; }
     /// @}
 
     /// @name Testing Interface
@@ -281,34 +514,33 @@ public:
     /**
      * @brief Determines the direction for the next rotation
      *
-     * This method uses sensor inputs and timing to decide the next rotation
-     * direction, implementing the core behavior logic for head movement.
-     * It considers factors like recent movements, sensor triggers, and timing.
+     * Turns away from an active hall sensor, otherwise picks a random direction
+     * biased by how long ago the head last turned each way. Called by the Scanning
+     * and Reacting states of the behavior machine.
      */
     virtual void setRotationDirection();
 
     /**
      * @brief Executes the rotation behavior based on current state
      *
-     * Manages the motor control for head rotation, including speed ramping,
-     * timing, and interaction with the PIR sensor. This method handles the
-     * actual movement logic once the direction has been determined.
+     * Feeds the behavior machine its events: PIR edges, reaching or closing on the
+     * limit the head is moving toward, and the deadline of the active state. Between
+     * them there is nothing to evaluate and the call returns at once. A playing show or a
+     * running behavior program takes the machine's place.
      */
     virtual void performRotate();
 
     /**
      * @brief Handles actions when PIR sensor is triggered
      *
-     * Contains logic to execute when motion is detected by the PIR sensor.
-     * This includes starting animations and setting appropriate timers.
+     * Records the start of motion and sends PirRise to the behavior machine.
      */
     void handlePirTriggered();
 
     /**
      * @brief Handles actions when PIR sensor becomes inactive
      *
-     * Contains logic to execute when motion is no longer detected.
-     * Manages the transition to idle state and related animations.
+     * Records the end of motion and sends PirFall to the behavior machine.
      */
     void handlePirInactive();
 
@@ -320,23 +552,225 @@ public:
     void updateLedFade();
 
 protected:
+    /**
+     * @brief Progress of a lookAt() move
+     */
+    enum class GazeState : uint8_t
+    {
+        Idle,     ///< Behaviors own the motor
+        Moving,   ///< Planner is moving to the target
+        Arrived,  ///< Holding at the target
+        Blocked,  ///< Halted at a hall sensor short of the target
+    };
+
+    /**
+     * @brief Forwards the behavior machine's callbacks to the Animation
+     */
+    class Behaviors : public BehaviorHandler
+    {
+    public:
+        explicit Behaviors(Animation& owner) : m_owner(owner) {}
+
+        void runBehaviorAction(BehaviorAction action) override
+        {
+            m_owner.runBehaviorAction(action);
+        }
+        bool checkBehaviorGuard(BehaviorGuard guard) const override
+        {
+            return m_owner.checkBehaviorGuard(guard);
+        }
+        unsigned long getBehaviorTimer(BehaviorTimer timer) const override
+        {
+            return m_owner.getBehaviorTimer(timer);
+        }
+
+    private:
+        Animation& m_owner;  ///< Animation the behaviors drive
+    };
+
+    /**
+     * @brief Forwards the behavior programs' instructions to the Animation
+     */
+    class Programs : public BehaviorVmHost
+    {
+    public:
+        explicit Programs(Animation& owner) : m_owner(owner) {}
+
+        void vmMotor(int8_t direction, uint8_t speed) override
+        {
+            m_owner.programMotor(direction, speed);
+        }
+        void vmEye(VmEye mode, uint8_t argument) override { m_owner.programEye(mode, argument); }
+        void vmSound(uint8_t index) override { m_owner.programSound(index); }
+        void vmDome(uint8_t level) override { m_owner.programDome(level); }
+        uint8_t vmSensors() const override { return m_owner.getProgramSensors(); }
+
+    private:
+        Animation& m_owner;  ///< Animation the programs drive
+    };
+
+    /**
+     * @brief Forwards the shows' cues to the Animation
+     */
+    class Shows : public ShowHost
+    {
+    public:
+        explicit Shows(Animation& owner) : m_owner(owner) {}
+
+        void showCue(const ShowCue& cue) override { m_owner.runShowCue(cue); }
+        bool showAudioClock(uint8_t sound, ShowAudioClock& clock) const override
+        {
+            return m_owner.getShowAudioClock(sound, clock);
+        }
+
+    private:
+        Animation& m_owner;  ///< Animation the shows drive
+    };
+
+    /**
+     * @brief Follow a gaze in place of the behaviors
+     */
+    void updateGaze();
+
+    /// @name Behavior Machine Callbacks
+    /// @{
+    /**
+     * @brief Perform an entry, exit or transition action of the behavior machine
+     *
+     * @param[in] action Action to perform
+     */
+    void runBehaviorAction(BehaviorAction action);
+
+    /**
+     * @brief Evaluate a transition guard of the behavior machine
+     *
+     * @param[in] guard Condition to check
+     * @return true if the condition holds, false otherwise
+     */
+    bool checkBehaviorGuard(BehaviorGuard guard) const;
+
+    /**
+     * @brief Get the deadline of a behavior timer
+     *
+     * @param[in] timer Timer to read
+     * @return unsigned long Absolute time (ms) the timer expires
+     */
+    unsigned long getBehaviorTimer(BehaviorTimer timer) const;
+
+    /**
+     * @brief Set the speed in the current direction and time the next update
+     *
+     * @details
+     * With a planner the speed is the maximum, which its ramps ease into; without one it
+     * follows a bell curve over the time spent in the direction, with random variation.
+     */
+    void steer();
+    /// @}
+
+    /// @name Behavior Program Callbacks
+    /// @{
+    /**
+     * @brief Turn the head for a program
+     *
+     * @param[in] direction Negative for left, positive for right, 0 to stop
+     * @param[in] speed Motor duty (0-255)
+     */
+    void programMotor(int8_t direction, uint8_t speed);
+
+    /**
+     * @brief Set the eye mode for a program
+     *
+     * @param[in] mode Eye mode
+     * @param[in] argument Blink length in 10 ms units for VmEye::Blink
+     */
+    void programEye(VmEye mode, uint8_t argument);
+
+    /**
+     * @brief Play a sound for a program
+     *
+     * @param[in] index Sound index, or BehaviorVmConstants::RANDOM_SOUND
+     */
+    void programSound(uint8_t index);
+
+    /**
+     * @brief Set the dome LED level for a program
+     *
+     * @param[in] level Brightness (0-255)
+     */
+    void programDome(uint8_t level);
+
+    /**
+     * @brief Get the sensors a program can test
+     *
+     * @return uint8_t Bit (1 << VmSensor) set for each active sensor
+     */
+    uint8_t getProgramSensors() const;
+    /// @}
+
+    /// @name Show Callbacks
+    /// @{
+    /**
+     * @brief Perform a show cue
+     *
+     * @param[in] cue Cue whose time has come
+     */
+    void runShowCue(const ShowCue& cue);
+
+    /**
+     * @brief Read the sample clock of a show's sound
+     *
+     * @param[in] sound Sound index the show started
+     * @param[out] clock Samples output so far and the sample rate
+     * @return true while that sound is playing, false otherwise
+     */
+    bool getShowAudioClock(uint8_t sound, ShowAudioClock& clock) const;
+
+    /**
+     * @brief Hand the head and eyes back once a show is over
+     */
+    void endShow();
+    /// @}
+
+    /**
+     * @brief Slow a move down when the head estimator says the limit ahead is close
+     *
+     * @param[in] speed Speed the behavior asked for (0-255)
+     * @return uint8_t kMinSpeed near the limit in the current direction, speed otherwise
+     */
+    uint8_t limitApproachSpeed(uint8_t speed) const;
+
     /// @name Hardware Interfaces
     /// @{
-    AnimationPins m_pins;                    ///< Pin configuration for all hardware components
-    EyeAnimation* m_eyeAnimation = nullptr;  ///< Controller for NeoPixel LEDs
-    AudioPlayer* m_audioPlayer = nullptr;    ///< Audio playback controller
+    AnimationPins m_pins;                      ///< Pin configuration for all hardware components
+    AudioPlayer* m_audioPlayer = nullptr;      ///< Audio playback controller
+    DomeLed* m_domeLed = nullptr;              ///< Optional timer-driven dome LED
+    PwmOutput m_neckMotorIn1;                  ///< Left H-bridge input without a driver
+    PwmOutput m_neckMotorIn2;                  ///< Right H-bridge input without a driver
+    PwmOutput m_domeLedOutput;                 ///< Dome LED without a DomeLed driver
+    HeadEstimator* m_headEstimator = nullptr;  ///< Optional head position estimator
+    MotionPlanner* m_motionPlanner = nullptr;  ///< Optional timer-driven neck motor planner
+    MotorDriver* m_motorDriver = nullptr;      ///< Optional timer-driven neck motor driver
+    /// @}
+
+    /// @name Eyes
+    /// @{
+    EyeAnimation* m_eyes[AnimationConstants::kMaxEyes] = {};  ///< Controllers for NeoPixel LEDs
+    uint8_t m_numEyes = 0;                                    ///< Number of attached eyes
     /// @}
 
     /// @name Motor Control State
     /// @{
     MotorDirection m_motorDirection =
         MotorDirection::Stop;                  ///< Current direction of motor movement
+    int16_t m_motorDuty = 0;                   ///< Duty last written, positive to the right
     unsigned long m_lastLeftTurnTime = 0;      ///< Timestamp of last left turn
     unsigned long m_lastRightTurnTime = 0;     ///< Timestamp of last right turn
-    unsigned long m_randomRotateTimer = 0;     ///< Timer for random rotation timing
+    unsigned long m_randomRotateTimer = 0;     ///< End of the movement cycle or the rest
     unsigned long m_randomDirectionTimer = 0;  ///< Timer for random direction timing
-    uint32_t m_lastMovementEndTime = 0;        ///< When the last movement ended
-    bool m_isInMovementCycle = false;          ///< Whether we're currently in a movement cycle
+    unsigned long m_nextSteerTime = 0;         ///< When the speed is next updated
+    GazeState m_gaze = GazeState::Idle;        ///< Progress of the last lookAt()
+    float m_gazeTarget = 0.0f;                 ///< Position the gaze is moving to
+    unsigned long m_gazeStartTime = 0;         ///< When the gaze move was planned
     /// @}
 
     /// @name LED Fade State
@@ -355,12 +789,24 @@ protected:
     int8_t m_inputButtonRectangle = 0;  ///< Current state of rectangular button
     int8_t m_inputButtonCircle = 0;     ///< Current state of circular button
     unsigned long m_lastPIRTimer = 0;   ///< Timestamp of last PIR sensor trigger
+    bool m_inputsLatched = false;       ///< Edges set input states since the last update
     /// @}
 
     /// @name System State
     /// @{
     unsigned long m_currentTime = 0;  ///< Current system time from last update() call
     /// @}
+
+    /// @name Behavior State
+    /// @{
+    Behaviors m_behaviorHandler{*this};             ///< Callbacks for the behavior machine
+    BehaviorMachine m_behavior{m_behaviorHandler};  ///< Sleep, Idle, Alert, Scanning, Reacting
+    Programs m_programHost{*this};                  ///< Callbacks for the behavior programs
+    BehaviorVm m_program{m_programHost};            ///< Interpreter for a behavior program
+    VmEye m_programEye = VmEye::Active;             ///< Eye mode a program or show set
+    Shows m_showHost{*this};                        ///< Callbacks for the shows
+    ShowPlayer m_show{m_showHost};                  ///< Player for a greeting, startle or sigh
+    /// @}
 };
 
 #endif  // Y_SERIES_USB_HUB_ANIMATION_H
\ No newline at end of file
@@ -4,56 +4,163 @@
  *
  * This file defines the AnimationInputs structure that holds the current state
  * of all input devices used in the animation system, including sensors and buttons.
- * It also provides a utility function to read these inputs from hardware pins.
+ * It also provides an InputReader that snapshots these inputs from hardware pins
+ * with a single read of the GPIO port.
  */
 
 #ifndef ANIMATIONINPUTS_H
 #define ANIMATIONINPUTS_H
 
 #include <Arduino.h>
+#include <hardware/gpio.h>
 
 #include "AnimationPins.h"
 
+/**
+ * @brief Bit of each input in a packed snapshot and in AnimationInputs::changed
+ */
+namespace AnimationInputBits
+{
+constexpr uint8_t SENSOR_LEFT = 1U << 0;       ///< Left hall effect sensor
+constexpr uint8_t SENSOR_RIGHT = 1U << 1;      ///< Right hall effect sensor
+constexpr uint8_t PIR_SENSOR = 1U << 2;        ///< PIR motion sensor
+constexpr uint8_t BUTTON_RECTANGLE = 1U << 3;  ///< Rectangular button
+constexpr uint8_t BUTTON_CIRCLE = 1U << 4;     ///< Circular button
+constexpr uint8_t COUNT = 5;                   ///< Number of inputs
+constexpr uint8_t ALL = (1U << COUNT) - 1;     ///< Every input
+}  // namespace AnimationInputBits
+
 /**
  * @brief Holds the current state of all animation input devices
  *
  * This structure stores the digital state of all input devices at a given moment,
  * along with a timestamp. It's used to pass input state between different
- * components of the animation system.
+ * components of the animation system. Each level is a single bit, so a snapshot
+ * packs into one byte of levels, one byte of changes and the timestamp.
  */
 struct AnimationInputs
 {
-    int8_t sensorLeft;       ///< Current state of the left hall effect sensor (HIGH/LOW)
-    int8_t sensorRight;      ///< Current state of the right hall effect sensor (HIGH/LOW)
-    int8_t pirSensor;        ///< Current state of the PIR motion sensor (HIGH/LOW)
-    int8_t buttonRectangle;  ///< Current state of the rectangular button (HIGH/LOW, with pull-up:
-                             ///< LOW when pressed)
-    int8_t buttonCircle;     ///< Current state of the circular button (HIGH/LOW, with pull-up: LOW
-                             ///< when pressed)
-    unsigned long currentTime;  ///< Timestamp in milliseconds when inputs were read
+    uint8_t sensorLeft : 1;       ///< Current state of the left hall effect sensor (HIGH/LOW)
+    uint8_t sensorRight : 1;      ///< Current state of the right hall effect sensor (HIGH/LOW)
+    uint8_t pirSensor : 1;        ///< Current state of the PIR motion sensor (HIGH/LOW)
+    uint8_t buttonRectangle : 1;  ///< Current state of the rectangular button (HIGH/LOW, with
+                                  ///< pull-up: LOW when pressed)
+    uint8_t buttonCircle : 1;     ///< Current state of the circular button (HIGH/LOW, with
+                                  ///< pull-up: LOW when pressed)
+    unsigned long currentTime;    ///< Timestamp in milliseconds when inputs were read
+    uint8_t changed = AnimationInputBits::ALL;  ///< AnimationInputBits that changed since the
+                                                ///< previous snapshot; all of them unless an
+                                                ///< InputReader took the snapshot
 };
 
 /**
- * @brief Reads the current state of all input devices
- *
- * This helper function reads the digital state of all input devices using the
- * provided pin configuration and returns them in an AnimationInputs structure.
- * The function also records the current time using millis().
+ * @brief Build an input snapshot from packed levels
  *
- * @param pins Reference to an AnimationPins structure containing pin numbers
- * @return AnimationInputs Structure containing the current state of all inputs
- *                         and the timestamp of when they were read
+ * @param levels Level of each input, one AnimationInputBits bit each (set = HIGH)
+ * @param currentTime Timestamp in milliseconds of the levels
+ * @param changed AnimationInputBits that changed since the previous snapshot
+ * @return AnimationInputs Snapshot holding the levels
  */
-inline AnimationInputs readInputs(const AnimationPins& pins)
+inline AnimationInputs unpackInputs(uint8_t levels, unsigned long currentTime, uint8_t changed)
 {
     AnimationInputs inputs;
-    inputs.sensorLeft = digitalRead(pins.sensorLeft);
-    inputs.sensorRight = digitalRead(pins.sensorRight);
-    inputs.pirSensor = digitalRead(pins.pirSensor);
-    inputs.buttonRectangle = digitalRead(pins.buttonRectangle);
-    inputs.buttonCircle = digitalRead(pins.buttonCircle);
-    inputs.currentTime = millis();
+    inputs.sensorLeft = (levels & AnimationInputBits::SENSOR_LEFT) != 0 ? HIGH : LOW;
+    inputs.sensorRight = (levels & AnimationInputBits::SENSOR_RIGHT) != 0 ? HIGH : LOW;
+    inputs.pirSensor = (levels & AnimationInputBits::PIR_SENSOR) != 0 ? HIGH : LOW;
+    inputs.buttonRectangle = (levels & AnimationInputBits::BUTTON_RECTANGLE) != 0 ? HIGH : LOW;
+    inputs.buttonCircle = (levels & AnimationInputBits::BUTTON_CIRCLE) != 0 ? HIGH : LOW;
+    inputs.currentTime = currentTime;
+    inputs.changed = changed;
     return inputs;
 }
 
+/**
+ * @brief Pack the levels of an input snapshot
+ *
+ * @param inputs Snapshot to pack
+ * @return uint8_t Level of each input, one AnimationInputBits bit each (set = HIGH)
+ */
+inline uint8_t packInputs(const AnimationInputs& inputs)
+{
+    return (inputs.sensorLeft ? AnimationInputBits::SENSOR_LEFT : 0) |
+           (inputs.sensorRight ? AnimationInputBits::SENSOR_RIGHT : 0) |
+           (inputs.pirSensor ? AnimationInputBits::PIR_SENSOR : 0) |
+           (inputs.buttonRectangle ? AnimationInputBits::BUTTON_RECTANGLE : 0) |
+           (inputs.buttonCircle ? AnimationInputBits::BUTTON_CIRCLE : 0);
+}
+
+/**
+ * @brief Snapshots every animation input with one read of the GPIO port
+ *
+ * The pin masks are worked out once, at construction, so a snapshot is a single
+ * gpio_get_all() and a handful of mask tests instead of a digitalRead per input.
+ * Each snapshot also reports which inputs changed since the one before it.
+ *
+ * @note On the native build gpio_get_all() comes from the test stand-in, which
+ *       counts the port reads
+ */
+class InputReader
+{
+public:
+    /**
+     * @brief Construct a reader for the given pin configuration
+     *
+     * @param pins Pin assignments whose input pins are read
+     */
+    explicit InputReader(const AnimationPins& pins)
+        : m_masks{1U << pins.sensorLeft, 1U << pins.sensorRight, 1U << pins.pirSensor,
+                  1U << pins.buttonRectangle, 1U << pins.buttonCircle}
+    {
+    }
+
+    // Prevent copying and assignment
+    InputReader(const InputReader&) = delete;
+    InputReader& operator=(const InputReader&) = delete;
+
+    /**
+     * @brief Read the current state of all input devices
+     *
+     * The first snapshot reports every input as changed.
+     *
+     * @return AnimationInputs Structure containing the current state of all inputs,
+     *                         the timestamp of when they were read and the inputs
+     *                         that changed since the previous snapshot
+     */
+    AnimationInputs read()
+    {
+        const uint8_t levels = readLevels();
+        const uint8_t changed = m_primed ? levels ^ m_levels : AnimationInputBits::ALL;
+        m_levels = levels;
+        m_primed = true;
+        return unpackInputs(levels, millis(), changed);
+    }
+
+    /**
+     * @brief Read the level of every input without taking a snapshot
+     *
+     * @return uint8_t Level of each input, one AnimationInputBits bit each (set = HIGH)
+     *
+     * @note Leaves the levels read() compares against alone, so a sampler such as the
+     *       Debouncer may call it from a timer
+     */
+    uint8_t readLevels() const
+    {
+        const uint32_t port = gpio_get_all();
+        uint8_t levels = 0;
+        for (uint8_t i = 0; i < AnimationInputBits::COUNT; i++)
+        {
+            if ((port & m_masks[i]) != 0)
+            {
+                levels |= 1U << i;
+            }
+        }
+        return levels;
+    }
+
+private:
+    const uint32_t m_masks[AnimationInputBits::COUNT];  ///< Port bit of each input
+    uint8_t m_levels = 0;   ///< Packed levels of the previous snapshot
+    bool m_primed = false;  ///< Whether a previous snapshot exists
+};
+
 #endif  // ANIMATIONINPUTS_H
@@ -11,6 +11,8 @@
 
 #include "AudioPlayer.h"
 
+#include <Random.h>
+
 /**
  * @brief Construct a new AudioPlayer instance
  *
@@ -143,7 +145,7 @@ bool AudioPlayer::playRandomSound()
     }
 
     // Generate random index (skip index 0 for system sounds)
-    const int randomIndex = (rand() % (NUM_SOUND_FILES - 1)) + 1;
+    const int randomIndex = static_cast<int>(Rng.below(NUM_SOUND_FILES - 1)) + 1;
 
     Log.info("Playing random sound %d", randomIndex);
     return play(randomIndex);
@@ -135,6 +135,24 @@ public:
      */
     virtual bool isPlaying() const { return m_state == WAVState::Playing; }
 
+    /**
+     * @brief Get the number of samples of the current sound output so far
+     * @return Samples clocked out by the TimerAudio since the sound started, 0 without one
+     */
+    virtual uint32_t getSamplesPlayed() const
+    {
+        return m_player != nullptr ? m_player->getSamplesPlayed() : 0;
+    }
+
+    /**
+     * @brief Get the rate the samples are clocked out at
+     * @return Sample rate in Hz, 0 without a TimerAudio
+     */
+    virtual uint32_t getSampleRate() const
+    {
+        return m_player != nullptr ? m_player->getSampleRate() : 0;
+    }
+
     /**
      * @brief Get the total number of available sounds
      * @return Number of sound files available (compile-time constant)
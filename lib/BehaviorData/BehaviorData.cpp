@@ -0,0 +1,25 @@
+/**
+ * @file BehaviorData.cpp
+ * @brief Implementation of built-in behavior program storage for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file collects the generated behavior program headers. The bytecode stays in
+ * program memory (PROGMEM) and is interpreted from there. The source of each program
+ * is kept in assets/behaviors/.
+ */
+
+#include "BehaviorData.h"
+
+// Include the generated behavior programs
+// These are generated with .scripts/behavior_compiler.py
+#include "behavior_sentry.h"
+
+// Array of pointers to all behavior programs
+// The order of programs in this array must match the program indices in BehaviorData.h
+const BehaviorProgram* const behavior_programs[NUM_BEHAVIOR_PROGRAMS] = {&behavior_sentry};
+
+// Static assertion to ensure data consistency
+static_assert(sizeof(behavior_programs) / sizeof(behavior_programs[0]) == NUM_BEHAVIOR_PROGRAMS,
+              "Mismatch between NUM_BEHAVIOR_PROGRAMS and behavior_programs array size");
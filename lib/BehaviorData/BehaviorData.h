@@ -0,0 +1,50 @@
+/**
+ * @file BehaviorData.h
+ * @brief Built-in behavior program storage for the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This module provides the precompiled behavior programs stored in program memory
+ * (PROGMEM). Each program is compiled from a text source with
+ * `make behavior-to-header` and run by Animation::runProgram().
+ */
+
+#ifndef Y_SERIES_USB_HUB_BEHAVIOR_DATA_H
+#define Y_SERIES_USB_HUB_BEHAVIOR_DATA_H
+
+// System includes
+#include <Arduino.h>
+
+// Project includes
+#include <BehaviorVm.h>
+
+/**
+ * @brief Number of available behavior programs in the system
+ */
+static constexpr uint8_t NUM_BEHAVIOR_PROGRAMS = 1;
+
+/// @name Program Indices
+/// @{
+static constexpr uint8_t BEHAVIOR_SENTRY = 0;  ///< Sweep the room and challenge visitors
+/// @}
+
+/**
+ * @brief Array of pointers to all behavior programs
+ *
+ * @note The order of programs in this array must match the program indices above
+ */
+extern const BehaviorProgram* const behavior_programs[NUM_BEHAVIOR_PROGRAMS];
+
+/**
+ * @brief Get a behavior program
+ *
+ * @param[in] index Index of the program (0 to NUM_BEHAVIOR_PROGRAMS-1)
+ * @return const BehaviorProgram* Program descriptor, or nullptr if index is invalid
+ */
+inline const BehaviorProgram* getBehaviorProgram(uint8_t index)
+{
+    return (index < NUM_BEHAVIOR_PROGRAMS) ? behavior_programs[index] : nullptr;
+}
+
+#endif  // Y_SERIES_USB_HUB_BEHAVIOR_DATA_H
@@ -0,0 +1,21 @@
+// Auto-generated from sentry.bvs
+#ifndef BEHAVIOR_SENTRY_H
+#define BEHAVIOR_SENTRY_H
+
+#include <Arduino.h>
+#include <BehaviorVm.h>
+
+// 71 bytes of behavior program
+const uint8_t behavior_sentry_data[] PROGMEM = {
+    0x02, 0x00, 0x00, 0x04, 0x00, 0x01, 0xff, 0x5a, 0x08, 0x00, 0x2d, 0x00,
+    0x08, 0x01, 0x16, 0x00, 0x05, 0x32, 0x00, 0x07, 0x08, 0x00, 0x01, 0x01,
+    0x5a, 0x08, 0x00, 0x2d, 0x00, 0x08, 0x02, 0x27, 0x00, 0x05, 0x32, 0x00,
+    0x07, 0x19, 0x00, 0x01, 0xff, 0x5a, 0x07, 0x08, 0x00, 0x01, 0x00, 0x00,
+    0x04, 0xff, 0x02, 0x03, 0x1e, 0x03, 0xff, 0x06, 0xd0, 0x07, 0xa0, 0x0f,
+    0x02, 0x04, 0x00, 0x09, 0x80, 0x05, 0xe8, 0x03, 0x07, 0x00, 0x00,
+};
+
+// Program descriptor: code, length
+const BehaviorProgram behavior_sentry = {behavior_sentry_data, sizeof(behavior_sentry_data)};
+
+#endif // BEHAVIOR_SENTRY_H
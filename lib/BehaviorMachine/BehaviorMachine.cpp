@@ -0,0 +1,164 @@
+/**
+ * @file BehaviorMachine.cpp
+ * @brief Implementation of the BehaviorMachine class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the BehaviorMachine class which looks events up in the
+ * transition table and walks the state hierarchy to run exit and entry actions.
+ */
+
+#include "BehaviorMachine.h"
+
+/**
+ * @brief Construct a new behavior machine
+ *
+ * @param[in] handler Owner of the actions, guards and timers
+ * @param[in] initial State to start in; its entry actions are not run
+ */
+BehaviorMachine::BehaviorMachine(BehaviorHandler& handler, BehaviorState initial)
+    : m_handler(handler), m_state(initial), m_eventCount(0)
+{
+}
+
+/**
+ * @brief Offer an event to the active state and its ancestors
+ *
+ * @param[in] event Event that occurred
+ * @return true if a row took the event, false if it was ignored
+ */
+bool BehaviorMachine::dispatch(BehaviorEvent event)
+{
+    for (BehaviorState state = m_state; state != BehaviorState::None; state = parentOf(state))
+    {
+        for (const BehaviorMachineConstants::Transition& row :
+             BehaviorMachineConstants::TRANSITIONS)
+        {
+            if (row.state != state || row.event != event ||
+                !m_handler.checkBehaviorGuard(row.guard))
+            {
+                continue;
+            }
+
+            m_eventCount++;
+            if (row.target == BehaviorState::None)
+            {
+                perform(row.action);
+            }
+            else
+            {
+                transitionTo(row.target, row.action);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Dispatch a Timeout if the active state's deadline has passed
+ *
+ * @param[in] now Current time (ms)
+ * @return true if a timeout was taken, false otherwise
+ */
+bool BehaviorMachine::poll(unsigned long now)
+{
+    const unsigned long deadline = getNextDeadline();
+    if (deadline == BehaviorMachineConstants::NO_DEADLINE || now < deadline)
+    {
+        return false;
+    }
+    return dispatch(BehaviorEvent::Timeout);
+}
+
+/**
+ * @brief Get the earliest deadline the active state waits on
+ *
+ * @return unsigned long Absolute time (ms), or NO_DEADLINE
+ */
+unsigned long BehaviorMachine::getNextDeadline() const
+{
+    const uint8_t timers = infoOf(m_state).timers;
+    unsigned long deadline = BehaviorMachineConstants::NO_DEADLINE;
+    for (uint8_t i = 0; i < BehaviorMachineConstants::TIMER_COUNT; i++)
+    {
+        const BehaviorTimer timer = static_cast<BehaviorTimer>(i);
+        if (timers & BehaviorMachineConstants::timerBit(timer))
+        {
+            const unsigned long at = m_handler.getBehaviorTimer(timer);
+            deadline = at < deadline ? at : deadline;
+        }
+    }
+    return deadline;
+}
+
+/**
+ * @brief Check whether a state is active, directly or through a substate
+ *
+ * @param[in] state State to check
+ * @return true if state is the active state or one of its ancestors, false otherwise
+ */
+bool BehaviorMachine::isIn(BehaviorState state) const
+{
+    for (BehaviorState s = m_state; s != BehaviorState::None; s = parentOf(s))
+    {
+        if (s == state)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Exit to the deepest state shared with the target, act, then enter the target
+ *
+ * @param[in] target State to end in
+ * @param[in] action Transition action
+ *
+ * @note A target that encloses the active state is not re-entered
+ */
+void BehaviorMachine::transitionTo(BehaviorState target, BehaviorAction action)
+{
+    // The deepest state that is both active and the target or one of its ancestors
+    BehaviorState shared = target;
+    while (shared != BehaviorState::None && !isIn(shared))
+    {
+        shared = parentOf(shared);
+    }
+
+    for (BehaviorState s = m_state; s != shared; s = parentOf(s))
+    {
+        perform(infoOf(s).exit);
+    }
+
+    perform(action);
+
+    // Enter from the outside in
+    BehaviorState path[BehaviorMachineConstants::MAX_DEPTH];
+    uint8_t depth = 0;
+    for (BehaviorState s = target; s != shared; s = parentOf(s))
+    {
+        path[depth++] = s;
+    }
+    m_state = target;
+    while (depth > 0)
+    {
+        const BehaviorState s = path[--depth];
+        perform(infoOf(s).entry);
+    }
+}
+
+/**
+ * @brief Hand an action to the handler, skipping None
+ *
+ * @param[in] action Action to perform
+ */
+void BehaviorMachine::perform(BehaviorAction action)
+{
+    if (action != BehaviorAction::None)
+    {
+        m_handler.runBehaviorAction(action);
+    }
+}
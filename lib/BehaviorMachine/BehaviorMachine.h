@@ -0,0 +1,393 @@
+/**
+ * @file BehaviorMachine.h
+ * @brief Table-driven hierarchical state machine for the head behaviors of the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the BehaviorMachine class which runs the head behaviors from two
+ * constexpr tables in flash: one describing each state (its parent, entry and exit
+ * actions, and the timers it waits on) and one listing the transitions. The states
+ * form a small hierarchy:
+ *
+ * - Sleep: no motion for a long time; the eyes sleep and nothing is timed
+ * - Idle: no motion; counts down to Sleep
+ * - Alert: motion in front of the PIR sensor; the head rests between movement cycles
+ *   - Scanning: a movement cycle, turning at random and easing the speed
+ *   - Reacting: backing off a hall sensor after reaching it
+ *
+ * An event is offered to the active state first and then to its ancestors, so the
+ * rows of Alert also apply to Scanning and Reacting. Rows for one state are tried in
+ * table order and the first whose guard holds is taken. A transition exits up to the
+ * deepest state it shares with the target, runs its action, then enters down to the
+ * target; a row without a target is internal and only runs its action.
+ *
+ * The actions, guards and timer values belong to the owner, which implements
+ * BehaviorHandler. The machine only reports the next deadline of the active state,
+ * so the owner can skip all behavior work until an event arrives or the deadline
+ * passes.
+ */
+
+#ifndef Y_SERIES_USB_HUB_BEHAVIOR_MACHINE_H
+#define Y_SERIES_USB_HUB_BEHAVIOR_MACHINE_H
+
+// System includes
+#include <Arduino.h>
+#include <array>
+
+/**
+ * @brief Behavior states, in the order of the state table
+ */
+enum class BehaviorState : uint8_t
+{
+    Sleep = 0,     ///< No motion for a long time
+    Idle = 1,      ///< No motion
+    Alert = 2,     ///< Motion detected, resting between movement cycles
+    Scanning = 3,  ///< Moving the head (inside Alert)
+    Reacting = 4,  ///< Backing off a hall sensor (inside Alert)
+    None = 5,      ///< No state: the parent of top-level states, the target of internal rows
+};
+
+/**
+ * @brief Events the owner feeds to the machine
+ */
+enum class BehaviorEvent : uint8_t
+{
+    PirRise = 0,   ///< The PIR sensor started seeing motion
+    PirFall = 1,   ///< The PIR sensor stopped seeing motion
+    Timeout = 2,   ///< The active state's deadline passed
+    Limit = 3,     ///< The head reached the hall sensor it was moving toward
+    Approach = 4,  ///< The head is closing on a limit faster than allowed near it
+};
+
+/**
+ * @brief Conditions a transition row can require
+ */
+enum class BehaviorGuard : uint8_t
+{
+    Always = 0,     ///< No condition
+    CycleOver = 1,  ///< The movement cycle has run its time
+    TurnDue = 2,    ///< The next direction change is due
+};
+
+/**
+ * @brief Actions the owner performs on entry, on exit and on transitions
+ */
+enum class BehaviorAction : uint8_t
+{
+    None = 0,        ///< Nothing to do
+    Doze = 1,        ///< Go to sleep
+    Notice = 2,      ///< React to motion: dome LED on, maybe a sound
+    Calm = 3,        ///< Motion gone: dome LED off
+    StartCycle = 4,  ///< Time a movement cycle
+    StartRest = 5,   ///< Time the rest before the next movement cycle
+    Turn = 6,        ///< Pick a new direction and drive it
+    Steer = 7,       ///< Update the speed in the current direction
+    Reverse = 8,     ///< Turn away from the hall sensor that was reached
+    Halt = 9,        ///< Stop the motor
+    Brake = 10,      ///< Stop a motor still spinning down short of the limit ahead
+};
+
+/**
+ * @brief Times a state can wait for, each an absolute deadline kept by the owner
+ */
+enum class BehaviorTimer : uint8_t
+{
+    Sleep = 0,  ///< When the lack of motion becomes sleep
+    Cycle = 1,  ///< When the movement cycle or the rest ends
+    Turn = 2,   ///< When the next direction change is due
+    Steer = 3,  ///< When the speed is next updated
+};
+
+/**
+ * @brief Contains constants and tables used by the BehaviorMachine class
+ */
+namespace BehaviorMachineConstants
+{
+/// @name Sizes
+/// @{
+constexpr uint8_t STATE_COUNT = static_cast<uint8_t>(BehaviorState::None);  ///< Real states
+constexpr uint8_t TIMER_COUNT = 4;  ///< BehaviorTimers
+constexpr uint8_t MAX_DEPTH = 4;    ///< Deepest nesting of states
+/// @}
+
+/// @name Deadlines
+/// @{
+constexpr unsigned long NO_DEADLINE = ~0UL;  ///< The active state waits for events only
+/// @}
+
+/**
+ * @brief Bit for a timer in a state's timer mask
+ */
+constexpr uint8_t timerBit(BehaviorTimer timer)
+{
+    return static_cast<uint8_t>(1U << static_cast<uint8_t>(timer));
+}
+
+/**
+ * @brief One row of the state table
+ */
+struct StateInfo
+{
+    BehaviorState parent;  ///< Enclosing state, or None at the top level
+    BehaviorAction entry;  ///< Run when the state is entered
+    BehaviorAction exit;   ///< Run when the state is left
+    uint8_t timers;        ///< timerBit()s of the deadlines the state waits on
+};
+
+/**
+ * @brief One row of the transition table
+ */
+struct Transition
+{
+    BehaviorState state;    ///< State the row belongs to (and its substates)
+    BehaviorEvent event;    ///< Event that triggers it
+    BehaviorGuard guard;    ///< Condition that must hold
+    BehaviorState target;   ///< State to go to, or None for an internal transition
+    BehaviorAction action;  ///< Run between the exits and the entries
+};
+
+/// @name Tables
+/// @{
+/**
+ * @brief The states, indexed by BehaviorState
+ */
+constexpr std::array<StateInfo, STATE_COUNT> STATES = {{
+    // Sleep
+    {BehaviorState::None, BehaviorAction::Doze, BehaviorAction::None, 0},
+    // Idle
+    {BehaviorState::None, BehaviorAction::None, BehaviorAction::None,
+     timerBit(BehaviorTimer::Sleep)},
+    // Alert
+    {BehaviorState::None, BehaviorAction::Notice, BehaviorAction::Calm,
+     timerBit(BehaviorTimer::Cycle)},
+    // Scanning
+    {BehaviorState::Alert, BehaviorAction::Turn, BehaviorAction::Halt,
+     timerBit(BehaviorTimer::Cycle) | timerBit(BehaviorTimer::Turn) |
+         timerBit(BehaviorTimer::Steer)},
+    // Reacting
+    {BehaviorState::Alert, BehaviorAction::Reverse, BehaviorAction::Halt,
+     timerBit(BehaviorTimer::Cycle) | timerBit(BehaviorTimer::Turn)},
+}};
+
+/**
+ * @brief The transitions, grouped by state and tried in order
+ */
+constexpr std::array<Transition, 14> TRANSITIONS = {{
+    {BehaviorState::Sleep, BehaviorEvent::PirRise, BehaviorGuard::Always,
+     BehaviorState::Scanning, BehaviorAction::StartCycle},
+    {BehaviorState::Idle, BehaviorEvent::PirRise, BehaviorGuard::Always,
+     BehaviorState::Scanning, BehaviorAction::StartCycle},
+    {BehaviorState::Idle, BehaviorEvent::Timeout, BehaviorGuard::Always, BehaviorState::Sleep,
+     BehaviorAction::None},
+    {BehaviorState::Alert, BehaviorEvent::PirFall, BehaviorGuard::Always, BehaviorState::Idle,
+     BehaviorAction::None},
+    {BehaviorState::Alert, BehaviorEvent::Timeout, BehaviorGuard::Always,
+     BehaviorState::Scanning, BehaviorAction::StartCycle},
+    {BehaviorState::Alert, BehaviorEvent::Approach, BehaviorGuard::Always, BehaviorState::None,
+     BehaviorAction::Brake},
+    {BehaviorState::Scanning, BehaviorEvent::Timeout, BehaviorGuard::CycleOver,
+     BehaviorState::Alert, BehaviorAction::StartRest},
+    {BehaviorState::Scanning, BehaviorEvent::Timeout, BehaviorGuard::TurnDue,
+     BehaviorState::None, BehaviorAction::Turn},
+    {BehaviorState::Scanning, BehaviorEvent::Timeout, BehaviorGuard::Always,
+     BehaviorState::None, BehaviorAction::Steer},
+    {BehaviorState::Scanning, BehaviorEvent::Limit, BehaviorGuard::Always,
+     BehaviorState::Reacting, BehaviorAction::None},
+    {BehaviorState::Scanning, BehaviorEvent::Approach, BehaviorGuard::Always,
+     BehaviorState::None, BehaviorAction::Steer},
+    {BehaviorState::Reacting, BehaviorEvent::Timeout, BehaviorGuard::CycleOver,
+     BehaviorState::Alert, BehaviorAction::StartRest},
+    {BehaviorState::Reacting, BehaviorEvent::Timeout, BehaviorGuard::Always,
+     BehaviorState::Scanning, BehaviorAction::None},
+    {BehaviorState::Reacting, BehaviorEvent::Approach, BehaviorGuard::Always,
+     BehaviorState::None, BehaviorAction::Steer},
+}};
+/// @}
+
+/// @name Table Checks
+/// @{
+/**
+ * @brief Nesting depth of a state, 1 at the top level, 0 if its parents loop
+ */
+constexpr uint8_t depthOf(BehaviorState state)
+{
+    uint8_t depth = 0;
+    for (BehaviorState s = state; s != BehaviorState::None;
+         s = STATES[static_cast<uint8_t>(s)].parent)
+    {
+        if (++depth > MAX_DEPTH)
+        {
+            return 0;
+        }
+    }
+    return depth;
+}
+
+/**
+ * @brief Check that every state nests within MAX_DEPTH
+ */
+constexpr bool statesNest()
+{
+    for (uint8_t i = 0; i < STATE_COUNT; i++)
+    {
+        if (depthOf(static_cast<BehaviorState>(i)) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check that rows are grouped by state and no row transitions a state to itself
+ */
+constexpr bool transitionsValid()
+{
+    for (size_t i = 0; i < TRANSITIONS.size(); i++)
+    {
+        const Transition& row = TRANSITIONS[i];
+        if (row.state == BehaviorState::None || row.target == row.state ||
+            (i > 0 && TRANSITIONS[i - 1].state > row.state))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(statesNest(), "Every state must reach the top level within MAX_DEPTH");
+static_assert(transitionsValid(), "Transition rows must be grouped by state");
+/// @}
+}  // namespace BehaviorMachineConstants
+
+/**
+ * @brief The actions, guards and timers a BehaviorMachine runs on
+ */
+class BehaviorHandler
+{
+public:
+    virtual ~BehaviorHandler() = default;
+
+    /**
+     * @brief Perform an entry, exit or transition action
+     *
+     * @param[in] action Action to perform, never None
+     */
+    virtual void runBehaviorAction(BehaviorAction action) = 0;
+
+    /**
+     * @brief Evaluate a transition guard
+     *
+     * @param[in] guard Condition to check
+     * @return true if the condition holds, false otherwise
+     */
+    virtual bool checkBehaviorGuard(BehaviorGuard guard) const = 0;
+
+    /**
+     * @brief Get the deadline of a timer
+     *
+     * @param[in] timer Timer to read
+     * @return unsigned long Absolute time (ms) the timer expires
+     */
+    virtual unsigned long getBehaviorTimer(BehaviorTimer timer) const = 0;
+};
+
+/**
+ * @brief Runs the behavior tables against a BehaviorHandler
+ */
+class BehaviorMachine
+{
+public:
+    /**
+     * @brief Construct a new behavior machine
+     *
+     * @param[in] handler Owner of the actions, guards and timers
+     * @param[in] initial State to start in; its entry actions are not run
+     */
+    explicit BehaviorMachine(BehaviorHandler& handler,
+                             BehaviorState initial = BehaviorState::Idle);
+
+    // Prevent copying and assignment
+    BehaviorMachine(const BehaviorMachine&) = delete;
+    BehaviorMachine& operator=(const BehaviorMachine&) = delete;
+
+    /**
+     * @brief Offer an event to the active state and its ancestors
+     *
+     * @param[in] event Event that occurred
+     * @return true if a row took the event, false if it was ignored
+     */
+    bool dispatch(BehaviorEvent event);
+
+    /**
+     * @brief Dispatch a Timeout if the active state's deadline has passed
+     *
+     * @param[in] now Current time (ms)
+     * @return true if a timeout was taken, false otherwise
+     */
+    bool poll(unsigned long now);
+
+    /**
+     * @brief Get the earliest deadline the active state waits on
+     *
+     * @return unsigned long Absolute time (ms), or NO_DEADLINE
+     */
+    unsigned long getNextDeadline() const;
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get the innermost active state
+     * @return BehaviorState Active state
+     */
+    BehaviorState getState() const { return m_state; }
+
+    /**
+     * @brief Check whether a state is active, directly or through a substate
+     *
+     * @param[in] state State to check
+     * @return true if state is the active state or one of its ancestors, false otherwise
+     */
+    bool isIn(BehaviorState state) const;
+
+    /**
+     * @brief Get the number of events taken by a row
+     * @return uint32_t Events that ran a transition or an internal action
+     */
+    uint32_t getEventCount() const { return m_eventCount; }
+    /// @}
+
+    /**
+     * @brief Get the parent of a state
+     *
+     * @param[in] state State to look up
+     * @return BehaviorState Enclosing state, or None
+     */
+    static BehaviorState parentOf(BehaviorState state) { return infoOf(state).parent; }
+
+private:
+    /**
+     * @brief Get the table entry of a state
+     */
+    static const BehaviorMachineConstants::StateInfo& infoOf(BehaviorState state)
+    {
+        return BehaviorMachineConstants::STATES[static_cast<uint8_t>(state)];
+    }
+
+    /**
+     * @brief Exit to the deepest state shared with the target, act, then enter the target
+     */
+    void transitionTo(BehaviorState target, BehaviorAction action);
+
+    /**
+     * @brief Hand an action to the handler, skipping None
+     */
+    void perform(BehaviorAction action);
+
+    BehaviorHandler& m_handler;  ///< Owner of the actions, guards and timers
+    BehaviorState m_state;       ///< Innermost active state
+    uint32_t m_eventCount;       ///< Events taken by a row
+};
+
+#endif  // Y_SERIES_USB_HUB_BEHAVIOR_MACHINE_H
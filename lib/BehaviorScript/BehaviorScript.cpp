@@ -0,0 +1,120 @@
+/**
+ * @file BehaviorScript.cpp
+ * @brief Implementation of the ScriptScheduler class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the ScriptScheduler class which places script frames in its
+ * arena and resumes each script when the time, PIR edge or silence it waits for comes.
+ */
+
+#include "BehaviorScript.h"
+
+namespace
+{
+// Names of the ScriptWait values for the footprint log
+const char* const WAIT_NAMES[] = {"start", "time", "PIR edge", "sound done", "done"};
+}  // namespace
+
+/**
+ * @brief Construct an empty scheduler
+ */
+ScriptScheduler::ScriptScheduler()
+    : m_arenaUsed(0), m_scripts{}, m_footprints{}, m_scriptCount(0), m_lastPirSensor(LOW)
+{
+}
+
+/**
+ * @brief Destructor - destroys the script frames in the arena
+ */
+ScriptScheduler::~ScriptScheduler()
+{
+    for (uint8_t i = 0; i < m_scriptCount; i++)
+    {
+        m_scripts[i]->~BehaviorScript();
+    }
+}
+
+/**
+ * @brief Take aligned space for a frame from the arena
+ *
+ * @param[in] size Frame size in bytes
+ * @param[in] alignment Frame alignment, a power of two
+ * @return void* Start of the frame, or nullptr if the arena or script table is full
+ */
+void* ScriptScheduler::allocate(size_t size, size_t alignment)
+{
+    const size_t start = (m_arenaUsed + alignment - 1) & ~(alignment - 1);
+    if (m_scriptCount >= BehaviorScriptConstants::MAX_SCRIPTS ||
+        start + size > BehaviorScriptConstants::ARENA_BYTES)
+    {
+        return nullptr;
+    }
+    m_arenaUsed = start + size;
+    return m_arena + start;
+}
+
+/**
+ * @brief Resume every script whose wait is over
+ *
+ * @param[in] now Current time (ms)
+ * @param[in] pirSensor PIR sensor state (HIGH/LOW)
+ * @param[in] soundPlaying True while the audio player is playing
+ * @return uint8_t Number of scripts resumed
+ */
+uint8_t ScriptScheduler::update(unsigned long now, int8_t pirSensor, bool soundPlaying)
+{
+    const bool pirEdge = pirSensor != m_lastPirSensor;
+    m_lastPirSensor = pirSensor;
+
+    uint8_t resumed = 0;
+    for (uint8_t i = 0; i < m_scriptCount; i++)
+    {
+        BehaviorScript& script = *m_scripts[i];
+        bool ready = false;
+        switch (script.m_wait)
+        {
+            case ScriptWait::Start:
+                ready = true;
+                break;
+            case ScriptWait::Time:
+                ready = static_cast<long>(now - script.m_wakeTime) >= 0;
+                break;
+            case ScriptWait::PirEdge:
+                ready = pirEdge;
+                break;
+            case ScriptWait::SoundDone:
+                ready = !soundPlaying;
+                break;
+            case ScriptWait::Done:
+            default:
+                break;
+        }
+        if (!ready)
+        {
+            continue;
+        }
+
+        script.m_now = now;
+        script.m_pirSensor = pirSensor;
+        script.m_soundPlaying = soundPlaying;
+        script.run();
+        resumed++;
+    }
+    return resumed;
+}
+
+/**
+ * @brief Log the frame size and wait of each script
+ */
+void ScriptScheduler::logFootprints() const
+{
+    for (uint8_t i = 0; i < m_scriptCount; i++)
+    {
+        Log.info("Script %u: %u byte frame, waiting for %s", i, m_footprints[i],
+                 WAIT_NAMES[static_cast<uint8_t>(m_scripts[i]->getWait())]);
+    }
+    Log.info("Script arena: %u of %u bytes", static_cast<unsigned>(m_arenaUsed),
+             static_cast<unsigned>(BehaviorScriptConstants::ARENA_BYTES));
+}
@@ -0,0 +1,329 @@
+/**
+ * @file BehaviorScript.h
+ * @brief Stackless behavior scripts with statically allocated frames for the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the BehaviorScript class and the ScriptScheduler that runs it. A
+ * script is a time-based behavior written top to bottom, waiting where it needs to
+ * instead of keeping a timer and a flag for every step:
+ *
+ * @code
+ * class Farewell : public BehaviorScript
+ * {
+ *     void run() override
+ *     {
+ *         SCRIPT_BEGIN();
+ *         while (true)
+ *         {
+ *             SCRIPT_AWAIT_PIR_EDGE();
+ *             ...
+ *             SCRIPT_AWAIT_SOUND_DONE();
+ *             SCRIPT_SLEEP_MS(1500);
+ *         }
+ *         SCRIPT_END();
+ *     }
+ * };
+ * @endcode
+ *
+ * The scripts are stackless coroutines in the style of protothreads: each wait records
+ * the line it was made on and returns, and the next run() jumps back to that line
+ * through the switch opened by SCRIPT_BEGIN(). Anything that must survive a wait is
+ * a member of the script class, so the class is the whole frame of the coroutine.
+ *
+ * Frames are constructed in a fixed arena inside the scheduler; there is no heap use,
+ * and the size of each frame is known and can be reported. The scheduler is driven
+ * from the main loop and only resumes a script when what it waits for has happened.
+ */
+
+#ifndef Y_SERIES_USB_HUB_BEHAVIOR_SCRIPT_H
+#define Y_SERIES_USB_HUB_BEHAVIOR_SCRIPT_H
+
+// System includes
+#include <Arduino.h>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Project includes
+#include <Logger.h>
+
+/**
+ * @brief Contains constants used by the BehaviorScript and ScriptScheduler classes
+ */
+namespace BehaviorScriptConstants
+{
+constexpr size_t ARENA_BYTES = 256;  ///< Space for all script frames
+constexpr uint8_t MAX_SCRIPTS = 4;   ///< Scripts a scheduler can run
+}  // namespace BehaviorScriptConstants
+
+/**
+ * @brief What a script is waiting for
+ */
+enum class ScriptWait : uint8_t
+{
+    Start = 0,      ///< Not run yet: runs on the next update
+    Time = 1,       ///< A wake-up time
+    PirEdge = 2,    ///< The PIR sensor changing state
+    SoundDone = 3,  ///< The audio player going quiet
+    Done = 4,       ///< Ran to SCRIPT_END(); never resumed again
+};
+
+/// @name Script Macros
+/// @{
+/**
+ * @brief Open the body of run(); must come first
+ */
+#define SCRIPT_BEGIN()    \
+    switch (m_resumeLine) \
+    {                     \
+        case 0:
+
+/**
+ * @brief Suspend until the wait is over, then continue on the next statement
+ *
+ * @note Resume points are keyed by line, so put at most one wait on a line
+ */
+#define SCRIPT_WAIT_(wait)         \
+    do                             \
+    {                              \
+        suspend((wait), __LINE__); \
+        return;                    \
+        case __LINE__:;            \
+    } while (0)
+
+/**
+ * @brief Suspend for a number of milliseconds
+ */
+#define SCRIPT_SLEEP_MS(ms)             \
+    do                                  \
+    {                                   \
+        sleepFor(ms);                   \
+        SCRIPT_WAIT_(ScriptWait::Time); \
+    } while (0)
+
+/**
+ * @brief Suspend until the PIR sensor rises or falls; read getPirSensor() to tell which
+ */
+#define SCRIPT_AWAIT_PIR_EDGE() SCRIPT_WAIT_(ScriptWait::PirEdge)
+
+/**
+ * @brief Suspend until no sound is playing (continues at once if none is)
+ */
+#define SCRIPT_AWAIT_SOUND_DONE()                \
+    do                                           \
+    {                                            \
+        if (isSoundPlaying())                    \
+        {                                        \
+            SCRIPT_WAIT_(ScriptWait::SoundDone); \
+        }                                        \
+    } while (0)
+
+/**
+ * @brief Close the body of run(); a script that gets here is done
+ */
+#define SCRIPT_END() \
+    }                \
+    finish()
+/// @}
+
+/**
+ * @brief A behavior written as a stackless coroutine
+ *
+ * @details
+ * Derive from it, keep the script's state in members, and write run() between
+ * SCRIPT_BEGIN() and SCRIPT_END(). Local variables do not survive a wait.
+ */
+class BehaviorScript
+{
+public:
+    BehaviorScript() = default;
+    virtual ~BehaviorScript() = default;
+
+    // Prevent copying and assignment
+    BehaviorScript(const BehaviorScript&) = delete;
+    BehaviorScript& operator=(const BehaviorScript&) = delete;
+
+    /**
+     * @brief Start the script over from the top on the next update
+     */
+    void restart()
+    {
+        m_resumeLine = 0;
+        m_wait = ScriptWait::Start;
+    }
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get what the script is waiting for
+     * @return ScriptWait Current wait, Done once finished
+     */
+    ScriptWait getWait() const { return m_wait; }
+
+    /**
+     * @brief Get the time a sleeping script wakes up
+     * @return unsigned long Absolute time (ms), meaningful while waiting on Time
+     */
+    unsigned long getWakeTime() const { return m_wakeTime; }
+
+    /**
+     * @brief Check whether the script has run to its end
+     * @return true if finished, false otherwise
+     */
+    bool isDone() const { return m_wait == ScriptWait::Done; }
+    /// @}
+
+protected:
+    /**
+     * @brief The script body, from SCRIPT_BEGIN() to SCRIPT_END()
+     */
+    virtual void run() = 0;
+
+    /// @name Script Context
+    /// @{
+    /**
+     * @brief Get the time of the update that resumed the script
+     * @return unsigned long Current time (ms)
+     */
+    unsigned long now() const { return m_now; }
+
+    /**
+     * @brief Get the PIR sensor state of the update that resumed the script
+     * @return int8_t HIGH or LOW
+     */
+    int8_t getPirSensor() const { return m_pirSensor; }
+
+    /**
+     * @brief Check whether a sound was playing at the update that resumed the script
+     * @return true if the audio player was busy, false otherwise
+     */
+    bool isSoundPlaying() const { return m_soundPlaying; }
+    /// @}
+
+    /// @name Used by the Script Macros
+    /// @{
+    void sleepFor(uint32_t ms) { m_wakeTime = m_now + ms; }
+    void suspend(ScriptWait wait, uint16_t resumeLine)
+    {
+        m_wait = wait;
+        m_resumeLine = resumeLine;
+    }
+    void finish() { m_wait = ScriptWait::Done; }
+
+    uint16_t m_resumeLine = 0;  ///< Line to continue from, 0 for the top
+    /// @}
+
+private:
+    friend class ScriptScheduler;
+
+    ScriptWait m_wait = ScriptWait::Start;  ///< What the script waits for
+    int8_t m_pirSensor = LOW;               ///< PIR sensor state when resumed
+    bool m_soundPlaying = false;            ///< Audio player state when resumed
+    unsigned long m_wakeTime = 0;           ///< When a sleep ends
+    unsigned long m_now = 0;                ///< Time when resumed
+};
+
+/**
+ * @brief Runs behavior scripts whose frames live in a fixed arena
+ */
+class ScriptScheduler
+{
+public:
+    /**
+     * @brief Construct an empty scheduler
+     */
+    ScriptScheduler();
+
+    /**
+     * @brief Destructor - destroys the script frames in the arena
+     */
+    ~ScriptScheduler();
+
+    // Prevent copying and assignment
+    ScriptScheduler(const ScriptScheduler&) = delete;
+    ScriptScheduler& operator=(const ScriptScheduler&) = delete;
+
+    /**
+     * @brief Construct a script in the arena and schedule it
+     *
+     * @tparam Script Class derived from BehaviorScript
+     * @param[in] args Arguments for the script's constructor
+     * @return Script* The scheduled script, or nullptr if the arena or script table is full
+     */
+    template <typename Script, typename... Args>
+    Script* spawn(Args&&... args)
+    {
+        void* frame = allocate(sizeof(Script), alignof(Script));
+        if (frame == nullptr)
+        {
+            Log.error("No room for a %u byte script", static_cast<unsigned>(sizeof(Script)));
+            return nullptr;
+        }
+        Script* script = new (frame) Script(std::forward<Args>(args)...);
+        m_scripts[m_scriptCount] = script;
+        m_footprints[m_scriptCount] = static_cast<uint16_t>(sizeof(Script));
+        m_scriptCount++;
+        return script;
+    }
+
+    /**
+     * @brief Resume every script whose wait is over
+     *
+     * @param[in] now Current time (ms)
+     * @param[in] pirSensor PIR sensor state (HIGH/LOW)
+     * @param[in] soundPlaying True while the audio player is playing
+     * @return uint8_t Number of scripts resumed
+     */
+    uint8_t update(unsigned long now, int8_t pirSensor, bool soundPlaying);
+
+    /**
+     * @brief Log the frame size and wait of each script
+     */
+    void logFootprints() const;
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get the number of scheduled scripts
+     * @return uint8_t Scripts spawned
+     */
+    uint8_t getScriptCount() const { return m_scriptCount; }
+
+    /**
+     * @brief Get the frame size of a script
+     *
+     * @param[in] index Script in spawn order
+     * @return uint16_t Bytes its frame takes in the arena, 0 if there is no such script
+     */
+    uint16_t getFootprint(uint8_t index) const
+    {
+        return index < m_scriptCount ? m_footprints[index] : 0;
+    }
+
+    /**
+     * @brief Get the arena space used, including alignment padding
+     * @return size_t Bytes of the arena in use
+     */
+    size_t getArenaUsed() const { return m_arenaUsed; }
+    /// @}
+
+private:
+    /**
+     * @brief Take aligned space for a frame from the arena
+     *
+     * @return void* Start of the frame, or nullptr if the arena or script table is full
+     */
+    void* allocate(size_t size, size_t alignment);
+
+    /// Script frames
+    alignas(std::max_align_t) uint8_t m_arena[BehaviorScriptConstants::ARENA_BYTES];
+    size_t m_arenaUsed;                                               ///< Bytes in use
+    BehaviorScript* m_scripts[BehaviorScriptConstants::MAX_SCRIPTS];  ///< In spawn order
+    uint16_t m_footprints[BehaviorScriptConstants::MAX_SCRIPTS];      ///< Frame sizes
+    uint8_t m_scriptCount;                                            ///< Scripts spawned
+    int8_t m_lastPirSensor;  ///< PIR sensor state at the previous update
+};
+
+#endif  // Y_SERIES_USB_HUB_BEHAVIOR_SCRIPT_H
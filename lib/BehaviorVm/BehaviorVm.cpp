@@ -0,0 +1,408 @@
+/**
+ * @file BehaviorVm.cpp
+ * @brief Implementation of the BehaviorVm and BehaviorVmLoader classes for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the BehaviorVm class which validates and interprets behavior
+ * programs, and the BehaviorVmLoader class which receives new programs byte by byte.
+ */
+
+#include "BehaviorVm.h"
+
+// Project includes
+#include <FrameStream.h>
+#include <Random.h>
+
+namespace
+{
+// Instruction sizes, opcode included, indexed by VmOp
+constexpr uint8_t INSTRUCTION_SIZES[] = {1, 3, 3, 2, 2, 3, 5, 3, 4, 2};
+static_assert(sizeof(INSTRUCTION_SIZES) == static_cast<size_t>(VmOp::Count),
+              "INSTRUCTION_SIZES must have one entry per opcode");
+
+// Check that a sensor operand names a sensor
+bool isValidSensor(uint8_t sensor)
+{
+    return (sensor & ~BehaviorVmConstants::SENSOR_NOT) < static_cast<uint8_t>(VmSensor::Count);
+}
+}  // namespace
+
+/**
+ * @brief Construct a stopped interpreter
+ *
+ * @param[in] host Outputs and inputs for the programs
+ */
+BehaviorVm::BehaviorVm(BehaviorVmHost& host)
+    : m_host(host),
+      m_code(nullptr),
+      m_length(0),
+      m_pc(0),
+      m_running(false),
+      m_waitingForTime(false),
+      m_waitSensor(0),
+      m_waitingForSensor(false),
+      m_wakeTime(0),
+      m_instructionCount(0)
+{
+}
+
+/**
+ * @brief Get the length of an instruction
+ *
+ * @param[in] op Opcode
+ * @return uint8_t Opcode and operand bytes, 0 for an unknown opcode
+ */
+uint8_t BehaviorVm::instructionSize(uint8_t op)
+{
+    return op < static_cast<uint8_t>(VmOp::Count) ? INSTRUCTION_SIZES[op] : 0;
+}
+
+/**
+ * @brief Check that a program is well formed
+ *
+ * @param[in] code Program bytes
+ * @param[in] length Program length
+ * @return true if every instruction is known and complete and every jump lands on an
+ *         instruction, false otherwise
+ *
+ * @details
+ * The first pass marks where each instruction starts and checks its operands; the
+ * second checks every jump target against those marks.
+ */
+bool BehaviorVm::validate(const uint8_t* code, uint16_t length)
+{
+    if (code == nullptr || length == 0 || length > BehaviorVmConstants::MAX_PROGRAM_SIZE)
+    {
+        return false;
+    }
+
+    uint8_t starts[BehaviorVmConstants::MAX_PROGRAM_SIZE / 8] = {};
+    for (uint16_t pc = 0; pc < length;)
+    {
+        const uint8_t size = instructionSize(code[pc]);
+        if (size == 0 || pc + size > length)
+        {
+            return false;
+        }
+        starts[pc / 8] |= static_cast<uint8_t>(1 << (pc % 8));
+
+        const uint8_t* operands = code + pc + 1;
+        switch (static_cast<VmOp>(code[pc]))
+        {
+            case VmOp::Eye:
+                if (operands[0] >= static_cast<uint8_t>(VmEye::Count))
+                {
+                    return false;
+                }
+                break;
+            case VmOp::WaitRandom:
+                if ((operands[0] | (operands[1] << 8)) > (operands[2] | (operands[3] << 8)))
+                {
+                    return false;
+                }
+                break;
+            case VmOp::JumpIf:
+            case VmOp::WaitFor:
+                if (!isValidSensor(operands[0]))
+                {
+                    return false;
+                }
+                break;
+            default:
+                break;
+        }
+        pc += size;
+    }
+
+    for (uint16_t pc = 0; pc < length; pc += instructionSize(code[pc]))
+    {
+        uint16_t target;
+        switch (static_cast<VmOp>(code[pc]))
+        {
+            case VmOp::Jump:
+                target = static_cast<uint16_t>(code[pc + 1] | (code[pc + 2] << 8));
+                break;
+            case VmOp::JumpIf:
+                target = static_cast<uint16_t>(code[pc + 2] | (code[pc + 3] << 8));
+                break;
+            default:
+                continue;
+        }
+        if (target >= length || !(starts[target / 8] & (1 << (target % 8))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Validate a program and start it from the top
+ *
+ * @param[in] code Program bytes, or nullptr
+ * @param[in] length Program length; 0 stops the running program
+ * @return true if the program was started or stopped, false if it is invalid
+ */
+bool BehaviorVm::load(const uint8_t* code, uint16_t length)
+{
+    if (length == 0)
+    {
+        m_running = false;
+        return true;
+    }
+    if (!validate(code, length))
+    {
+        return false;
+    }
+
+    m_code = code;
+    m_length = length;
+    m_pc = 0;
+    m_waitingForTime = false;
+    m_waitingForSensor = false;
+    m_running = true;
+    return true;
+}
+
+/**
+ * @brief Check a sensor operand against the host's sensors
+ *
+ * @param[in] sensor VmSensor, with SENSOR_NOT to test for inactive
+ * @return true if the condition holds, false otherwise
+ */
+bool BehaviorVm::sensorHolds(uint8_t sensor) const
+{
+    const uint8_t bit = 1 << (sensor & ~BehaviorVmConstants::SENSOR_NOT);
+    const bool active = (m_host.vmSensors() & bit) != 0;
+    return (sensor & BehaviorVmConstants::SENSOR_NOT) ? !active : active;
+}
+
+/**
+ * @brief Run the program until it waits, ends or uses up the step budget
+ *
+ * @param[in] now Current time (ms)
+ * @return uint8_t Instructions executed, 0 while the program is waiting
+ *
+ * @note A program that loops without waiting is cut off after MAX_STEPS_PER_TICK
+ *       instructions and continues on the next tick, so it cannot stall the main loop
+ */
+uint8_t BehaviorVm::tick(unsigned long now)
+{
+    if (!m_running)
+    {
+        return 0;
+    }
+    if (m_waitingForTime)
+    {
+        if (static_cast<long>(now - m_wakeTime) < 0)
+        {
+            return 0;
+        }
+        m_waitingForTime = false;
+    }
+    if (m_waitingForSensor)
+    {
+        if (!sensorHolds(m_waitSensor))
+        {
+            return 0;
+        }
+        m_waitingForSensor = false;
+    }
+
+    uint8_t steps = 0;
+    while (steps < BehaviorVmConstants::MAX_STEPS_PER_TICK)
+    {
+        if (m_pc >= m_length)
+        {
+            m_running = false;
+            break;
+        }
+        const uint16_t pc = m_pc;
+        const uint8_t* operands = m_code + pc + 1;
+        m_pc = pc + INSTRUCTION_SIZES[m_code[pc]];
+        steps++;
+
+        switch (static_cast<VmOp>(m_code[pc]))
+        {
+            case VmOp::End:
+                m_running = false;
+                break;
+            case VmOp::Motor:
+                m_host.vmMotor(static_cast<int8_t>(operands[0]), operands[1]);
+                break;
+            case VmOp::Eye:
+                m_host.vmEye(static_cast<VmEye>(operands[0]), operands[1]);
+                break;
+            case VmOp::Sound:
+                m_host.vmSound(operands[0]);
+                break;
+            case VmOp::Dome:
+                m_host.vmDome(operands[0]);
+                break;
+            case VmOp::Wait:
+                m_wakeTime = now + operand16(pc + 1);
+                m_waitingForTime = true;
+                break;
+            case VmOp::WaitRandom:
+                m_wakeTime = now + Rng.range(operand16(pc + 1), operand16(pc + 3) + 1L);
+                m_waitingForTime = true;
+                break;
+            case VmOp::Jump:
+                m_pc = operand16(pc + 1);
+                break;
+            case VmOp::JumpIf:
+                if (sensorHolds(operands[0]))
+                {
+                    m_pc = operand16(pc + 2);
+                }
+                break;
+            case VmOp::WaitFor:
+                m_waitSensor = operands[0];
+                m_waitingForSensor = !sensorHolds(m_waitSensor);
+                break;
+            default:
+                break;
+        }
+        if (!m_running || m_waitingForTime || m_waitingForSensor)
+        {
+            break;
+        }
+    }
+    m_instructionCount += steps;
+    return steps;
+}
+
+/**
+ * @brief Construct an idle loader
+ */
+BehaviorVmLoader::BehaviorVmLoader()
+    : m_buffers{},
+      m_programSlot(0),
+      m_programLength(0),
+      m_state(ParseState::Sync0),
+      m_length(0),
+      m_pos(0),
+      m_crc(0),
+      m_loaded(0),
+      m_rejected(0)
+{
+}
+
+/**
+ * @brief Parse one received byte
+ *
+ * @param[in] byte Received byte
+ * @return true if it completed a valid program, now returned by getProgram()
+ *
+ * @note The program is received into the buffer the newest program is not in
+ */
+bool BehaviorVmLoader::receive(uint8_t byte)
+{
+    switch (m_state)
+    {
+        case ParseState::Sync0:
+            if (byte == BehaviorVmConstants::SYNC_0)
+            {
+                m_state = ParseState::Sync1;
+            }
+            break;
+        case ParseState::Sync1:
+            if (byte == BehaviorVmConstants::SYNC_1)
+            {
+                m_state = ParseState::Length;
+                m_length = 0;
+                m_pos = 0;
+                m_crc = 0;
+            }
+            else
+            {
+                m_state = byte == BehaviorVmConstants::SYNC_0 ? ParseState::Sync1
+                                                              : ParseState::Sync0;
+            }
+            break;
+        case ParseState::Length:
+            m_crc = FrameStream::crc8(m_crc, byte);
+            m_length |= static_cast<uint16_t>(byte << (8 * m_pos));
+            if (++m_pos == 2)
+            {
+                m_pos = 0;
+                if (m_length > BehaviorVmConstants::MAX_PROGRAM_SIZE)
+                {
+                    m_rejected++;
+                    m_state = ParseState::Sync0;
+                }
+                else
+                {
+                    m_state = m_length == 0 ? ParseState::Checksum : ParseState::Program;
+                }
+            }
+            break;
+        case ParseState::Program:
+            m_crc = FrameStream::crc8(m_crc, byte);
+            m_buffers[m_programSlot ^ 1][m_pos] = byte;
+            if (++m_pos == m_length)
+            {
+                m_state = ParseState::Checksum;
+            }
+            break;
+        case ParseState::Checksum:
+            m_state = ParseState::Sync0;
+            return complete(byte);
+    }
+    return false;
+}
+
+/**
+ * @brief Validate the received program and publish it
+ *
+ * @param[in] crc Received CRC-8
+ * @return true if the program is valid and now the newest, false otherwise
+ */
+bool BehaviorVmLoader::complete(uint8_t crc)
+{
+    const uint8_t slot = m_programSlot ^ 1;
+    if (crc != m_crc || (m_length > 0 && !BehaviorVm::validate(m_buffers[slot], m_length)))
+    {
+        m_rejected++;
+        return false;
+    }
+    m_programSlot = slot;
+    m_programLength = m_length;
+    m_loaded++;
+    return true;
+}
+
+/**
+ * @brief Encode a program message, as sent by the host
+ *
+ * @param[in] code Program bytes
+ * @param[in] length Program length (up to MAX_PROGRAM_SIZE)
+ * @param[out] out Buffer of at least MAX_MESSAGE_SIZE bytes
+ * @return size_t Message length, or 0 if the program is too long
+ */
+size_t BehaviorVmLoader::encode(const uint8_t* code, uint16_t length, uint8_t* out)
+{
+    if (length > BehaviorVmConstants::MAX_PROGRAM_SIZE)
+    {
+        return 0;
+    }
+    out[0] = BehaviorVmConstants::SYNC_0;
+    out[1] = BehaviorVmConstants::SYNC_1;
+    out[2] = static_cast<uint8_t>(length & 0xFF);
+    out[3] = static_cast<uint8_t>(length >> 8);
+    for (uint16_t i = 0; i < length; i++)
+    {
+        out[BehaviorVmConstants::HEADER_SIZE + i] = code[i];
+    }
+
+    uint8_t crc = 0;
+    const size_t end = BehaviorVmConstants::HEADER_SIZE + length;
+    for (size_t i = 2; i < end; i++)
+    {
+        crc = FrameStream::crc8(crc, out[i]);
+    }
+    out[BehaviorVmConstants::HEADER_SIZE + length] = crc;
+    return BehaviorVmConstants::HEADER_SIZE + length + 1;
+}
@@ -0,0 +1,374 @@
+/**
+ * @file BehaviorVm.h
+ * @brief Compact bytecode interpreter for behavior programs on the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the BehaviorVm class, a small allocation-free interpreter for
+ * behavior programs, and the BehaviorVmLoader that receives new programs over the USB
+ * serial port while the firmware runs. Programs are written in a short text language
+ * and compiled on the host by .scripts/behavior_compiler.py, either into a header that
+ * keeps the program in flash or into a message sent to a running hub.
+ *
+ * Each instruction is an opcode byte followed by fixed operands, multi-byte operands
+ * little endian:
+ *
+ * | Opcode | Operands                      | Effect                                     |
+ * |--------|-------------------------------|--------------------------------------------|
+ * | End    | -                             | Stop the program                           |
+ * | Motor  | direction (s8), speed (u8)    | Turn the head; direction 0 stops it        |
+ * | Eye    | VmEye mode (u8), argument (u8)| Set the eye mode, blink for argument x10 ms|
+ * | Sound  | index (u8)                    | Play a sound, RANDOM_SOUND for any         |
+ * | Dome   | level (u8)                    | Set the dome LED level                     |
+ * | Wait   | ms (u16)                      | Suspend for a time                         |
+ * | WaitRandom | min ms (u16), max ms (u16)| Suspend for a random time                  |
+ * | Jump   | address (u16)                 | Continue at address                        |
+ * | JumpIf | sensor (u8), address (u16)    | Jump if the sensor condition holds         |
+ * | WaitFor| sensor (u8)                   | Suspend until the sensor condition holds   |
+ *
+ * A sensor operand is a VmSensor in the low bits, with SENSOR_NOT set to test for the
+ * sensor being inactive. A program is validated as a whole before it is run: every
+ * opcode must be known, every instruction complete and every jump must land on an
+ * instruction, so the interpreter itself does no bounds checks beyond the end of
+ * the program.
+ */
+
+#ifndef Y_SERIES_USB_HUB_BEHAVIOR_VM_H
+#define Y_SERIES_USB_HUB_BEHAVIOR_VM_H
+
+// System includes
+#include <Arduino.h>
+
+/**
+ * @brief Contains constants used by the BehaviorVm and BehaviorVmLoader classes
+ */
+namespace BehaviorVmConstants
+{
+/// @name Limits
+/// @{
+constexpr uint16_t MAX_PROGRAM_SIZE = 512;  ///< Largest program in bytes
+constexpr uint8_t MAX_STEPS_PER_TICK = 32;  ///< Instructions run per tick before yielding
+/// @}
+
+/// @name Operands
+/// @{
+constexpr uint8_t SENSOR_NOT = 0x80;    ///< Sensor operand flag: test for inactive
+constexpr uint8_t RANDOM_SOUND = 0xFF;  ///< Sound operand: pick a random sound
+/// @}
+
+/// @name Program Message
+/// @{
+constexpr uint8_t SYNC_0 = 0xB5;      ///< First sync byte
+constexpr uint8_t SYNC_1 = 0x5B;      ///< Second sync byte
+constexpr uint8_t HEADER_SIZE = 4;    ///< Sync bytes and the program length (u16)
+constexpr size_t MAX_MESSAGE_SIZE = HEADER_SIZE + MAX_PROGRAM_SIZE + 1;  ///< With the CRC-8
+/// @}
+}  // namespace BehaviorVmConstants
+
+/**
+ * @brief Instruction opcodes
+ */
+enum class VmOp : uint8_t
+{
+    End = 0,         ///< Stop the program
+    Motor = 1,       ///< Turn the head
+    Eye = 2,         ///< Set the eye mode
+    Sound = 3,       ///< Play a sound
+    Dome = 4,        ///< Set the dome LED level
+    Wait = 5,        ///< Suspend for a time
+    WaitRandom = 6,  ///< Suspend for a random time
+    Jump = 7,        ///< Continue elsewhere
+    JumpIf = 8,      ///< Continue elsewhere if a sensor condition holds
+    WaitFor = 9,     ///< Suspend until a sensor condition holds
+    Count = 10,      ///< Number of opcodes
+};
+
+/**
+ * @brief Eye modes of the Eye instruction
+ */
+enum class VmEye : uint8_t
+{
+    Active = 0,     ///< The active color
+    Rainbow = 1,    ///< Cycle through the rainbow
+    Sleep = 2,      ///< Eyes closed
+    Blink = 3,      ///< Blink once, for the argument x10 ms
+    NextColor = 4,  ///< Move on to the next active color
+    Count = 5,      ///< Number of modes
+};
+
+/**
+ * @brief Sensors a program can test, as bits of BehaviorVmHost::vmSensors()
+ */
+enum class VmSensor : uint8_t
+{
+    Pir = 0,        ///< Motion in front of the PIR sensor
+    Left = 1,       ///< Head on the left hall sensor
+    Right = 2,      ///< Head on the right hall sensor
+    Rectangle = 3,  ///< Rectangle button pressed
+    Circle = 4,     ///< Circle button pressed
+    Count = 5,      ///< Number of sensors
+};
+
+/**
+ * @brief A compiled behavior program
+ */
+struct BehaviorProgram
+{
+    const uint8_t* code;  ///< Program bytes
+    uint16_t length;      ///< Program length
+};
+
+/**
+ * @brief The outputs and inputs a BehaviorVm drives
+ */
+class BehaviorVmHost
+{
+public:
+    virtual ~BehaviorVmHost() = default;
+
+    /**
+     * @brief Turn the head
+     *
+     * @param[in] direction Negative for left, positive for right, 0 to stop
+     * @param[in] speed Motor duty (0-255)
+     */
+    virtual void vmMotor(int8_t direction, uint8_t speed) = 0;
+
+    /**
+     * @brief Set the eye mode
+     *
+     * @param[in] mode Eye mode
+     * @param[in] argument Blink length in 10 ms units for VmEye::Blink
+     */
+    virtual void vmEye(VmEye mode, uint8_t argument) = 0;
+
+    /**
+     * @brief Play a sound
+     *
+     * @param[in] index Sound index, or RANDOM_SOUND
+     */
+    virtual void vmSound(uint8_t index) = 0;
+
+    /**
+     * @brief Set the dome LED level
+     *
+     * @param[in] level Brightness (0-255)
+     */
+    virtual void vmDome(uint8_t level) = 0;
+
+    /**
+     * @brief Get the active sensors
+     *
+     * @return uint8_t Bit (1 << VmSensor) set for each active sensor
+     */
+    virtual uint8_t vmSensors() const = 0;
+};
+
+/**
+ * @brief Runs one validated behavior program against a BehaviorVmHost
+ *
+ * @details
+ * The program is not copied: the code must stay valid while it runs, which it does
+ * for a program in flash and for the newest program held by a BehaviorVmLoader.
+ */
+class BehaviorVm
+{
+public:
+    /**
+     * @brief Construct a stopped interpreter
+     *
+     * @param[in] host Outputs and inputs for the programs
+     */
+    explicit BehaviorVm(BehaviorVmHost& host);
+
+    // Prevent copying and assignment
+    BehaviorVm(const BehaviorVm&) = delete;
+    BehaviorVm& operator=(const BehaviorVm&) = delete;
+
+    /**
+     * @brief Validate a program and start it from the top
+     *
+     * @param[in] code Program bytes, or nullptr
+     * @param[in] length Program length; 0 stops the running program
+     * @return true if the program was started or stopped, false if it is invalid
+     *
+     * @note An invalid program leaves the running one untouched
+     */
+    bool load(const uint8_t* code, uint16_t length);
+
+    /**
+     * @brief Stop the program
+     */
+    void stop() { m_running = false; }
+
+    /**
+     * @brief Run the program until it waits, ends or uses up the step budget
+     *
+     * @param[in] now Current time (ms)
+     * @return uint8_t Instructions executed, 0 while the program is waiting
+     */
+    uint8_t tick(unsigned long now);
+
+    /**
+     * @brief Check that a program is well formed
+     *
+     * @param[in] code Program bytes
+     * @param[in] length Program length
+     * @return true if every instruction is known and complete and every jump lands on
+     *         an instruction, false otherwise
+     */
+    static bool validate(const uint8_t* code, uint16_t length);
+
+    /**
+     * @brief Get the length of an instruction
+     *
+     * @param[in] op Opcode
+     * @return uint8_t Opcode and operand bytes, 0 for an unknown opcode
+     */
+    static uint8_t instructionSize(uint8_t op);
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Check whether a program is loaded and has not ended
+     * @return true while running, false otherwise
+     */
+    bool isRunning() const { return m_running; }
+
+    /**
+     * @brief Get the address of the next instruction
+     * @return uint16_t Program counter
+     */
+    uint16_t getPc() const { return m_pc; }
+
+    /**
+     * @brief Get the number of instructions executed since construction
+     * @return uint32_t Instructions executed
+     */
+    uint32_t getInstructionCount() const { return m_instructionCount; }
+    /// @}
+
+private:
+    /**
+     * @brief Check a sensor operand against the host's sensors
+     */
+    bool sensorHolds(uint8_t sensor) const;
+
+    /**
+     * @brief Read a little endian u16 operand
+     */
+    uint16_t operand16(uint16_t offset) const
+    {
+        return static_cast<uint16_t>(m_code[offset] | (m_code[offset + 1] << 8));
+    }
+
+    BehaviorVmHost& m_host;        ///< Outputs and inputs
+    const uint8_t* m_code;         ///< Program bytes
+    uint16_t m_length;             ///< Program length
+    uint16_t m_pc;                 ///< Next instruction
+    bool m_running;                ///< True until the program ends or is stopped
+    bool m_waitingForTime;         ///< True while a Wait or WaitRandom runs
+    uint8_t m_waitSensor;          ///< Sensor operand of a running WaitFor, or 0
+    bool m_waitingForSensor;       ///< True while a WaitFor runs
+    unsigned long m_wakeTime;      ///< When a Wait ends
+    uint32_t m_instructionCount;   ///< Instructions executed
+};
+
+/**
+ * @brief Receives behavior programs over a serial port
+ *
+ * @details
+ * A program message is the sync bytes, the program length (u16), the program and a
+ * CRC-8 (polynomial 0x07, as FrameStream uses) of the length and program bytes.
+ * Programs are received into one of two buffers while the other holds the newest
+ * valid program, so the program a BehaviorVm runs is never overwritten. A zero
+ * length message is valid and asks for the running program to be stopped.
+ */
+class BehaviorVmLoader
+{
+public:
+    /**
+     * @brief Construct an idle loader
+     */
+    BehaviorVmLoader();
+
+    // Prevent copying and assignment
+    BehaviorVmLoader(const BehaviorVmLoader&) = delete;
+    BehaviorVmLoader& operator=(const BehaviorVmLoader&) = delete;
+
+    /**
+     * @brief Parse one received byte
+     *
+     * @param[in] byte Received byte
+     * @return true if it completed a valid program, now returned by getProgram()
+     */
+    bool receive(uint8_t byte);
+
+    /**
+     * @brief Encode a program message, as sent by the host
+     *
+     * @param[in] code Program bytes
+     * @param[in] length Program length (up to MAX_PROGRAM_SIZE)
+     * @param[out] out Buffer of at least MAX_MESSAGE_SIZE bytes
+     * @return size_t Message length, or 0 if the program is too long
+     */
+    static size_t encode(const uint8_t* code, uint16_t length, uint8_t* out);
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get the newest valid program
+     * @return const uint8_t* Program bytes, valid until the next program completes
+     */
+    const uint8_t* getProgram() const { return m_buffers[m_programSlot]; }
+
+    /**
+     * @brief Get the length of the newest valid program
+     * @return uint16_t Program length, 0 if none or a stop was requested
+     */
+    uint16_t getProgramLength() const { return m_programLength; }
+
+    /**
+     * @brief Get the number of valid programs received
+     * @return uint32_t Programs received
+     */
+    uint32_t getLoadedCount() const { return m_loaded; }
+
+    /**
+     * @brief Get the number of messages rejected for a bad length, CRC or program
+     * @return uint32_t Messages rejected
+     */
+    uint32_t getRejectedCount() const { return m_rejected; }
+    /// @}
+
+private:
+    /**
+     * @brief Parser position within a message
+     */
+    enum class ParseState : uint8_t
+    {
+        Sync0,     ///< Waiting for the first sync byte
+        Sync1,     ///< Waiting for the second sync byte
+        Length,    ///< Program length
+        Program,   ///< Program bytes
+        Checksum,  ///< CRC-8
+    };
+
+    /**
+     * @brief Validate the received program and publish it
+     */
+    bool complete(uint8_t crc);
+
+    uint8_t m_buffers[2][BehaviorVmConstants::MAX_PROGRAM_SIZE];  ///< Receive and newest
+    uint8_t m_programSlot;                                        ///< Buffer of the newest
+    uint16_t m_programLength;                                     ///< Length of the newest
+    ParseState m_state;                                           ///< Position in the message
+    uint16_t m_length;                                            ///< Length being received
+    uint16_t m_pos;                                               ///< Bytes received in state
+    uint8_t m_crc;                                                ///< CRC of the message so far
+    uint32_t m_loaded;                                            ///< Valid programs received
+    uint32_t m_rejected;                                          ///< Messages rejected
+};
+
+#endif  // Y_SERIES_USB_HUB_BEHAVIOR_VM_H
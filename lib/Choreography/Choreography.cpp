@@ -0,0 +1,252 @@
+/**
+ * @file Choreography.cpp
+ * @brief Implementation of the built-in shows and the ShowPlayer class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file holds the authored show for each ShowTrigger and implements the ShowPlayer
+ * class which fires their cues against the show clock.
+ */
+
+#include "Choreography.h"
+
+namespace
+{
+// Sound indices, in WavData order
+constexpr uint8_t SOUND_EXCITED_03 = 2;
+constexpr uint8_t SOUND_EXCITED_04 = 3;
+constexpr uint8_t SOUND_SAD_03 = 10;
+
+// Track of each action, indexed by ShowAction
+constexpr ShowTrack ACTION_TRACKS[] = {
+    ShowTrack::Motor, ShowTrack::Motor, ShowTrack::Eye,  ShowTrack::Eye,
+    ShowTrack::Eye,   ShowTrack::Eye,   ShowTrack::Eye,  ShowTrack::Dome,
+    ShowTrack::Dome,  ShowTrack::Dome,  ShowTrack::Audio};
+static_assert(sizeof(ACTION_TRACKS) == static_cast<size_t>(ShowAction::Count),
+              "ACTION_TRACKS must have one entry per action");
+
+// Face forward, then chirp with a blink on each syllable while glancing either side
+// (excited_04 runs about 1360 ms from 300 ms)
+constexpr ShowCue GREETING_CUES[] = {
+    {0, ShowAction::Look, 128, 300},
+    {0, ShowAction::DomeLevel, 255, 0},
+    {300, ShowAction::Sound, SOUND_EXCITED_04, 0},
+    {300, ShowAction::Blink, 0, 120},
+    {640, ShowAction::NextColor, 0, 0},
+    {700, ShowAction::Blink, 0, 120},
+    {1000, ShowAction::Look, 90, 250},
+    {1250, ShowAction::Look, 166, 250},
+    {1300, ShowAction::Blink, 0, 120},
+    {1500, ShowAction::Look, 128, 200},
+    {1660, ShowAction::DomeBreathe, 0, 1600},
+    {1800, ShowAction::Release, 0, 0},
+};
+
+// Snap forward with a yelp, flash through the rainbow and settle
+// (excited_03 runs about 650 ms from 0 ms)
+constexpr ShowCue STARTLED_CUES[] = {
+    {0, ShowAction::Sound, SOUND_EXCITED_03, 0},
+    {0, ShowAction::Look, 128, 0},
+    {0, ShowAction::Blink, 0, 60},
+    {0, ShowAction::DomeLevel, 255, 0},
+    {120, ShowAction::Rainbow, 0, 0},
+    {330, ShowAction::Blink, 0, 60},
+    {660, ShowAction::Active, 0, 0},
+    {660, ShowAction::DomeBreathe, 0, 800},
+    {1000, ShowAction::Release, 0, 0},
+};
+
+// Dim the dome, sigh with a slow blink and turn away
+// (sad_03 runs about 1150 ms from 200 ms)
+constexpr ShowCue SAD_CUES[] = {
+    {0, ShowAction::DomeLevel, 60, 0},
+    {0, ShowAction::Look, 128, 800},
+    {200, ShowAction::Sound, SOUND_SAD_03, 0},
+    {200, ShowAction::Blink, 0, 400},
+    {700, ShowAction::Look, 50, 1200},
+    {1350, ShowAction::DomeOff, 0, 0},
+    {1350, ShowAction::Blink, 0, 600},
+    {2000, ShowAction::Release, 0, 0},
+};
+
+// Show of each trigger, indexed by ShowTrigger
+constexpr Show SHOWS[] = {
+    {"greeting", GREETING_CUES, sizeof(GREETING_CUES) / sizeof(GREETING_CUES[0]), 1800},
+    {"startled", STARTLED_CUES, sizeof(STARTLED_CUES) / sizeof(STARTLED_CUES[0]), 1000},
+    {"sad", SAD_CUES, sizeof(SAD_CUES) / sizeof(SAD_CUES[0]), 2000},
+};
+static_assert(sizeof(SHOWS) / sizeof(SHOWS[0]) == static_cast<size_t>(ShowTrigger::Count),
+              "SHOWS must have one entry per trigger");
+}  // namespace
+
+/**
+ * @brief Get the track an action belongs to
+ *
+ * @param[in] action Cue action
+ * @return ShowTrack Track it drives, ShowTrack::Count for an unknown action
+ */
+ShowTrack getShowTrack(ShowAction action)
+{
+    return action < ShowAction::Count ? ACTION_TRACKS[static_cast<uint8_t>(action)]
+                                      : ShowTrack::Count;
+}
+
+/**
+ * @brief Get the show for a trigger
+ *
+ * @param[in] trigger Situation
+ * @return const Show* Show, or nullptr for an unknown trigger
+ */
+const Show* getShow(ShowTrigger trigger)
+{
+    return trigger < ShowTrigger::Count ? &SHOWS[static_cast<uint8_t>(trigger)] : nullptr;
+}
+
+/**
+ * @brief Construct an idle player
+ *
+ * @param[in] host Outputs and audio clock for the shows
+ */
+ShowPlayer::ShowPlayer(ShowHost& host)
+    : m_host(host),
+      m_show(nullptr),
+      m_lastShow(nullptr),
+      m_nextCue(0),
+      m_anchorUs(0),
+      m_anchorMs(0),
+      m_followingAudio(false),
+      m_sound(0),
+      m_soundCueUs(0),
+      m_soundCued(false),
+      m_showTimeUs(0),
+      m_maxLatenessUs(0),
+      m_totalLatenessUs(0)
+{
+}
+
+/**
+ * @brief Check that a show's cues are sorted and fit within it
+ *
+ * @param[in] show Show to check
+ * @return true if the show can be played, false otherwise
+ */
+bool ShowPlayer::validate(const Show* show)
+{
+    if (show == nullptr || show->numCues > ChoreographyConstants::MAX_CUES ||
+        (show->numCues > 0 && show->cues == nullptr))
+    {
+        return false;
+    }
+    for (uint8_t i = 0; i < show->numCues; i++)
+    {
+        const ShowCue& cue = show->cues[i];
+        if (cue.action >= ShowAction::Count || cue.timeMs > show->durationMs ||
+            (i > 0 && cue.timeMs < show->cues[i - 1].timeMs))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Start a show from its beginning
+ *
+ * @param[in] show Show to play
+ * @param[in] now Current time (ms)
+ * @return true if the show started, false if it fails validate()
+ */
+bool ShowPlayer::play(const Show* show, unsigned long now)
+{
+    if (!validate(show))
+    {
+        return false;
+    }
+    m_show = show;
+    m_lastShow = show;
+    m_nextCue = 0;
+    m_anchorUs = 0;
+    m_anchorMs = now;
+    m_followingAudio = false;
+    m_soundCued = false;
+    m_showTimeUs = 0;
+    m_maxLatenessUs = 0;
+    m_totalLatenessUs = 0;
+    return true;
+}
+
+/**
+ * @brief Work out the show clock
+ *
+ * @param[in] now Current time (ms)
+ * @return uint32_t Time from the start of the show (us)
+ *
+ * @details
+ * While the show's sound plays the clock is the sound's sample count, offset by the
+ * time of its cue, and each reading re-anchors the millisecond clock so that it
+ * carries on from the last sample time once the sound ends.
+ */
+uint32_t ShowPlayer::showTime(unsigned long now)
+{
+    ShowAudioClock clock;
+    if (m_soundCued && m_host.showAudioClock(m_sound, clock) && clock.sampleRate > 0)
+    {
+        m_followingAudio = true;
+        m_anchorUs = m_soundCueUs +
+                     static_cast<uint32_t>(static_cast<uint64_t>(clock.samples) * 1000000UL /
+                                           clock.sampleRate);
+        m_anchorMs = now;
+        return m_anchorUs;
+    }
+    m_followingAudio = false;
+    m_soundCued = false;
+    return m_anchorUs + static_cast<uint32_t>(now - m_anchorMs) * 1000UL;
+}
+
+/**
+ * @brief Advance the show clock and fire every cue it has reached
+ *
+ * @param[in] now Current time (ms)
+ * @return true while the show plays, false once it is over or if none is playing
+ *
+ * @note A Sound cue switches the clock over to its samples at once, so the cues after
+ *       it in the same update are timed against the sound
+ */
+bool ShowPlayer::update(unsigned long now)
+{
+    if (m_show == nullptr)
+    {
+        return false;
+    }
+
+    m_showTimeUs = showTime(now);
+    while (m_nextCue < m_show->numCues)
+    {
+        const ShowCue& cue = m_show->cues[m_nextCue];
+        const uint32_t cueUs = cue.timeMs * 1000UL;
+        if (m_showTimeUs < cueUs)
+        {
+            break;
+        }
+        const uint32_t latenessUs = m_showTimeUs - cueUs;
+        m_maxLatenessUs = latenessUs > m_maxLatenessUs ? latenessUs : m_maxLatenessUs;
+        m_totalLatenessUs += latenessUs;
+        m_nextCue++;
+
+        m_host.showCue(cue);
+        if (cue.action == ShowAction::Sound)
+        {
+            m_sound = cue.a;
+            m_soundCueUs = cueUs;
+            m_soundCued = true;
+            m_showTimeUs = showTime(now);
+        }
+    }
+
+    if (m_nextCue == m_show->numCues && m_showTimeUs >= m_show->durationMs * 1000UL)
+    {
+        m_show = nullptr;
+    }
+    return m_show != nullptr;
+}
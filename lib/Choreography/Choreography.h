@@ -0,0 +1,279 @@
+/**
+ * @file Choreography.h
+ * @brief Timed shows that lock head motion, eyes, dome LED and audio together
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the show format and the ShowPlayer that plays it. A show is a
+ * table of cues, sorted by time, on four tracks:
+ *
+ * | Track | Actions                                  | Operands                         |
+ * |-------|------------------------------------------|----------------------------------|
+ * | Motor | Look, Release                            | position (a/255), move time (b)  |
+ * | Eye   | Blink, NextColor, Rainbow, Active, Sleep | blink length in ms (b)           |
+ * | Dome  | DomeOff, DomeLevel, DomeBreathe          | level (a), breathing period (b)  |
+ * | Audio | Sound                                    | sound index (a)                  |
+ *
+ * All tracks share one time base. Until the show's sound starts it is the millisecond
+ * clock; while the sound plays it is the sound's sample clock, so a cue authored 400
+ * ms after a Sound cue fires when 400 ms of samples have been output, however late the
+ * sound started. When the sound ends the clock carries on from where the samples left
+ * it. Cues are fired from the main loop, so each fires within one loop tick of its
+ * time; the lateness of every cue is measured against the show clock.
+ */
+
+#ifndef Y_SERIES_USB_HUB_CHOREOGRAPHY_H
+#define Y_SERIES_USB_HUB_CHOREOGRAPHY_H
+
+// System includes
+#include <Arduino.h>
+
+/**
+ * @brief Contains constants used by the ShowPlayer class
+ */
+namespace ChoreographyConstants
+{
+/// @name Limits
+/// @{
+constexpr uint8_t MAX_CUES = 32;  ///< Most cues in one show
+/// @}
+}  // namespace ChoreographyConstants
+
+/**
+ * @brief Output a cue drives
+ */
+enum class ShowTrack : uint8_t
+{
+    Motor = 0,  ///< Head position
+    Eye = 1,    ///< Eye effects
+    Dome = 2,   ///< Dome LED pattern
+    Audio = 3,  ///< Sound clips
+    Count = 4,  ///< Number of tracks
+};
+
+/**
+ * @brief What a cue does
+ */
+enum class ShowAction : uint8_t
+{
+    Look = 0,         ///< Motor: turn to position a/255, taking b ms
+    Release = 1,      ///< Motor: hand the head back to the behaviors
+    Blink = 2,        ///< Eye: blink once for b ms
+    NextColor = 3,    ///< Eye: move on to the next active color
+    Rainbow = 4,      ///< Eye: cycle through the rainbow
+    Active = 5,       ///< Eye: back to the active color
+    Sleep = 6,        ///< Eye: eyes closed
+    DomeOff = 7,      ///< Dome: off
+    DomeLevel = 8,    ///< Dome: steady at level a
+    DomeBreathe = 9,  ///< Dome: breathe with a period of b ms
+    Sound = 10,       ///< Audio: play sound a; the show clock follows its samples
+    Count = 11,       ///< Number of actions
+};
+
+/**
+ * @brief Get the track an action belongs to
+ *
+ * @param[in] action Cue action
+ * @return ShowTrack Track it drives
+ */
+ShowTrack getShowTrack(ShowAction action);
+
+/**
+ * @brief One timed action of a show
+ */
+struct ShowCue
+{
+    uint16_t timeMs;    ///< Time from the start of the show
+    ShowAction action;  ///< What to do
+    uint8_t a;          ///< Position, level or sound index
+    uint16_t b;         ///< Duration or period (ms)
+};
+
+/**
+ * @brief A show: cues sorted by time, and when it is over
+ */
+struct Show
+{
+    const char* name;     ///< Name for the log
+    const ShowCue* cues;  ///< Cues, sorted by time
+    uint8_t numCues;      ///< Number of cues
+    uint16_t durationMs;  ///< Length of the show, at or after the last cue
+};
+
+/**
+ * @brief Situations with an authored show
+ */
+enum class ShowTrigger : uint8_t
+{
+    Greeting = 0,  ///< Someone arrives after a quiet spell
+    Startled = 1,  ///< Someone wakes the hub from sleep
+    Sad = 2,       ///< Everyone has left
+    Count = 3,     ///< Number of triggers
+};
+
+/**
+ * @brief Get the show for a trigger
+ *
+ * @param[in] trigger Situation
+ * @return const Show* Show, or nullptr for an unknown trigger
+ */
+const Show* getShow(ShowTrigger trigger);
+
+/**
+ * @brief Position of the audio sample clock
+ */
+struct ShowAudioClock
+{
+    uint32_t samples;     ///< Samples output since the sound started
+    uint32_t sampleRate;  ///< Samples per second
+};
+
+/**
+ * @brief The outputs a ShowPlayer drives and the audio clock it follows
+ */
+class ShowHost
+{
+public:
+    virtual ~ShowHost() = default;
+
+    /**
+     * @brief Perform a cue
+     *
+     * @param[in] cue Cue whose time has come
+     */
+    virtual void showCue(const ShowCue& cue) = 0;
+
+    /**
+     * @brief Read the sample clock of a sound
+     *
+     * @param[in] sound Sound index a Sound cue started
+     * @param[out] clock Samples output so far and the sample rate
+     * @return true while that sound is playing, false otherwise
+     */
+    virtual bool showAudioClock(uint8_t sound, ShowAudioClock& clock) const = 0;
+};
+
+/**
+ * @brief Plays one show at a time against a ShowHost
+ *
+ * @details
+ * The show is not copied, so its cues must stay valid while it plays, as the built-in
+ * shows in flash do.
+ */
+class ShowPlayer
+{
+public:
+    /**
+     * @brief Construct an idle player
+     *
+     * @param[in] host Outputs and audio clock for the shows
+     */
+    explicit ShowPlayer(ShowHost& host);
+
+    // Prevent copying and assignment
+    ShowPlayer(const ShowPlayer&) = delete;
+    ShowPlayer& operator=(const ShowPlayer&) = delete;
+
+    /**
+     * @brief Start a show from its beginning
+     *
+     * @param[in] show Show to play
+     * @param[in] now Current time (ms)
+     * @return true if the show started, false if it fails validate()
+     *
+     * @note Cues at time 0 fire on the first update()
+     */
+    bool play(const Show* show, unsigned long now);
+
+    /**
+     * @brief Stop the show without firing its remaining cues
+     */
+    void stop() { m_show = nullptr; }
+
+    /**
+     * @brief Advance the show clock and fire every cue it has reached
+     *
+     * @param[in] now Current time (ms)
+     * @return true while the show plays, false once it is over or if none is playing
+     */
+    bool update(unsigned long now);
+
+    /**
+     * @brief Check that a show's cues are sorted and fit within it
+     *
+     * @param[in] show Show to check
+     * @return true if the show can be played, false otherwise
+     */
+    static bool validate(const Show* show);
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Check whether a show is playing
+     * @return true from play() until the show is over or stopped, false otherwise
+     */
+    bool isPlaying() const { return m_show != nullptr; }
+
+    /**
+     * @brief Get the show playing or last played
+     * @return const Show* Show, or nullptr before the first play()
+     */
+    const Show* getShow() const { return m_lastShow; }
+
+    /**
+     * @brief Get the show clock as of the last update()
+     * @return uint32_t Time from the start of the show (us)
+     */
+    uint32_t getShowTimeUs() const { return m_showTimeUs; }
+
+    /**
+     * @brief Check whether the show clock follows a sound
+     * @return true while the show's sound plays, false otherwise
+     */
+    bool isFollowingAudio() const { return m_followingAudio; }
+
+    /**
+     * @brief Get the number of cues fired in the current or last show
+     * @return uint8_t Cues fired
+     */
+    uint8_t getCuesFired() const { return m_nextCue; }
+
+    /**
+     * @brief Get the latest any cue of the current or last show fired
+     * @return uint32_t Show clock past the cue's time when it fired (us)
+     */
+    uint32_t getMaxLatenessUs() const { return m_maxLatenessUs; }
+
+    /**
+     * @brief Get the average lateness of the cues of the current or last show
+     * @return uint32_t Average show clock past the cues' times when they fired (us)
+     */
+    uint32_t getAverageLatenessUs() const
+    {
+        return m_nextCue > 0 ? m_totalLatenessUs / m_nextCue : 0;
+    }
+    /// @}
+
+private:
+    /**
+     * @brief Work out the show clock
+     */
+    uint32_t showTime(unsigned long now);
+
+    ShowHost& m_host;            ///< Outputs and audio clock
+    const Show* m_show;          ///< Show playing, or nullptr
+    const Show* m_lastShow;      ///< Show playing or last played
+    uint8_t m_nextCue;           ///< Next cue to fire
+    uint32_t m_anchorUs;         ///< Show clock at m_anchorMs
+    unsigned long m_anchorMs;    ///< Time the millisecond clock counts from
+    bool m_followingAudio;       ///< True while the show's sound plays
+    uint8_t m_sound;             ///< Sound of the last Sound cue
+    uint32_t m_soundCueUs;       ///< Show time the sound's first sample belongs at
+    bool m_soundCued;            ///< True once a Sound cue has fired
+    uint32_t m_showTimeUs;       ///< Show clock as of the last update
+    uint32_t m_maxLatenessUs;    ///< Latest cue
+    uint32_t m_totalLatenessUs;  ///< Sum of the cues' lateness
+};
+
+#endif  // Y_SERIES_USB_HUB_CHOREOGRAPHY_H
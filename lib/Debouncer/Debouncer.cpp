@@ -0,0 +1,207 @@
+/**
+ * @file Debouncer.cpp
+ * @brief Implementation of the Debouncer class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the vertical-counter debouncer that filters every animation input
+ * at once from a fixed-rate timer and queues the debounced edges.
+ */
+
+#include "Debouncer.h"
+
+#include <Logger.h>
+
+/**
+ * @brief Construct a debouncer with the default thresholds
+ *
+ * @param[in] pins Pin assignments; the hall sensors, PIR and buttons are sampled
+ */
+Debouncer::Debouncer(const AnimationPins& pins)
+    : m_reader(pins),
+      m_queue(),
+      m_pins{pins.sensorLeft, pins.sensorRight, pins.pirSensor, pins.buttonRectangle,
+             pins.buttonCircle},
+      m_threshold(),
+      m_count(),
+      m_levels(0),
+      m_edges(0),
+      m_sampleTimeUs(0),
+      m_readLevels(0),
+      m_readPrimed(false),
+      m_started(false)
+{
+    setThreshold(AnimationInputBits::SENSOR_LEFT | AnimationInputBits::SENSOR_RIGHT,
+                 DebouncerConstants::SENSOR_THRESHOLD);
+    setThreshold(AnimationInputBits::PIR_SENSOR, DebouncerConstants::PIR_THRESHOLD);
+    setThreshold(AnimationInputBits::BUTTON_RECTANGLE | AnimationInputBits::BUTTON_CIRCLE,
+                 DebouncerConstants::BUTTON_THRESHOLD);
+}
+
+/**
+ * @brief Destructor - stops the timer
+ */
+Debouncer::~Debouncer()
+{
+#ifdef ARDUINO_ARCH_RP2040
+    if (m_started)
+    {
+        cancel_repeating_timer(&m_timer);
+    }
+#endif
+}
+
+/**
+ * @brief Take the current levels as debounced and start the repeating timer
+ *
+ * @return true if the timer started, false otherwise
+ */
+bool Debouncer::begin()
+{
+    prime(m_reader.readLevels());
+#ifdef ARDUINO_ARCH_RP2040
+    // Negative interval keeps the samples evenly spaced regardless of callback time
+    m_started = add_repeating_timer_us(
+        -static_cast<int64_t>(DebouncerConstants::SAMPLE_US),
+        [](repeating_timer_t* rt) -> bool
+        {
+            static_cast<Debouncer*>(rt->user_data)->tick();
+            return true;
+        },
+        this, &m_timer);
+    if (!m_started)
+    {
+        Log.error("Failed to start debouncer timer");
+    }
+#else
+    m_started = true;
+#endif
+    return m_started;
+}
+
+/**
+ * @brief Set how many consecutive samples a new level must hold
+ *
+ * @param[in] inputs AnimationInputBits of the inputs to set
+ * @param[in] samples Threshold, clamped to 1-MAX_THRESHOLD
+ */
+void Debouncer::setThreshold(uint8_t inputs, uint8_t samples)
+{
+    samples = constrain(samples, 1, DebouncerConstants::MAX_THRESHOLD);
+    for (uint8_t plane = 0; plane < DebouncerConstants::PLANES; plane++)
+    {
+        if ((samples >> plane) & 1U)
+        {
+            m_threshold[plane] |= inputs;
+        }
+        else
+        {
+            m_threshold[plane] &= ~inputs;
+        }
+    }
+}
+
+/**
+ * @brief Take levels as debounced without producing edges
+ *
+ * @param[in] levels Level of each input, one AnimationInputBits bit each
+ */
+void Debouncer::prime(uint8_t levels)
+{
+    m_levels = levels & AnimationInputBits::ALL;
+    for (uint8_t& count : m_count)
+    {
+        count = 0;
+    }
+}
+
+/**
+ * @brief Filter one sample of every input
+ *
+ * @param[in] levels Sampled level of each input, one AnimationInputBits bit each
+ * @param[in] timeUs Microsecond timer of the sample, stamped on its edges
+ * @return uint8_t AnimationInputBits whose debounced level flipped
+ */
+uint8_t Debouncer::sample(uint8_t levels, uint32_t timeUs)
+{
+    m_sampleTimeUs = timeUs;
+    const uint8_t debounced = m_levels;
+    const uint8_t delta = (levels ^ debounced) & AnimationInputBits::ALL;
+
+    // Count up where the sample differs, restart from 0 where it agrees, and match the
+    // new counts against the thresholds, one plane at a time
+    uint8_t carry = delta;
+    uint8_t flipped = delta;
+    for (uint8_t plane = 0; plane < DebouncerConstants::PLANES; plane++)
+    {
+        const uint8_t count = m_count[plane] & delta;
+        m_count[plane] = count ^ carry;
+        carry &= count;
+        flipped &= ~(m_count[plane] ^ m_threshold[plane]);
+    }
+    if (flipped == 0)
+    {
+        return 0;
+    }
+
+    // Inputs that reached their threshold take the new level and count from 0 again
+    for (uint8_t& count : m_count)
+    {
+        count &= ~flipped;
+    }
+    m_levels = debounced ^ flipped;
+    for (uint8_t i = 0; i < AnimationInputBits::COUNT; i++)
+    {
+        if ((flipped >> i) & 1U)
+        {
+            m_queue.push({timeUs, m_pins[i], static_cast<uint8_t>((levels >> i) & 1U)});
+            m_edges = m_edges + 1;
+        }
+    }
+    return flipped;
+}
+
+/**
+ * @brief Sample the inputs from the GPIO port
+ */
+void Debouncer::tick()
+{
+#ifdef ARDUINO_ARCH_RP2040
+    const uint32_t now = time_us_32();
+#else
+    const uint32_t now = m_sampleTimeUs + DebouncerConstants::SAMPLE_US;
+#endif
+    sample(m_reader.readLevels(), now);
+}
+
+/**
+ * @brief Take a snapshot of the debounced levels
+ *
+ * @return AnimationInputs Debounced levels, the time in milliseconds and the inputs that
+ *         changed since the previous snapshot
+ */
+AnimationInputs Debouncer::read()
+{
+    const uint8_t levels = m_levels;
+    const uint8_t changed = m_readPrimed ? levels ^ m_readLevels : AnimationInputBits::ALL;
+    m_readLevels = levels;
+    m_readPrimed = true;
+    return unpackInputs(levels, millis(), changed);
+}
+
+/**
+ * @brief Get the threshold of one input
+ *
+ * @param[in] input Index of the input (0 for AnimationInputBits::SENSOR_LEFT, ...)
+ * @return uint8_t Threshold (samples)
+ */
+uint8_t Debouncer::getThreshold(uint8_t input) const
+{
+    uint8_t samples = 0;
+    for (uint8_t plane = 0; plane < DebouncerConstants::PLANES; plane++)
+    {
+        samples |= ((m_threshold[plane] >> input) & 1U) << plane;
+    }
+    return samples;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file Debouncer.h
+ * @brief Timer-driven vertical-counter debouncer for the inputs of the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the Debouncer class which samples every animation input at a fixed
+ * rate off a hardware repeating timer and filters all of them at once with a vertical
+ * counter. Bit n of each counter plane holds bit of the count of input n, so one sample
+ * costs a few bitwise operations per plane however many inputs there are.
+ *
+ * An input's count runs while its sample differs from its debounced level and restarts
+ * whenever the two agree; when it reaches the input's threshold the debounced level
+ * flips. A level therefore has to hold for the threshold number of consecutive samples,
+ * and bounce shorter than that produces no edge at all. Each threshold is set per input,
+ * from 1 up to MAX_THRESHOLD samples.
+ *
+ * Every debounced edge is pushed to an InputEventQueue for Animation to drain, and
+ * read() takes a snapshot of the debounced levels in place of InputReader::read().
+ *
+ * On the native build there is no timer; tick() or sample() is called directly.
+ */
+
+#ifndef Y_SERIES_USB_HUB_DEBOUNCER_H
+#define Y_SERIES_USB_HUB_DEBOUNCER_H
+
+// System includes
+#include <Arduino.h>
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/timer.h>
+#endif
+
+// Project includes
+#include <AnimationInputs.h>
+#include <AnimationPins.h>
+#include <InputEvents.h>
+
+/**
+ * @brief Contains constants used by the Debouncer class
+ */
+namespace DebouncerConstants
+{
+/// @name Timing
+/// @{
+constexpr uint32_t SAMPLE_US = 1000;  ///< Sample period (1 kHz)
+/// @}
+
+/// @name Counter
+/// @{
+constexpr uint8_t PLANES = 4;                           ///< Counter bits per input
+constexpr uint8_t MAX_THRESHOLD = (1U << PLANES) - 1;  ///< Longest threshold (samples)
+/// @}
+
+/// @name Default Thresholds
+/// @{
+constexpr uint8_t SENSOR_THRESHOLD = 3;  ///< Hall sensors, which chatter at the band edge
+constexpr uint8_t PIR_THRESHOLD = 2;     ///< PIR output, driven and clean
+constexpr uint8_t BUTTON_THRESHOLD = 8;  ///< Buttons, whose contacts bounce for a few ms
+/// @}
+}  // namespace DebouncerConstants
+
+/**
+ * @brief Debounces every animation input at once from a fixed-rate timer
+ */
+class Debouncer
+{
+public:
+    /**
+     * @brief Construct a debouncer with the default thresholds
+     *
+     * @param[in] pins Pin assignments; the hall sensors, PIR and buttons are sampled
+     */
+    explicit Debouncer(const AnimationPins& pins);
+
+    /**
+     * @brief Destructor - stops the timer
+     */
+    ~Debouncer();
+
+    // Prevent copying and assignment
+    Debouncer(const Debouncer&) = delete;
+    Debouncer& operator=(const Debouncer&) = delete;
+
+    /**
+     * @brief Take the current levels as debounced and start the repeating timer
+     *
+     * @return true if the timer started, false otherwise
+     *
+     * @note Call after the pins are configured as inputs
+     */
+    bool begin();
+
+    /**
+     * @brief Set how many consecutive samples a new level must hold
+     *
+     * @param[in] inputs AnimationInputBits of the inputs to set
+     * @param[in] samples Threshold, clamped to 1-MAX_THRESHOLD
+     *
+     * @note Set thresholds before begin(); the timer reads them on every sample
+     */
+    void setThreshold(uint8_t inputs, uint8_t samples);
+
+    /**
+     * @brief Take levels as debounced without producing edges
+     *
+     * @param[in] levels Level of each input, one AnimationInputBits bit each
+     */
+    void prime(uint8_t levels);
+
+    /**
+     * @brief Filter one sample of every input
+     *
+     * @param[in] levels Sampled level of each input, one AnimationInputBits bit each
+     * @param[in] timeUs Microsecond timer of the sample, stamped on its edges
+     * @return uint8_t AnimationInputBits whose debounced level flipped
+     */
+    uint8_t sample(uint8_t levels, uint32_t timeUs);
+
+    /**
+     * @brief Sample the inputs from the GPIO port
+     *
+     * @note Called from the timer interrupt on the RP2040; call it directly on the host
+     */
+    void tick();
+
+    /**
+     * @brief Take a snapshot of the debounced levels
+     *
+     * The first snapshot reports every input as changed.
+     *
+     * @return AnimationInputs Debounced levels, the time in milliseconds and the inputs
+     *         that changed since the previous snapshot
+     */
+    AnimationInputs read();
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get the threshold of one input
+     *
+     * @param[in] input Index of the input (0 for AnimationInputBits::SENSOR_LEFT, ...)
+     * @return uint8_t Threshold (samples)
+     */
+    uint8_t getThreshold(uint8_t input) const;
+
+    /**
+     * @brief Get the debounced levels
+     * @return uint8_t Level of each input, one AnimationInputBits bit each
+     */
+    uint8_t getLevels() const { return m_levels; }
+
+    /**
+     * @brief Get the queue the debounced edges are pushed to
+     * @return InputEventQueue& Queue for Animation to drain
+     */
+    InputEventQueue& getQueue() { return m_queue; }
+
+    /**
+     * @brief Get the number of debounced edges produced
+     * @return uint32_t Edges since construction
+     */
+    uint32_t getEdges() const { return m_edges; }
+    /// @}
+
+private:
+    InputReader m_reader;                                 ///< Port sampler
+    InputEventQueue m_queue;                              ///< Debounced edges
+    uint8_t m_pins[AnimationInputBits::COUNT];            ///< Pin of each input
+    uint8_t m_threshold[DebouncerConstants::PLANES];      ///< Threshold of each input, by plane
+    uint8_t m_count[DebouncerConstants::PLANES];          ///< Count of each input, by plane
+    volatile uint8_t m_levels;                            ///< Debounced levels
+    volatile uint32_t m_edges;                            ///< Debounced edges produced
+    uint32_t m_sampleTimeUs;                              ///< Time of the last sample
+    uint8_t m_readLevels;                                 ///< Levels of the last read()
+    bool m_readPrimed;                                    ///< True after the first read()
+#ifdef ARDUINO_ARCH_RP2040
+    repeating_timer_t m_timer;  ///< Hardware timer driving tick()
+#endif
+    bool m_started;  ///< True once the timer is running
+};
+
+#endif  // Y_SERIES_USB_HUB_DEBOUNCER_H
@@ -0,0 +1,213 @@
+/**
+ * @file DomeLed.cpp
+ * @brief Implementation of the DomeLed class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the DomeLed class which steps the dome LED's pattern from a
+ * hardware repeating timer and writes gamma-corrected duties to the PWM slice.
+ */
+
+#include "DomeLed.h"
+
+#include <algorithm>  // For std::min, std::max, std::swap
+
+namespace
+{
+// Pattern word layout: mode in the top byte, then low level, high level and period
+constexpr uint32_t packPattern(DomeLedMode mode, uint8_t low, uint8_t high, uint8_t periodUnits)
+{
+    return (static_cast<uint32_t>(mode) << 24) | (static_cast<uint32_t>(low) << 16) |
+           (static_cast<uint32_t>(high) << 8) | periodUnits;
+}
+
+// Forces the first tick to apply whatever pattern is pending
+constexpr uint32_t NO_PATTERN = 0xFFFFFFFF;
+}  // namespace
+
+/**
+ * @brief Construct a new dome LED driver
+ *
+ * @param[in] pin GPIO pin of the dome LED (must be PWM-capable)
+ */
+DomeLed::DomeLed(uint8_t pin)
+    : m_pin(pin),
+#ifdef ARDUINO_ARCH_RP2040
+      m_timer(),
+#endif
+      m_started(false),
+      m_pending(packPattern(DomeLedMode::Off, 0, 0, 0)),
+      m_active(NO_PATTERN),
+      m_mode(DomeLedMode::Off),
+      m_low(0),
+      m_high(0),
+      m_phase(0),
+      m_phaseStep(0),
+      m_level(0),
+      m_duty(0)
+{
+}
+
+/**
+ * @brief Destructor - stops the timer
+ */
+DomeLed::~DomeLed()
+{
+#ifdef ARDUINO_ARCH_RP2040
+    if (m_started)
+    {
+        cancel_repeating_timer(&m_timer);
+    }
+#endif
+}
+
+/**
+ * @brief Configure the PWM slice and start the repeating timer
+ *
+ * @return true if the timer was started, false otherwise
+ */
+bool DomeLed::begin()
+{
+#ifdef ARDUINO_ARCH_RP2040
+    gpio_set_function(m_pin, GPIO_FUNC_PWM);
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_wrap(&config, DomeLedConstants::PWM_WRAP);
+    pwm_init(pwm_gpio_to_slice_num(m_pin), &config, true);
+    pwm_set_gpio_level(m_pin, m_duty);
+
+    // Negative interval keeps the ticks evenly spaced regardless of callback time
+    m_started = add_repeating_timer_us(
+        -static_cast<int64_t>(DomeLedConstants::TICK_US),
+        [](repeating_timer_t* rt) -> bool
+        {
+            static_cast<DomeLed*>(rt->user_data)->tick();
+            return true;
+        },
+        this, &m_timer);
+    if (!m_started)
+    {
+        Log.error("Failed to start dome LED timer");
+    }
+#else
+    m_started = true;
+#endif
+    return m_started;
+}
+
+/**
+ * @brief Breathe between two perceived levels
+ *
+ * @param[in] low Dimmest level (0-255)
+ * @param[in] high Brightest level (0-255)
+ * @param[in] periodMs Duration of one breath, rounded to PERIOD_UNIT_MS
+ */
+void DomeLed::breathe(uint8_t low, uint8_t high, uint16_t periodMs)
+{
+    if (low > high)
+    {
+        std::swap(low, high);
+    }
+    const uint16_t clamped = std::min(std::max(periodMs, DomeLedConstants::PERIOD_UNIT_MS),
+                                      DomeLedConstants::MAX_PERIOD_MS);
+    const uint16_t units = (clamped + DomeLedConstants::PERIOD_UNIT_MS / 2) /
+                           DomeLedConstants::PERIOD_UNIT_MS;
+    setPattern(DomeLedMode::Breathing, low, high, static_cast<uint8_t>(units));
+}
+
+/**
+ * @brief Publish a pattern for the next tick
+ *
+ * @note A single aligned 32-bit store, so the timer sees the old or the new pattern
+ */
+void DomeLed::setPattern(DomeLedMode mode, uint8_t low, uint8_t high, uint8_t periodUnits)
+{
+    m_pending = packPattern(mode, low, high, periodUnits);
+}
+
+/**
+ * @brief Load a newly published pattern into the tick state
+ *
+ * @param[in] pattern Packed pattern word
+ */
+void DomeLed::applyPattern(uint32_t pattern)
+{
+    m_active = pattern;
+    m_mode = static_cast<DomeLedMode>(pattern >> 24);
+    m_low = static_cast<uint8_t>(pattern >> 16);
+    m_high = static_cast<uint8_t>(pattern >> 8);
+
+    const uint32_t periodMs = (pattern & 0xFF) * DomeLedConstants::PERIOD_UNIT_MS;
+    m_phaseStep = 0;
+    if (m_mode == DomeLedMode::Breathing && periodMs > 0)
+    {
+        m_phaseStep = static_cast<uint16_t>(65536UL * DomeLedConstants::TICK_MS / periodMs);
+    }
+    m_phase = 0;  // Every breath starts from the low level
+}
+
+/**
+ * @brief Advance the pattern by one timer tick and update the PWM
+ */
+void DomeLed::tick()
+{
+    const uint32_t pattern = m_pending;
+    if (pattern != m_active)
+    {
+        applyPattern(pattern);
+    }
+
+    if (m_mode == DomeLedMode::Breathing)
+    {
+        const uint8_t shape = DomeLedConstants::BREATH_CURVE[m_phase >> 8];
+        m_level = static_cast<uint8_t>(m_low + ((m_high - m_low) * shape + 127) / 255);
+        m_phase = static_cast<uint16_t>(m_phase + m_phaseStep);
+    }
+    else
+    {
+        // Off and Steady ramp toward their level instead of jumping
+        const int target = m_mode == DomeLedMode::Off ? 0 : m_low;
+        const int step = DomeLedConstants::RAMP_STEP;
+        if (m_level < target)
+        {
+            m_level = static_cast<uint8_t>(std::min(target, m_level + step));
+        }
+        else if (m_level > target)
+        {
+            m_level = static_cast<uint8_t>(std::max(target, m_level - step));
+        }
+    }
+
+    writeDuty(HsvColor::gamma8(m_level));
+}
+
+/**
+ * @brief Write a duty to the PWM compare register if it changed
+ *
+ * @param[in] duty Gamma-corrected duty (0-255)
+ */
+void DomeLed::writeDuty(uint8_t duty)
+{
+    if (duty == m_duty)
+    {
+        return;
+    }
+    m_duty = duty;
+#ifdef ARDUINO_ARCH_RP2040
+    pwm_set_gpio_level(m_pin, duty);
+#endif
+}
+
+/**
+ * @brief Get the number of ticks in one breath of the active pattern
+ *
+ * @return Ticks per breath, or 0 when not breathing
+ */
+uint32_t DomeLed::getTicksPerBreath() const
+{
+    if (m_phaseStep == 0)
+    {
+        return 0;
+    }
+    return (65536UL + m_phaseStep - 1) / m_phaseStep;
+}
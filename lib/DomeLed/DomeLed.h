@@ -0,0 +1,241 @@
+/**
+ * @file DomeLed.h
+ * @brief Timer-driven breathing driver for the dome LED of the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the DomeLed class which runs the dome LED's breathing effect off a
+ * hardware repeating timer, so the fade keeps its pace no matter how long the main
+ * loop takes. The main loop only selects a pattern (off, a steady level, or breathing
+ * between two levels); every timer tick advances the pattern and writes the PWM
+ * compare register directly.
+ *
+ * The breathing shape comes from a constexpr table and levels are perceived
+ * brightness, gamma corrected by HsvColor before they reach the PWM. On the native
+ * build there is no timer; tick() is called directly to step the driver.
+ */
+
+#ifndef Y_SERIES_USB_HUB_DOME_LED_H
+#define Y_SERIES_USB_HUB_DOME_LED_H
+
+// System includes
+#include <Arduino.h>
+#include <array>
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/pwm.h>
+#include <hardware/timer.h>
+#endif
+
+// Project includes
+#include <HsvColor.h>
+#include <Logger.h>
+
+/**
+ * @brief Contains constants used by the DomeLed class
+ */
+namespace DomeLedConstants
+{
+/// @name Timing
+/// @{
+constexpr uint32_t TICK_US = 5000;                         ///< Timer period (200 Hz)
+constexpr uint16_t TICK_MS = TICK_US / 1000;               ///< Timer period in milliseconds
+constexpr uint16_t DEFAULT_PERIOD_MS = 1600;               ///< One full breath
+constexpr uint16_t PERIOD_UNIT_MS = 20;                    ///< Resolution of a breathing period
+constexpr uint16_t MAX_PERIOD_MS = 255 * PERIOD_UNIT_MS;   ///< Longest breathing period
+/// @}
+
+/// @name Levels
+/// @{
+constexpr uint8_t DEFAULT_LOW_LEVEL = 150;   ///< Dimmest breath (about duty 64 after gamma)
+constexpr uint8_t DEFAULT_HIGH_LEVEL = 195;  ///< Brightest breath (about duty 128 after gamma)
+constexpr uint8_t RAMP_STEP = 4;             ///< Level change per tick toward a steady level
+constexpr uint32_t PWM_WRAP = 255;           ///< PWM counter top for 8-bit duty
+/// @}
+
+/// @name Breathing Curve
+/// @{
+constexpr uint16_t CURVE_SIZE = 256;  ///< Entries per breath, indexed by the phase's high byte
+
+/**
+ * @brief Build the breathing curve: a smoothstep up over the first half, down over the second
+ *
+ * @return std::array<uint8_t, CURVE_SIZE> Shape from 0 (low level) to 255 (high level)
+ */
+constexpr std::array<uint8_t, CURVE_SIZE> makeBreathCurve()
+{
+    std::array<uint8_t, CURVE_SIZE> curve{};
+    for (uint16_t i = 0; i < CURVE_SIZE; i++)
+    {
+        // Triangle 0..256..0 in Q8, then 3t^2 - 2t^3 to ease in and out of each end
+        const uint32_t t = i < CURVE_SIZE / 2 ? i * 2 : (CURVE_SIZE - i) * 2;
+        const uint32_t smooth = (t * t * (3 * 256 - 2 * t)) >> 16;
+        curve[i] = static_cast<uint8_t>(smooth > 255 ? 255 : smooth);
+    }
+    return curve;
+}
+
+constexpr std::array<uint8_t, CURVE_SIZE> BREATH_CURVE = makeBreathCurve();  ///< In flash
+/// @}
+}  // namespace DomeLedConstants
+
+/**
+ * @brief Patterns the dome LED can show
+ */
+enum class DomeLedMode : uint8_t
+{
+    Off = 0,        ///< Ramp down to dark
+    Steady = 1,     ///< Ramp to a fixed level and hold it
+    Breathing = 2,  ///< Breathe between a low and a high level
+};
+
+/**
+ * @brief Breathes the dome LED from a hardware timer
+ *
+ * @details
+ * Patterns are handed from the main loop to the timer as one packed 32-bit word, which
+ * the RP2040 reads and writes atomically, so neither side ever sees half a pattern and
+ * no interrupt masking is needed. Setting the pattern that is already running is a
+ * no-op, so the main loop can call breathe() on every pass without restarting it.
+ */
+class DomeLed
+{
+public:
+    /// @name Construction and Initialization
+    /// @{
+    /**
+     * @brief Construct a new dome LED driver
+     *
+     * @param[in] pin GPIO pin of the dome LED (must be PWM-capable)
+     */
+    explicit DomeLed(uint8_t pin);
+
+    /**
+     * @brief Destructor - stops the timer
+     */
+    ~DomeLed();
+
+    // Prevent copying and assignment
+    DomeLed(const DomeLed&) = delete;
+    DomeLed& operator=(const DomeLed&) = delete;
+
+    /**
+     * @brief Configure the PWM slice and start the repeating timer
+     *
+     * @return true if the timer was started, false otherwise
+     *
+     * @note On the native build there is no timer and this always succeeds
+     */
+    bool begin();
+    /// @}
+
+    /// @name Pattern Control (main loop)
+    /// @{
+    /**
+     * @brief Fade the LED out and keep it dark
+     */
+    void off() { setPattern(DomeLedMode::Off, 0, 0, 0); }
+
+    /**
+     * @brief Fade the LED to a fixed perceived level and hold it
+     *
+     * @param[in] level Perceived brightness (0-255)
+     */
+    void setLevel(uint8_t level) { setPattern(DomeLedMode::Steady, level, level, 0); }
+
+    /**
+     * @brief Breathe between two perceived levels
+     *
+     * @param[in] low Dimmest level (0-255)
+     * @param[in] high Brightest level (0-255)
+     * @param[in] periodMs Duration of one breath, rounded to PERIOD_UNIT_MS
+     */
+    void breathe(uint8_t low = DomeLedConstants::DEFAULT_LOW_LEVEL,
+                 uint8_t high = DomeLedConstants::DEFAULT_HIGH_LEVEL,
+                 uint16_t periodMs = DomeLedConstants::DEFAULT_PERIOD_MS);
+    /// @}
+
+    /// @name Timer Interface
+    /// @{
+    /**
+     * @brief Advance the pattern by one timer tick and update the PWM
+     *
+     * @note Called from the timer interrupt on the RP2040; call it directly on the host
+     */
+    void tick();
+    /// @}
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get the pattern applied by the last tick
+     * @return Current DomeLedMode
+     */
+    DomeLedMode getMode() const { return m_mode; }
+
+    /**
+     * @brief Get the current perceived level
+     * @return Level before gamma correction (0-255)
+     */
+    uint8_t getLevel() const { return m_level; }
+
+    /**
+     * @brief Get the duty last written to the PWM
+     * @return Gamma-corrected duty (0-255)
+     */
+    uint8_t getDuty() const { return m_duty; }
+
+    /**
+     * @brief Get the number of ticks in one breath of the active pattern
+     * @return Ticks per breath, or 0 when not breathing
+     */
+    uint32_t getTicksPerBreath() const;
+    /// @}
+
+private:
+    /// @name Internal Methods
+    /// @{
+    /**
+     * @brief Publish a pattern for the next tick
+     */
+    void setPattern(DomeLedMode mode, uint8_t low, uint8_t high, uint8_t periodUnits);
+
+    /**
+     * @brief Load a newly published pattern into the tick state
+     */
+    void applyPattern(uint32_t pattern);
+
+    /**
+     * @brief Write a duty to the PWM compare register if it changed
+     */
+    void writeDuty(uint8_t duty);
+    /// @}
+
+    /// @name Hardware Configuration
+    /// @{
+    uint8_t m_pin;  ///< Dome LED pin
+#ifdef ARDUINO_ARCH_RP2040
+    repeating_timer_t m_timer;  ///< Hardware timer driving tick()
+#endif
+    bool m_started;  ///< True once the timer is running
+    /// @}
+
+    /// @name Pattern Handoff
+    /// @{
+    volatile uint32_t m_pending;  ///< Pattern set by the main loop (mode|low|high|period)
+    uint32_t m_active;            ///< Pattern the tick state was built from
+    /// @}
+
+    /// @name Tick State (owned by the timer)
+    /// @{
+    DomeLedMode m_mode;    ///< Active pattern
+    uint8_t m_low;         ///< Low or steady level
+    uint8_t m_high;        ///< High level
+    uint16_t m_phase;      ///< Position in the breath (0-65535)
+    uint16_t m_phaseStep;  ///< Phase advance per tick
+    uint8_t m_level;       ///< Current perceived level
+    uint8_t m_duty;        ///< Duty last written to the PWM
+    /// @}
+};
+
+#endif  // Y_SERIES_USB_HUB_DOME_LED_H
@@ -12,6 +12,10 @@
 
 #include "EyeAnimation.h"
 
+#include <algorithm>  // For std::copy, std::fill, std::min
+
+#include <Random.h>
+
 /**
  * @brief Construct a new EyeAnimation object
  *
@@ -19,6 +23,16 @@
  */
 EyeAnimation::EyeAnimation(Adafruit_NeoPixel* pixels)
     : m_pixels(pixels),
+      m_strips(nullptr),
+      m_stream(nullptr),
+      m_interpolate(false),
+      m_cutKeyframe(true),
+      m_keyframeTime{0, 0},
+      m_outputWeight(0),
+      m_stats{},
+      m_sprite(),
+      m_spriteStart(0),
+      m_spriteLoop(false),
       m_rainbowIndex(0),
       m_rainbowTimer(0),
       m_activeColor(EyeAnimationConstants::COLOR_BLUE),
@@ -34,7 +48,16 @@ EyeAnimation::EyeAnimation(Adafruit_NeoPixel* pixels)
       m_topPixel2(EyeAnimationConstants::NUM_PIXELS_IN_RING - 1),
       m_nextBlinkDelay(0),
       m_blinkCount(0),
+      m_lastBlinkEnd(0),
+      m_blinksStarted(0),
+      m_lastBlinkStart(0),
       m_lastColorChangeTime(0),
+      m_leader(nullptr),
+      m_followOffset(0),
+      m_followedBlinks(0),
+      m_followBlinkAt(0),
+      m_followDuration(0),
+      m_followPending(false),
       m_isSleeping(false)
 {
     // Initialize pixel progress and order arrays
@@ -43,12 +66,17 @@ EyeAnimation::EyeAnimation(Adafruit_NeoPixel* pixels)
         m_pixelProgress[i] = 0.0f;
         m_pixelOrder[i] = i;  // Default order (will be updated by setTopPixels)
     }
+    for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS; i++)
+    {
+        m_pixelLevel[i] = 255;
+    }
 
     // Calculate initial pixel order
     calculatePixelOrder();
 
     // Initialize all pixels to off
     setAllPixelsColor(0);
+    renderFrame();
 }
 
 /**
@@ -66,12 +94,16 @@ void EyeAnimation::updateRainbowColor()
 
     m_rainbowTimer = m_currentTime;
 
-    // Calculate new color for each pixel
-    for (uint16_t i = 0; i < m_pixels->numPixels(); i++)
+    // Calculate new color for each pixel, unless a sprite clip is playing
+    const uint16_t numPixels = m_pixels->numPixels();
+    if (!updateSprite())
     {
-        // Distribute the color wheel across all pixels
-        uint8_t offset = (m_rainbowIndex + (i * 256 / m_pixels->numPixels())) % 256;
-        setPixelColorWithBrightness(i, wheel(offset), m_brightness);
+        for (uint16_t i = 0; i < std::min(numPixels, EyeAnimationConstants::NUM_PIXELS); i++)
+        {
+            // Spread one turn of hue around the pixels, rotating a step per frame
+            const uint8_t offset = (m_rainbowIndex + (i * 256 / numPixels)) % 256;
+            m_frame[i] = HsvColor::toRgb(static_cast<uint16_t>(offset) << 8);
+        }
     }
 
     // Move to the next color in the rainbow
@@ -97,8 +129,11 @@ void EyeAnimation::updateActiveColor()
     }
     m_isSleeping = false;
 
-    // Set all pixels to the active color
-    setAllPixelsColor(m_activeColor);
+    // Set all pixels to the active color, unless a sprite clip is playing
+    if (!updateSprite())
+    {
+        setAllPixelsColor(m_activeColor);
+    }
 
     // Update blink animation if active
     updateBlink();
@@ -117,14 +152,86 @@ void EyeAnimation::sleep()
         return;
     }
 
-    for (uint16_t i = 0; i < m_pixels->numPixels(); i++)
+    stopSprite();
+    for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS; i++)
     {
-        m_pixels->setPixelColor(i, 0);
+        m_frame[i] = 0;
     }
+    m_cutKeyframe = true;  // Go dark at once instead of fading out
     show();
     m_isSleeping = true;
 }
 
+/**
+ * @brief Play a precompiled sprite clip in place of the solid or rainbow color
+ *
+ * @param[in] clip Clip to play (see SpriteData.h), or nullptr to stop
+ * @param[in] loop True to repeat the clip until stopSprite() is called
+ */
+void EyeAnimation::playSprite(const EyeSpriteClip* clip, bool loop)
+{
+    if (!clip || clip->numFrames == 0 || clip->frameMs == 0)
+    {
+        stopSprite();
+        return;
+    }
+
+    m_sprite.start(clip);
+    m_spriteStart = m_currentTime;
+    m_spriteLoop = loop;
+
+    // The first frame is stored relative to black
+    std::fill(m_frame, m_frame + EyeAnimationConstants::NUM_PIXELS,
+              EyeAnimationConstants::COLOR_BLACK);
+}
+
+/**
+ * @brief Decode the sprite frame due at the current time into the composed frame
+ *
+ * @return true if a sprite frame was composed, false if no clip is playing
+ *
+ * @note The composed frame doubles as the decoder's previous frame, so nothing else may
+ *       write it while a clip plays
+ */
+bool EyeAnimation::updateSprite()
+{
+    const EyeSpriteClip* clip = m_sprite.getClip();
+    if (!clip)
+    {
+        return false;
+    }
+
+    const unsigned long clipMs = static_cast<unsigned long>(clip->numFrames) * clip->frameMs;
+    unsigned long elapsed = m_currentTime - m_spriteStart;
+    if (elapsed >= clipMs)
+    {
+        if (!m_spriteLoop)
+        {
+            stopSprite();
+            return false;
+        }
+
+        // Start over, dropping any whole passes missed while the eye wasn't updated
+        m_spriteStart += elapsed - elapsed % clipMs;
+        elapsed %= clipMs;
+        m_sprite.rewind();
+        std::fill(m_frame, m_frame + EyeAnimationConstants::NUM_PIXELS,
+                  EyeAnimationConstants::COLOR_BLACK);
+    }
+
+    // Frames only hold changes, so apply every frame up to the one due now
+    const uint16_t due = static_cast<uint16_t>(elapsed / clip->frameMs);
+    while (m_sprite.getFramesDecoded() <= due)
+    {
+        if (!m_sprite.decodeNext(m_frame, EyeAnimationConstants::NUM_PIXELS))
+        {
+            stopSprite();
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * @brief Set all pixels to the specified color
  *
@@ -139,64 +246,77 @@ void EyeAnimation::setAllPixelsColor(uint32_t color)
 
     for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS_IN_RING; i++)
     {
-        setPixelColorWithBrightness(i, color, m_brightness);
+        m_frame[i] = color;
     }
 
     // The colors blue/green are too bright where the center pixel gives off a white glow
     // alter the colors to provide a more intentional deviation for the center of the eye
     if (EyeAnimationConstants::COLOR_BLUE == color)
     {
-        setPixelColorWithBrightness(EyeAnimationConstants::NUM_PIXELS_IN_RING, 0x0000FF,
-                                    m_brightness);
+        m_frame[EyeAnimationConstants::NUM_PIXELS_IN_RING] = 0x0000FF;
     }
     else
     {
-        setPixelColorWithBrightness(EyeAnimationConstants::NUM_PIXELS_IN_RING, 0x00FF00,
-                                    m_brightness);
+        m_frame[EyeAnimationConstants::NUM_PIXELS_IN_RING] = 0x00FF00;
     }
 }
 
 /**
- * @brief Set a single pixel's color with brightness adjustment
+ * @brief Scale the composed frame and write it to the NeoPixels
  *
- * @param[in] pixel Pixel index (0 to numPixels-1)
- * @param[in] color 32-bit color value (0x00RRGGBB)
- * @param[in] brightness Brightness value (0-255)
- *
- * @note If brightness is 255, the color is set directly for better performance
+ * @note A scale of 255 leaves a color untouched, matching the full-brightness fast path
  */
-void EyeAnimation::setPixelColorWithBrightness(uint16_t pixel, uint32_t color, uint8_t brightness)
+void EyeAnimation::renderFrame()
 {
-    if (!m_pixels || pixel >= m_pixels->numPixels())
+    if (!m_pixels)
     {
-        return;  // Safety check
+        return;
     }
 
-    // Fast path for full brightness
-    if (brightness == 255)
+    const uint16_t count = std::min(m_pixels->numPixels(), EyeAnimationConstants::NUM_PIXELS);
+    for (uint16_t i = 0; i < count; i++)
     {
-        m_pixels->setPixelColor(pixel, color);
-        return;
+        m_pixels->setPixelColor(i, scaledPixel(i));
     }
+}
 
-    // Extract RGB components
-    uint8_t r = static_cast<uint8_t>((color >> 16) & 0xFF);
-    uint8_t g = static_cast<uint8_t>((color >> 8) & 0xFF);
-    uint8_t b = static_cast<uint8_t>(color & 0xFF);
+/**
+ * @brief Scale the composed frame into the newest keyframe
+ *
+ * @note A cut stores the frame as both keyframes so it is shown without blending
+ */
+void EyeAnimation::pushKeyframe()
+{
+    uint32_t* older = m_keyframe[0];
+    uint32_t* newer = m_keyframe[1];
+    if (!m_cutKeyframe)
+    {
+        std::copy(newer, newer + EyeAnimationConstants::NUM_PIXELS, older);
+    }
 
-    // Scale colors by brightness (using fixed-point math for efficiency)
-    r = static_cast<uint8_t>((r * brightness) >> 8);
-    g = static_cast<uint8_t>((g * brightness) >> 8);
-    b = static_cast<uint8_t>((b * brightness) >> 8);
+    for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS; i++)
+    {
+        newer[i] = scaledPixel(i);
+    }
 
-    // Combine back into 32-bit color
-    uint32_t newColor = (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b;
+    if (m_cutKeyframe)
+    {
+        std::copy(newer, newer + EyeAnimationConstants::NUM_PIXELS, older);
+        m_keyframeTime[0] = m_currentTime;
+        m_cutKeyframe = false;
+    }
+    else
+    {
+        m_keyframeTime[0] = m_keyframeTime[1];
+    }
+    m_keyframeTime[1] = m_currentTime;
 
-    m_pixels->setPixelColor(pixel, newColor);
+    // Force the next output pass to write, even if the weight comes out the same
+    m_outputWeight = EyeAnimationConstants::LERP_WEIGHT_MAX + 1;
 }
 
 /**
- * @brief Update the display
+ * @brief Render the frame and update the display
  */
 void EyeAnimation::show()
 {
@@ -204,39 +324,176 @@ void EyeAnimation::show()
     {
         return;
     }
+    m_stats.logicFrames++;
+
+    if (m_interpolate)
+    {
+        pushKeyframe();
+        return;
+    }
+    if (m_stream && m_stream->isActive(micros()))
+    {
+        return;  // The host owns the LEDs
+    }
+
+#ifdef ARDUINO_ARCH_RP2040
+    const unsigned long startUs = micros();
+#endif
+    renderFrame();
+    m_pixels->show();
+    showAccentStrips();
+    m_stats.outputFrames++;
+#ifdef ARDUINO_ARCH_RP2040
+    m_stats.outputTimeUs += micros() - startUs;
+#endif
+}
+
+/**
+ * @brief Enable interpolated output between logical frames
+ *
+ * @param[in] enabled True to interpolate, false to show every logical frame directly
+ */
+void EyeAnimation::setInterpolation(bool enabled)
+{
+    m_interpolate = enabled;
+    m_cutKeyframe = true;  // Don't blend from a stale keyframe
+}
+
+/**
+ * @brief Write an interpolated frame between the last two logical frames
+ *
+ * @param[in] currentTime Current time in milliseconds
+ * @return true if a frame was written to the LEDs, false otherwise
+ *
+ * @note The blend weight is computed once per frame; each pixel is then a fixed-point
+ *       lerp of two already scaled colors
+ */
+bool EyeAnimation::renderInterpolated(unsigned long currentTime)
+{
+    if (m_pixels && m_stream)
+    {
+        const unsigned long nowUs = micros();
+        if (m_stream->isActive(nowUs))
+        {
+            return renderStreamFrame(nowUs);
+        }
+    }
+
+    if (!m_pixels || !m_interpolate || m_cutKeyframe)
+    {
+        return false;  // Disabled, or no keyframe composed yet
+    }
+
+    // Weight of the newer keyframe, reaching it one logical interval after it was made
+    const unsigned long interval = m_keyframeTime[1] - m_keyframeTime[0];
+    const unsigned long elapsed = currentTime - m_keyframeTime[1];
+    uint16_t weight = EyeAnimationConstants::LERP_WEIGHT_MAX;
+    if (elapsed < interval)
+    {
+        weight =
+            static_cast<uint16_t>(elapsed * EyeAnimationConstants::LERP_WEIGHT_MAX / interval);
+    }
+    if (weight == m_outputWeight)
+    {
+        return false;  // Same frame as last time
+    }
+
+    // Never block the loop on a transmission still in progress
+    if (!m_pixels->canShow() || (m_strips && m_strips->isBusy()))
+    {
+        m_stats.skippedFrames++;
+        return false;
+    }
+
+#ifdef ARDUINO_ARCH_RP2040
+    const unsigned long startUs = micros();
+#endif
+    const uint16_t count = std::min(m_pixels->numPixels(), EyeAnimationConstants::NUM_PIXELS);
+    for (uint16_t i = 0; i < count; i++)
+    {
+        m_pixels->setPixelColor(i, lerpColor(m_keyframe[0][i], m_keyframe[1][i], weight));
+    }
     m_pixels->show();
+    showAccentStrips();
+    m_outputWeight = weight;
+    m_stats.outputFrames++;
+#ifdef ARDUINO_ARCH_RP2040
+    m_stats.outputTimeUs += micros() - startUs;
+#endif
+    return true;
 }
 
 /**
- * @brief Generate a color from a position on the color wheel
+ * @brief Write the newest streamed frame to the LEDs
  *
- * @param[in] pos Position on the color wheel (0-255)
- * @return uint32_t Color value (0x00RRGGBB)
+ * @param[in] nowUs Current time in microseconds
+ * @return true if a frame was written to the LEDs, false otherwise
  *
- * @note This creates a smooth color transition through the rainbow
+ * @note A frame that can't be written because a driver is busy stays in the mailbox
+ *       for the next pass, unless a newer frame replaces it first
  */
-uint32_t EyeAnimation::wheel(uint8_t pos)
+bool EyeAnimation::renderStreamFrame(unsigned long nowUs)
 {
-    pos = 255 - pos;  // Reverse direction for better color progression
+    if (!m_stream->hasNewFrame())
+    {
+        return false;
+    }
+    if (!m_pixels->canShow() || (m_strips && m_strips->isBusy()))
+    {
+        m_stats.skippedFrames++;
+        return false;
+    }
 
-    // Calculate color based on position in the color wheel
-    if (pos < 85)
+#ifdef ARDUINO_ARCH_RP2040
+    const unsigned long startUs = micros();
+#endif
+    const StreamFrame* frame = m_stream->take(nowUs);
+    const uint16_t count = std::min(m_pixels->numPixels(), EyeAnimationConstants::NUM_PIXELS);
+    for (uint16_t i = 0; i < count; i++)
     {
-        // Red to Green transition (decreasing red, increasing green)
-        return (static_cast<uint32_t>(255 - pos * 3) << 16) | (static_cast<uint32_t>(pos * 3) << 8);
+        uint32_t color = i < frame->numPixels ? frame->pixels[i] : 0;
+        if (m_brightness != 255)
+        {
+            color = scaleColor(color, m_brightness);
+        }
+        m_pixels->setPixelColor(i, color);
     }
-    else if (pos < 170)
+    m_pixels->show();
+    showAccentStrips();
+    m_stats.outputFrames++;
+#ifdef ARDUINO_ARCH_RP2040
+    m_stats.outputTimeUs += micros() - startUs;
+#endif
+
+    // Rewrite the eye's own frame on the first output pass after the stream ends
+    m_outputWeight = EyeAnimationConstants::LERP_WEIGHT_MAX + 1;
+    return true;
+}
+
+/**
+ * @brief Copy the composited eye frame to the accent strips and start them
+ *
+ * @note The strips are driven in parallel and never block; if the previous frame
+ *       is still being transmitted this frame is dropped for the strips only
+ */
+void EyeAnimation::showAccentStrips()
+{
+    if (!m_strips)
     {
-        // Green to Blue transition (decreasing green, increasing blue)
-        pos -= 85;
-        return (static_cast<uint32_t>(pos * 3) << 8) | (static_cast<uint32_t>(255 - pos * 3));
+        return;
     }
-    else
+
+    for (uint8_t strip = 0; strip < m_strips->numStrips(); strip++)
     {
-        // Blue to Red transition (decreasing blue, increasing red)
-        pos -= 170;
-        return (static_cast<uint32_t>(255 - pos * 3) << 16) | (static_cast<uint32_t>(pos * 3));
+        const uint16_t length = m_strips->numPixels(strip);
+        for (uint16_t i = 0; i < length; i++)
+        {
+            // Resample the ring onto the strip so every output shows the same frame
+            const uint16_t source = (i * EyeAnimationConstants::NUM_PIXELS_IN_RING) / length;
+            m_strips->setPixelColor(strip, i, m_pixels->getPixelColor(source));
+        }
     }
+    m_strips->show();
 }
 
 /**
@@ -372,6 +629,8 @@ void EyeAnimation::blink(unsigned long duration)
     m_blinkPhase = 1;  // Start closing
     m_blinkProgress = 0.0f;
     m_blinkEndTime = m_blinkStartTime + m_blinkDuration;
+    m_lastBlinkStart = m_blinkStartTime;
+    m_blinksStarted++;
 
     // Initialize all pixel progress to 0 (fully on)
     for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS_IN_RING; i++)
@@ -389,32 +648,40 @@ void EyeAnimation::blink(unsigned long duration)
  */
 void EyeAnimation::sequenceBlink()
 {
+    // A following eye mirrors its leader's blinks instead of drawing its own
+    if (m_leader)
+    {
+        followLeaderBlink();
+        return;
+    }
+
     // If we're not currently blinking
     if (!m_isBlinking)
     {
         // If we have more blinks in the sequence, start the next one
         if (m_blinkCount > 0)
         {
-            // Small delay between blinks in a sequence (100-200ms)
-            static unsigned long lastBlinkEnd = 0;
-            if (m_currentTime - lastBlinkEnd >= 200)
+            // Small delay between blinks in a sequence
+            if (m_currentTime - m_lastBlinkEnd >= EyeAnimationConstants::SEQUENCE_BLINK_GAP)
             {
-                uint8_t duration = random(200, 400);
+                const uint16_t duration =
+                    static_cast<uint16_t>(Rng.range(EyeAnimationConstants::SEQUENCE_BLINK_MIN,
+                                                    EyeAnimationConstants::SEQUENCE_BLINK_MAX));
                 blink(duration);
-                lastBlinkEnd = m_currentTime + duration;  // Update when this blink will end
+                m_lastBlinkEnd = m_currentTime + duration;  // Update when this blink will end
             }
         }
         // If no more blinks in sequence, schedule next sequence
         else if (m_nextBlinkDelay == 0)
         {
             // Set a random delay before next blink sequence (2-8 seconds)
-            m_nextBlinkDelay = m_currentTime + random(2000, 8000);
+            m_nextBlinkDelay = m_currentTime + Rng.range(2000, 8000);
         }
         // If it's time for a new blink sequence
         else if (m_currentTime >= m_nextBlinkDelay)
         {
             // 70% chance of single blink, 25% double blink, 5% triple blink
-            uint8_t r = random(100);
+            const uint32_t r = Rng.below(100);
             if (r < 70)
             {
                 m_blinkCount = 1;
@@ -432,6 +699,41 @@ void EyeAnimation::sequenceBlink()
     }
 }
 
+/**
+ * @brief Blink together with another eye instead of on an own random schedule
+ *
+ * @param[in] leader Eye whose blinks are mirrored, or nullptr for an independent schedule
+ * @param[in] offsetMs Delay after each of the leader's blinks starts (ms)
+ */
+void EyeAnimation::followBlinks(const EyeAnimation* leader, unsigned long offsetMs)
+{
+    m_leader = leader != this ? leader : nullptr;
+    m_followOffset = offsetMs;
+    m_followedBlinks = m_leader ? m_leader->m_blinksStarted : 0;
+    m_followPending = false;
+}
+
+/**
+ * @brief Start the leader's most recent blink once the follow offset has passed
+ */
+void EyeAnimation::followLeaderBlink()
+{
+    if (m_leader->m_blinksStarted != m_followedBlinks)
+    {
+        m_followedBlinks = m_leader->m_blinksStarted;
+        m_followBlinkAt = m_leader->m_lastBlinkStart + m_followOffset;
+        m_followDuration = m_leader->m_blinkDuration;
+        m_followPending = true;
+    }
+
+    if (m_followPending && !m_isBlinking &&
+        static_cast<long>(m_currentTime - m_followBlinkAt) >= 0)
+    {
+        blink(m_followDuration);
+        m_followPending = false;
+    }
+}
+
 /**
  * @brief Update the blink animation state
  *
@@ -446,6 +748,12 @@ bool EyeAnimation::updateBlink()
         return false;  // Safety check
     }
 
+    // Every pixel is fully open unless the blink below closes it
+    for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS; i++)
+    {
+        m_pixelLevel[i] = 255;
+    }
+
     // Handle blink sequence if needed
     sequenceBlink();
 
@@ -538,24 +846,20 @@ bool EyeAnimation::updateBlink()
         m_pixelProgress[pixel4] = ringLocalProgress;
     }
 
-    // Update all pixels based on their current progress
+    // Set each ring pixel's level from its progress; renderFrame() applies it on output.
+    // The center pixel stays lit for the whole blink.
     for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS_IN_RING; i++)
     {
         uint16_t pixelIndex = m_pixelOrder[i];
+        if (pixelIndex >= EyeAnimationConstants::NUM_PIXELS_IN_RING)
+        {
+            continue;  // Order slot not assigned
+        }
 
         // Calculate brightness (invert progress for closing phase)
         float brightness = 1.0f - m_pixelProgress[pixelIndex];
-
-        // Get the pixel's current color and apply brightness
-        uint32_t color = m_pixels->getPixelColor(pixelIndex);
-        setPixelColorWithBrightness(pixelIndex, color, brightness * 255);
+        m_pixelLevel[pixelIndex] = static_cast<uint8_t>(brightness * 255);
     }
-    // set the center pixel to off when all others are off
-    uint16_t centerPixelRef = (m_topPixel1 + numPairs) % EyeAnimationConstants::NUM_PIXELS_IN_RING;
-    setPixelColorWithBrightness(
-        EyeAnimationConstants::NUM_PIXELS_IN_RING + 1,
-        m_pixels->getPixelColor(EyeAnimationConstants::NUM_PIXELS_IN_RING + 1),
-        1.0f - m_pixelProgress[centerPixelRef] * 255);
 
     return true;
 }
@@ -13,6 +13,8 @@
  * - Managing NeoPixel LED states and colors
  * - Handling smooth eye blinking animations
  * - Supporting different eye display modes (solid color, rainbow, etc.)
+ * - Playing precompiled sprite clips straight from program memory
+ * - Showing frames streamed live from a host over USB
  * - Providing a clean interface for eye animation control
  */
 
@@ -26,6 +28,10 @@
 #include <Adafruit_NeoPixel.h>
 
 // Project-local includes
+#include <EyeSprite.h>
+#include <FrameStream.h>
+#include <HsvColor.h>
+#include <LedStrips.h>
 #include <Logger.h>
 
 /**
@@ -40,12 +46,33 @@ constexpr uint32_t COLOR_BLUE = 0x21DDF5;   ///< Blue eye
 constexpr uint32_t COLOR_GREEN = 0x0BBD39;  ///< Green eye
 /// @}
 
-constexpr uint16_t NUM_PIXELS_IN_RING = 16;            // Number of LEDs in the eye ring
-constexpr uint8_t DEFAULT_BRIGHTNESS = 64;             // Maximum brightness
-constexpr unsigned long DEFAULT_BLINK_DURATION = 300;  // ms for a complete blink
-constexpr unsigned long COLOR_CHANGE_DELAY = 1000;     // ms between color changes
+constexpr uint16_t NUM_PIXELS_IN_RING = 16;              // Number of LEDs in the eye ring
+constexpr uint16_t NUM_PIXELS = NUM_PIXELS_IN_RING + 1;  // Ring plus the center pixel
+constexpr uint8_t DEFAULT_BRIGHTNESS = 64;               // Maximum brightness
+constexpr unsigned long DEFAULT_BLINK_DURATION = 300;    // ms for a complete blink
+constexpr unsigned long COLOR_CHANGE_DELAY = 1000;       // ms between color changes
+constexpr uint16_t SEQUENCE_BLINK_MIN = 200;             // Shortest blink in a sequence (ms)
+constexpr uint16_t SEQUENCE_BLINK_MAX = 400;             // Longest blink in a sequence (ms)
+constexpr unsigned long SEQUENCE_BLINK_GAP = 200;        // ms between blinks in a sequence
+constexpr uint16_t LERP_WEIGHT_MAX = 256;                // Interpolation weight at the newer frame
 };  // namespace EyeAnimationConstants
 
+/**
+ * @brief Frame counters for the eye's logic and output passes
+ *
+ * @details
+ * With interpolation enabled the behavior logic composes keyframes at its own rate while
+ * the output pass writes in-between frames to the LEDs, so the two rates are counted
+ * separately. outputTimeUs is only measured on the RP2040.
+ */
+struct EyeFrameStats
+{
+    uint32_t logicFrames;    ///< Frames composed by the behavior logic
+    uint32_t outputFrames;   ///< Frames written to the LEDs
+    uint32_t skippedFrames;  ///< Output passes dropped because an LED driver was busy
+    uint32_t outputTimeUs;   ///< Time spent writing frames to the LEDs (us)
+};
+
 /**
  * @brief Controls eye animations using NeoPixel LEDs
  *
@@ -96,6 +123,23 @@ public:
      */
     virtual void setActiveColor(uint32_t color) { m_activeColor = color; }
 
+    /**
+     * @brief Set the active eye color from hue, saturation and value
+     *
+     * @param[in] hue Hue angle (0-65535, 0 = red)
+     * @param[in] sat Saturation (0 = white, 255 = fully saturated)
+     * @param[in] val Value (0 = off, 255 = full intensity)
+     * @param[in] gamma True to gamma-correct the resulting color
+     *
+     * @note The global brightness is still applied on top when the frame is shown
+     */
+    virtual void setActiveColorHsv(uint16_t hue, uint8_t sat = 255, uint8_t val = 255,
+                                   bool gamma = false)
+    {
+        setActiveColor(gamma ? HsvColor::toRgbGamma(hue, sat, val)
+                             : HsvColor::toRgb(hue, sat, val));
+    }
+
     /**
      * @brief Set the global brightness
      *
@@ -110,6 +154,47 @@ public:
      */
     virtual void setCurrentTime(unsigned long currentTime) { m_currentTime = currentTime; }
 
+    /**
+     * @brief Attach accent strips that mirror the eye
+     *
+     * @param[in] strips Pointer to the LedStrips instance, or nullptr to detach
+     *
+     * @note Every strip shows the composited eye frame resampled to its length, so
+     *       brightness and blink effects are applied once and shared by all outputs
+     */
+    virtual void setAccentStrips(LedStrips* strips) { m_strips = strips; }
+
+    /**
+     * @brief Attach a live frame stream from a host
+     *
+     * @param[in] stream Pointer to the FrameStream instance, or nullptr to detach
+     *
+     * @note While the host is streaming, its frames replace the eye's own animation at
+     *       the render tick; only the global brightness is applied to them
+     */
+    virtual void setFrameStream(FrameStream* stream) { m_stream = stream; }
+
+    /**
+     * @brief Blink together with another eye instead of on an own random schedule
+     *
+     * @param[in] leader Eye whose blinks are mirrored, or nullptr for an independent schedule
+     * @param[in] offsetMs Delay after each of the leader's blinks starts (ms)
+     *
+     * @note Only the most recent leader blink is remembered, so keep the offset shorter
+     *       than the gap between blinks in a sequence
+     */
+    virtual void followBlinks(const EyeAnimation* leader, unsigned long offsetMs = 0);
+
+    /**
+     * @brief Enable interpolated output between logical frames
+     *
+     * @param[in] enabled True to interpolate, false to show every logical frame directly
+     *
+     * @note When enabled, logical updates only compose keyframes and nothing reaches the
+     *       LEDs until renderInterpolated() is called
+     */
+    virtual void setInterpolation(bool enabled);
+
     /// @}
 
     /// @name Animation Control
@@ -162,6 +247,105 @@ public:
      */
     virtual void sequenceBlink();
 
+    /**
+     * @brief Play a precompiled sprite clip in place of the solid or rainbow color
+     *
+     * @param[in] clip Clip to play (see SpriteData.h), or nullptr to stop
+     * @param[in] loop True to repeat the clip until stopSprite() is called
+     *
+     * @details
+     * Frames are decoded from program memory into the composed frame by the regular
+     * updateActiveColor() and updateRainbowColor() calls, at the clip's own frame rate,
+     * so blinks, brightness and interpolation apply to the sprite as to any other frame.
+     * Once a clip that does not loop has ended, the eye returns to its previous effect.
+     */
+    virtual void playSprite(const EyeSpriteClip* clip, bool loop = false);
+
+    /**
+     * @brief Stop the sprite clip and return to the solid or rainbow color
+     */
+    virtual void stopSprite() { m_sprite.start(nullptr); }
+
+    /**
+     * @brief Check whether a sprite clip is playing
+     *
+     * @return true if a sprite clip is playing, false otherwise
+     */
+    bool isPlayingSprite() const { return m_sprite.getClip() != nullptr; }
+
+    /**
+     * @brief Write an interpolated frame between the last two logical frames
+     *
+     * @param[in] currentTime Current time in milliseconds
+     * @return true if a frame was written to the LEDs, false otherwise
+     *
+     * @details
+     * The output runs one logical interval behind: a keyframe composed at T1 after one at
+     * T0 is reached at T1 + (T1 - T0). Nothing is written while the eye or accent strip
+     * driver is still transmitting, or when the frame would not change. While a host is
+     * streaming, its newest frame is written instead.
+     *
+     * @note Call this from the main loop as often as the LEDs should refresh
+     */
+    virtual bool renderInterpolated(unsigned long currentTime);
+
+    /**
+     * @brief Get the logic and output frame counters
+     *
+     * @return const EyeFrameStats& Counters since construction or the last reset
+     */
+    const EyeFrameStats& getFrameStats() const { return m_stats; }
+
+    /**
+     * @brief Reset the logic and output frame counters
+     */
+    void resetFrameStats() { m_stats = EyeFrameStats{}; }
+
+    /// @}
+
+    /// @name Color Utilities
+    /// @{
+
+    /**
+     * @brief Scale a packed color by a brightness factor
+     *
+     * @param[in] color 32-bit color value (0x00RRGGBB)
+     * @param[in] scale Brightness value (0-255)
+     * @return uint32_t Scaled color, each channel equal to (channel * scale) >> 8
+     *
+     * @details
+     * Red and blue are scaled together in one multiply using the 0x00FF00FF mask and
+     * green in a second one. With 8-bit channels and an 8-bit scale the products
+     * never carry into the neighbouring channel, so the result is bit-exact with
+     * scaling each channel separately.
+     */
+    static constexpr uint32_t scaleColor(uint32_t color, uint8_t scale)
+    {
+        return ((((color & 0x00FF00FF) * scale) >> 8) & 0x00FF00FF) |
+               ((((color & 0x0000FF00) * scale) >> 8) & 0x0000FF00);
+    }
+
+    /**
+     * @brief Blend two packed colors
+     *
+     * @param[in] from Color at weight 0 (0x00RRGGBB)
+     * @param[in] to Color at weight LERP_WEIGHT_MAX (0x00RRGGBB)
+     * @param[in] weight Blend weight (0-256)
+     * @return uint32_t Blended color, each channel equal to
+     *         (from * (256 - weight) + to * weight) >> 8
+     *
+     * @details
+     * Uses the same red/blue and green lanes as scaleColor(). The two weights sum to 256,
+     * so each lane's sum stays below 65536 and both endpoints are reproduced exactly.
+     */
+    static constexpr uint32_t lerpColor(uint32_t from, uint32_t to, uint16_t weight)
+    {
+        return ((((from & 0x00FF00FF) * (256 - weight) + (to & 0x00FF00FF) * weight) >> 8) &
+                0x00FF00FF) |
+               ((((from & 0x0000FF00) * (256 - weight) + (to & 0x0000FF00) * weight) >> 8) &
+                0x0000FF00);
+    }
+
     /// @}
 
 protected:
@@ -176,27 +360,65 @@ protected:
     virtual void setAllPixelsColor(uint32_t color);
 
     /**
-     * @brief Set a single pixel's color with brightness adjustment
+     * @brief Decode the sprite frame due at the current time into the composed frame
      *
-     * @param[in] pixel Pixel index
-     * @param[in] color 32-bit color value (0x00RRGGBB)
-     * @param[in] brightness Brightness value (0-255)
+     * @return true if a sprite frame was composed, false if no clip is playing
      */
-    virtual void setPixelColorWithBrightness(uint16_t pixel, uint32_t color,
-                                             uint8_t brightness = 255);
+    virtual bool updateSprite();
 
     /**
-     * @brief Update the display
+     * @brief Scale the composed frame and write it to the NeoPixels
+     *
+     * @note Applies the global brightness and each pixel's blink level in one pass
      */
-    virtual void show();
+    virtual void renderFrame();
+
+    /**
+     * @brief Get a composed pixel with brightness and blink level applied
+     *
+     * @param[in] i Pixel index (0-16)
+     * @return uint32_t Scaled color (0x00RRGGBB)
+     */
+    uint32_t scaledPixel(uint16_t i) const
+    {
+        uint32_t color = m_frame[i];
+        if (m_brightness != 255)
+        {
+            color = scaleColor(color, m_brightness);
+        }
+        if (m_pixelLevel[i] != 255)
+        {
+            color = scaleColor(color, m_pixelLevel[i]);
+        }
+        return color;
+    }
+
+    /**
+     * @brief Scale the composed frame into the newest keyframe
+     *
+     * @note The previous newest keyframe becomes the older one unless a cut is pending
+     */
+    virtual void pushKeyframe();
+
+    /**
+     * @brief Write the newest streamed frame to the LEDs
+     *
+     * @param[in] nowUs Current time in microseconds
+     * @return true if a frame was written to the LEDs, false otherwise
+     */
+    virtual bool renderStreamFrame(unsigned long nowUs);
 
     /**
-     * @brief Generate a color from a position on the color wheel
+     * @brief Render the frame and update the display
      *
-     * @param[in] pos Position on the color wheel (0-255)
-     * @return uint32_t Color value (0x00RRGGBB)
+     * @note With interpolation enabled this only pushes a keyframe
+     */
+    virtual void show();
+
+    /**
+     * @brief Copy the composited eye frame to the accent strips and start them
      */
-    virtual uint32_t wheel(uint8_t pos);
+    virtual void showAccentStrips();
 
     /**
      * @brief Calculate the order in which pixels should animate during a blink
@@ -205,6 +427,13 @@ protected:
      */
     virtual void calculatePixelOrder();
 
+    /**
+     * @brief Start the leader's most recent blink once the follow offset has passed
+     *
+     * @note Called from sequenceBlink() when following another eye
+     */
+    virtual void followLeaderBlink();
+
     /// @}
 
 private:
@@ -212,6 +441,25 @@ private:
     /// @{
 
     Adafruit_NeoPixel* m_pixels;  ///< Pointer to NeoPixel controller
+    LedStrips* m_strips;          ///< Optional accent strips mirroring the eye
+    FrameStream* m_stream;        ///< Optional live frames from a host
+
+    // Frame composition
+    uint32_t m_frame[EyeAnimationConstants::NUM_PIXELS];      ///< Unscaled colors per pixel
+    uint8_t m_pixelLevel[EyeAnimationConstants::NUM_PIXELS];  ///< Blink level (255 = open)
+
+    // Interpolated output
+    bool m_interpolate;                                         ///< True to interpolate output
+    bool m_cutKeyframe;                                         ///< Next keyframe replaces both
+    uint32_t m_keyframe[2][EyeAnimationConstants::NUM_PIXELS];  ///< Older and newer scaled frames
+    unsigned long m_keyframeTime[2];                            ///< When each keyframe was made
+    uint16_t m_outputWeight;                                    ///< Weight last written
+    EyeFrameStats m_stats;                                      ///< Logic and output counters
+
+    // Sprite playback
+    EyeSpriteDecoder m_sprite;    ///< Decoder of the playing clip (no clip when stopped)
+    unsigned long m_spriteStart;  ///< When the current pass through the clip started
+    bool m_spriteLoop;            ///< True to repeat the clip
 
     // Animation state
     uint16_t m_rainbowIndex;       ///< Current position in rainbow animation
@@ -234,8 +482,19 @@ private:
     uint8_t m_pixelOrder[16];             ///< Animation order for pixels during blink
     unsigned long m_nextBlinkDelay;       ///< Delay until next blink in sequence
     uint8_t m_blinkCount;                 ///< Number of blinks in current sequence
+    unsigned long m_lastBlinkEnd;         ///< When the last sequence blink ends
+    uint32_t m_blinksStarted;             ///< Blinks started since construction
+    unsigned long m_lastBlinkStart;       ///< When the most recent blink started
     unsigned long m_lastColorChangeTime;  ///< Time of last color change
 
+    // Followed blinks
+    const EyeAnimation* m_leader;    ///< Eye whose blinks are mirrored, or nullptr
+    unsigned long m_followOffset;    ///< Delay after a leader blink (ms)
+    uint32_t m_followedBlinks;       ///< Leader blinks already seen
+    unsigned long m_followBlinkAt;   ///< When the pending mirrored blink starts
+    unsigned long m_followDuration;  ///< Duration of the pending mirrored blink
+    bool m_followPending;            ///< True if a mirrored blink is waiting
+
     /// @}
 };
 
@@ -0,0 +1,102 @@
+/**
+ * @file EyeSprite.cpp
+ * @brief Implementation of the EyeSpriteDecoder class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the EyeSpriteDecoder which applies a sprite clip's per-frame
+ * changes from program memory to a frame buffer.
+ */
+
+#include "EyeSprite.h"
+
+#include <Logger.h>
+
+/**
+ * @brief Start decoding a clip from its first frame
+ *
+ * @param[in] clip Clip to decode, or nullptr to detach
+ */
+void EyeSpriteDecoder::start(const EyeSpriteClip* clip)
+{
+    m_clip = clip;
+    rewind();
+}
+
+/**
+ * @brief Read the next packed RGB color of the clip from program memory
+ *
+ * @return uint32_t Color value (0x00RRGGBB)
+ */
+uint32_t EyeSpriteDecoder::readColor()
+{
+    const uint32_t red = readByte();
+    const uint32_t green = readByte();
+    const uint32_t blue = readByte();
+    return (red << 16) | (green << 8) | blue;
+}
+
+/**
+ * @brief Apply the next frame's changes to a frame buffer
+ *
+ * @param[in,out] frame Previous frame, updated to the next one (0x00RRGGBB)
+ * @param[in] numPixels Size of the frame buffer
+ * @return true if a frame was decoded, false at the end of the clip or on bad data
+ *
+ * @note Every operation is checked against the clip size before its bytes are read, so
+ *       a truncated or corrupt clip ends playback instead of reading past the data
+ */
+bool EyeSpriteDecoder::decodeNext(uint32_t* frame, uint16_t numPixels)
+{
+    if (isFinished())
+    {
+        return false;
+    }
+
+    uint16_t pixel = 0;
+    while (m_offset < m_clip->size)
+    {
+        const uint8_t op = readByte();
+        if (op == EyeSpriteConstants::OP_END)
+        {
+            m_framesDecoded++;
+            return true;
+        }
+
+        const uint8_t kind = op & EyeSpriteConstants::OP_MASK;
+        const uint8_t count = (op & ~EyeSpriteConstants::OP_MASK) + 1;
+        if (kind == EyeSpriteConstants::OP_SKIP)
+        {
+            pixel += count;
+            continue;
+        }
+
+        // A run carries one color, a literal one per pixel
+        const size_t colorBytes = kind == EyeSpriteConstants::OP_RUN ? 3 : 3 * count;
+        const bool known =
+            kind == EyeSpriteConstants::OP_RUN || kind == EyeSpriteConstants::OP_LITERAL;
+        if (!known || m_offset + colorBytes > m_clip->size)
+        {
+            break;
+        }
+
+        uint32_t color = 0;
+        for (uint8_t i = 0; i < count; i++, pixel++)
+        {
+            if (i == 0 || kind == EyeSpriteConstants::OP_LITERAL)
+            {
+                color = readColor();
+            }
+            if (pixel < numPixels)
+            {
+                frame[pixel] = color;
+            }
+        }
+    }
+
+    Log.error("Sprite clip is corrupt at byte %u of frame %u", static_cast<unsigned>(m_offset),
+              static_cast<unsigned>(m_framesDecoded));
+    m_framesDecoded = m_clip->numFrames;  // Stop playback rather than show garbage
+    return false;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file EyeSprite.h
+ * @brief Delta-encoded LED sprite clips for the Y-Series USB Hub eye
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the EyeSpriteClip descriptor and the EyeSpriteDecoder which plays
+ * precompiled eye animations straight out of program memory (PROGMEM). Clips are built
+ * from CSV or image frame sequences by .scripts/sprite_to_header.py, in the same way
+ * WAV files are turned into headers for WavData.
+ *
+ * Every frame is stored as the changes from the frame before it (the first frame is
+ * relative to black), as a list of byte-coded operations:
+ * - SKIP n:    leave the next n pixels unchanged
+ * - RUN n:     set the next n pixels to one RGB color that follows
+ * - LITERAL n: set the next n pixels to the n RGB colors that follow
+ * - END:       the rest of the frame is unchanged
+ *
+ * The decoder applies these operations directly to the caller's frame buffer, so a
+ * clip is never copied into RAM and decoding a frame costs only the pixels it changes.
+ */
+
+#ifndef Y_SERIES_USB_HUB_EYE_SPRITE_H
+#define Y_SERIES_USB_HUB_EYE_SPRITE_H
+
+// System includes
+#include <Arduino.h>
+#include <stddef.h>
+
+/**
+ * @brief Contains constants describing the sprite clip encoding
+ */
+namespace EyeSpriteConstants
+{
+/// @name Operation Codes
+/// @{
+constexpr uint8_t OP_MASK = 0xC0;      ///< Bits selecting the operation
+constexpr uint8_t OP_SKIP = 0x00;      ///< Leave pixels unchanged
+constexpr uint8_t OP_RUN = 0x40;       ///< Repeat one color
+constexpr uint8_t OP_LITERAL = 0x80;   ///< One color per pixel
+constexpr uint8_t OP_END = 0xFF;       ///< End of frame
+constexpr uint8_t MAX_OP_PIXELS = 64;  ///< Most pixels in one operation (count - 1 in 6 bits)
+/// @}
+}  // namespace EyeSpriteConstants
+
+/**
+ * @brief A precompiled sprite clip stored in program memory
+ *
+ * @note Generated by .scripts/sprite_to_header.py; data points into PROGMEM
+ */
+struct EyeSpriteClip
+{
+    const uint8_t* data;  ///< Encoded frames in PROGMEM
+    size_t size;          ///< Size of the encoded frames in bytes
+    uint16_t numFrames;   ///< Number of frames in the clip
+    uint16_t frameMs;     ///< Duration of each frame in milliseconds
+    uint8_t numPixels;    ///< Pixels per frame
+};
+
+/**
+ * @brief Decodes a sprite clip one frame at a time from program memory
+ *
+ * @details
+ * The decoder only keeps a read offset into the clip; the frame itself lives in the
+ * caller's buffer, which must still hold the previous decoded frame when the next one
+ * is decoded. rewind() starts the clip over, after which the caller clears the buffer
+ * to black before decoding the first frame again.
+ */
+class EyeSpriteDecoder
+{
+public:
+    /**
+     * @brief Construct a decoder with no clip
+     */
+    EyeSpriteDecoder() : m_clip(nullptr), m_offset(0), m_framesDecoded(0) {}
+
+    /**
+     * @brief Start decoding a clip from its first frame
+     *
+     * @param[in] clip Clip to decode, or nullptr to detach
+     */
+    void start(const EyeSpriteClip* clip);
+
+    /**
+     * @brief Go back to the first frame of the current clip
+     */
+    void rewind()
+    {
+        m_offset = 0;
+        m_framesDecoded = 0;
+    }
+
+    /**
+     * @brief Apply the next frame's changes to a frame buffer
+     *
+     * @param[in,out] frame Previous frame, updated to the next one (0x00RRGGBB)
+     * @param[in] numPixels Size of the frame buffer
+     * @return true if a frame was decoded, false at the end of the clip or on bad data
+     *
+     * @note Pixels beyond numPixels are decoded but not written
+     */
+    bool decodeNext(uint32_t* frame, uint16_t numPixels);
+
+    /**
+     * @brief Get the clip being decoded
+     * @return Current clip, or nullptr
+     */
+    const EyeSpriteClip* getClip() const { return m_clip; }
+
+    /**
+     * @brief Get the number of frames decoded since the clip started
+     * @return Frames decoded (the index of the next frame)
+     */
+    uint16_t getFramesDecoded() const { return m_framesDecoded; }
+
+    /**
+     * @brief Check whether every frame of the clip has been decoded
+     * @return true at the end of the clip or with no clip, false otherwise
+     */
+    bool isFinished() const { return !m_clip || m_framesDecoded >= m_clip->numFrames; }
+
+private:
+    /**
+     * @brief Read the next byte of the clip from program memory
+     */
+    uint8_t readByte() { return pgm_read_byte(&m_clip->data[m_offset++]); }
+
+    /**
+     * @brief Read the next packed RGB color of the clip from program memory
+     */
+    uint32_t readColor();
+
+    const EyeSpriteClip* m_clip;  ///< Clip being decoded
+    size_t m_offset;              ///< Read position in the clip data
+    uint16_t m_framesDecoded;     ///< Frames decoded since the clip started
+};
+
+#endif  // Y_SERIES_USB_HUB_EYE_SPRITE_H
@@ -0,0 +1,252 @@
+/**
+ * @file FrameStream.cpp
+ * @brief Implementation of the FrameStream class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the FrameStream class which parses streamed eye frame messages
+ * byte by byte into its two-slot mailbox.
+ */
+
+#include "FrameStream.h"
+
+/**
+ * @brief Construct an idle frame stream
+ */
+FrameStream::FrameStream()
+    : m_slots{},
+      m_receiveSlot(0),
+      m_hasFrame(false),
+      m_unread(false),
+      m_lastFrameUs(0),
+      m_state(ParseState::Sync0),
+      m_header{},
+      m_pos(0),
+      m_crc(0),
+      m_stats{}
+{
+}
+
+/**
+ * @brief Parse every byte waiting on a serial port
+ *
+ * @param[in] stream Serial port to read (usually the USB CDC Serial)
+ * @param[in] nowUs Current time in microseconds
+ */
+void FrameStream::poll(Stream& stream, unsigned long nowUs)
+{
+    while (stream.available() > 0)
+    {
+        const int byte = stream.read();
+        if (byte < 0)
+        {
+            break;
+        }
+        receive(static_cast<uint8_t>(byte), nowUs);
+    }
+}
+
+/**
+ * @brief Parse received bytes
+ *
+ * @param[in] data Received bytes
+ * @param[in] length Number of bytes
+ * @param[in] nowUs Time the bytes were received in microseconds
+ */
+void FrameStream::receive(const uint8_t* data, size_t length, unsigned long nowUs)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        receive(data[i], nowUs);
+    }
+}
+
+/**
+ * @brief Parse one received byte
+ *
+ * @param[in] byte Received byte
+ * @param[in] nowUs Time the byte was received in microseconds
+ *
+ * @note Pixels are written straight into the receive slot; a message that turns out to
+ *       be corrupt is simply overwritten by the next one
+ */
+void FrameStream::receive(uint8_t byte, unsigned long nowUs)
+{
+    switch (m_state)
+    {
+        case ParseState::Sync0:
+            if (byte == FrameStreamConstants::SYNC_0)
+            {
+                m_state = ParseState::Sync1;
+            }
+            break;
+
+        case ParseState::Sync1:
+            if (byte == FrameStreamConstants::SYNC_1)
+            {
+                m_state = ParseState::Header;
+                m_pos = 0;
+                m_crc = 0;
+            }
+            else if (byte != FrameStreamConstants::SYNC_0)
+            {
+                m_state = ParseState::Sync0;
+            }
+            break;
+
+        case ParseState::Header:
+            m_crc = crc8(m_crc, byte);
+            m_header[m_pos++] = byte;
+            if (m_pos == 1 && (byte == 0 || byte > FrameStreamConstants::MAX_PIXELS))
+            {
+                m_stats.corrupt++;
+                m_state = ParseState::Sync0;
+            }
+            else if (m_pos == sizeof(m_header))
+            {
+                m_state = ParseState::Pixels;
+                m_pos = 0;
+            }
+            break;
+
+        case ParseState::Pixels:
+        {
+            m_crc = crc8(m_crc, byte);
+            uint32_t& pixel = m_slots[m_receiveSlot].pixels[m_pos / 3];
+            const uint8_t shift = 8 * (2 - m_pos % 3);  // Red, then green, then blue
+            pixel = (m_pos % 3 == 0 ? 0 : pixel) | (static_cast<uint32_t>(byte) << shift);
+            if (++m_pos == 3 * m_header[0])
+            {
+                m_state = ParseState::Checksum;
+            }
+            break;
+        }
+
+        case ParseState::Checksum:
+            m_state = ParseState::Sync0;
+            if (byte != m_crc)
+            {
+                m_stats.corrupt++;
+                break;
+            }
+            completeFrame(nowUs);
+            break;
+    }
+}
+
+/**
+ * @brief Publish the frame in the receive slot as the newest frame
+ *
+ * @param[in] nowUs Time the last byte was received in microseconds
+ */
+void FrameStream::completeFrame(unsigned long nowUs)
+{
+    StreamFrame& frame = m_slots[m_receiveSlot];
+    frame.numPixels = m_header[0];
+    frame.sequence = static_cast<uint16_t>(m_header[1] | (m_header[2] << 8));
+    frame.hostTimeUs = static_cast<uint32_t>(m_header[3]) |
+                       (static_cast<uint32_t>(m_header[4]) << 8) |
+                       (static_cast<uint32_t>(m_header[5]) << 16) |
+                       (static_cast<uint32_t>(m_header[6]) << 24);
+    frame.receivedUs = nowUs;
+
+    // Not newer than the newest frame: a duplicate or late frame, unless the host restarted
+    if (isActive(nowUs))
+    {
+        const uint16_t behind = m_slots[m_receiveSlot ^ 1].sequence - frame.sequence;
+        if (behind < FrameStreamConstants::RESTART_WINDOW)
+        {
+            m_stats.stale++;
+            return;
+        }
+    }
+
+    if (m_unread)
+    {
+        m_stats.dropped++;  // Replaced before the render tick took it
+    }
+    m_receiveSlot ^= 1;  // The completed slot becomes the newest frame
+    m_unread = true;
+    m_hasFrame = true;
+    m_lastFrameUs = nowUs;
+    m_stats.received++;
+}
+
+/**
+ * @brief Check whether the host is streaming
+ *
+ * @param[in] nowUs Current time in microseconds
+ * @return true if a frame was received within TIMEOUT_US, false otherwise
+ */
+bool FrameStream::isActive(unsigned long nowUs) const
+{
+    return m_hasFrame && nowUs - m_lastFrameUs < FrameStreamConstants::TIMEOUT_US;
+}
+
+/**
+ * @brief Take the newest complete frame if it was not shown yet
+ *
+ * @param[in] nowUs Current time in microseconds, for the latency statistics
+ * @return const StreamFrame* Frame to show, valid until the next poll(), or nullptr
+ */
+const StreamFrame* FrameStream::take(unsigned long nowUs)
+{
+    if (!m_unread)
+    {
+        return nullptr;
+    }
+    m_unread = false;
+
+    const StreamFrame& frame = m_slots[m_receiveSlot ^ 1];
+    const uint32_t latency = static_cast<uint32_t>(nowUs - frame.receivedUs);
+    m_stats.shown++;
+    m_stats.lastLatencyUs = latency;
+    m_stats.maxLatencyUs = latency > m_stats.maxLatencyUs ? latency : m_stats.maxLatencyUs;
+    m_stats.totalLatencyUs += latency;
+    return &frame;
+}
+
+/**
+ * @brief Encode a frame message, as sent by the host
+ *
+ * @param[in] sequence Sequence number
+ * @param[in] hostTimeUs Host timestamp (us)
+ * @param[in] pixels Colors (0x00RRGGBB)
+ * @param[in] numPixels Number of pixels (1-MAX_PIXELS)
+ * @param[out] out Buffer of at least MAX_MESSAGE_SIZE bytes
+ * @return size_t Message length, or 0 if numPixels is out of range
+ */
+size_t FrameStream::encode(uint16_t sequence, uint32_t hostTimeUs, const uint32_t* pixels,
+                           uint8_t numPixels, uint8_t* out)
+{
+    if (numPixels == 0 || numPixels > FrameStreamConstants::MAX_PIXELS)
+    {
+        return 0;
+    }
+
+    size_t length = 0;
+    out[length++] = FrameStreamConstants::SYNC_0;
+    out[length++] = FrameStreamConstants::SYNC_1;
+    out[length++] = numPixels;
+    out[length++] = static_cast<uint8_t>(sequence);
+    out[length++] = static_cast<uint8_t>(sequence >> 8);
+    for (uint8_t shift = 0; shift < 32; shift += 8)
+    {
+        out[length++] = static_cast<uint8_t>(hostTimeUs >> shift);
+    }
+    for (uint8_t i = 0; i < numPixels; i++)
+    {
+        out[length++] = static_cast<uint8_t>(pixels[i] >> 16);
+        out[length++] = static_cast<uint8_t>(pixels[i] >> 8);
+        out[length++] = static_cast<uint8_t>(pixels[i]);
+    }
+
+    uint8_t crc = 0;
+    for (size_t i = 2; i < length; i++)
+    {
+        crc = crc8(crc, out[i]);
+    }
+    out[length++] = crc;
+    return length;
+}
@@ -0,0 +1,246 @@
+/**
+ * @file FrameStream.h
+ * @brief Live eye frames streamed from a host over USB for the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the FrameStream class which receives complete eye frames from a
+ * PC over the USB CDC serial port, so a show controller can drive the eye ring
+ * directly (for example at 60 FPS, synchronized with other props).
+ *
+ * Each frame is a compact binary message, multi-byte fields little endian:
+ *
+ * | Offset | Size | Field                                         |
+ * |--------|------|-----------------------------------------------|
+ * | 0      | 2    | Sync bytes 0xA5 0x5A                          |
+ * | 2      | 1    | Number of pixels N (1-MAX_PIXELS)             |
+ * | 3      | 2    | Sequence number, incremented per frame        |
+ * | 5      | 4    | Host timestamp (us)                           |
+ * | 9      | 3N   | Pixel colors as R, G, B                       |
+ * | 9 + 3N | 1    | CRC-8 (polynomial 0x07) of bytes 2 to 8 + 3N  |
+ *
+ * Frames are parsed straight into a two-slot mailbox: one slot is being received
+ * while the other holds the newest complete frame. EyeAnimation takes that frame at
+ * its render tick. A frame that is replaced before it was shown is dropped rather than
+ * queued, so the eye never falls behind the host. .scripts/stream_frames.py sends
+ * frames from a PC.
+ */
+
+#ifndef Y_SERIES_USB_HUB_FRAME_STREAM_H
+#define Y_SERIES_USB_HUB_FRAME_STREAM_H
+
+// System includes
+#include <Arduino.h>
+
+/**
+ * @brief Contains constants used by the FrameStream class
+ */
+namespace FrameStreamConstants
+{
+/// @name Message Format
+/// @{
+constexpr uint8_t SYNC_0 = 0xA5;          ///< First sync byte
+constexpr uint8_t SYNC_1 = 0x5A;          ///< Second sync byte
+constexpr uint8_t HEADER_SIZE = 9;        ///< Sync, pixel count, sequence and timestamp
+constexpr uint8_t MAX_PIXELS = 17;        ///< Eye ring plus the center pixel
+constexpr uint8_t CRC_POLYNOMIAL = 0x07;  ///< CRC-8 over everything after the sync bytes
+
+constexpr size_t MAX_MESSAGE_SIZE = HEADER_SIZE + 3 * MAX_PIXELS + 1;  ///< Largest message
+/// @}
+
+/// @name Stream Behavior
+/// @{
+constexpr unsigned long TIMEOUT_US = 500000;  ///< Eye returns to its own animation after this
+constexpr uint16_t RESTART_WINDOW = 64;       ///< Sequence jump back treated as a new stream
+/// @}
+}  // namespace FrameStreamConstants
+
+/**
+ * @brief One streamed frame
+ */
+struct StreamFrame
+{
+    uint16_t sequence;                                  ///< Host sequence number
+    uint32_t hostTimeUs;                                ///< Host timestamp (us)
+    unsigned long receivedUs;                           ///< When the last byte arrived (us)
+    uint8_t numPixels;                                  ///< Pixels in this frame
+    uint32_t pixels[FrameStreamConstants::MAX_PIXELS];  ///< Colors (0x00RRGGBB)
+};
+
+/**
+ * @brief Counters for the received stream
+ */
+struct FrameStreamStats
+{
+    uint32_t received;        ///< Complete, valid frames received
+    uint32_t shown;           ///< Frames taken by the render tick
+    uint32_t dropped;         ///< Frames replaced by a newer one before they were shown
+    uint32_t stale;           ///< Frames older than the newest one received
+    uint32_t corrupt;         ///< Messages with a bad pixel count or checksum
+    uint32_t lastLatencyUs;   ///< Receive-to-show latency of the last shown frame (us)
+    uint32_t maxLatencyUs;    ///< Largest receive-to-show latency (us)
+    uint64_t totalLatencyUs;  ///< Sum of receive-to-show latencies, for the average (us)
+};
+
+/**
+ * @brief Receives streamed eye frames into a two-slot mailbox
+ *
+ * @details
+ * Reception and the render tick both run in the main loop, so the mailbox needs no
+ * locking: poll() parses whatever bytes have arrived and take() hands the newest
+ * complete frame to the eye exactly once.
+ */
+class FrameStream
+{
+public:
+    /// @name Construction
+    /// @{
+    /**
+     * @brief Construct an idle frame stream
+     */
+    FrameStream();
+
+    // Prevent copying and assignment
+    FrameStream(const FrameStream&) = delete;
+    FrameStream& operator=(const FrameStream&) = delete;
+    /// @}
+
+    /// @name Receiving
+    /// @{
+    /**
+     * @brief Parse every byte waiting on a serial port
+     *
+     * @param[in] stream Serial port to read (usually the USB CDC Serial)
+     * @param[in] nowUs Current time in microseconds
+     */
+    void poll(Stream& stream, unsigned long nowUs);
+
+    /**
+     * @brief Parse received bytes
+     *
+     * @param[in] data Received bytes
+     * @param[in] length Number of bytes
+     * @param[in] nowUs Time the bytes were received in microseconds
+     */
+    void receive(const uint8_t* data, size_t length, unsigned long nowUs);
+
+    /**
+     * @brief Parse one received byte
+     *
+     * @param[in] byte Received byte
+     * @param[in] nowUs Time the byte was received in microseconds
+     */
+    void receive(uint8_t byte, unsigned long nowUs);
+    /// @}
+
+    /// @name Render Tick
+    /// @{
+    /**
+     * @brief Check whether the host is streaming
+     *
+     * @param[in] nowUs Current time in microseconds
+     * @return true if a frame was received within TIMEOUT_US, false otherwise
+     */
+    bool isActive(unsigned long nowUs) const;
+
+    /**
+     * @brief Check whether a complete frame is waiting to be taken
+     *
+     * @return true if the newest frame was not taken yet, false otherwise
+     */
+    bool hasNewFrame() const { return m_unread; }
+
+    /**
+     * @brief Take the newest complete frame if it was not shown yet
+     *
+     * @param[in] nowUs Current time in microseconds, for the latency statistics
+     * @return const StreamFrame* Frame to show, valid until the next poll(), or nullptr
+     */
+    const StreamFrame* take(unsigned long nowUs);
+    /// @}
+
+    /// @name Statistics
+    /// @{
+    /**
+     * @brief Get the stream counters
+     * @return const FrameStreamStats& Counters since construction or the last reset
+     */
+    const FrameStreamStats& getStats() const { return m_stats; }
+
+    /**
+     * @brief Reset the stream counters
+     */
+    void resetStats() { m_stats = FrameStreamStats{}; }
+    /// @}
+
+    /// @name Message Encoding
+    /// @{
+    /**
+     * @brief Encode a frame message, as sent by the host
+     *
+     * @param[in] sequence Sequence number
+     * @param[in] hostTimeUs Host timestamp (us)
+     * @param[in] pixels Colors (0x00RRGGBB)
+     * @param[in] numPixels Number of pixels (1-MAX_PIXELS)
+     * @param[out] out Buffer of at least MAX_MESSAGE_SIZE bytes
+     * @return size_t Message length, or 0 if numPixels is out of range
+     */
+    static size_t encode(uint16_t sequence, uint32_t hostTimeUs, const uint32_t* pixels,
+                         uint8_t numPixels, uint8_t* out);
+
+    /**
+     * @brief Update a CRC-8 (polynomial 0x07) with one byte
+     *
+     * @param[in] crc CRC so far (0 to start)
+     * @param[in] byte Next byte
+     * @return uint8_t Updated CRC
+     */
+    static constexpr uint8_t crc8(uint8_t crc, uint8_t byte)
+    {
+        crc ^= byte;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^
+                                                      FrameStreamConstants::CRC_POLYNOMIAL)
+                               : static_cast<uint8_t>(crc << 1);
+        }
+        return crc;
+    }
+    /// @}
+
+private:
+    /**
+     * @brief Parser position within a message
+     */
+    enum class ParseState : uint8_t
+    {
+        Sync0,     ///< Waiting for the first sync byte
+        Sync1,     ///< Waiting for the second sync byte
+        Header,    ///< Pixel count, sequence and timestamp
+        Pixels,    ///< Pixel colors
+        Checksum,  ///< CRC-8
+    };
+
+    /**
+     * @brief Publish the frame in the receive slot as the newest frame
+     */
+    void completeFrame(unsigned long nowUs);
+
+    // Mailbox
+    StreamFrame m_slots[2];       ///< Receive slot and newest complete frame
+    uint8_t m_receiveSlot;        ///< Slot the parser writes into
+    bool m_hasFrame;              ///< True once any frame was received
+    bool m_unread;                ///< True if the newest frame was not taken yet
+    unsigned long m_lastFrameUs;  ///< When the newest frame was received
+
+    // Parser
+    ParseState m_state;                                       ///< Position within the message
+    uint8_t m_header[FrameStreamConstants::HEADER_SIZE - 2];  ///< Header bytes after the sync
+    uint8_t m_pos;                                            ///< Bytes received in this state
+    uint8_t m_crc;                                            ///< CRC of the message so far
+
+    FrameStreamStats m_stats;  ///< Stream counters
+};
+
+#endif  // Y_SERIES_USB_HUB_FRAME_STREAM_H
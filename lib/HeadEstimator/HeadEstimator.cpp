@@ -0,0 +1,238 @@
+/**
+ * @file HeadEstimator.cpp
+ * @brief Implementation of the HeadEstimator class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the HeadEstimator class which dead-reckons the head position
+ * from the commanded duty and re-anchors it on the hall sensors.
+ */
+
+// System includes
+#include <algorithm>
+
+// Project includes
+#include "HeadEstimator.h"
+
+/**
+ * @brief Construct an uncalibrated estimator
+ */
+HeadEstimator::HeadEstimator()
+    : m_position(0.5f),
+      m_blindTravel(0.0f),
+      m_travelDutyMs(0.0f),
+      m_anchorCount(0),
+      m_started(false),
+      m_lastUpdateMs(0),
+      m_lastLeft(false),
+      m_lastRight(false),
+      m_traverse(Traverse::None),
+      m_traverseDutyMs(0),
+      m_calibration(HeadCalibration::Uncalibrated),
+      m_phaseStartMs(0)
+{
+}
+
+/**
+ * @brief Start the calibration sweep
+ *
+ * @param[in] nowMs Current time in milliseconds
+ */
+void HeadEstimator::startCalibration(unsigned long nowMs)
+{
+    m_calibration = HeadCalibration::SeekLeft;
+    m_phaseStartMs = nowMs;
+    Log.info("Calibrating head travel");
+}
+
+/**
+ * @brief Get the direction the calibration sweep needs
+ * @return int8_t -1 to drive left, 1 to drive right, 0 when not calibrating
+ */
+int8_t HeadEstimator::getCalibrationDirection() const
+{
+    switch (m_calibration)
+    {
+        case HeadCalibration::SeekLeft:
+            return -1;
+        case HeadCalibration::SweepRight:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Advance the estimate to the current time
+ *
+ * @param[in] nowMs Current time in milliseconds
+ * @param[in] duty Duty commanded since the previous update, positive to the right
+ * @param[in] sensorLeft true if the left hall sensor is active
+ * @param[in] sensorRight true if the right hall sensor is active
+ *
+ * @note Edges are only seen at update times, so every anchor and traverse is accurate
+ *       to one main loop tick
+ */
+void HeadEstimator::update(unsigned long nowMs, int16_t duty, bool sensorLeft, bool sensorRight)
+{
+    const unsigned long elapsed = m_started ? nowMs - m_lastUpdateMs : 0;
+    updateTravel(nowMs, static_cast<int32_t>(duty) * static_cast<int32_t>(elapsed), sensorLeft,
+                 sensorRight);
+}
+
+/**
+ * @brief Advance the estimate by a measured travel
+ *
+ * @param[in] nowMs Current time in milliseconds
+ * @param[in] dutyMs Duty-milliseconds driven since the previous update, positive to the right
+ * @param[in] sensorLeft true if the left hall sensor is active
+ * @param[in] sensorRight true if the right hall sensor is active
+ */
+void HeadEstimator::updateTravel(unsigned long nowMs, int32_t dutyMs, bool sensorLeft,
+                                 bool sensorRight)
+{
+    m_started = true;
+    m_lastUpdateMs = nowMs;
+
+    // Dead reckoning: the duty driven since the last update moved the head this far
+    m_traverseDutyMs += dutyMs;
+    if (isCalibrated())
+    {
+        const float travel = dutyMs / m_travelDutyMs;
+        m_position += travel;
+        m_blindTravel += travel < 0.0f ? -travel : travel;
+    }
+
+    // Arriving at a sensor completes a traverse from the other one
+    if (sensorRight && !m_lastRight && m_traverse == Traverse::FromLeft)
+    {
+        learnTravel(m_traverseDutyMs);
+    }
+    else if (sensorLeft && !m_lastLeft && m_traverse == Traverse::FromRight)
+    {
+        learnTravel(-m_traverseDutyMs);
+    }
+
+    // Leaving a sensor starts one
+    if (m_lastLeft && !sensorLeft)
+    {
+        m_traverse = Traverse::FromLeft;
+        m_traverseDutyMs = 0;
+    }
+    else if (m_lastRight && !sensorRight)
+    {
+        m_traverse = Traverse::FromRight;
+        m_traverseDutyMs = 0;
+    }
+
+    // Every sensor edge is an exact position; inside a sensor's zone the head is known
+    // to be beyond the edge, and between the sensors it is known to be between them
+    if (sensorLeft != m_lastLeft)
+    {
+        anchor(0.0f);
+    }
+    else if (sensorRight != m_lastRight)
+    {
+        anchor(1.0f);
+    }
+    else if (sensorLeft || sensorRight)
+    {
+        m_position = sensorLeft ? std::min(m_position, 0.0f) : std::max(m_position, 1.0f);
+        m_blindTravel = 0.0f;
+    }
+    else
+    {
+        m_position = std::min(1.0f, std::max(0.0f, m_position));
+    }
+    m_lastLeft = sensorLeft;
+    m_lastRight = sensorRight;
+
+    // Calibration sweep: reach the left sensor, then time the travel to the right one
+    if (m_calibration == HeadCalibration::SeekLeft && sensorLeft)
+    {
+        m_calibration = HeadCalibration::SweepRight;
+        m_phaseStartMs = nowMs;
+    }
+    else if (isCalibrating() &&
+             nowMs - m_phaseStartMs > HeadEstimatorConstants::CALIBRATION_TIMEOUT_MS)
+    {
+        m_calibration = HeadCalibration::Failed;
+        Log.error("Head calibration failed: no hall sensor after %lu ms",
+                  HeadEstimatorConstants::CALIBRATION_TIMEOUT_MS);
+    }
+}
+
+/**
+ * @brief Get the confidence in the estimated position
+ * @return float 1.0 on a hall sensor, falling as the head is driven blind, 0 if uncalibrated
+ */
+float HeadEstimator::getConfidence() const
+{
+    if (!isCalibrated() || m_anchorCount == 0)
+    {
+        return 0.0f;
+    }
+    return std::max(0.0f, 1.0f - m_blindTravel * HeadEstimatorConstants::DRIFT_PER_TRAVEL);
+}
+
+/**
+ * @brief Check whether the head is confidently near the limit it is heading for
+ *
+ * @param[in] direction Direction of travel, -1 left or 1 right
+ * @param[in] margin Distance to the limit that counts as near (0.0-1.0)
+ * @return true if confidence is at least MIN_CONFIDENCE and the limit is within margin
+ */
+bool HeadEstimator::isNearLimit(int8_t direction, float margin) const
+{
+    if (direction == 0 || getConfidence() < HeadEstimatorConstants::MIN_CONFIDENCE)
+    {
+        return false;
+    }
+    return direction < 0 ? m_position <= margin : m_position >= 1.0f - margin;
+}
+
+/**
+ * @brief Put the estimate on a hall sensor edge
+ *
+ * @param[in] position 0.0 for the left sensor, 1.0 for the right one
+ */
+void HeadEstimator::anchor(float position)
+{
+    m_position = position;
+    m_blindTravel = 0.0f;
+    m_anchorCount++;
+}
+
+/**
+ * @brief Fold a measured limit-to-limit traverse into the travel
+ *
+ * @param[in] dutyMs Duty-ms integrated over the traverse, positive toward its end
+ */
+void HeadEstimator::learnTravel(int32_t dutyMs)
+{
+    m_traverse = Traverse::None;
+    if (dutyMs <= 0)
+    {
+        return;  // Pushed there by hand, or the sensor glitched
+    }
+
+    if (!isCalibrated())
+    {
+        m_travelDutyMs = static_cast<float>(dutyMs);
+    }
+    else
+    {
+        m_travelDutyMs += HeadEstimatorConstants::LEARNING_RATE * (dutyMs - m_travelDutyMs);
+    }
+
+    // The sweep, or a traverse after a failed sweep, completes the calibration
+    if (m_calibration != HeadCalibration::Calibrated)
+    {
+        const unsigned long travelMs =
+            static_cast<unsigned long>(m_travelDutyMs / HeadEstimatorConstants::CALIBRATION_DUTY);
+        m_calibration = HeadCalibration::Calibrated;
+        Log.info("Head travel calibrated: %lu ms at duty %d", travelMs,
+                 HeadEstimatorConstants::CALIBRATION_DUTY);
+    }
+}
@@ -0,0 +1,228 @@
+/**
+ * @file HeadEstimator.h
+ * @brief Dead-reckoning estimate of the head position for the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the HeadEstimator class which estimates where the head is between
+ * the two hall sensors. The sensors only report "at the left limit" and "at the right
+ * limit"; in between, the estimator integrates the commanded motor duty over time.
+ *
+ * Position is normalized: 0.0 is the edge of the left hall sensor and 1.0 the edge of
+ * the right one. The head's speed is modeled as proportional to the PWM duty, so the
+ * only motor parameter is the duty-milliseconds it takes to travel from one sensor to
+ * the other. A calibration sweep at boot measures it at a known duty: seek the left
+ * sensor, then time the travel to the right one. Every later limit-to-limit traverse
+ * refines it, because the signed duty integrated between leaving one sensor and
+ * reaching the other is one full travel whatever the speed or direction changes.
+ *
+ * Each hall edge re-anchors the estimate. Inside a sensor's zone the estimate keeps
+ * integrating past the edge, so it knows how far the head coasted onto the sensor.
+ * Confidence starts at 1.0 on a sensor and falls with the distance driven blind since,
+ * so behaviors can tell a fresh estimate from a stale one.
+ */
+
+#ifndef Y_SERIES_USB_HUB_HEAD_ESTIMATOR_H
+#define Y_SERIES_USB_HUB_HEAD_ESTIMATOR_H
+
+// System includes
+#include <Arduino.h>
+
+// Project includes
+#include <Logger.h>
+
+/**
+ * @brief Contains constants used by the HeadEstimator class
+ */
+namespace HeadEstimatorConstants
+{
+/// @name Calibration
+/// @{
+constexpr uint8_t CALIBRATION_DUTY = 96;                 ///< Known PWM duty of the boot sweep
+constexpr unsigned long CALIBRATION_TIMEOUT_MS = 10000;  ///< Longest wait for a hall sensor
+constexpr float LEARNING_RATE = 0.25f;                   ///< Weight of each later traverse
+/// @}
+
+/// @name Confidence
+/// @{
+constexpr float DRIFT_PER_TRAVEL = 0.5f;  ///< Confidence lost per full travel driven blind
+constexpr float MIN_CONFIDENCE = 0.5f;    ///< Below this behaviors ignore the estimate
+constexpr float LIMIT_MARGIN = 0.15f;     ///< Distance to a limit that counts as near it
+/// @}
+}  // namespace HeadEstimatorConstants
+
+/**
+ * @brief Calibration progress of a HeadEstimator
+ */
+enum class HeadCalibration : uint8_t
+{
+    Uncalibrated,  ///< No travel measured yet
+    SeekLeft,      ///< Boot sweep driving to the left sensor
+    SweepRight,    ///< Boot sweep timing the travel to the right sensor
+    Calibrated,    ///< Travel known, the estimate is usable
+    Failed         ///< A sensor was not reached within CALIBRATION_TIMEOUT_MS
+};
+
+/**
+ * @brief Estimates the head position from commanded duty and hall sensor edges
+ *
+ * @details
+ * update() is called once per main loop tick with the duty commanded since the
+ * previous call. During the calibration sweep getCalibrationDirection() tells the
+ * caller which way to drive at CALIBRATION_DUTY.
+ */
+class HeadEstimator
+{
+public:
+    /// @name Construction
+    /// @{
+    /**
+     * @brief Construct an uncalibrated estimator
+     */
+    HeadEstimator();
+
+    // Prevent copying and assignment
+    HeadEstimator(const HeadEstimator&) = delete;
+    HeadEstimator& operator=(const HeadEstimator&) = delete;
+    /// @}
+
+    /// @name Calibration
+    /// @{
+    /**
+     * @brief Start the calibration sweep
+     *
+     * @param[in] nowMs Current time in milliseconds
+     */
+    void startCalibration(unsigned long nowMs);
+
+    /**
+     * @brief Get the direction the calibration sweep needs
+     * @return int8_t -1 to drive left, 1 to drive right, 0 when not calibrating
+     */
+    int8_t getCalibrationDirection() const;
+
+    /**
+     * @brief Check whether the calibration sweep is running
+     * @return true while the sweep needs the motor, false otherwise
+     */
+    bool isCalibrating() const
+    {
+        return m_calibration == HeadCalibration::SeekLeft ||
+               m_calibration == HeadCalibration::SweepRight;
+    }
+
+    /**
+     * @brief Check whether the head travel has been measured
+     * @return true if the estimate can be used, false otherwise
+     */
+    bool isCalibrated() const { return m_travelDutyMs > 0.0f; }
+
+    /**
+     * @brief Get the calibration progress
+     * @return HeadCalibration Current calibration state
+     */
+    HeadCalibration getCalibration() const { return m_calibration; }
+
+    /**
+     * @brief Get the measured travel between the hall sensors
+     * @return float Duty-milliseconds from one sensor to the other, 0 if uncalibrated
+     */
+    float getTravelDutyMs() const { return m_travelDutyMs; }
+    /// @}
+
+    /// @name Estimation
+    /// @{
+    /**
+     * @brief Advance the estimate to the current time
+     *
+     * @param[in] nowMs Current time in milliseconds
+     * @param[in] duty Duty commanded since the previous update, positive to the right
+     * @param[in] sensorLeft true if the left hall sensor is active
+     * @param[in] sensorRight true if the right hall sensor is active
+     */
+    void update(unsigned long nowMs, int16_t duty, bool sensorLeft, bool sensorRight);
+
+    /**
+     * @brief Advance the estimate by a measured travel
+     *
+     * @param[in] nowMs Current time in milliseconds
+     * @param[in] dutyMs Duty-milliseconds driven since the previous update, positive to the right
+     * @param[in] sensorLeft true if the left hall sensor is active
+     * @param[in] sensorRight true if the right hall sensor is active
+     *
+     * @note For a motor whose duty changes between updates, such as one driven by a
+     *       MotionPlanner
+     */
+    void updateTravel(unsigned long nowMs, int32_t dutyMs, bool sensorLeft, bool sensorRight);
+
+    /**
+     * @brief Get the estimated head position
+     * @return float 0.0 at the left hall sensor edge to 1.0 at the right one, beyond that
+     *         range while the head is on a sensor
+     */
+    float getPosition() const { return m_position; }
+
+    /**
+     * @brief Get the confidence in the estimated position
+     * @return float 1.0 on a hall sensor, falling as the head is driven blind, 0 if uncalibrated
+     */
+    float getConfidence() const;
+
+    /**
+     * @brief Check whether the head is confidently near the limit it is heading for
+     *
+     * @param[in] direction Direction of travel, -1 left or 1 right
+     * @param[in] margin Distance to the limit that counts as near (0.0-1.0)
+     * @return true if confidence is at least MIN_CONFIDENCE and the limit is within margin
+     */
+    bool isNearLimit(int8_t direction, float margin = HeadEstimatorConstants::LIMIT_MARGIN) const;
+
+    /**
+     * @brief Get the number of hall sensor anchors
+     * @return uint32_t Sensor edges seen
+     */
+    uint32_t getAnchorCount() const { return m_anchorCount; }
+    /// @}
+
+private:
+    /**
+     * @brief Put the estimate on a hall sensor edge
+     */
+    void anchor(float position);
+
+    /**
+     * @brief Fold a measured limit-to-limit traverse into the travel
+     */
+    void learnTravel(int32_t dutyMs);
+
+    /**
+     * @brief Source of the traverse being measured
+     */
+    enum class Traverse : uint8_t
+    {
+        None,       ///< Not measuring
+        FromLeft,   ///< Left the left sensor, waiting for the right one
+        FromRight,  ///< Left the right sensor, waiting for the left one
+    };
+
+    // Estimate
+    float m_position;        ///< Estimated position (0.0-1.0)
+    float m_blindTravel;     ///< Travel estimated since the last anchor
+    float m_travelDutyMs;    ///< Duty-ms between the sensors, 0 if unknown
+    uint32_t m_anchorCount;  ///< Sensor edges seen
+
+    // Sensor edges
+    bool m_started;                ///< True once the first update was seen
+    unsigned long m_lastUpdateMs;  ///< Time of the previous update
+    bool m_lastLeft;               ///< Left sensor state at the previous update
+    bool m_lastRight;              ///< Right sensor state at the previous update
+    Traverse m_traverse;           ///< Traverse being measured
+    int32_t m_traverseDutyMs;      ///< Signed duty-ms since the traverse started
+
+    // Calibration
+    HeadCalibration m_calibration;  ///< Calibration progress
+    unsigned long m_phaseStartMs;   ///< When the current sweep phase started
+};
+
+#endif  // Y_SERIES_USB_HUB_HEAD_ESTIMATOR_H
@@ -0,0 +1,134 @@
+/**
+ * @file HsvColor.cpp
+ * @brief Implementation of the HsvColor class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements integer HSV to RGB conversion and the gamma table used to
+ * map linear LED intensities onto perceived brightness.
+ */
+
+#include "HsvColor.h"
+
+namespace
+{
+// round(pow(i / 255.0, 2.6) * 255) for i = 0..255
+const uint8_t kGammaTable[256] PROGMEM = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,
+    2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,
+    5,   5,   6,   6,   6,   6,   7,   7,   7,   8,   8,   8,   9,   9,   9,   10,  10,  10,  11,
+    11,  11,  12,  12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+    20,  20,  21,  21,  22,  22,  23,  24,  24,  25,  25,  26,  27,  27,  28,  29,  29,  30,  31,
+    31,  32,  33,  34,  34,  35,  36,  37,  38,  38,  39,  40,  41,  42,  42,  43,  44,  45,  46,
+    47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  64,  65,
+    66,  68,  69,  70,  71,  72,  73,  75,  76,  77,  78,  80,  81,  82,  84,  85,  86,  88,  89,
+    90,  92,  93,  94,  96,  97,  99,  100, 102, 103, 105, 106, 108, 109, 111, 112, 114, 115, 117,
+    119, 120, 122, 124, 125, 127, 129, 130, 132, 134, 136, 137, 139, 141, 143, 145, 146, 148, 150,
+    152, 154, 156, 158, 160, 162, 164, 166, 168, 170, 172, 174, 176, 178, 180, 182, 184, 186, 188,
+    191, 193, 195, 197, 199, 202, 204, 206, 209, 211, 213, 215, 218, 220, 223, 225, 227, 230, 232,
+    235, 237, 240, 242, 245, 247, 250, 252, 255,
+};
+}  // namespace
+
+/**
+ * @brief Convert a hue, saturation and value to a packed color
+ *
+ * @param[in] hue Hue angle (0-65535, 0 = red, wraps around)
+ * @param[in] sat Saturation (0 = white, 255 = fully saturated)
+ * @param[in] val Value (0 = off, 255 = full intensity)
+ * @return uint32_t Color value (0x00RRGGBB)
+ */
+uint32_t HsvColor::toRgb(uint16_t hue, uint8_t sat, uint8_t val)
+{
+    // Map the 16-bit hue onto 0..1530 with a rounding multiply and shift
+    const uint16_t h = (static_cast<uint32_t>(hue) * HsvColorConstants::HUE_STEPS + 0x8000) >> 16;
+
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    if (h < 255)
+    {
+        // Red to yellow
+        r = 255;
+        g = h;
+        b = 0;
+    }
+    else if (h < 510)
+    {
+        // Yellow to green
+        r = 510 - h;
+        g = 255;
+        b = 0;
+    }
+    else if (h < 765)
+    {
+        // Green to cyan
+        r = 0;
+        g = 255;
+        b = h - 510;
+    }
+    else if (h < 1020)
+    {
+        // Cyan to blue
+        r = 0;
+        g = 1020 - h;
+        b = 255;
+    }
+    else if (h < 1275)
+    {
+        // Blue to magenta
+        r = h - 1020;
+        g = 0;
+        b = 255;
+    }
+    else if (h < 1530)
+    {
+        // Magenta to red
+        r = 255;
+        g = 0;
+        b = 1530 - h;
+    }
+    else
+    {
+        // Rounded up to a full turn, back at red
+        r = 255;
+        g = 0;
+        b = 0;
+    }
+
+    // Blend toward white by (255 - sat), then scale by val; the +1 terms let
+    // 255 act as unity so fully saturated, full value colors are exact
+    const uint16_t s1 = sat + 1;
+    const uint8_t s2 = 255 - sat;
+    const uint16_t v1 = val + 1;
+    const uint32_t red = ((((r * s1) >> 8) + s2) * v1) >> 8;
+    const uint32_t green = ((((g * s1) >> 8) + s2) * v1) >> 8;
+    const uint32_t blue = ((((b * s1) >> 8) + s2) * v1) >> 8;
+
+    return (red << 16) | (green << 8) | blue;
+}
+
+/**
+ * @brief Apply gamma correction to a single 8-bit intensity
+ *
+ * @param[in] value Linear intensity (0-255)
+ * @return uint8_t Gamma-corrected intensity (gamma 2.6)
+ */
+uint8_t HsvColor::gamma8(uint8_t value)
+{
+    return pgm_read_byte(&kGammaTable[value]);
+}
+
+/**
+ * @brief Apply gamma correction to each channel of a packed color
+ *
+ * @param[in] color 32-bit color value (0x00RRGGBB)
+ * @return uint32_t Gamma-corrected color (0x00RRGGBB)
+ */
+uint32_t HsvColor::gamma32(uint32_t color)
+{
+    return (static_cast<uint32_t>(gamma8((color >> 16) & 0xFF)) << 16) |
+           (static_cast<uint32_t>(gamma8((color >> 8) & 0xFF)) << 8) | gamma8(color & 0xFF);
+}
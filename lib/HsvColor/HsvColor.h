@@ -0,0 +1,98 @@
+/**
+ * @file HsvColor.h
+ * @brief Integer HSV color conversion for the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the HsvColor class which converts hue, saturation and value
+ * into packed 0x00RRGGBB colors using only integer multiplies and shifts, so eye
+ * effects can rotate hues, fade saturation or tint a mood without re-deriving RGB
+ * constants by hand.
+ *
+ * Hue is a 16-bit angle that wraps naturally: 0 is red, 65536 would be red again.
+ * An optional gamma table maps linear intensities onto perceived brightness.
+ */
+
+#ifndef Y_SERIES_USB_HUB_HSV_COLOR_H
+#define Y_SERIES_USB_HUB_HSV_COLOR_H
+
+// System includes
+#include <Arduino.h>
+
+/**
+ * @brief Contains constants used by the HsvColor class
+ */
+namespace HsvColorConstants
+{
+/// @name Hue Angles
+/// @{
+constexpr uint16_t HUE_RED = 0;          ///< 0 degrees
+constexpr uint16_t HUE_YELLOW = 10923;   ///< 60 degrees
+constexpr uint16_t HUE_GREEN = 21845;    ///< 120 degrees
+constexpr uint16_t HUE_CYAN = 32768;     ///< 180 degrees
+constexpr uint16_t HUE_BLUE = 43691;     ///< 240 degrees
+constexpr uint16_t HUE_MAGENTA = 54613;  ///< 300 degrees
+/// @}
+
+/// @name Conversion
+/// @{
+constexpr uint16_t HUE_STEPS = 6 * 255;  ///< Distinct hues produced (255 per sector)
+/// @}
+}  // namespace HsvColorConstants
+
+/**
+ * @brief Converts HSV to packed RGB without floats or divisions
+ *
+ * @details
+ * The hue is mapped onto six 255-step sectors with one multiply and a shift. Within
+ * a sector one channel is full, one is off and one ramps, after which saturation
+ * blends toward white and value scales the result, again with multiplies and shifts.
+ */
+class HsvColor
+{
+public:
+    /**
+     * @brief Convert a hue, saturation and value to a packed color
+     *
+     * @param[in] hue Hue angle (0-65535, 0 = red, wraps around)
+     * @param[in] sat Saturation (0 = white, 255 = fully saturated)
+     * @param[in] val Value (0 = off, 255 = full intensity)
+     * @return uint32_t Color value (0x00RRGGBB)
+     */
+    static uint32_t toRgb(uint16_t hue, uint8_t sat = 255, uint8_t val = 255);
+
+    /**
+     * @brief Apply gamma correction to a single 8-bit intensity
+     *
+     * @param[in] value Linear intensity (0-255)
+     * @return uint8_t Gamma-corrected intensity (gamma 2.6)
+     */
+    static uint8_t gamma8(uint8_t value);
+
+    /**
+     * @brief Apply gamma correction to each channel of a packed color
+     *
+     * @param[in] color 32-bit color value (0x00RRGGBB)
+     * @return uint32_t Gamma-corrected color (0x00RRGGBB)
+     */
+    static uint32_t gamma32(uint32_t color);
+
+    /**
+     * @brief Convert to a packed color and gamma-correct it
+     *
+     * @param[in] hue Hue angle (0-65535, 0 = red, wraps around)
+     * @param[in] sat Saturation (0 = white, 255 = fully saturated)
+     * @param[in] val Value (0 = off, 255 = full intensity)
+     * @return uint32_t Gamma-corrected color value (0x00RRGGBB)
+     */
+    static uint32_t toRgbGamma(uint16_t hue, uint8_t sat = 255, uint8_t val = 255)
+    {
+        return gamma32(toRgb(hue, sat, val));
+    }
+
+    // Static-only utility
+    HsvColor() = delete;
+};
+
+#endif  // Y_SERIES_USB_HUB_HSV_COLOR_H
@@ -0,0 +1,226 @@
+/**
+ * @file InputEvents.cpp
+ * @brief Implementation of the InputEventQueue and InputEdgeCapture classes for
+ *        Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the input edge queue and the GPIO edge interrupts that fill it,
+ * including the hall sensor limit stop made from the interrupt.
+ */
+
+#include "InputEvents.h"
+
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/gpio.h>
+#include <hardware/irq.h>
+#include <hardware/sync.h>
+#include <hardware/timer.h>
+#endif
+
+// Static instance pointer for the GPIO interrupt callback
+InputEdgeCapture* InputEdgeCapture::s_instance = nullptr;
+
+/**
+ * @brief Construct an empty queue
+ */
+InputEventQueue::InputEventQueue() : m_events(), m_head(0), m_tail(0), m_dropped(0) {}
+
+/**
+ * @brief Add an edge (producer side)
+ *
+ * @param[in] event Edge to add
+ * @return true if it was queued, false if the queue was full
+ */
+bool InputEventQueue::push(const InputEvent& event)
+{
+    const uint8_t head = m_head;
+    if (static_cast<uint8_t>(head - m_tail) >= InputEventsConstants::QUEUE_CAPACITY)
+    {
+        m_dropped = m_dropped + 1;
+        return false;
+    }
+    m_events[head & InputEventsConstants::QUEUE_MASK] = event;
+#ifdef ARDUINO_ARCH_RP2040
+    __dmb();  // The slot is written before the consumer can see it
+#endif
+    m_head = head + 1;
+    return true;
+}
+
+/**
+ * @brief Take the oldest edge (consumer side)
+ *
+ * @param[out] event Oldest edge, unchanged if the queue is empty
+ * @return true if an edge was taken, false if the queue was empty
+ */
+bool InputEventQueue::pop(InputEvent& event)
+{
+    const uint8_t tail = m_tail;
+    if (tail == m_head)
+    {
+        return false;
+    }
+#ifdef ARDUINO_ARCH_RP2040
+    __dmb();  // The slot is read after the producer published it
+#endif
+    event = m_events[tail & InputEventsConstants::QUEUE_MASK];
+    m_tail = tail + 1;
+    return true;
+}
+
+/**
+ * @brief Construct a capture for the input pins of a pin configuration
+ *
+ * @param[in] pins Pin assignments; the hall sensors, PIR and buttons are captured
+ */
+InputEdgeCapture::InputEdgeCapture(const AnimationPins& pins)
+    : m_queue(),
+      m_pins{pins.sensorLeft, pins.sensorRight, pins.pirSensor, pins.buttonRectangle,
+             pins.buttonCircle},
+      m_pinMask(0),
+      m_sensorLeft(pins.sensorLeft),
+      m_sensorRight(pins.sensorRight),
+      m_planner(nullptr),
+      m_driver(nullptr),
+      m_queueEdges(true),
+      m_limitStops(0)
+{
+    for (uint8_t pin : m_pins)
+    {
+        m_pinMask |= 1UL << pin;
+    }
+}
+
+/**
+ * @brief Destructor - disables the edge interrupts
+ */
+InputEdgeCapture::~InputEdgeCapture()
+{
+    if (s_instance != this)
+    {
+        return;
+    }
+#ifdef ARDUINO_ARCH_RP2040
+    for (uint8_t pin : m_pins)
+    {
+        gpio_set_irq_enabled(pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
+    }
+    gpio_remove_raw_irq_handler_masked(m_pinMask, &InputEdgeCapture::onGpioIrq);
+#endif
+    s_instance = nullptr;
+}
+
+/**
+ * @brief Enable rising and falling edge interrupts on every captured pin
+ */
+void InputEdgeCapture::begin()
+{
+    s_instance = this;
+#ifdef ARDUINO_ARCH_RP2040
+    // A raw handler for these pins only, leaving the shared callback to other pins
+    gpio_add_raw_irq_handler_masked(m_pinMask, &InputEdgeCapture::onGpioIrq);
+    for (uint8_t pin : m_pins)
+    {
+        gpio_set_irq_enabled(pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+    }
+    irq_set_enabled(IO_IRQ_BANK0, true);
+#endif
+}
+
+/**
+ * @brief Stop the neck from the interrupt when it runs into a hall sensor
+ *
+ * @param[in] planner Planner to halt, or nullptr
+ * @param[in] driver Driver to stop, or nullptr
+ */
+void InputEdgeCapture::setLimitStop(MotionPlanner* planner, MotorDriver* driver)
+{
+    m_planner = planner;
+    m_driver = driver;
+}
+
+/**
+ * @brief Record an edge and react to a hall sensor limit
+ *
+ * @param[in] pin GPIO pin
+ * @param[in] level Level after the edge (HIGH/LOW)
+ * @param[in] timeUs Microsecond timer when the edge was taken
+ */
+void InputEdgeCapture::handleEdge(uint8_t pin, uint8_t level, uint32_t timeUs)
+{
+    // The sensors pull low over a magnet, so only a falling edge is a limit
+    if (level == LOW && (pin == m_sensorLeft || pin == m_sensorRight))
+    {
+        stopAtLimit(pin, timeUs);
+    }
+    if (m_queueEdges)
+    {
+        m_queue.push({timeUs, pin, level});
+    }
+}
+
+/**
+ * @brief Stop the neck if it is heading into the hall sensor on a pin
+ *
+ * @param[in] pin GPIO pin that went active
+ * @param[in] timeUs Microsecond timer when the edge was taken
+ *
+ * @note The driver is stopped as well as the planner: the driver picks the stop up on its
+ *       next 1 ms tick, the planner only on its next 5 ms tick. The driver times the
+ *       stop from the edge to that tick.
+ */
+void InputEdgeCapture::stopAtLimit(uint8_t pin, uint32_t timeUs)
+{
+    // Heading is the planned duty, or the applied duty while the planner is at rest
+    int16_t heading = m_planner != nullptr ? m_planner->getOutput() : 0;
+    if (heading == 0 && m_driver != nullptr)
+    {
+        heading = m_driver->getOutput();
+    }
+    if ((pin == m_sensorLeft && heading >= 0) || (pin == m_sensorRight && heading <= 0))
+    {
+        return;
+    }
+
+    if (m_driver != nullptr)
+    {
+        m_driver->stopFromEdge(MotorStop::Brake, timeUs);
+    }
+    if (m_planner != nullptr)
+    {
+        m_planner->halt(MotorStop::Brake);
+    }
+    m_limitStops = m_limitStops + 1;
+}
+
+#ifdef ARDUINO_ARCH_RP2040
+/**
+ * @brief Raw GPIO interrupt handler for the captured pins
+ *
+ * @note A raw handler acknowledges its own events. When both edges are pending the pin
+ *       bounced; its level now is the one to keep.
+ */
+void InputEdgeCapture::onGpioIrq()
+{
+    const uint32_t now = time_us_32();
+    if (s_instance == nullptr)
+    {
+        return;
+    }
+    for (uint8_t gpio : s_instance->m_pins)
+    {
+        const uint32_t events =
+            gpio_get_irq_event_mask(gpio) & (GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
+        if (events == 0)
+        {
+            continue;
+        }
+        gpio_acknowledge_irq(gpio, events);
+        const bool both = (events & GPIO_IRQ_EDGE_RISE) && (events & GPIO_IRQ_EDGE_FALL);
+        const bool high = both ? gpio_get(gpio) : (events & GPIO_IRQ_EDGE_RISE) != 0;
+        s_instance->handleEdge(gpio, high ? HIGH : LOW, now);
+    }
+}
+#endif
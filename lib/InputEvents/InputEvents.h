@@ -0,0 +1,242 @@
+/**
+ * @file InputEvents.h
+ * @brief Interrupt-driven edge capture for the inputs of the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the InputEventQueue, a lock-free single-producer single-consumer
+ * ring of input edges, and the InputEdgeCapture class which fills it from GPIO edge
+ * interrupts on the hall sensors, the PIR and the buttons. Each edge is stamped with
+ * the microsecond timer as the interrupt is taken, so a tap shorter than a loop pass
+ * still reaches Animation, which drains the queue on every logic pass.
+ *
+ * A hall sensor edge is also a hard limit: when the head is heading into the sensor
+ * that just went active, the interrupt stops the MotorDriver and halts the
+ * MotionPlanner at once instead of waiting for the next logic pass. The driver
+ * releases the bridge on its next tick, at most MotorDriverConstants::TICK_US later,
+ * and times every limit stop from the edge to that release.
+ *
+ * The interrupt is a raw GPIO handler for the captured pins only, so the shared GPIO
+ * callback stays free for attachInterrupt() on other pins. On the native build there
+ * are no interrupts; handleEdge() is called directly, as the host simulator does when
+ * its model head crosses a sensor.
+ */
+
+#ifndef Y_SERIES_USB_HUB_INPUT_EVENTS_H
+#define Y_SERIES_USB_HUB_INPUT_EVENTS_H
+
+// System includes
+#include <Arduino.h>
+
+// Project includes
+#include <AnimationPins.h>
+#include <MotionPlanner.h>
+#include <MotorDriver.h>
+
+/**
+ * @brief Contains constants used by the InputEventQueue and InputEdgeCapture classes
+ */
+namespace InputEventsConstants
+{
+constexpr uint8_t QUEUE_CAPACITY = 32;               ///< Edges held, a power of two
+constexpr uint8_t QUEUE_MASK = QUEUE_CAPACITY - 1;  ///< Ring index mask
+constexpr uint8_t CAPTURED_PINS = 5;                ///< Hall sensors, PIR and buttons
+static_assert((QUEUE_CAPACITY & QUEUE_MASK) == 0, "QUEUE_CAPACITY must be a power of two");
+}  // namespace InputEventsConstants
+
+/**
+ * @brief One input edge
+ */
+struct InputEvent
+{
+    uint32_t timeUs;  ///< Microsecond timer when the edge was taken, wraps
+    uint8_t pin;      ///< GPIO pin
+    uint8_t level;    ///< Level after the edge (HIGH/LOW)
+};
+
+/**
+ * @brief Lock-free ring of input edges, pushed by one interrupt and popped by the loop
+ *
+ * @note Only the producer writes the head and only the consumer writes the tail, so
+ *       neither side needs to disable interrupts. A push to a full queue drops the edge
+ *       and counts it.
+ */
+class InputEventQueue
+{
+public:
+    /**
+     * @brief Construct an empty queue
+     */
+    InputEventQueue();
+
+    // Prevent copying and assignment
+    InputEventQueue(const InputEventQueue&) = delete;
+    InputEventQueue& operator=(const InputEventQueue&) = delete;
+
+    /**
+     * @brief Add an edge (producer side)
+     *
+     * @param[in] event Edge to add
+     * @return true if it was queued, false if the queue was full
+     */
+    bool push(const InputEvent& event);
+
+    /**
+     * @brief Take the oldest edge (consumer side)
+     *
+     * @param[out] event Oldest edge, unchanged if the queue is empty
+     * @return true if an edge was taken, false if the queue was empty
+     */
+    bool pop(InputEvent& event);
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Check whether the queue is empty
+     * @return true if there is no edge to pop, false otherwise
+     */
+    bool isEmpty() const { return m_head == m_tail; }
+
+    /**
+     * @brief Get the number of edges waiting
+     * @return uint8_t Edges queued
+     */
+    uint8_t size() const { return static_cast<uint8_t>(m_head - m_tail); }
+
+    /**
+     * @brief Get the number of edges dropped because the queue was full
+     * @return uint32_t Dropped edges since construction
+     */
+    uint32_t getDropped() const { return m_dropped; }
+    /// @}
+
+private:
+    InputEvent m_events[InputEventsConstants::QUEUE_CAPACITY];  ///< Ring storage
+    volatile uint8_t m_head;                                    ///< Next slot to write
+    volatile uint8_t m_tail;                                    ///< Next slot to read
+    volatile uint32_t m_dropped;                                ///< Edges lost to a full queue
+};
+
+/**
+ * @brief Captures input edges from GPIO interrupts and stops the neck at a hall sensor
+ *
+ * @note The interrupt handler finds its capture through a static pointer, so only one
+ *       capture may be active at a time
+ */
+class InputEdgeCapture
+{
+public:
+    /**
+     * @brief Construct a capture for the input pins of a pin configuration
+     *
+     * @param[in] pins Pin assignments; the hall sensors, PIR and buttons are captured
+     */
+    explicit InputEdgeCapture(const AnimationPins& pins);
+
+    /**
+     * @brief Destructor - disables the edge interrupts
+     */
+    ~InputEdgeCapture();
+
+    // Prevent copying and assignment
+    InputEdgeCapture(const InputEdgeCapture&) = delete;
+    InputEdgeCapture& operator=(const InputEdgeCapture&) = delete;
+
+    /**
+     * @brief Enable rising and falling edge interrupts on every captured pin
+     *
+     * @note Call after the pins are configured as inputs
+     */
+    void begin();
+
+    /**
+     * @brief Stop the neck from the interrupt when it runs into a hall sensor
+     *
+     * @param[in] planner Planner to halt, or nullptr
+     * @param[in] driver Driver to stop, or nullptr
+     */
+    void setLimitStop(MotionPlanner* planner, MotorDriver* driver);
+
+    /**
+     * @brief Choose whether edges are queued as well as checked for a limit
+     *
+     * @param[in] enabled false when the edges reach Animation another way, such as
+     *                    through a Debouncer, and only the limit stop is wanted
+     */
+    void setQueueEdges(bool enabled) { m_queueEdges = enabled; }
+
+    /**
+     * @brief Record an edge and react to a hall sensor limit
+     *
+     * @param[in] pin GPIO pin
+     * @param[in] level Level after the edge (HIGH/LOW)
+     * @param[in] timeUs Microsecond timer when the edge was taken
+     *
+     * @note Called from the GPIO interrupt on the RP2040; call it directly on the host
+     */
+    void handleEdge(uint8_t pin, uint8_t level, uint32_t timeUs);
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get the queue the edges are pushed to
+     * @return InputEventQueue& Queue for Animation to drain
+     */
+    InputEventQueue& getQueue() { return m_queue; }
+
+    /**
+     * @brief Get the number of limit stops made from the interrupt
+     * @return uint32_t Limit stops since construction
+     */
+    uint32_t getLimitStops() const { return m_limitStops; }
+
+    /**
+     * @brief Get the time from the last limit edge to the release of the bridge
+     * @return uint32_t Latency (µs), 0 without a driver to stop
+     */
+    uint32_t getLastLimitLatencyUs() const
+    {
+        return m_driver != nullptr ? m_driver->getLastStopLatencyUs() : 0;
+    }
+
+    /**
+     * @brief Get the longest time from a limit edge to the release of the bridge
+     * @return uint32_t Latency (µs), 0 without a driver to stop
+     */
+    uint32_t getMaxLimitLatencyUs() const
+    {
+        return m_driver != nullptr ? m_driver->getMaxStopLatencyUs() : 0;
+    }
+    /// @}
+
+private:
+    /**
+     * @brief Stop the neck if it is heading into the hall sensor on a pin
+     *
+     * @param[in] pin GPIO pin that went active
+     * @param[in] timeUs Microsecond timer when the edge was taken
+     */
+    void stopAtLimit(uint8_t pin, uint32_t timeUs);
+
+#ifdef ARDUINO_ARCH_RP2040
+    /**
+     * @brief Raw GPIO interrupt handler for the captured pins
+     */
+    static void onGpioIrq();
+#endif
+
+    static InputEdgeCapture* s_instance;  ///< Capture the interrupt callback feeds
+
+    InputEventQueue m_queue;                               ///< Captured edges
+    uint8_t m_pins[InputEventsConstants::CAPTURED_PINS];  ///< Pins with edge interrupts
+    uint32_t m_pinMask;                                   ///< Bit per captured pin
+    uint8_t m_sensorLeft;                                 ///< Left hall sensor pin
+    uint8_t m_sensorRight;                                ///< Right hall sensor pin
+    MotionPlanner* m_planner;                             ///< Planner halted at a limit
+    MotorDriver* m_driver;                                ///< Driver stopped at a limit
+    bool m_queueEdges;                                    ///< True to queue every edge
+    volatile uint32_t m_limitStops;                       ///< Stops made at a limit
+};
+
+#endif  // Y_SERIES_USB_HUB_INPUT_EVENTS_H
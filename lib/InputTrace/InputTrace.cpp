@@ -0,0 +1,335 @@
+/**
+ * @file InputTrace.cpp
+ * @brief Implementation of the InputTrace and InputTracePlayer classes for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the ring of input changes recorded on the device, its serial
+ * dump and parser, and the player that steps through a trace on the host.
+ */
+
+#include "InputTrace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+constexpr uint16_t kIndexMask = InputTraceConstants::CAPACITY - 1;
+static_assert((InputTraceConstants::CAPACITY & kIndexMask) == 0,
+              "CAPACITY must be a power of two");
+
+/**
+ * @brief Get the inputs a record flipped
+ *
+ * @param[in] record Record
+ * @return uint8_t AnimationInputBits that flipped, 0 for a gap
+ */
+inline uint8_t recordFlipped(uint16_t record)
+{
+    return static_cast<uint8_t>(record >> InputTraceConstants::DELTA_BITS);
+}
+}  // namespace
+
+/**
+ * @brief Construct an empty trace
+ */
+InputTrace::InputTrace()
+    : m_records(),
+      m_head(0),
+      m_count(0),
+      m_started(false),
+      m_baseTime(0),
+      m_baseLevels(0),
+      m_lastTime(0),
+      m_lastLevels(0),
+      m_overwritten(0),
+      m_requestMatched(0)
+{
+}
+
+/**
+ * @brief Record packed levels if any of them changed
+ *
+ * @param[in] levels Level of each input, one AnimationInputBits bit each
+ * @param[in] timeMs Time of the levels (ms)
+ */
+void InputTrace::record(uint8_t levels, unsigned long timeMs)
+{
+    // Nothing changed on almost every pass, so that check comes first
+    levels &= AnimationInputBits::ALL;
+    const uint8_t flipped = levels ^ m_lastLevels;
+    if (flipped == 0 && m_started)
+    {
+        return;
+    }
+    if (!m_started)
+    {
+        m_started = true;
+        m_baseTime = timeMs;
+        m_baseLevels = levels;
+        m_lastTime = timeMs;
+        m_lastLevels = levels;
+        return;
+    }
+
+    // A spell longer than the time field goes in gap records counted in whole seconds,
+    // so an idle hour costs two records rather than a ring full of them
+    uint32_t gapMs = static_cast<uint32_t>(timeMs - m_lastTime);
+    while (gapMs > InputTraceConstants::MAX_DELTA)
+    {
+        uint32_t units = gapMs / InputTraceConstants::GAP_UNIT_MS;
+        if (units > InputTraceConstants::MAX_DELTA)
+        {
+            units = InputTraceConstants::MAX_DELTA;
+        }
+        push(static_cast<uint16_t>(units));
+        gapMs -= units * InputTraceConstants::GAP_UNIT_MS;
+    }
+    push(static_cast<uint16_t>((flipped << InputTraceConstants::DELTA_BITS) | gapMs));
+    m_lastTime = timeMs;
+    m_lastLevels = levels;
+}
+
+/**
+ * @brief Empty the trace, so the next record() sets a new base
+ */
+void InputTrace::clear()
+{
+    m_head = 0;
+    m_count = 0;
+    m_started = false;
+    m_baseTime = 0;
+    m_baseLevels = 0;
+    m_lastTime = 0;
+    m_lastLevels = 0;
+    m_overwritten = 0;
+}
+
+/**
+ * @brief Parse one byte from the host, looking for a dump request
+ *
+ * @param[in] byte Received byte
+ * @return true once a whole DUMP_REQUEST has been received, false otherwise
+ */
+bool InputTrace::receive(uint8_t byte)
+{
+    // Terminals may send CR LF for the newline
+    if (byte == '\r')
+    {
+        return false;
+    }
+
+    const char* request = InputTraceConstants::DUMP_REQUEST;
+    if (byte == static_cast<uint8_t>(request[m_requestMatched]))
+    {
+        m_requestMatched++;
+        if (request[m_requestMatched] == '\0')
+        {
+            m_requestMatched = 0;
+            return true;
+        }
+        return false;
+    }
+    m_requestMatched = byte == static_cast<uint8_t>(request[0]) ? 1 : 0;
+    return false;
+}
+
+/**
+ * @brief Format one line of the serial dump
+ *
+ * @param[in] line Line number, from 0 for the header
+ * @param[out] buffer Line, newline terminated, at least MIN_LINE_SIZE bytes
+ * @param[in] size Size of the buffer
+ * @return size_t Length of the line, 0 after the END line or if the buffer is small
+ */
+size_t InputTrace::formatDumpLine(uint16_t line, char* buffer, size_t size) const
+{
+    if (buffer == nullptr || size < InputTraceConstants::MIN_LINE_SIZE)
+    {
+        return 0;
+    }
+
+    const uint16_t dataLines = static_cast<uint16_t>(
+        (m_count + InputTraceConstants::RECORDS_PER_LINE - 1) /
+        InputTraceConstants::RECORDS_PER_LINE);
+    int length = 0;
+    if (line == 0)
+    {
+        length = snprintf(buffer, size, "TRACE %u %lu %02X %u\n",
+                          static_cast<unsigned>(InputTraceConstants::FORMAT_VERSION),
+                          static_cast<unsigned long>(m_baseTime),
+                          static_cast<unsigned>(m_baseLevels), static_cast<unsigned>(m_count));
+    }
+    else if (line <= dataLines)
+    {
+        const uint16_t first = (line - 1) * InputTraceConstants::RECORDS_PER_LINE;
+        uint16_t last = first + InputTraceConstants::RECORDS_PER_LINE;
+        if (last > m_count)
+        {
+            last = m_count;
+        }
+        for (uint16_t i = first; i < last; i++)
+        {
+            length += snprintf(buffer + length, size - length, i == first ? "%04X" : " %04X",
+                               static_cast<unsigned>(getRecord(i)));
+        }
+        length += snprintf(buffer + length, size - length, "\n");
+    }
+    else if (line == dataLines + 1)
+    {
+        length = snprintf(buffer, size, "END\n");
+    }
+    return length > 0 ? static_cast<size_t>(length) : 0;
+}
+
+/**
+ * @brief Replace the trace with one parsed from a serial dump
+ *
+ * @param[in] text Dump, as formatDumpLine() writes it; other lines before the header,
+ *                 such as log output, are skipped
+ * @return true if a whole trace was parsed, false otherwise (the trace is then empty)
+ */
+bool InputTrace::parseDump(const char* text)
+{
+    clear();
+    const char* cursor = text;
+    while (cursor != nullptr && strncmp(cursor, "TRACE ", 6) != 0)
+    {
+        cursor = strchr(cursor, '\n');
+        if (cursor != nullptr)
+        {
+            cursor++;
+        }
+    }
+    if (cursor == nullptr)
+    {
+        return false;
+    }
+
+    unsigned version = 0;
+    unsigned long baseTime = 0;
+    unsigned levels = 0;
+    unsigned count = 0;
+    if (sscanf(cursor, "TRACE %u %lu %x %u", &version, &baseTime, &levels, &count) != 4 ||
+        version != InputTraceConstants::FORMAT_VERSION || levels > AnimationInputBits::ALL ||
+        count > InputTraceConstants::CAPACITY)
+    {
+        return false;
+    }
+    cursor = strchr(cursor, '\n');
+    if (cursor == nullptr)
+    {
+        return false;
+    }
+
+    m_baseTime = baseTime;
+    m_baseLevels = static_cast<uint8_t>(levels);
+    m_lastTime = baseTime;
+    m_lastLevels = m_baseLevels;
+    for (unsigned i = 0; i < count; i++)
+    {
+        char* end = nullptr;
+        const unsigned long record = strtoul(cursor, &end, 16);
+        if (end == cursor || record > 0xFFFFUL ||
+            (recordFlipped(static_cast<uint16_t>(record)) & ~AnimationInputBits::ALL) != 0)
+        {
+            clear();
+            return false;
+        }
+        cursor = end;
+        m_records[i] = static_cast<uint16_t>(record);
+        m_lastTime += getRecordDurationMs(m_records[i]);
+        m_lastLevels ^= recordFlipped(m_records[i]);
+    }
+    m_count = static_cast<uint16_t>(count);
+
+    cursor += strspn(cursor, " \r\n");
+    if (strncmp(cursor, "END", 3) != 0)
+    {
+        clear();
+        return false;
+    }
+    m_started = true;
+    return true;
+}
+
+/**
+ * @brief Get a record
+ *
+ * @param[in] index Record index, 0 for the oldest
+ * @return uint16_t Record (flipped mask << DELTA_BITS | time field)
+ */
+uint16_t InputTrace::getRecord(uint16_t index) const
+{
+    return index < m_count ? m_records[(m_head + index) & kIndexMask] : 0;
+}
+
+/**
+ * @brief Get the time a record covers
+ *
+ * @param[in] record Record
+ * @return uint32_t Time since the previous record (ms)
+ */
+uint32_t InputTrace::getRecordDurationMs(uint16_t record)
+{
+    const uint32_t delta = record & InputTraceConstants::MAX_DELTA;
+    return recordFlipped(record) != 0 ? delta : delta * InputTraceConstants::GAP_UNIT_MS;
+}
+
+/**
+ * @brief Add a record, folding the oldest into the base if the ring is full
+ *
+ * @param[in] record Record to add
+ */
+void InputTrace::push(uint16_t record)
+{
+    if (m_count == InputTraceConstants::CAPACITY)
+    {
+        const uint16_t oldest = m_records[m_head];
+        m_baseTime += getRecordDurationMs(oldest);
+        m_baseLevels ^= recordFlipped(oldest);
+        m_head = (m_head + 1) & kIndexMask;
+        m_count--;
+        m_overwritten++;
+    }
+    m_records[(m_head + m_count) & kIndexMask] = record;
+    m_count++;
+}
+
+/**
+ * @brief Construct a player at the start of a trace
+ *
+ * @param[in] trace Trace to play; must outlive the player and stay unchanged
+ */
+InputTracePlayer::InputTracePlayer(const InputTrace& trace)
+    : m_trace(trace),
+      m_durationMs(trace.getEndTime() - trace.getBaseTime()),
+      m_next(0),
+      m_nextTime(trace.size() > 0 ? InputTrace::getRecordDurationMs(trace.getRecord(0)) : 0),
+      m_levels(trace.getBaseLevels())
+{
+}
+
+/**
+ * @brief Get the levels at a time, moving forward through the trace
+ *
+ * @param[in] elapsedMs Time since the start of the trace (ms), not less than on the
+ *                      previous call
+ * @return uint8_t Level of each input, one AnimationInputBits bit each
+ */
+uint8_t InputTracePlayer::levelsAt(unsigned long elapsedMs)
+{
+    while (m_next < m_trace.size() && m_nextTime <= elapsedMs)
+    {
+        m_levels ^= recordFlipped(m_trace.getRecord(m_next));
+        m_next++;
+        if (m_next < m_trace.size())
+        {
+            m_nextTime += InputTrace::getRecordDurationMs(m_trace.getRecord(m_next));
+        }
+    }
+    return m_levels;
+}
@@ -0,0 +1,251 @@
+/**
+ * @file InputTrace.h
+ * @brief Input trace recorder and player for field issues on the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the InputTrace class, a RAM ring of input changes recorded on the
+ * device, and the InputTracePlayer which steps through a trace on the host. A trace
+ * starts from a base time and the levels of every input then; each record after it
+ * holds the time since the previous record and the mask of the inputs that flipped:
+ *
+ * | Bits  | Field                                                           |
+ * |-------|-----------------------------------------------------------------|
+ * | 15-11 | AnimationInputBits that flipped; 0 for a gap with no change     |
+ * | 10-0  | Time since the previous record, in ms, or in s for a gap        |
+ *
+ * Recording compares the packed levels against the last ones and returns at once when
+ * nothing changed, so it can run on every loop pass. When the ring is full the oldest
+ * record is folded into the base, so the trace always covers the most recent changes.
+ *
+ * A trace is dumped over serial as text when the host sends DUMP_REQUEST:
+ *
+ *     TRACE 1 <base time ms> <base levels, hex> <records>
+ *     <up to 16 records as 4 hex digits, separated by spaces>
+ *     ...
+ *     END
+ *
+ * and parsed back on the host by parseDump() for replay in the host simulator.
+ */
+
+#ifndef Y_SERIES_USB_HUB_INPUT_TRACE_H
+#define Y_SERIES_USB_HUB_INPUT_TRACE_H
+
+// System includes
+#include <Arduino.h>
+
+// Project includes
+#include <AnimationInputs.h>
+
+/**
+ * @brief Contains constants used by the InputTrace and InputTracePlayer classes
+ */
+namespace InputTraceConstants
+{
+/// @name Records
+/// @{
+constexpr uint16_t CAPACITY = 4096;                     ///< Records held (8 KB of RAM)
+constexpr uint8_t DELTA_BITS = 11;                      ///< Bits of the time field
+constexpr uint16_t MAX_DELTA = (1U << DELTA_BITS) - 1;  ///< Largest time field
+constexpr uint16_t GAP_UNIT_MS = 1000;                  ///< Time unit of a gap record
+/// @}
+
+/// @name Serial Dump
+/// @{
+constexpr uint8_t FORMAT_VERSION = 1;              ///< Version in the dump header
+constexpr uint8_t RECORDS_PER_LINE = 16;           ///< Records on each dump line
+constexpr size_t MIN_LINE_SIZE = 96;               ///< Buffer needed for one dump line
+constexpr const char* DUMP_REQUEST = "!trace\n";  ///< Sent by the host to ask for a dump
+/// @}
+}  // namespace InputTraceConstants
+
+/**
+ * @brief Ring of input changes, recorded on the device and parsed on the host
+ */
+class InputTrace
+{
+public:
+    /**
+     * @brief Construct an empty trace
+     */
+    InputTrace();
+
+    // Prevent copying and assignment
+    InputTrace(const InputTrace&) = delete;
+    InputTrace& operator=(const InputTrace&) = delete;
+
+    /**
+     * @brief Record the inputs if any of them changed
+     *
+     * The first call only sets the base of the trace.
+     *
+     * @param[in] inputs Snapshot of the inputs
+     */
+    void record(const AnimationInputs& inputs) { record(packInputs(inputs), inputs.currentTime); }
+
+    /**
+     * @brief Record packed levels if any of them changed
+     *
+     * @param[in] levels Level of each input, one AnimationInputBits bit each
+     * @param[in] timeMs Time of the levels (ms)
+     */
+    void record(uint8_t levels, unsigned long timeMs);
+
+    /**
+     * @brief Empty the trace, so the next record() sets a new base
+     */
+    void clear();
+
+    /**
+     * @brief Parse one byte from the host, looking for a dump request
+     *
+     * @param[in] byte Received byte
+     * @return true once a whole DUMP_REQUEST has been received, false otherwise
+     */
+    bool receive(uint8_t byte);
+
+    /**
+     * @brief Format one line of the serial dump
+     *
+     * @param[in] line Line number, from 0 for the header
+     * @param[out] buffer Line, newline terminated, at least MIN_LINE_SIZE bytes
+     * @param[in] size Size of the buffer
+     * @return size_t Length of the line, 0 after the END line or if the buffer is small
+     */
+    size_t formatDumpLine(uint16_t line, char* buffer, size_t size) const;
+
+    /**
+     * @brief Replace the trace with one parsed from a serial dump
+     *
+     * @param[in] text Dump, as formatDumpLine() writes it; other lines before the
+     *                 header, such as log output, are skipped
+     * @return true if a whole trace was parsed, false otherwise (the trace is then empty)
+     */
+    bool parseDump(const char* text);
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Check whether the trace has a base
+     * @return true after the first record() or a parsed dump, false otherwise
+     */
+    bool isStarted() const { return m_started; }
+
+    /**
+     * @brief Get the number of records held
+     * @return uint16_t Records, oldest first
+     */
+    uint16_t size() const { return m_count; }
+
+    /**
+     * @brief Get a record
+     *
+     * @param[in] index Record index, 0 for the oldest
+     * @return uint16_t Record (flipped mask << DELTA_BITS | time field)
+     */
+    uint16_t getRecord(uint16_t index) const;
+
+    /**
+     * @brief Get the time the trace starts from
+     * @return unsigned long Base time (ms)
+     */
+    unsigned long getBaseTime() const { return m_baseTime; }
+
+    /**
+     * @brief Get the levels the trace starts from
+     * @return uint8_t Level of each input at the base time, one AnimationInputBits bit each
+     */
+    uint8_t getBaseLevels() const { return m_baseLevels; }
+
+    /**
+     * @brief Get the time of the newest record
+     * @return unsigned long Time (ms), the base time if there are no records
+     */
+    unsigned long getEndTime() const { return m_lastTime; }
+
+    /**
+     * @brief Get the number of records folded into the base because the ring was full
+     * @return uint32_t Records lost since construction or clear()
+     */
+    uint32_t getOverwritten() const { return m_overwritten; }
+    /// @}
+
+    /**
+     * @brief Get the time a record covers
+     *
+     * @param[in] record Record
+     * @return uint32_t Time since the previous record (ms)
+     */
+    static uint32_t getRecordDurationMs(uint16_t record);
+
+private:
+    /**
+     * @brief Add a record, folding the oldest into the base if the ring is full
+     *
+     * @param[in] record Record to add
+     */
+    void push(uint16_t record);
+
+    uint16_t m_records[InputTraceConstants::CAPACITY];  ///< Ring storage
+    uint16_t m_head;                                    ///< Index of the oldest record
+    uint16_t m_count;                                   ///< Records held
+    bool m_started;                                     ///< True once the base is set
+    unsigned long m_baseTime;                           ///< Time before the oldest record
+    uint8_t m_baseLevels;                               ///< Levels at the base time
+    unsigned long m_lastTime;                           ///< Time of the newest record
+    uint8_t m_lastLevels;                               ///< Levels after the newest record
+    uint32_t m_overwritten;                             ///< Records folded into the base
+    uint8_t m_requestMatched;                           ///< DUMP_REQUEST bytes matched
+};
+
+/**
+ * @brief Steps through a trace in time, as a replay driver needs it
+ */
+class InputTracePlayer
+{
+public:
+    /**
+     * @brief Construct a player at the start of a trace
+     *
+     * @param[in] trace Trace to play; must outlive the player and stay unchanged
+     */
+    explicit InputTracePlayer(const InputTrace& trace);
+
+    // Prevent copying and assignment
+    InputTracePlayer(const InputTracePlayer&) = delete;
+    InputTracePlayer& operator=(const InputTracePlayer&) = delete;
+
+    /**
+     * @brief Get the levels at a time, moving forward through the trace
+     *
+     * @param[in] elapsedMs Time since the start of the trace (ms), not less than on the
+     *                      previous call
+     * @return uint8_t Level of each input, one AnimationInputBits bit each
+     */
+    uint8_t levelsAt(unsigned long elapsedMs);
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get the length of the trace
+     * @return unsigned long Time from the base to the newest record (ms)
+     */
+    unsigned long getDurationMs() const { return m_durationMs; }
+
+    /**
+     * @brief Get the number of records played so far
+     * @return uint16_t Records applied
+     */
+    uint16_t getPlayed() const { return m_next; }
+    /// @}
+
+private:
+    const InputTrace& m_trace;   ///< Trace being played
+    unsigned long m_durationMs;  ///< Length of the trace
+    uint16_t m_next;             ///< Next record to apply
+    unsigned long m_nextTime;    ///< Time of the next record, from the start
+    uint8_t m_levels;            ///< Levels after the records applied
+};
+
+#endif  // Y_SERIES_USB_HUB_INPUT_TRACE_H
@@ -0,0 +1,327 @@
+/**
+ * @file LedStrips.cpp
+ * @brief Implementation of the LedStrips class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements parallel WS2812 output. On the RP2040 each strip runs the
+ * standard ws2812 PIO program on its own state machine and is fed by a dedicated
+ * DMA channel; all channels are triggered with a single register write. The native
+ * backend copies each frame into a per-strip record instead.
+ */
+
+#include "LedStrips.h"
+
+#include <algorithm>  // For std::max
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/clocks.h>
+#include <hardware/dma.h>
+#endif
+
+#include <Logger.h>
+
+#ifdef ARDUINO_ARCH_RP2040
+namespace
+{
+/// @name ws2812 PIO Program
+/// @{
+constexpr uint8_t WS2812_T1 = 2;  ///< Cycles of the leading high pulse
+constexpr uint8_t WS2812_T2 = 5;  ///< Cycles of the data-dependent middle section
+constexpr uint8_t WS2812_T3 = 3;  ///< Cycles of the trailing low section
+
+// Assembled ws2812 program from the pico-examples repository (side-set 1, wrap 0..3):
+//   0: out x, 1        side 0 [2]
+//   1: jmp !x, 3       side 1 [1]
+//   2: jmp 0           side 1 [4]
+//   3: nop             side 0 [4]
+const uint16_t kWs2812Instructions[] = {0x6221, 0x1123, 0x1400, 0xa442};
+const pio_program_t kWs2812Program = {kWs2812Instructions, 4, -1};
+/// @}
+
+/**
+ * @brief Load the ws2812 program into a PIO block once and return its offset
+ *
+ * @param[in] pio PIO block to load the program into
+ * @return int Program offset, or -1 if the block has no instruction memory left
+ */
+int loadProgram(PIO pio)
+{
+    static int offsets[2] = {-1, -1};
+    const uint index = pio_get_index(pio);
+    if (offsets[index] < 0 && pio_can_add_program(pio, &kWs2812Program))
+    {
+        offsets[index] = pio_add_program(pio, &kWs2812Program);
+    }
+    return offsets[index];
+}
+}  // namespace
+#endif
+
+/**
+ * @brief Construct an empty strip set
+ */
+LedStrips::LedStrips()
+    : m_numStrips(0),
+      m_maxPixels(0),
+      m_droppedFrames(0)
+#ifdef ARDUINO_ARCH_RP2040
+      ,
+      m_dmaMask(0),
+      m_frameStartUs(0),
+      m_started(false)
+#endif
+{
+    for (uint8_t s = 0; s < LedStripsConstants::MAX_STRIPS; s++)
+    {
+        m_strips[s].pin = 0;
+        m_strips[s].numPixels = 0;
+        m_strips[s].frameCount = 0;
+        for (uint16_t i = 0; i < LedStripsConstants::MAX_PIXELS_PER_STRIP; i++)
+        {
+            m_strips[s].pixels[i] = 0;
+#ifdef ARDUINO_ARCH_RP2040
+            m_strips[s].wire[i] = 0;
+#else
+            m_strips[s].shown[i] = 0;
+#endif
+        }
+    }
+}
+
+/**
+ * @brief Register a strip on the given data pin
+ *
+ * @param[in] pin GPIO pin connected to the strip's data input
+ * @param[in] numPixels Number of pixels on the strip
+ * @return int8_t Index of the new strip, or -1 if no slot is available
+ */
+int8_t LedStrips::addStrip(uint8_t pin, uint16_t numPixels)
+{
+    if (m_numStrips >= LedStripsConstants::MAX_STRIPS)
+    {
+        Log.error("Cannot add strip on pin %d: all %d slots in use", pin,
+                  LedStripsConstants::MAX_STRIPS);
+        return -1;
+    }
+    if (numPixels == 0 || numPixels > LedStripsConstants::MAX_PIXELS_PER_STRIP)
+    {
+        Log.error("Invalid strip length %d (valid: 1-%d)", numPixels,
+                  LedStripsConstants::MAX_PIXELS_PER_STRIP);
+        return -1;
+    }
+
+    Strip& strip = m_strips[m_numStrips];
+    strip.pin = pin;
+    strip.numPixels = numPixels;
+    m_maxPixels = std::max(m_maxPixels, numPixels);
+
+    Log.info("Added strip %d on pin %d with %d pixels", m_numStrips, pin, numPixels);
+    return static_cast<int8_t>(m_numStrips++);
+}
+
+/**
+ * @brief Claim the PIO state machines and DMA channels for all strips
+ *
+ * @return true if every strip was configured
+ * @return false if the hardware ran out of state machines or DMA channels
+ */
+bool LedStrips::begin()
+{
+#ifdef ARDUINO_ARCH_RP2040
+    const float clockDivider =
+        static_cast<float>(clock_get_hz(clk_sys)) /
+        (LedStripsConstants::BIT_RATE_HZ * (WS2812_T1 + WS2812_T2 + WS2812_T3));
+
+    for (uint8_t s = 0; s < m_numStrips; s++)
+    {
+        Strip& strip = m_strips[s];
+
+        // Prefer pio0, fall back to pio1 once its four state machines are taken
+        strip.pio = pio0;
+        int sm = pio_claim_unused_sm(pio0, false);
+        if (sm < 0)
+        {
+            strip.pio = pio1;
+            sm = pio_claim_unused_sm(pio1, false);
+        }
+        const int offset = sm < 0 ? -1 : loadProgram(strip.pio);
+        if (sm < 0 || offset < 0)
+        {
+            Log.error("No PIO state machine available for strip %d", s);
+            return false;
+        }
+        strip.sm = static_cast<uint>(sm);
+
+        // Configure the state machine to shift out 24 bits per pixel, MSB first
+        pio_gpio_init(strip.pio, strip.pin);
+        pio_sm_set_consecutive_pindirs(strip.pio, strip.sm, strip.pin, 1, true);
+        pio_sm_config config = pio_get_default_sm_config();
+        sm_config_set_wrap(&config, offset, offset + 3);
+        sm_config_set_sideset(&config, 1, false, false);
+        sm_config_set_sideset_pins(&config, strip.pin);
+        sm_config_set_out_shift(&config, false, true, 24);
+        sm_config_set_fifo_join(&config, PIO_FIFO_JOIN_TX);
+        sm_config_set_clkdiv(&config, clockDivider);
+        pio_sm_init(strip.pio, strip.sm, offset, &config);
+        pio_sm_set_enabled(strip.pio, strip.sm, true);
+
+        // Pace a DMA channel on the state machine's TX FIFO
+        strip.dma = dma_claim_unused_channel(false);
+        if (strip.dma < 0)
+        {
+            Log.error("No DMA channel available for strip %d", s);
+            return false;
+        }
+        dma_channel_config dmaConfig = dma_channel_get_default_config(strip.dma);
+        channel_config_set_transfer_data_size(&dmaConfig, DMA_SIZE_32);
+        channel_config_set_read_increment(&dmaConfig, true);
+        channel_config_set_write_increment(&dmaConfig, false);
+        channel_config_set_dreq(&dmaConfig, pio_get_dreq(strip.pio, strip.sm, true));
+        dma_channel_configure(strip.dma, &dmaConfig, &strip.pio->txf[strip.sm], strip.wire,
+                              strip.numPixels, false);
+        m_dmaMask |= 1u << strip.dma;
+    }
+#endif
+
+    Log.info("LedStrips started with %d strips", m_numStrips);
+    return true;
+}
+
+/**
+ * @brief Set a pixel in a strip's render buffer
+ *
+ * @param[in] strip Strip index
+ * @param[in] pixel Pixel index within the strip
+ * @param[in] color 32-bit color value (0x00RRGGBB)
+ */
+void LedStrips::setPixelColor(uint8_t strip, uint16_t pixel, uint32_t color)
+{
+    if (strip >= m_numStrips || pixel >= m_strips[strip].numPixels)
+    {
+        return;  // Safety check
+    }
+    m_strips[strip].pixels[pixel] = color & 0x00FFFFFF;
+}
+
+/**
+ * @brief Read a pixel back from a strip's render buffer
+ *
+ * @param[in] strip Strip index
+ * @param[in] pixel Pixel index within the strip
+ * @return uint32_t Color value (0x00RRGGBB), or 0 if out of range
+ */
+uint32_t LedStrips::getPixelColor(uint8_t strip, uint16_t pixel) const
+{
+    if (strip >= m_numStrips || pixel >= m_strips[strip].numPixels)
+    {
+        return 0;
+    }
+    return m_strips[strip].pixels[pixel];
+}
+
+/**
+ * @brief Set every pixel of a strip to the same color
+ *
+ * @param[in] strip Strip index
+ * @param[in] color 32-bit color value (0x00RRGGBB)
+ */
+void LedStrips::fill(uint8_t strip, uint32_t color)
+{
+    if (strip >= m_numStrips)
+    {
+        return;
+    }
+    for (uint16_t i = 0; i < m_strips[strip].numPixels; i++)
+    {
+        m_strips[strip].pixels[i] = color & 0x00FFFFFF;
+    }
+}
+
+/**
+ * @brief Turn off every pixel of every strip
+ */
+void LedStrips::clear()
+{
+    for (uint8_t s = 0; s < m_numStrips; s++)
+    {
+        fill(s, 0);
+    }
+}
+
+/**
+ * @brief Check whether a frame is still being transmitted or latched
+ *
+ * @return true if show() would currently drop a frame
+ */
+bool LedStrips::isBusy() const
+{
+#ifdef ARDUINO_ARCH_RP2040
+    if (!m_started)
+    {
+        return false;
+    }
+    for (uint8_t s = 0; s < m_numStrips; s++)
+    {
+        if (dma_channel_is_busy(m_strips[s].dma))
+        {
+            return true;
+        }
+    }
+
+    // The FIFO drains after DMA completes, then the line must idle low to latch
+    const uint32_t frameTimeUs = m_maxPixels * LedStripsConstants::US_PER_PIXEL +
+                                 LedStripsConstants::LATCH_TIME_US;
+    return (micros() - m_frameStartUs) < frameTimeUs;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Start transmitting the render buffers of all strips
+ *
+ * @return true if the frame was started
+ * @return false if the previous frame is still being transmitted
+ */
+bool LedStrips::show()
+{
+    if (m_numStrips == 0)
+    {
+        return false;
+    }
+    if (isBusy())
+    {
+        m_droppedFrames++;
+        return false;
+    }
+
+    for (uint8_t s = 0; s < m_numStrips; s++)
+    {
+        Strip& strip = m_strips[s];
+#ifdef ARDUINO_ARCH_RP2040
+        // Convert 0x00RRGGBB into left-aligned GRB words for the state machine
+        for (uint16_t i = 0; i < strip.numPixels; i++)
+        {
+            const uint32_t c = strip.pixels[i];
+            strip.wire[i] = ((c & 0x00FF00) << 16) | (c & 0xFF0000) | ((c & 0x0000FF) << 8);
+        }
+        dma_channel_set_read_addr(strip.dma, strip.wire, false);
+        dma_channel_set_trans_count(strip.dma, strip.numPixels, false);
+#else
+        for (uint16_t i = 0; i < strip.numPixels; i++)
+        {
+            strip.shown[i] = strip.pixels[i];
+        }
+#endif
+        strip.frameCount++;
+    }
+
+#ifdef ARDUINO_ARCH_RP2040
+    // Kick every channel in the same cycle so the strips refresh in parallel
+    dma_start_channel_mask(m_dmaMask);
+    m_frameStartUs = micros();
+    m_started = true;
+#endif
+    return true;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file LedStrips.h
+ * @brief Parallel multi-strip NeoPixel output for the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the LedStrips class which drives several independent WS2812
+ * strips at once, for example one accent strip per lightsaber port. On the RP2040
+ * every strip gets its own PIO state machine fed by its own DMA channel, and all
+ * channels are started together so a refresh takes as long as the longest strip
+ * rather than the sum of all strips.
+ *
+ * On the native build there is no PIO; the backend records the last frame shown
+ * on every strip so tests can inspect exactly what would have been transmitted.
+ */
+
+#ifndef Y_SERIES_USB_HUB_LED_STRIPS_H
+#define Y_SERIES_USB_HUB_LED_STRIPS_H
+
+// System includes
+#include <Arduino.h>
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/pio.h>
+#endif
+
+/**
+ * @brief Contains constants used by the LedStrips class
+ */
+namespace LedStripsConstants
+{
+/// @name Capacity
+/// @{
+constexpr uint8_t MAX_STRIPS = 4;              ///< One accent strip per lightsaber port
+constexpr uint16_t MAX_PIXELS_PER_STRIP = 32;  ///< Pixel buffer size reserved per strip
+/// @}
+
+/// @name WS2812 Timing
+/// @{
+constexpr uint32_t BIT_RATE_HZ = 800000;  ///< Data rate of the WS2812 protocol
+constexpr uint32_t US_PER_PIXEL = 30;     ///< 24 bits at 800 kHz
+constexpr uint32_t LATCH_TIME_US = 300;   ///< Low time needed to latch a frame
+/// @}
+}  // namespace LedStripsConstants
+
+/**
+ * @brief Drives several NeoPixel strips in parallel
+ *
+ * @details
+ * Pixels are written into a per-strip render buffer with setPixelColor(). show()
+ * converts every strip into its wire format and starts all transfers at once, so
+ * the render buffers can be modified again immediately while the previous frame
+ * is still being clocked out.
+ */
+class LedStrips
+{
+public:
+    /// @name Construction and Initialization
+    /// @{
+
+    /**
+     * @brief Construct an empty strip set
+     */
+    LedStrips();
+
+    // Prevent copying and assignment
+    LedStrips(const LedStrips&) = delete;
+    LedStrips& operator=(const LedStrips&) = delete;
+
+    /**
+     * @brief Register a strip on the given data pin
+     *
+     * @param[in] pin GPIO pin connected to the strip's data input
+     * @param[in] numPixels Number of pixels on the strip
+     * @return int8_t Index of the new strip, or -1 if no slot is available
+     *
+     * @note Strips must be added before begin()
+     */
+    int8_t addStrip(uint8_t pin, uint16_t numPixels);
+
+    /**
+     * @brief Claim the PIO state machines and DMA channels for all strips
+     *
+     * @return true if every strip was configured
+     * @return false if the hardware ran out of state machines or DMA channels
+     */
+    bool begin();
+
+    /// @}
+
+    /// @name Pixel Access
+    /// @{
+
+    /**
+     * @brief Set a pixel in a strip's render buffer
+     *
+     * @param[in] strip Strip index
+     * @param[in] pixel Pixel index within the strip
+     * @param[in] color 32-bit color value (0x00RRGGBB)
+     */
+    void setPixelColor(uint8_t strip, uint16_t pixel, uint32_t color);
+
+    /**
+     * @brief Read a pixel back from a strip's render buffer
+     *
+     * @param[in] strip Strip index
+     * @param[in] pixel Pixel index within the strip
+     * @return uint32_t Color value (0x00RRGGBB), or 0 if out of range
+     */
+    uint32_t getPixelColor(uint8_t strip, uint16_t pixel) const;
+
+    /**
+     * @brief Set every pixel of a strip to the same color
+     *
+     * @param[in] strip Strip index
+     * @param[in] color 32-bit color value (0x00RRGGBB)
+     */
+    void fill(uint8_t strip, uint32_t color);
+
+    /**
+     * @brief Turn off every pixel of every strip
+     */
+    void clear();
+
+    /// @}
+
+    /// @name Output
+    /// @{
+
+    /**
+     * @brief Start transmitting the render buffers of all strips
+     *
+     * @return true if the frame was started
+     * @return false if the previous frame is still being transmitted
+     *
+     * @note This never blocks; a frame that arrives while busy is dropped
+     */
+    bool show();
+
+    /**
+     * @brief Check whether a frame is still being transmitted or latched
+     *
+     * @return true if show() would currently drop a frame
+     */
+    bool isBusy() const;
+
+    /// @}
+
+    /// @name State Queries
+    /// @{
+
+    /**
+     * @brief Get the number of registered strips
+     * @return Number of strips added with addStrip()
+     */
+    uint8_t numStrips() const { return m_numStrips; }
+
+    /**
+     * @brief Get the number of pixels on a strip
+     * @param[in] strip Strip index
+     * @return Number of pixels, or 0 if the index is invalid
+     */
+    uint16_t numPixels(uint8_t strip) const
+    {
+        return strip < m_numStrips ? m_strips[strip].numPixels : 0;
+    }
+
+    /**
+     * @brief Get the number of frames shown on a strip
+     * @param[in] strip Strip index
+     * @return Number of frames started on the strip since construction
+     */
+    uint32_t getFrameCount(uint8_t strip) const
+    {
+        return strip < m_numStrips ? m_strips[strip].frameCount : 0;
+    }
+
+    /**
+     * @brief Get the number of frames dropped because the strips were busy
+     * @return Number of show() calls that returned false
+     */
+    uint32_t getDroppedFrames() const { return m_droppedFrames; }
+
+#ifndef ARDUINO_ARCH_RP2040
+    /**
+     * @brief Get the last frame recorded for a strip (native backend only)
+     *
+     * @param[in] strip Strip index
+     * @return const uint32_t* Colors (0x00RRGGBB) of the last frame, or nullptr
+     */
+    const uint32_t* getLastFrame(uint8_t strip) const
+    {
+        return strip < m_numStrips ? m_strips[strip].shown : nullptr;
+    }
+#endif
+
+    /// @}
+
+private:
+    /**
+     * @brief Per-strip configuration and buffers
+     */
+    struct Strip
+    {
+        uint8_t pin;                                                ///< Data pin
+        uint16_t numPixels;                                         ///< Pixels on the strip
+        uint32_t frameCount;                                        ///< Frames started
+        uint32_t pixels[LedStripsConstants::MAX_PIXELS_PER_STRIP];  ///< Render buffer
+#ifdef ARDUINO_ARCH_RP2040
+        PIO pio;                                                  ///< PIO block for the strip
+        uint sm;                                                  ///< State machine index
+        int dma;                                                  ///< DMA channel feeding it
+        uint32_t wire[LedStripsConstants::MAX_PIXELS_PER_STRIP];  ///< GRB words read by DMA
+#else
+        uint32_t shown[LedStripsConstants::MAX_PIXELS_PER_STRIP];  ///< Last recorded frame
+#endif
+    };
+
+    /// @name Member Variables
+    /// @{
+    Strip m_strips[LedStripsConstants::MAX_STRIPS];  ///< Registered strips
+    uint8_t m_numStrips;                             ///< Number of registered strips
+    uint16_t m_maxPixels;                            ///< Length of the longest strip
+    uint32_t m_droppedFrames;                        ///< Frames dropped while busy
+#ifdef ARDUINO_ARCH_RP2040
+    uint32_t m_dmaMask;       ///< Mask of all DMA channels, started together
+    uint32_t m_frameStartUs;  ///< When the current frame was started
+    bool m_started;           ///< True once the first frame has been started
+#endif
+    /// @}
+};
+
+#endif  // Y_SERIES_USB_HUB_LED_STRIPS_H
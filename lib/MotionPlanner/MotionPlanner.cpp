@@ -0,0 +1,388 @@
+/**
+ * @file MotionPlanner.cpp
+ * @brief Implementation of the MotionPlanner class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the MotionPlanner class which steps S-curve speed ramps from a
+ * hardware repeating timer and hands the resulting duty to the MotorDriver.
+ */
+
+#include "MotionPlanner.h"
+
+#include <algorithm>  // For std::min, std::max
+
+namespace
+{
+// Command word layout: mode in the top two bits, then the direction, the duty, the
+// sequence number and the move distance in DISTANCE_UNITs
+constexpr uint8_t MODE_SHIFT = 30;
+constexpr uint32_t REVERSE_BIT = 1UL << 29;
+constexpr uint8_t DUTY_SHIFT = 21;
+constexpr uint8_t SEQUENCE_SHIFT = MotionPlannerConstants::DISTANCE_BITS;
+constexpr uint32_t SEQUENCE_MASK = ((1UL << MotionPlannerConstants::SEQUENCE_BITS) - 1)
+                                   << SEQUENCE_SHIFT;
+constexpr uint32_t DISTANCE_MASK = (1UL << SEQUENCE_SHIFT) - 1;
+static_assert(SEQUENCE_SHIFT + MotionPlannerConstants::SEQUENCE_BITS == DUTY_SHIFT,
+              "The sequence number must fill the bits between the distance and the duty");
+
+// Forces the first tick to apply whatever command is pending
+constexpr uint32_t NO_COMMAND = 0xFFFFFFFF;
+}  // namespace
+
+/**
+ * @brief Construct a new motion planner
+ *
+ * @param[in] driver H-bridge driver the duty is written to
+ * @param[in] minDuty Lowest duty the motor turns at, 0 for none
+ */
+MotionPlanner::MotionPlanner(MotorDriver& driver, uint8_t minDuty)
+    : m_driver(driver),
+      m_minDuty(minDuty),
+#ifdef ARDUINO_ARCH_RP2040
+      m_timer(),
+#endif
+      m_started(false),
+      m_pending(packCommand(MotionMode::Halt, 0, 0)),
+      m_haltPending(0),
+      m_sequence(0),
+      m_active(NO_COMMAND),
+      m_mode(MotionMode::Halt),
+      m_target(0),
+      m_speed(0),
+      m_rampFrom(0),
+      m_rampDelta(0),
+      m_rampTicks(0),
+      m_rampTick(0),
+      m_phase(0),
+      m_phaseStep(0),
+      m_remaining(0),
+      m_decelerating(false),
+      m_output(0)
+{
+}
+
+/**
+ * @brief Destructor - stops the timer
+ */
+MotionPlanner::~MotionPlanner()
+{
+#ifdef ARDUINO_ARCH_RP2040
+    if (m_started)
+    {
+        cancel_repeating_timer(&m_timer);
+    }
+#endif
+}
+
+/**
+ * @brief Start the repeating timer
+ *
+ * @return true if the timer was started, false otherwise
+ */
+bool MotionPlanner::begin()
+{
+#ifdef ARDUINO_ARCH_RP2040
+    // Negative interval keeps the ticks evenly spaced regardless of callback time
+    m_started = add_repeating_timer_us(
+        -static_cast<int64_t>(MotionPlannerConstants::TICK_US),
+        [](repeating_timer_t* rt) -> bool
+        {
+            static_cast<MotionPlanner*>(rt->user_data)->tick();
+            return true;
+        },
+        this, &m_timer);
+    if (!m_started)
+    {
+        Log.error("Failed to start motion planner timer");
+    }
+#else
+    m_started = true;
+#endif
+    return m_started;
+}
+
+/**
+ * @brief Ramp to a speed and hold it
+ *
+ * @param[in] duty Target duty, positive to the right (IN2), negative to the left (IN1)
+ */
+void MotionPlanner::setSpeed(int16_t duty)
+{
+    publish(packCommand(MotionMode::Speed, duty, 0));
+}
+
+/**
+ * @brief Travel a distance and stop at its end
+ *
+ * @param[in] distance Duty-milliseconds to travel, positive to the right
+ * @param[in] cruiseDuty Highest duty to use on the way
+ */
+void MotionPlanner::moveBy(int32_t distance, uint8_t cruiseDuty)
+{
+    const uint32_t magnitude = std::min(static_cast<uint32_t>(distance < 0 ? -distance : distance),
+                                        MotionPlannerConstants::MAX_DISTANCE);
+    const uint32_t units = (magnitude + MotionPlannerConstants::DISTANCE_UNIT / 2) /
+                           MotionPlannerConstants::DISTANCE_UNIT;
+    const int16_t duty = distance < 0 ? -static_cast<int16_t>(cruiseDuty) : cruiseDuty;
+    publish(packCommand(MotionMode::Move, duty, units));
+}
+
+/**
+ * @brief Pack a command word: mode, direction, duty and move distance
+ *
+ * @param[in] mode Command
+ * @param[in] duty Target or cruise duty, negative to the left
+ * @param[in] distanceUnits Move distance in DISTANCE_UNITs
+ * @return uint32_t Command word
+ */
+uint32_t MotionPlanner::packCommand(MotionMode mode, int16_t duty, uint32_t distanceUnits)
+{
+    const uint32_t magnitude =
+        std::min<uint32_t>(duty < 0 ? -duty : duty, MotionPlannerConstants::MAX_DUTY);
+    return (static_cast<uint32_t>(mode) << MODE_SHIFT) | (duty < 0 ? REVERSE_BIT : 0) |
+           (magnitude << DUTY_SHIFT) | (distanceUnits & DISTANCE_MASK);
+}
+
+/**
+ * @brief Stamp a command word with the next sequence number and hand it to the timer
+ *
+ * @param[in] command Packed command word without a sequence number
+ */
+void MotionPlanner::publish(uint32_t command)
+{
+    m_sequence = static_cast<uint8_t>((m_sequence + 1) &
+                                      ((1U << MotionPlannerConstants::SEQUENCE_BITS) - 1));
+    m_pending = command | (static_cast<uint32_t>(m_sequence) << SEQUENCE_SHIFT);
+}
+
+/**
+ * @brief Load a newly published command into the tick state
+ *
+ * @param[in] command Packed command word
+ *
+ * @note A ramp in progress is dropped; the next stage starts from the current speed
+ */
+void MotionPlanner::applyCommand(uint32_t command)
+{
+    // The speed already being held or ramped to keeps its ramp, so the main loop can
+    // repeat it on every pass; after a halt the mode is Halt and it starts again
+    const bool sameSpeed =
+        m_mode == MotionMode::Speed && ((command ^ m_active) & ~SEQUENCE_MASK) == 0;
+    m_active = command;
+    if (sameSpeed)
+    {
+        return;
+    }
+    m_mode = static_cast<MotionMode>(command >> MODE_SHIFT);
+    const int32_t duty = static_cast<int32_t>((command >> DUTY_SHIFT) & 0xFF)
+                         << MotionPlannerConstants::SPEED_SHIFT;
+    m_target = (command & REVERSE_BIT) ? -duty : duty;
+    m_rampTicks = 0;
+
+    if (m_mode == MotionMode::Halt)
+    {
+        m_target = 0;
+        m_speed = 0;
+    }
+    else if (m_mode == MotionMode::Move)
+    {
+        m_remaining = static_cast<int32_t>((command & DISTANCE_MASK) *
+                                           MotionPlannerConstants::DISTANCE_UNIT);
+        m_decelerating = false;
+    }
+}
+
+/**
+ * @brief Advance the profile by one control period and update the driver
+ */
+void MotionPlanner::tick()
+{
+    const uint8_t haltRest = m_haltPending;
+    if (haltRest != 0)
+    {
+        m_haltPending = 0;
+        m_mode = MotionMode::Halt;
+        m_target = 0;
+        m_speed = 0;
+        m_rampTicks = 0;
+        m_output = 0;
+        m_driver.stop(static_cast<MotorStop>(haltRest - 1));
+    }
+
+    const uint32_t command = m_pending;
+    if (command != m_active)
+    {
+        applyCommand(command);
+    }
+
+    // A move ramps down once the rest of it is what stopping takes
+    if (m_mode == MotionMode::Move && !m_decelerating && m_remaining <= stoppingDistance())
+    {
+        m_decelerating = true;
+        m_target = 0;
+        m_rampTicks = 0;
+    }
+
+    if (m_rampTicks == 0 && m_speed != m_target)
+    {
+        planStage();
+    }
+
+    if (m_rampTicks != 0)
+    {
+        if (++m_rampTick >= m_rampTicks)
+        {
+            m_speed = m_rampFrom + m_rampDelta;
+            m_rampTicks = 0;
+        }
+        else
+        {
+            // Interpolate the S-curve between its segment boundaries
+            m_phase += m_phaseStep;
+            const uint32_t index = m_phase >> 8;
+            const int32_t low = MotionPlannerConstants::S_CURVE[index];
+            const int32_t high = MotionPlannerConstants::S_CURVE[index + 1];
+            const int32_t fraction = static_cast<int32_t>(m_phase & 0xFF);
+            const int32_t shape = low + (((high - low) * fraction) >> 8);
+            const int64_t change = static_cast<int64_t>(m_rampDelta) * shape;
+            m_speed =
+                m_rampFrom + static_cast<int32_t>(change >> MotionPlannerConstants::CURVE_SHIFT);
+        }
+    }
+
+    int16_t duty = static_cast<int16_t>((m_speed + 128) >> MotionPlannerConstants::SPEED_SHIFT);
+    if (duty != 0 && (duty < 0 ? -duty : duty) < m_minDuty)
+    {
+        duty = duty < 0 ? -m_minDuty : m_minDuty;
+    }
+
+    if (m_mode == MotionMode::Move && duty != 0)
+    {
+        if (m_remaining <= 0)
+        {
+            // The move has covered its distance: stop here
+            m_target = 0;
+            m_speed = 0;
+            m_rampTicks = 0;
+            duty = 0;
+        }
+        else
+        {
+            m_remaining -= (duty < 0 ? -duty : duty) * MotionPlannerConstants::TICK_MS;
+        }
+    }
+
+    writeOutput(duty);
+}
+
+/**
+ * @brief Start the next stage toward the target speed
+ *
+ * @details
+ * Starting from rest steps straight to the minimum duty. Stopping or reversing ramps
+ * down to the minimum duty and then steps to zero; a reversal continues from rest on
+ * a later tick, and a move creeps at the minimum until its distance is covered.
+ * Otherwise the stage is one ramp to the target.
+ */
+void MotionPlanner::planStage()
+{
+    const int32_t minSpeed = static_cast<int32_t>(m_minDuty) << MotionPlannerConstants::SPEED_SHIFT;
+    if (m_speed == 0)
+    {
+        m_speed = m_target > 0 ? minSpeed : -minSpeed;
+    }
+
+    const bool stopping =
+        m_speed != 0 && (m_target == 0 || (m_target > 0) != (m_speed > 0));
+    if (stopping)
+    {
+        const int32_t slowest = m_speed > 0 ? minSpeed : -minSpeed;
+        if (m_speed == slowest && m_mode == MotionMode::Move && m_remaining > 0)
+        {
+            return;  // Creep the rest of the move at the minimum duty
+        }
+        if (m_speed == slowest)
+        {
+            m_speed = 0;
+        }
+        else
+        {
+            startRamp(slowest);
+        }
+        return;
+    }
+
+    int32_t to = m_target;
+    if ((to < 0 ? -to : to) < minSpeed)
+    {
+        to = to < 0 ? -minSpeed : minSpeed;
+    }
+    if (to != m_speed)
+    {
+        startRamp(to);
+    }
+}
+
+/**
+ * @brief Start an S-curve from the current speed to a new one
+ *
+ * @param[in] toQ8 Speed at the end of the ramp (Q8)
+ */
+void MotionPlanner::startRamp(int32_t toQ8)
+{
+    m_rampFrom = m_speed;
+    m_rampDelta = toQ8 - m_speed;
+    const uint32_t magnitude = static_cast<uint32_t>(m_rampDelta < 0 ? -m_rampDelta : m_rampDelta);
+    const uint32_t deltaDuty =
+        std::min<uint32_t>((magnitude + 255) >> MotionPlannerConstants::SPEED_SHIFT,
+                           MotionPlannerConstants::MAX_DUTY);
+    m_rampTicks = std::max<uint16_t>(MotionPlannerConstants::RAMP_TICKS[deltaDuty], 1);
+    m_rampTick = 0;
+    m_phase = 0;
+    m_phaseStep = 65536UL / m_rampTicks;
+}
+
+/**
+ * @brief Stopping distance from the current speed, in duty-ms
+ *
+ * @return int32_t Distance a ramp down to the minimum duty and the step to zero take
+ */
+int32_t MotionPlanner::stoppingDistance() const
+{
+    const int32_t speed = (m_speed < 0 ? -m_speed : m_speed) >> MotionPlannerConstants::SPEED_SHIFT;
+    if (speed <= m_minDuty)
+    {
+        return speed * MotionPlannerConstants::TICK_MS;
+    }
+
+    // The S-curve is symmetric, so the ramp averages its start and end speeds
+    const int32_t ticks = MotionPlannerConstants::RAMP_TICKS[speed - m_minDuty];
+    return ticks * MotionPlannerConstants::TICK_MS * (speed + m_minDuty) / 2 +
+           m_minDuty * MotionPlannerConstants::TICK_MS;
+}
+
+/**
+ * @brief Write a duty to the driver if it changed
+ *
+ * @param[in] duty Duty, positive to the right, negative to the left, 0 to coast
+ *
+ * @note A stop coasts; only halt() brakes
+ */
+void MotionPlanner::writeOutput(int16_t duty)
+{
+    if (duty == m_output)
+    {
+        return;
+    }
+    m_output = duty;
+    if (duty == 0)
+    {
+        m_driver.stop(MotorStop::Coast);
+    }
+    else
+    {
+        m_driver.drive(duty);
+    }
+}
@@ -0,0 +1,357 @@
+/**
+ * @file MotionPlanner.h
+ * @brief Jerk-limited S-curve speed planner for the neck motor of the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the MotionPlanner class which turns speed and move commands from
+ * the main loop into a smooth duty profile for the neck motor's MotorDriver. It runs
+ * off a hardware repeating timer at a fixed control rate, so the profile does not
+ * depend on how long the main loop takes. The driver below it keeps the H-bridge safe:
+ * it adds the dead time on reversals and the slew limit on steps such as the one to
+ * the minimum duty.
+ *
+ * Every speed change follows a smoothstep S-curve read from a constexpr table, with
+ * speeds in Q8 fixed point so the timer never touches floating point. A ramp is long
+ * enough to keep both the peak acceleration (1.5 x change / ramp time) within
+ * MAX_ACCEL and the peak jerk (6 x change / ramp time^2) within MAX_JERK; those ramp
+ * lengths come from a second constexpr table.
+ *
+ * The motor does not turn below a minimum duty, so a planner built with one steps
+ * between 0 and the minimum and only shapes the profile above it. A reversal ramps
+ * down to the minimum, stops, and ramps up the other way.
+ *
+ * On the native build there is no timer; tick() is called directly to step the
+ * planner, and the output is read back with getOutput().
+ */
+
+#ifndef Y_SERIES_USB_HUB_MOTION_PLANNER_H
+#define Y_SERIES_USB_HUB_MOTION_PLANNER_H
+
+// System includes
+#include <Arduino.h>
+#include <array>
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/timer.h>
+#endif
+
+// Project includes
+#include <Logger.h>
+#include <MotorDriver.h>
+
+/**
+ * @brief Contains constants used by the MotionPlanner class
+ */
+namespace MotionPlannerConstants
+{
+/// @name Timing
+/// @{
+constexpr uint32_t TICK_US = 5000;                         ///< Control period (200 Hz)
+constexpr uint16_t TICK_MS = TICK_US / 1000;               ///< Control period in milliseconds
+constexpr uint32_t CONTROL_RATE_HZ = 1000000UL / TICK_US;  ///< Control updates per second
+/// @}
+
+/// @name Limits
+/// @{
+constexpr uint32_t MAX_ACCEL = 320;  ///< Peak acceleration (duty per second)
+constexpr uint32_t MAX_JERK = 3000;  ///< Peak jerk (duty per second squared)
+constexpr uint8_t MAX_DUTY = 255;    ///< Largest duty
+/// @}
+
+/// @name Fixed Point
+/// @{
+constexpr uint8_t SPEED_SHIFT = 8;                  ///< Speeds are duty in Q8
+constexpr uint8_t CURVE_SHIFT = 15;                 ///< S-curve values are Q15 (0-32768)
+constexpr uint16_t CURVE_SEGMENTS = 256;            ///< Linear segments, indexed by phase >> 8
+constexpr uint32_t CURVE_ONE = 1UL << CURVE_SHIFT;  ///< S-curve value at the end of a ramp
+/// @}
+
+/// @name Move Commands
+/// @{
+constexpr uint32_t DISTANCE_UNIT = 16;  ///< Move resolution (duty-ms)
+constexpr uint8_t DISTANCE_BITS = 17;   ///< Bits of the distance in a command word
+constexpr uint8_t SEQUENCE_BITS = 4;    ///< Bits of the sequence number in a command word
+
+constexpr uint32_t MAX_DISTANCE = ((1UL << DISTANCE_BITS) - 1) * DISTANCE_UNIT;  ///< Longest move
+/// @}
+
+/// @name Lookup Tables
+/// @{
+/**
+ * @brief Build the S-curve: smoothstep 3u^2 - 2u^3 from 0 to CURVE_ONE
+ *
+ * @return std::array<uint16_t, CURVE_SEGMENTS + 1> Curve at each segment boundary
+ */
+constexpr std::array<uint16_t, CURVE_SEGMENTS + 1> makeSCurve()
+{
+    std::array<uint16_t, CURVE_SEGMENTS + 1> curve{};
+    for (uint32_t i = 0; i <= CURVE_SEGMENTS; i++)
+    {
+        // u = i / 256; u^2 (3 - 2u) in Q24, rounded to Q15
+        const uint64_t value = static_cast<uint64_t>(i) * i * (3 * CURVE_SEGMENTS - 2 * i);
+        curve[i] = static_cast<uint16_t>((value + (1U << 8)) >> 9);
+    }
+    return curve;
+}
+
+/**
+ * @brief Smallest integer whose square is at least value
+ */
+constexpr uint32_t ceilSqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    while (root * root < value)
+    {
+        root++;
+    }
+    return root;
+}
+
+/**
+ * @brief Build the ramp lengths for every speed change
+ *
+ * @return std::array<uint16_t, MAX_DUTY + 1> Ticks needed to change speed by the index
+ *         in duty without exceeding MAX_ACCEL or MAX_JERK
+ */
+constexpr std::array<uint16_t, MAX_DUTY + 1> makeRampTicks()
+{
+    std::array<uint16_t, MAX_DUTY + 1> ticks{};
+    for (uint32_t delta = 1; delta <= MAX_DUTY; delta++)
+    {
+        const uint32_t accelTicks = (3 * delta * CONTROL_RATE_HZ + 2 * MAX_ACCEL - 1) /
+                                    (2 * MAX_ACCEL);
+        const uint32_t jerkTicks =
+            ceilSqrt((6 * delta * CONTROL_RATE_HZ * CONTROL_RATE_HZ + MAX_JERK - 1) / MAX_JERK);
+        ticks[delta] = static_cast<uint16_t>(accelTicks > jerkTicks ? accelTicks : jerkTicks);
+    }
+    return ticks;
+}
+
+constexpr std::array<uint16_t, CURVE_SEGMENTS + 1> S_CURVE = makeSCurve();  ///< In flash
+constexpr std::array<uint16_t, MAX_DUTY + 1> RAMP_TICKS = makeRampTicks();  ///< In flash
+
+static_assert(RAMP_TICKS[MAX_DUTY] <= CURVE_SEGMENTS,
+              "A ramp must not step over a whole S-curve segment per tick");
+/// @}
+}  // namespace MotionPlannerConstants
+
+/**
+ * @brief Commands the planner can follow
+ */
+enum class MotionMode : uint8_t
+{
+    Halt = 0,   ///< Stop immediately
+    Speed = 1,  ///< Ramp to a speed and hold it
+    Move = 2,   ///< Travel a distance, then ramp down and stop at its end
+};
+
+/**
+ * @brief Plans a jerk-limited speed profile for the neck motor from a hardware timer
+ *
+ * @details
+ * Commands are handed from the main loop to the timer as one packed 32-bit word,
+ * which the RP2040 reads and writes atomically, as DomeLed does. Each call stamps the
+ * word with the next sequence number, so every call is a new command: a moveBy()
+ * repeated after the first has ended travels again, and a command repeated after a
+ * halt() starts again. Only setSpeed() to the speed already being held or ramped to
+ * keeps its ramp, so the main loop can set the speed on every pass. Any other command
+ * that arrives mid-ramp starts a new ramp from the current speed: acceleration stays
+ * within MAX_ACCEL, but the jerk limit only holds within a ramp.
+ */
+class MotionPlanner
+{
+public:
+    /// @name Construction and Initialization
+    /// @{
+    /**
+     * @brief Construct a new motion planner
+     *
+     * @param[in] driver H-bridge driver the duty is written to
+     * @param[in] minDuty Lowest duty the motor turns at, 0 for none
+     */
+    explicit MotionPlanner(MotorDriver& driver, uint8_t minDuty = 0);
+
+    /**
+     * @brief Destructor - stops the timer
+     */
+    ~MotionPlanner();
+
+    // Prevent copying and assignment
+    MotionPlanner(const MotionPlanner&) = delete;
+    MotionPlanner& operator=(const MotionPlanner&) = delete;
+
+    /**
+     * @brief Start the repeating timer
+     *
+     * @return true if the timer was started, false otherwise
+     *
+     * @note On the native build there is no timer and this always succeeds
+     */
+    bool begin();
+    /// @}
+
+    /// @name Commands (main loop)
+    /// @{
+    /**
+     * @brief Ramp to a speed and hold it
+     *
+     * @param[in] duty Target duty, positive to the right (IN2), negative to the left (IN1)
+     */
+    void setSpeed(int16_t duty);
+
+    /**
+     * @brief Travel a distance and stop at its end
+     *
+     * @param[in] distance Duty-milliseconds to travel, positive to the right
+     * @param[in] cruiseDuty Highest duty to use on the way
+     *
+     * @note The distance is rounded to DISTANCE_UNIT and limited to MAX_DISTANCE. A call
+     *       replaces a move in progress with a new one from where the head is.
+     */
+    void moveBy(int32_t distance, uint8_t cruiseDuty);
+
+    /**
+     * @brief Stop immediately, without a ramp
+     *
+     * @param[in] rest Whether the motor coasts or brakes to a stop
+     *
+     * @note Cancels the active command even if another is set before the next tick, which
+     *       then starts from rest. Sending the cancelled command again restarts it.
+     */
+    void halt(MotorStop rest = MotorStop::Coast)
+    {
+        m_haltPending = static_cast<uint8_t>(rest) + 1;
+    }
+
+    /**
+     * @brief Take the distance travelled since the previous call
+     *
+     * @return int32_t Duty-milliseconds applied to the motor, positive to the right
+     *
+     * @note Read from the driver, so the dead time and slew limit are accounted for
+     */
+    int32_t takeTravel() { return m_driver.takeTravel(); }
+    /// @}
+
+    /// @name Timer Interface
+    /// @{
+    /**
+     * @brief Advance the profile by one control period and update the driver
+     *
+     * @note Called from the timer interrupt on the RP2040; call it directly on the host
+     */
+    void tick();
+    /// @}
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get the duty last written to the driver
+     * @return int16_t Duty, positive to the right, negative to the left
+     */
+    int16_t getOutput() const { return m_output; }
+
+    /**
+     * @brief Get the planned speed before the minimum duty is applied
+     * @return int32_t Speed in Q8 duty
+     */
+    int32_t getSpeedQ8() const { return m_speed; }
+
+    /**
+     * @brief Get the command applied by the last tick
+     * @return Current MotionMode
+     */
+    MotionMode getMode() const { return m_mode; }
+
+    /**
+     * @brief Check whether the motor is being driven
+     * @return true if the last tick wrote a non-zero duty, false otherwise
+     */
+    bool isMoving() const { return m_output != 0; }
+
+    /**
+     * @brief Check whether the latest command has run to completion
+     * @return true once the timer has applied the latest command and the motor is at rest
+     *         with nothing left to do, false otherwise
+     *
+     * @note A finished moveBy() is settled; a non-zero setSpeed() never is
+     */
+    bool isSettled() const { return m_pending == m_active && m_speed == 0 && m_target == 0; }
+    /// @}
+
+private:
+    /// @name Internal Methods
+    /// @{
+    /**
+     * @brief Pack a command word: mode, direction, duty and move distance
+     */
+    static uint32_t packCommand(MotionMode mode, int16_t duty, uint32_t distanceUnits);
+
+    /**
+     * @brief Stamp a command word with the next sequence number and hand it to the timer
+     */
+    void publish(uint32_t command);
+
+    /**
+     * @brief Load a newly published command into the tick state
+     */
+    void applyCommand(uint32_t command);
+
+    /**
+     * @brief Start the next stage toward the target speed
+     */
+    void planStage();
+
+    /**
+     * @brief Start an S-curve from the current speed to a new one
+     */
+    void startRamp(int32_t toQ8);
+
+    /**
+     * @brief Stopping distance from the current speed, in duty-ms
+     */
+    int32_t stoppingDistance() const;
+
+    /**
+     * @brief Write a duty to the driver if it changed
+     */
+    void writeOutput(int16_t duty);
+    /// @}
+
+    /// @name Hardware Configuration
+    /// @{
+    MotorDriver& m_driver;  ///< H-bridge the duty is written to
+    uint8_t m_minDuty;      ///< Lowest duty the motor turns at
+#ifdef ARDUINO_ARCH_RP2040
+    repeating_timer_t m_timer;  ///< Hardware timer driving tick()
+#endif
+    bool m_started;  ///< True once the timer is running
+    /// @}
+
+    /// @name Command Handoff
+    /// @{
+    volatile uint32_t m_pending;  ///< Command set by the main loop (mode|dir|duty|seq|distance)
+    volatile uint8_t m_haltPending;  ///< Stop requested by the main loop (MotorStop + 1)
+    uint8_t m_sequence;              ///< Sequence number of the last command published
+    uint32_t m_active;               ///< Command the tick state was built from
+    /// @}
+
+    /// @name Tick State (owned by the timer)
+    /// @{
+    MotionMode m_mode;     ///< Active command
+    int32_t m_target;      ///< Speed the profile is heading for (Q8)
+    int32_t m_speed;       ///< Planned speed (Q8)
+    int32_t m_rampFrom;    ///< Speed at the start of the ramp (Q8)
+    int32_t m_rampDelta;   ///< Speed change over the ramp (Q8)
+    uint16_t m_rampTicks;  ///< Length of the ramp, 0 when not ramping
+    uint16_t m_rampTick;   ///< Ticks into the ramp
+    uint32_t m_phase;      ///< Position in the ramp (Q16)
+    uint32_t m_phaseStep;  ///< Phase advance per tick (Q16)
+    int32_t m_remaining;   ///< Distance left to move (duty-ms)
+    bool m_decelerating;   ///< True once the move is ramping down to its end
+    int16_t m_output;      ///< Duty last written
+    /// @}
+};
+
+#endif  // Y_SERIES_USB_HUB_MOTION_PLANNER_H
@@ -0,0 +1,250 @@
+/**
+ * @file MotorDriver.cpp
+ * @brief Implementation of the MotorDriver class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the MotorDriver class which slews the H-bridge duty, rests the
+ * bridge for a dead time on every reversal and applies coast or brake stops.
+ */
+
+#include "MotorDriver.h"
+
+namespace
+{
+// Command word layout: rest state, direction, then the duty in the low byte
+constexpr uint8_t REST_SHIFT = 9;
+constexpr uint32_t REVERSE_BIT = 1UL << 8;
+constexpr uint32_t DUTY_MASK = 0xFF;
+}  // namespace
+
+/**
+ * @brief Construct a new motor driver
+ *
+ * @param[in] pinIn1 H-bridge input driven for negative (left) duty
+ * @param[in] pinIn2 H-bridge input driven for positive (right) duty
+ * @param[in] reverseRest Rest state during the dead time of a reversal
+ * @param[in] deadTimeMs Rest between driving one way and the other
+ * @param[in] slewPerTick Largest duty change per tick
+ */
+MotorDriver::MotorDriver(uint8_t pinIn1, uint8_t pinIn2, MotorStop reverseRest,
+                         uint8_t deadTimeMs, uint8_t slewPerTick)
+    : m_in1(pinIn1, MotorDriverConstants::PWM_FREQUENCY_HZ),
+      m_in2(pinIn2, MotorDriverConstants::PWM_FREQUENCY_HZ),
+      m_reverseRest(reverseRest),
+      m_deadTimeTicks(deadTimeMs / MotorDriverConstants::TICK_MS),
+      m_slewPerTick(slewPerTick > 0 ? slewPerTick : 1),
+#ifdef ARDUINO_ARCH_RP2040
+      m_timer(),
+#endif
+      m_started(false),
+      m_pending(packCommand(MotorStop::Coast, 0)),
+      m_travel(0),
+      m_travelTaken(0),
+      m_stopEdgeUs(0),
+      m_stopTimed(false),
+      m_output(0),
+      m_rest(MotorStop::Coast),
+      m_deadTicks(0),
+      m_ticks(0),
+      m_lastStopLatencyUs(0),
+      m_maxStopLatencyUs(0)
+{
+}
+
+/**
+ * @brief Destructor - stops the timer
+ */
+MotorDriver::~MotorDriver()
+{
+#ifdef ARDUINO_ARCH_RP2040
+    if (m_started)
+    {
+        cancel_repeating_timer(&m_timer);
+    }
+#endif
+}
+
+/**
+ * @brief Coast the bridge and start the repeating timer
+ *
+ * @return true if the timer was started, false otherwise
+ */
+bool MotorDriver::begin()
+{
+    writeBridge();
+#ifdef ARDUINO_ARCH_RP2040
+    // Negative interval keeps the ticks evenly spaced regardless of callback time
+    m_started = add_repeating_timer_us(
+        -static_cast<int64_t>(MotorDriverConstants::TICK_US),
+        [](repeating_timer_t* rt) -> bool
+        {
+            static_cast<MotorDriver*>(rt->user_data)->tick();
+            return true;
+        },
+        this, &m_timer);
+    if (!m_started)
+    {
+        Log.error("Failed to start motor driver timer");
+    }
+#else
+    m_started = true;
+#endif
+    return m_started;
+}
+
+/**
+ * @brief Drive the motor toward a duty
+ *
+ * @param[in] duty Target duty, positive to the right (IN2), negative to the left (IN1),
+ *                 0 to coast
+ */
+void MotorDriver::drive(int16_t duty)
+{
+    m_pending = packCommand(MotorStop::Coast, duty);
+}
+
+/**
+ * @brief Stop driving the motor
+ *
+ * @param[in] rest Coast or brake
+ */
+void MotorDriver::stop(MotorStop rest)
+{
+    m_pending = packCommand(rest, 0);
+}
+
+/**
+ * @brief Stop driving the motor and time the release of the bridge from an edge
+ *
+ * @param[in] rest Coast or brake
+ * @param[in] edgeUs Microsecond timer when the edge that asked for the stop was taken
+ */
+void MotorDriver::stopFromEdge(MotorStop rest, uint32_t edgeUs)
+{
+    // The edge is in place before the stop the tick picks it up with
+    m_stopEdgeUs = edgeUs;
+    m_stopTimed = true;
+    stop(rest);
+}
+
+/**
+ * @brief Take the distance travelled since the previous call
+ *
+ * @return int32_t Duty-milliseconds applied to the motor, positive to the right
+ */
+int32_t MotorDriver::takeTravel()
+{
+    const uint32_t total = m_travel;
+    const int32_t travel = static_cast<int32_t>(total - m_travelTaken);
+    m_travelTaken = total;
+    return travel;
+}
+
+/**
+ * @brief Advance the driver by one tick and update the H-bridge
+ */
+void MotorDriver::tick()
+{
+    m_ticks++;
+    const uint32_t command = m_pending;
+    const int16_t magnitude = static_cast<int16_t>(command & DUTY_MASK);
+    const int16_t target = (command & REVERSE_BIT) ? -magnitude : magnitude;
+
+    if (m_output == 0 && m_deadTicks != 0)
+    {
+        m_deadTicks--;
+    }
+
+    const bool reversing = m_output != 0 && target != 0 && (m_output > 0) != (target > 0);
+    if (target == 0 || reversing)
+    {
+        // Release the bridge at once; driving again waits out the dead time
+        if (m_output != 0)
+        {
+            m_output = 0;
+            m_deadTicks = m_deadTimeTicks;
+        }
+        m_rest = reversing ? m_reverseRest : static_cast<MotorStop>(command >> REST_SHIFT);
+    }
+    else if (m_deadTicks == 0)
+    {
+        // Slew toward the target, starting from rest after a stop or reversal
+        const int16_t step = target - m_output;
+        const int16_t limit = m_slewPerTick;
+        m_output += step > limit ? limit : (step < -limit ? -limit : step);
+    }
+
+    writeBridge();
+    m_travel = m_travel + static_cast<uint32_t>(m_output * MotorDriverConstants::TICK_MS);
+
+    // A timed stop ends once the bridge is written released
+    if (target == 0 && m_stopTimed)
+    {
+        m_stopTimed = false;
+        const uint32_t latency = nowUs() - m_stopEdgeUs;
+        m_lastStopLatencyUs = latency;
+        if (latency > m_maxStopLatencyUs)
+        {
+            m_maxStopLatencyUs = latency;
+        }
+    }
+}
+
+/**
+ * @brief Pack a command word: rest state, direction and duty
+ *
+ * @param[in] rest Rest state for a zero duty
+ * @param[in] duty Target duty, negative to the left
+ * @return uint32_t Command word
+ */
+uint32_t MotorDriver::packCommand(MotorStop rest, int16_t duty)
+{
+    const uint32_t magnitude = duty < 0 ? -duty : duty;
+    return (static_cast<uint32_t>(rest) << REST_SHIFT) | (duty < 0 ? REVERSE_BIT : 0) |
+           (magnitude > DUTY_MASK ? DUTY_MASK : magnitude);
+}
+
+/**
+ * @brief Get the microsecond timer the stop latency is measured with
+ *
+ * @return uint32_t Microsecond timer, or the ticks run in µs on the host
+ */
+uint32_t MotorDriver::nowUs() const
+{
+#ifdef ARDUINO_ARCH_RP2040
+    return time_us_32();
+#else
+    return m_ticks * MotorDriverConstants::TICK_US;
+#endif
+}
+
+/**
+ * @brief Write the bridge inputs for the current output and rest state
+ *
+ * @note The input being released is always written before the one being driven
+ */
+void MotorDriver::writeBridge()
+{
+    if (m_output > 0)
+    {
+        m_in1.write(0);
+        m_in2.write(static_cast<uint8_t>(m_output));
+    }
+    else if (m_output < 0)
+    {
+        m_in2.write(0);
+        m_in1.write(static_cast<uint8_t>(-m_output));
+    }
+    else if (m_rest == MotorStop::Brake)
+    {
+        m_in1.write(MotorDriverConstants::FULL_DUTY);
+        m_in2.write(MotorDriverConstants::FULL_DUTY);
+    }
+    else
+    {
+        m_in1.write(0);
+        m_in2.write(0);
+    }
+}
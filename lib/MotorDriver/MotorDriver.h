@@ -0,0 +1,248 @@
+/**
+ * @file MotorDriver.h
+ * @brief Timer-driven H-bridge driver for the neck motor of the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the MotorDriver class which owns the two inputs of the neck motor's
+ * H-bridge and protects the supply from the current spikes of abrupt changes. It runs
+ * off a hardware repeating timer at 1 kHz and applies three rules on every tick:
+ *
+ * - The duty moves toward its target by at most the slew limit per tick.
+ * - A reversal never drives the opposite input straight away: the bridge first rests
+ *   (coasting or braking) for the dead time, then ramps up the other way from zero.
+ * - A stop is explicit about the rest state: coast (both inputs low, the motor spins
+ *   down freely) or brake (both inputs high, the motor windings are shorted).
+ *
+ * The duty actually applied is integrated into a travel total, so a position estimate
+ * can follow what the motor did rather than what it was asked to do. A stop made for an
+ * input edge is timed from the edge to the tick that releases the bridge. On the native
+ * build there is no timer; tick() is called directly to step the driver, and the ticks
+ * run so far stand in for the microsecond timer.
+ */
+
+#ifndef Y_SERIES_USB_HUB_MOTOR_DRIVER_H
+#define Y_SERIES_USB_HUB_MOTOR_DRIVER_H
+
+// System includes
+#include <Arduino.h>
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/timer.h>
+#endif
+
+// Project includes
+#include <Logger.h>
+#include <PwmOutput.h>
+
+/**
+ * @brief Contains constants used by the MotorDriver class
+ */
+namespace MotorDriverConstants
+{
+/// @name Timing
+/// @{
+constexpr uint32_t TICK_US = 1000;            ///< Timer period (1 kHz)
+constexpr uint16_t TICK_MS = TICK_US / 1000;  ///< Timer period in milliseconds
+/// @}
+
+/// @name Protection
+/// @{
+constexpr uint8_t DEFAULT_DEAD_TIME_MS = 20;  ///< Rest between driving one way and the other
+constexpr uint8_t DEFAULT_SLEW_PER_TICK = 8;  ///< Largest duty change per tick (0-255 in 32 ms)
+/// @}
+
+/// @name Output
+/// @{
+constexpr uint32_t PWM_FREQUENCY_HZ = 20000;  ///< H-bridge PWM, above the audible range
+constexpr uint8_t FULL_DUTY = 255;            ///< Duty of an input held high
+/// @}
+}  // namespace MotorDriverConstants
+
+/**
+ * @brief How the H-bridge rests when the motor is not driven
+ */
+enum class MotorStop : uint8_t
+{
+    Coast = 0,  ///< Both inputs low: the motor spins down freely
+    Brake = 1,  ///< Both inputs high: the shorted windings stop the motor quickly
+};
+
+/**
+ * @brief Drives an H-bridge with slew limiting and a dead time on every reversal
+ *
+ * @details
+ * Commands are handed to the timer as one packed 32-bit word, as DomeLed does, so the
+ * main loop or a MotionPlanner tick can set the target at any time.
+ */
+class MotorDriver
+{
+public:
+    /// @name Construction and Initialization
+    /// @{
+    /**
+     * @brief Construct a new motor driver
+     *
+     * @param[in] pinIn1 H-bridge input driven for negative (left) duty
+     * @param[in] pinIn2 H-bridge input driven for positive (right) duty
+     * @param[in] reverseRest Rest state during the dead time of a reversal
+     * @param[in] deadTimeMs Rest between driving one way and the other
+     * @param[in] slewPerTick Largest duty change per tick
+     */
+    MotorDriver(uint8_t pinIn1, uint8_t pinIn2, MotorStop reverseRest = MotorStop::Coast,
+                uint8_t deadTimeMs = MotorDriverConstants::DEFAULT_DEAD_TIME_MS,
+                uint8_t slewPerTick = MotorDriverConstants::DEFAULT_SLEW_PER_TICK);
+
+    /**
+     * @brief Destructor - stops the timer
+     */
+    ~MotorDriver();
+
+    // Prevent copying and assignment
+    MotorDriver(const MotorDriver&) = delete;
+    MotorDriver& operator=(const MotorDriver&) = delete;
+
+    /**
+     * @brief Coast the bridge and start the repeating timer
+     *
+     * @return true if the timer was started, false otherwise
+     *
+     * @note On the native build there is no timer and this always succeeds
+     */
+    bool begin();
+    /// @}
+
+    /// @name Commands
+    /// @{
+    /**
+     * @brief Drive the motor toward a duty
+     *
+     * @param[in] duty Target duty, positive to the right (IN2), negative to the left (IN1),
+     *                 0 to coast
+     */
+    void drive(int16_t duty);
+
+    /**
+     * @brief Stop driving the motor
+     *
+     * @param[in] rest Coast or brake
+     *
+     * @note Takes effect on the next tick, without a slew: releasing or shorting the
+     *       motor does not draw drive current
+     */
+    void stop(MotorStop rest = MotorStop::Coast);
+
+    /**
+     * @brief Stop driving the motor and time the release of the bridge from an edge
+     *
+     * @param[in] rest Coast or brake
+     * @param[in] edgeUs Microsecond timer when the edge that asked for the stop was taken
+     *
+     * @note For an interrupt: the latency is read back with getLastStopLatencyUs()
+     */
+    void stopFromEdge(MotorStop rest, uint32_t edgeUs);
+
+    /**
+     * @brief Take the distance travelled since the previous call
+     *
+     * @return int32_t Duty-milliseconds applied to the motor, positive to the right
+     *
+     * @note Reads the timer's running total with one 32-bit load, so it is safe to call
+     *       while the timer runs
+     */
+    int32_t takeTravel();
+    /// @}
+
+    /// @name Timer Interface
+    /// @{
+    /**
+     * @brief Advance the driver by one tick and update the H-bridge
+     *
+     * @note Called from the timer interrupt on the RP2040; call it directly on the host
+     */
+    void tick();
+    /// @}
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get the duty applied by the last tick
+     * @return int16_t Duty, positive to the right, negative to the left, 0 while resting
+     */
+    int16_t getOutput() const { return m_output; }
+
+    /**
+     * @brief Get the rest state applied while the duty is zero
+     * @return MotorStop Coast or brake
+     */
+    MotorStop getRest() const { return m_rest; }
+
+    /**
+     * @brief Check whether a dead time is running
+     * @return true while the bridge rests before driving again, false otherwise
+     */
+    bool isInDeadTime() const { return m_deadTicks != 0; }
+
+    /**
+     * @brief Get the time from the edge of the last timed stop to the release of the bridge
+     * @return uint32_t Latency (µs)
+     */
+    uint32_t getLastStopLatencyUs() const { return m_lastStopLatencyUs; }
+
+    /**
+     * @brief Get the longest time from the edge of a timed stop to the release of the bridge
+     * @return uint32_t Latency (µs)
+     */
+    uint32_t getMaxStopLatencyUs() const { return m_maxStopLatencyUs; }
+    /// @}
+
+private:
+    /**
+     * @brief Pack a command word: rest state, direction and duty
+     */
+    static uint32_t packCommand(MotorStop rest, int16_t duty);
+
+    /**
+     * @brief Write the bridge inputs for the current output and rest state
+     */
+    void writeBridge();
+
+    /**
+     * @brief Get the microsecond timer the stop latency is measured with
+     */
+    uint32_t nowUs() const;
+
+    /// @name Hardware Configuration
+    /// @{
+    PwmOutput m_in1;          ///< H-bridge input for left
+    PwmOutput m_in2;          ///< H-bridge input for right
+    MotorStop m_reverseRest;  ///< Rest state during a reversal
+    uint8_t m_deadTimeTicks;  ///< Dead time in ticks
+    uint8_t m_slewPerTick;    ///< Largest duty change per tick
+#ifdef ARDUINO_ARCH_RP2040
+    repeating_timer_t m_timer;  ///< Hardware timer driving tick()
+#endif
+    bool m_started;  ///< True once the timer is running
+    /// @}
+
+    /// @name Command Handoff
+    /// @{
+    volatile uint32_t m_pending;     ///< Command set by the caller (rest|dir|duty)
+    volatile uint32_t m_travel;      ///< Running total of duty-ms applied, wraps
+    uint32_t m_travelTaken;          ///< Total at the previous takeTravel()
+    volatile uint32_t m_stopEdgeUs;  ///< Edge the pending timed stop is measured from
+    volatile bool m_stopTimed;       ///< True while a timed stop waits for its release
+    /// @}
+
+    /// @name Tick State (owned by the timer)
+    /// @{
+    int16_t m_output;                       ///< Duty applied
+    MotorStop m_rest;                       ///< Rest state applied while the duty is zero
+    uint8_t m_deadTicks;                    ///< Ticks left before the bridge may drive again
+    uint32_t m_ticks;                       ///< Ticks run, the microsecond timer on the host
+    volatile uint32_t m_lastStopLatencyUs;  ///< Edge to release, last timed stop
+    volatile uint32_t m_maxStopLatencyUs;   ///< Edge to release, longest timed stop
+    /// @}
+};
+
+#endif  // Y_SERIES_USB_HUB_MOTOR_DRIVER_H
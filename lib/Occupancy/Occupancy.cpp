@@ -0,0 +1,172 @@
+/**
+ * @file Occupancy.cpp
+ * @brief Implementation of the OccupancyEstimator class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the OccupancyEstimator class which turns PIR edges into an
+ * activity estimate and a power tier.
+ */
+
+#include "Occupancy.h"
+
+namespace
+{
+// Profile of each tier, indexed by PowerTier
+constexpr PowerProfile POWER_PROFILES[] = {
+    {10, 4, true},     // Active
+    {20, 10, true},    // Settled
+    {40, 20, false},   // Quiet
+    {100, 50, false},  // Asleep
+};
+static_assert(sizeof(POWER_PROFILES) / sizeof(POWER_PROFILES[0]) ==
+                  static_cast<size_t>(PowerTier::Count),
+              "POWER_PROFILES must have one entry per tier");
+
+// Name of each tier, indexed by PowerTier
+const char* const TIER_NAMES[] = {"active", "settled", "quiet", "asleep"};
+}  // namespace
+
+/**
+ * @brief Get the profile of a power tier
+ *
+ * @param[in] tier Power tier
+ * @return const PowerProfile& Rates and amplifier power, the Asleep profile for an
+ *         unknown tier
+ */
+const PowerProfile& getPowerProfile(PowerTier tier)
+{
+    return POWER_PROFILES[static_cast<uint8_t>(tier < PowerTier::Count ? tier
+                                                                        : PowerTier::Asleep)];
+}
+
+/**
+ * @brief Get the name of a power tier
+ *
+ * @param[in] tier Power tier
+ * @return const char* Name for the log
+ */
+const char* getPowerTierName(PowerTier tier)
+{
+    return tier < PowerTier::Count ? TIER_NAMES[static_cast<uint8_t>(tier)] : "unknown";
+}
+
+/**
+ * @brief Construct an estimator with one arrival's activity, in the Active tier
+ */
+OccupancyEstimator::OccupancyEstimator()
+    : m_activity(OccupancyConstants::ARRIVAL),
+      m_motion(false),
+      m_tier(PowerTier::Active),
+      m_lastUpdate(0),
+      m_lastDecay(0),
+      m_residencyMs{},
+      m_arrivals(0),
+      m_tierChanges(0),
+      m_started(false)
+{
+}
+
+/**
+ * @brief Decay the activity, count an arrival and pick the tier
+ *
+ * @param[in] now Current time (ms)
+ * @param[in] motion PIR output, true while it sees motion
+ * @return true if the PIR output changed since the last call, false otherwise
+ *
+ * @details
+ * The activity loses 1/256 of itself each second, a half-life of about 177 s, in whole
+ * steps so the result does not depend on how often update() is called. The time since
+ * the last call counts toward the tier the hub was in.
+ */
+bool OccupancyEstimator::update(unsigned long now, bool motion)
+{
+    if (!m_started)
+    {
+        m_started = true;
+        m_lastUpdate = now;
+        m_lastDecay = now;
+    }
+    m_residencyMs[static_cast<uint8_t>(m_tier)] += now - m_lastUpdate;
+    m_lastUpdate = now;
+
+    uint32_t steps = (now - m_lastDecay) / OccupancyConstants::DECAY_STEP_MS;
+    m_lastDecay += steps * OccupancyConstants::DECAY_STEP_MS;
+    if (steps >= OccupancyConstants::MAX_DECAY_STEPS)
+    {
+        m_activity = 0;
+        steps = 0;
+    }
+    for (; steps > 0 && m_activity > 0; steps--)
+    {
+        // Round the step up so the activity reaches 0 instead of stalling
+        m_activity -= (m_activity >> OccupancyConstants::DECAY_SHIFT) | 1;
+    }
+
+    const bool edge = motion != m_motion;
+    m_motion = motion;
+    if (edge && motion)
+    {
+        m_arrivals++;
+        m_activity = m_activity + OccupancyConstants::ARRIVAL < OccupancyConstants::MAX_ACTIVITY
+                         ? m_activity + OccupancyConstants::ARRIVAL
+                         : OccupancyConstants::MAX_ACTIVITY;
+    }
+    // Someone was just here, however long ago they arrived
+    else if (edge && m_activity < OccupancyConstants::ARRIVAL)
+    {
+        m_activity = OccupancyConstants::ARRIVAL;
+    }
+
+    const PowerTier tier = selectTier();
+    if (tier != m_tier)
+    {
+        m_tier = tier;
+        m_tierChanges++;
+    }
+    return edge;
+}
+
+/**
+ * @brief Pick the tier for the activity and the PIR output
+ *
+ * @return PowerTier Active while the PIR sees motion, otherwise by the activity
+ */
+PowerTier OccupancyEstimator::selectTier() const
+{
+    if (m_motion || m_activity >= OccupancyConstants::ACTIVE_LEVEL)
+    {
+        return PowerTier::Active;
+    }
+    if (m_activity >= OccupancyConstants::SETTLED_LEVEL)
+    {
+        return PowerTier::Settled;
+    }
+    return m_activity >= OccupancyConstants::QUIET_LEVEL ? PowerTier::Quiet : PowerTier::Asleep;
+}
+
+/**
+ * @brief Clear the tier residency, keeping the activity and the tier
+ *
+ * @param[in] now Current time (ms)
+ */
+void OccupancyEstimator::resetResidency(unsigned long now)
+{
+    for (uint32_t& residency : m_residencyMs)
+    {
+        residency = 0;
+    }
+    m_lastUpdate = now;
+}
+
+/**
+ * @brief Get the time spent in a tier since construction or resetResidency()
+ *
+ * @param[in] tier Power tier
+ * @return uint32_t Time in the tier (ms), 0 for an unknown tier
+ */
+uint32_t OccupancyEstimator::getResidencyMs(PowerTier tier) const
+{
+    return tier < PowerTier::Count ? m_residencyMs[static_cast<uint8_t>(tier)] : 0;
+}
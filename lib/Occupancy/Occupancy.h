@@ -0,0 +1,191 @@
+/**
+ * @file Occupancy.h
+ * @brief PIR occupancy estimate and the power tiers it selects for the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the OccupancyEstimator class, which keeps an exponentially weighted
+ * count of PIR arrivals in integer arithmetic and picks a power tier from it. Each tier
+ * sets how often the behavior logic runs, how often the eye is rendered and whether the
+ * audio amplifier stays powered:
+ *
+ * | Tier    | Logic   | Eye output | Amplifier |
+ * |---------|---------|------------|-----------|
+ * | Active  | 100 Hz  | 250 Hz     | on        |
+ * | Settled | 50 Hz   | 100 Hz     | on        |
+ * | Quiet   | 25 Hz   | 50 Hz      | off       |
+ * | Asleep  | 10 Hz   | 20 Hz      | off       |
+ *
+ * Every rising PIR edge adds one arrival to the activity, which halves about every three
+ * minutes, and a falling edge tops it up to one arrival. While the PIR output is high,
+ * and until the activity decays below ACTIVE_LEVEL, the hub is Active; lower levels step
+ * down through the tiers. A busy room therefore keeps the hub responsive for longer after
+ * it empties than a single passer-by does. Any PIR edge restores the Active tier at once.
+ */
+
+#ifndef Y_SERIES_USB_HUB_OCCUPANCY_H
+#define Y_SERIES_USB_HUB_OCCUPANCY_H
+
+// System includes
+#include <Arduino.h>
+
+/**
+ * @brief Contains constants used by the OccupancyEstimator class
+ */
+namespace OccupancyConstants
+{
+/// @name Activity
+/// @{
+constexpr uint8_t FRACTION_BITS = 16;                       ///< Activity fixed point (Q16)
+constexpr uint32_t ARRIVAL = 1UL << FRACTION_BITS;          ///< Activity added per arrival
+constexpr uint32_t DECAY_STEP_MS = 1000;                    ///< Time between decay steps
+constexpr uint8_t DECAY_SHIFT = 8;                          ///< Decay by 1/256 per step
+constexpr uint32_t MAX_ACTIVITY = 64 * ARRIVAL;             ///< Activity saturates here
+constexpr uint32_t MAX_DECAY_STEPS = 32 * (1 << DECAY_SHIFT);  ///< Activity is 0 after these
+/// @}
+
+/// @name Tier Thresholds
+/// @{
+constexpr uint32_t ACTIVE_LEVEL = ARRIVAL * 3 / 4;  ///< Active at or above (74 s after one)
+constexpr uint32_t SETTLED_LEVEL = ARRIVAL / 4;     ///< Settled at or above (355 s after one)
+constexpr uint32_t QUIET_LEVEL = ARRIVAL / 16;      ///< Quiet at or above (710 s after one)
+/// @}
+}  // namespace OccupancyConstants
+
+/**
+ * @brief Power and performance tiers, from full rate down
+ */
+enum class PowerTier : uint8_t
+{
+    Active = 0,   ///< Someone is there or just left
+    Settled = 1,  ///< Recently occupied
+    Quiet = 2,    ///< Occupied a while ago
+    Asleep = 3,   ///< Nobody for a long time
+    Count = 4,    ///< Number of tiers
+};
+
+/**
+ * @brief What a power tier runs at
+ */
+struct PowerProfile
+{
+    uint16_t logicIntervalMs;   ///< Period of the behavior logic
+    uint16_t outputIntervalMs;  ///< Period of the eye output pass
+    bool amplifier;             ///< True to keep the audio amplifier powered while silent
+};
+
+/**
+ * @brief Get the profile of a power tier
+ *
+ * @param[in] tier Power tier
+ * @return const PowerProfile& Rates and amplifier power, the Asleep profile for an
+ *         unknown tier
+ */
+const PowerProfile& getPowerProfile(PowerTier tier);
+
+/**
+ * @brief Get the name of a power tier
+ *
+ * @param[in] tier Power tier
+ * @return const char* Name for the log
+ */
+const char* getPowerTierName(PowerTier tier);
+
+/**
+ * @brief Estimates occupancy from PIR edges and picks the power tier
+ *
+ * @details
+ * update() is cheap enough to call on every pass of the main loop, so a PIR edge is seen
+ * within one output pass even while the behavior logic runs slowly. The time spent in
+ * each tier is accumulated for reporting.
+ */
+class OccupancyEstimator
+{
+public:
+    /**
+     * @brief Construct an estimator with one arrival's activity, in the Active tier
+     *
+     * @note Someone just powered the hub up, so the boot and calibration run at full rate
+     */
+    OccupancyEstimator();
+
+    // Prevent copying and assignment
+    OccupancyEstimator(const OccupancyEstimator&) = delete;
+    OccupancyEstimator& operator=(const OccupancyEstimator&) = delete;
+
+    /**
+     * @brief Decay the activity, count an arrival and pick the tier
+     *
+     * @param[in] now Current time (ms)
+     * @param[in] motion PIR output, true while it sees motion
+     * @return true if the PIR output changed since the last call, false otherwise
+     */
+    bool update(unsigned long now, bool motion);
+
+    /**
+     * @brief Clear the tier residency, keeping the activity and the tier
+     *
+     * @param[in] now Current time (ms)
+     */
+    void resetResidency(unsigned long now);
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get the power tier
+     * @return PowerTier Tier picked by the last update()
+     */
+    PowerTier getTier() const { return m_tier; }
+
+    /**
+     * @brief Get the profile of the current tier
+     * @return const PowerProfile& Rates and amplifier power
+     */
+    const PowerProfile& getProfile() const { return getPowerProfile(m_tier); }
+
+    /**
+     * @brief Get the activity estimate
+     * @return uint32_t Recent arrivals, Q16 fixed point
+     */
+    uint32_t getActivity() const { return m_activity; }
+
+    /**
+     * @brief Get the time spent in a tier since construction or resetResidency()
+     *
+     * @param[in] tier Power tier
+     * @return uint32_t Time in the tier (ms), 0 for an unknown tier
+     */
+    uint32_t getResidencyMs(PowerTier tier) const;
+
+    /**
+     * @brief Get the number of rising PIR edges seen
+     * @return uint32_t Arrivals since construction
+     */
+    uint32_t getArrivals() const { return m_arrivals; }
+
+    /**
+     * @brief Get the number of tier changes
+     * @return uint32_t Tier changes since construction
+     */
+    uint32_t getTierChanges() const { return m_tierChanges; }
+    /// @}
+
+private:
+    /**
+     * @brief Pick the tier for the activity and the PIR output
+     */
+    PowerTier selectTier() const;
+
+    uint32_t m_activity;                                            ///< Recent arrivals (Q16)
+    bool m_motion;                                                  ///< PIR output last seen
+    PowerTier m_tier;                                               ///< Current tier
+    unsigned long m_lastUpdate;                                     ///< Time of the last update
+    unsigned long m_lastDecay;                                      ///< Time of the last decay
+    uint32_t m_residencyMs[static_cast<uint8_t>(PowerTier::Count)];  ///< Time in each tier
+    uint32_t m_arrivals;                                            ///< Rising PIR edges
+    uint32_t m_tierChanges;                                         ///< Tier changes
+    bool m_started;                                                 ///< True after an update
+};
+
+#endif  // Y_SERIES_USB_HUB_OCCUPANCY_H
@@ -0,0 +1,121 @@
+/**
+ * @file PwmOutput.cpp
+ * @brief Implementation of the PwmOutput class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the PwmOutput class which caches a PWM pin's level and writes
+ * the compare register only when it changes.
+ */
+
+#include "PwmOutput.h"
+
+#include <algorithm>
+
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/clocks.h>
+#endif
+
+uint32_t PwmOutput::s_totalWriteCount = 0;
+
+/**
+ * @brief Construct a new PWM output
+ *
+ * @param[in] pin GPIO pin to drive
+ * @param[in] frequencyHz PWM frequency of the pin's slice
+ */
+PwmOutput::PwmOutput(uint8_t pin, uint32_t frequencyHz)
+    : m_pin(pin),
+      m_frequencyHz(frequencyHz),
+      m_configured(false),
+      m_levelShift(0),
+      m_level(PwmOutputConstants::UNKNOWN_LEVEL),
+      m_writeCount(0)
+{
+}
+
+/**
+ * @brief Set the output level
+ *
+ * @param[in] level Duty (0-255)
+ * @return true if the hardware was written, false if the level was already set
+ */
+bool PwmOutput::write(uint8_t level)
+{
+    if (m_level == level)
+    {
+        return false;
+    }
+    if (!m_configured)
+    {
+        configure();
+    }
+    m_level = level;
+    m_writeCount++;
+    s_totalWriteCount++;
+#ifdef ARDUINO_ARCH_RP2040
+    pwm_set_gpio_level(m_pin, static_cast<uint16_t>(level) << m_levelShift);
+#else
+    analogWrite(m_pin, level);
+#endif
+    return true;
+}
+
+/**
+ * @brief Hand the pin to its PWM slice and set the slice's frequency
+ *
+ * @note The slice is set up field by field rather than with pwm_init, which would also
+ *       clear the level of the slice's other channel
+ */
+void PwmOutput::configure()
+{
+#ifdef ARDUINO_ARCH_RP2040
+    const PwmSliceConfig config = computeSliceConfig(clock_get_hz(clk_sys), m_frequencyHz);
+    const uint slice = pwm_gpio_to_slice_num(m_pin);
+    gpio_set_function(m_pin, GPIO_FUNC_PWM);
+    pwm_set_clkdiv_int_frac(slice, static_cast<uint8_t>(config.divider16 >> 4),
+                            static_cast<uint8_t>(config.divider16 & 0xF));
+    pwm_set_wrap(slice, config.wrap);
+    pwm_set_enabled(slice, true);
+    m_levelShift = config.levelShift;
+#endif
+    m_configured = true;
+}
+
+/**
+ * @brief Work out the divider and counter top for a PWM frequency
+ *
+ * @param[in] clockHz System clock feeding the slice
+ * @param[in] frequencyHz PWM frequency wanted
+ * @return PwmSliceConfig Smallest counter top, from PWM_WRAP in powers of two, whose
+ *         divider fits in 8.4 fixed point
+ */
+PwmSliceConfig PwmOutput::computeSliceConfig(uint32_t clockHz, uint32_t frequencyHz)
+{
+    // A wider counter keeps the divider in range at low frequencies, at the cost of
+    // the levels only using every 2^shift-th step of it
+    const uint64_t clock16 = static_cast<uint64_t>(clockHz) << 4;
+    const uint64_t frequency = std::max<uint32_t>(frequencyHz, 1);
+    uint8_t shift = 0;
+    uint64_t divider16 = 0;
+    for (;; shift++)
+    {
+        const uint64_t period = (static_cast<uint64_t>(PwmOutputConstants::PWM_WRAP) + 1)
+                                << shift;
+        divider16 = (clock16 + period * frequency / 2) / (period * frequency);
+        if (divider16 <= PwmOutputConstants::MAX_DIVIDER_16THS ||
+            shift == PwmOutputConstants::MAX_LEVEL_SHIFT)
+        {
+            break;
+        }
+    }
+
+    PwmSliceConfig config;
+    config.divider16 = static_cast<uint16_t>(
+        std::min<uint64_t>(std::max<uint64_t>(divider16, PwmOutputConstants::MIN_DIVIDER_16THS),
+                           PwmOutputConstants::MAX_DIVIDER_16THS));
+    config.wrap = static_cast<uint16_t>(((PwmOutputConstants::PWM_WRAP + 1) << shift) - 1);
+    config.levelShift = shift;
+    return config;
+}
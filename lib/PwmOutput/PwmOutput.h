@@ -0,0 +1,151 @@
+/**
+ * @file PwmOutput.h
+ * @brief Write-on-change PWM output channel for the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the PwmOutput class which remembers the level last written to a PWM
+ * pin and only touches the hardware when a new level differs. analogWrite reconfigures
+ * the GPIO function and the PWM slice on every call; a PwmOutput configures the slice
+ * once, on its first write, and afterwards only sets the channel's compare level.
+ *
+ * The slice's clock divider is 8.4 fixed point and tops out just below 256, which at
+ * the system clock is too little for 1 kHz with an 8-bit counter. As analogWrite does,
+ * the counter top is then doubled until the divider fits, and levels are scaled up to
+ * the wider counter.
+ *
+ * On the native build the write goes to analogWrite so tests can observe it, and every
+ * hardware write is counted so a test can hold the write rate down.
+ */
+
+#ifndef Y_SERIES_USB_HUB_PWM_OUTPUT_H
+#define Y_SERIES_USB_HUB_PWM_OUTPUT_H
+
+// System includes
+#include <Arduino.h>
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/pwm.h>
+#endif
+
+/**
+ * @brief Contains constants used by the PwmOutput class
+ */
+namespace PwmOutputConstants
+{
+constexpr uint32_t DEFAULT_FREQUENCY_HZ = 1000;  ///< PWM frequency, as analogWrite uses
+constexpr uint32_t PWM_WRAP = 255;               ///< PWM counter top for 8-bit levels
+constexpr int16_t UNKNOWN_LEVEL = -1;            ///< Level before the first write
+
+/// @name Slice Clock
+/// @{
+constexpr uint16_t MIN_DIVIDER_16THS = 1 << 4;          ///< Divider of 1.0 in 8.4 fixed point
+constexpr uint16_t MAX_DIVIDER_16THS = (256 << 4) - 1;  ///< Divider of 255.9375
+constexpr uint8_t MAX_LEVEL_SHIFT = 8;                  ///< Counter top of 65535 at most
+/// @}
+}  // namespace PwmOutputConstants
+
+/**
+ * @brief Slice settings that give a PWM frequency from the system clock
+ */
+struct PwmSliceConfig
+{
+    uint16_t divider16;  ///< Clock divider in 16ths (8.4 fixed point)
+    uint16_t wrap;       ///< Counter top
+    uint8_t levelShift;  ///< Shift from an 8-bit level to a compare level
+};
+
+/**
+ * @brief One PWM pin that is only written when its level changes
+ *
+ * @note Both channels of a slice may be driven by separate PwmOutputs at the same
+ *       frequency; configuring the slice leaves the other channel's level alone
+ */
+class PwmOutput
+{
+public:
+    /**
+     * @brief Construct a new PWM output
+     *
+     * @param[in] pin GPIO pin to drive
+     * @param[in] frequencyHz PWM frequency of the pin's slice
+     */
+    explicit PwmOutput(uint8_t pin,
+                       uint32_t frequencyHz = PwmOutputConstants::DEFAULT_FREQUENCY_HZ);
+
+    // Prevent copying and assignment
+    PwmOutput(const PwmOutput&) = delete;
+    PwmOutput& operator=(const PwmOutput&) = delete;
+
+    /**
+     * @brief Set the output level
+     *
+     * @param[in] level Duty (0-255)
+     * @return true if the hardware was written, false if the level was already set
+     */
+    bool write(uint8_t level);
+
+    /**
+     * @brief Forget the last level so the next write reaches the hardware
+     *
+     * @note For when something else has driven the pin, such as analogWrite at start up
+     */
+    void invalidate() { m_level = PwmOutputConstants::UNKNOWN_LEVEL; }
+
+    /// @name Getters
+    /// @{
+    /**
+     * @brief Get the pin this output drives
+     * @return uint8_t GPIO pin
+     */
+    uint8_t getPin() const { return m_pin; }
+
+    /**
+     * @brief Get the level last written
+     * @return int16_t Duty (0-255), or UNKNOWN_LEVEL before the first write
+     */
+    int16_t getLevel() const { return m_level; }
+
+    /**
+     * @brief Get the number of writes that reached this output's hardware
+     * @return uint32_t Hardware writes
+     */
+    uint32_t getWriteCount() const { return m_writeCount; }
+
+    /**
+     * @brief Get the number of writes that reached the hardware over all outputs
+     * @return uint32_t Hardware writes since start up
+     */
+    static uint32_t getTotalWriteCount() { return s_totalWriteCount; }
+    /// @}
+
+    /**
+     * @brief Work out the divider and counter top for a PWM frequency
+     *
+     * @param[in] clockHz System clock feeding the slice
+     * @param[in] frequencyHz PWM frequency wanted
+     * @return PwmSliceConfig Smallest counter top, from PWM_WRAP in powers of two, whose
+     *         divider fits in 8.4 fixed point
+     *
+     * @note A frequency out of reach gets the divider clamped to its range, and so the
+     *       nearest frequency the slice can make
+     */
+    static PwmSliceConfig computeSliceConfig(uint32_t clockHz, uint32_t frequencyHz);
+
+private:
+    /**
+     * @brief Hand the pin to its PWM slice and set the slice's frequency
+     */
+    void configure();
+
+    uint8_t m_pin;           ///< GPIO pin driven
+    uint32_t m_frequencyHz;  ///< PWM frequency of the slice
+    bool m_configured;       ///< True once the slice has been set up
+    uint8_t m_levelShift;    ///< Shift from a level to the slice's compare level
+    int16_t m_level;         ///< Level last written, or UNKNOWN_LEVEL
+    uint32_t m_writeCount;   ///< Writes that reached the hardware
+
+    static uint32_t s_totalWriteCount;  ///< Writes that reached the hardware, all outputs
+};
+
+#endif  // Y_SERIES_USB_HUB_PWM_OUTPUT_H
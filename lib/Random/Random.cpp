@@ -0,0 +1,159 @@
+/**
+ * @file Random.cpp
+ * @brief Implementation of the RandomGenerator class for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file implements the RandomGenerator class which draws xoshiro128** values and
+ * reduces them to bounded ranges without bias.
+ */
+
+#include "Random.h"
+
+#ifdef ARDUINO_ARCH_RP2040
+#include <hardware/structs/rosc.h>
+#endif
+
+namespace
+{
+inline uint32_t rotateLeft(uint32_t value, uint8_t bits)
+{
+    return (value << bits) | (value >> (32 - bits));
+}
+
+// Finalizer of MurmurHash3, which spreads every bit of the input over the output
+inline uint32_t mix(uint32_t value)
+{
+    value = (value ^ (value >> 16)) * 0x85EBCA6BUL;
+    value = (value ^ (value >> 13)) * 0xC2B2AE35UL;
+    return value ^ (value >> 16);
+}
+
+// Number of leading zero bits, for a value that is not 0
+inline uint8_t leadingZeros(uint32_t value)
+{
+    return static_cast<uint8_t>(__builtin_clz(value));
+}
+}  // namespace
+
+// Global generator, reseeded from the hardware in setup()
+RandomGenerator Rng;
+
+/**
+ * @brief Construct a generator
+ *
+ * @param[in] seed Seed, expanded into the 128-bit state
+ */
+RandomGenerator::RandomGenerator(uint32_t seed) : m_state{}
+{
+    this->seed(seed);
+}
+
+/**
+ * @brief Restart the sequence from a seed
+ *
+ * @param[in] seed Seed, expanded into the 128-bit state
+ *
+ * @details
+ * Each state word is the mixed seed plus a multiple of the golden ratio, so that nearby
+ * seeds give unrelated sequences.
+ */
+void RandomGenerator::seed(uint32_t seed)
+{
+    uint32_t any = 0;
+    for (uint32_t& word : m_state)
+    {
+        seed += RandomConstants::SEED_INCREMENT;
+        word = mix(seed);
+        any |= word;
+    }
+    // The all-zero state would only ever produce zeros
+    if (any == 0)
+    {
+        m_state[0] = RandomConstants::SEED_INCREMENT;
+    }
+}
+
+/**
+ * @brief Draw 32 random bits
+ *
+ * @return uint32_t Next value of the sequence
+ */
+uint32_t RandomGenerator::next()
+{
+    const uint32_t result = rotateLeft(m_state[1] * 5, 7) * 9;
+    const uint32_t shifted = m_state[1] << 9;
+
+    m_state[2] ^= m_state[0];
+    m_state[3] ^= m_state[1];
+    m_state[1] ^= m_state[2];
+    m_state[0] ^= m_state[3];
+    m_state[2] ^= shifted;
+    m_state[3] = rotateLeft(m_state[3], 11);
+    return result;
+}
+
+/**
+ * @brief Draw a value below a bound, without modulo bias
+ *
+ * @param[in] bound Number of possible values
+ * @return uint32_t Value in [0, bound), 0 if bound is 0
+ *
+ * @details
+ * Keeps just enough top bits to cover the bound and draws again while the value is out
+ * of range, which happens less than half the time.
+ */
+uint32_t RandomGenerator::below(uint32_t bound)
+{
+    if (bound <= 1)
+    {
+        return 0;
+    }
+    const uint8_t shift = leadingZeros(bound - 1);
+    uint32_t value;
+    do
+    {
+        value = next() >> shift;
+    } while (value >= bound);
+    return value;
+}
+
+/**
+ * @brief Draw a value in a range, as Arduino random(lo, hi) does
+ *
+ * @param[in] lo Smallest value
+ * @param[in] hi One past the largest value
+ * @return long Value in [lo, hi), lo if hi is not above lo
+ */
+long RandomGenerator::range(long lo, long hi)
+{
+    if (hi <= lo)
+    {
+        return lo;
+    }
+    return lo + static_cast<long>(below(static_cast<uint32_t>(hi - lo)));
+}
+
+/**
+ * @brief Read a seed from the hardware
+ *
+ * @return uint32_t Ring oscillator noise on the RP2040, DEFAULT_SEED natively
+ *
+ * @details
+ * The ring oscillator's random bit is jitter between two free-running clocks. Single
+ * bits are slightly biased and correlated, so 32 of them are mixed into the seed.
+ */
+uint32_t RandomGenerator::hardwareSeed()
+{
+#ifdef ARDUINO_ARCH_RP2040
+    uint32_t bits = 0;
+    for (uint8_t i = 0; i < RandomConstants::HARDWARE_SEED_BITS; i++)
+    {
+        bits = (bits << 1) | (rosc_hw->randombit & 1U);
+    }
+    return mix(bits);
+#else
+    return RandomConstants::DEFAULT_SEED;
+#endif
+}
@@ -0,0 +1,107 @@
+/**
+ * @file Random.h
+ * @brief Fast deterministic random number generator for the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file defines the RandomGenerator class, a xoshiro128** generator that every
+ * module draws its randomness from through the global Rng instance. It replaces Arduino
+ * random() and the C library rand():
+ *
+ * - Each draw is a handful of shifts, xors and two multiplies by small constants, with
+ *   no division, which suits the Cortex-M0+ of the RP2040
+ * - Bounded draws are unbiased: the top bits are taken and out-of-range values are
+ *   drawn again, instead of reducing modulo the bound
+ * - The firmware seeds it from the RP2040 ring oscillator at boot, so each power-up
+ *   behaves differently; natively it starts from DEFAULT_SEED, so tests and the host
+ *   simulator are reproducible without stubbing random()
+ */
+
+#ifndef Y_SERIES_USB_HUB_RANDOM_H
+#define Y_SERIES_USB_HUB_RANDOM_H
+
+// System includes
+#include <Arduino.h>
+
+/**
+ * @brief Contains constants used by the RandomGenerator class
+ */
+namespace RandomConstants
+{
+/// @name Seeding
+/// @{
+constexpr uint32_t DEFAULT_SEED = 1;             ///< Seed natively and at construction
+constexpr uint32_t SEED_INCREMENT = 0x9E3779B9;  ///< Golden-ratio step between state words
+constexpr uint8_t HARDWARE_SEED_BITS = 32;       ///< Ring oscillator bits read for a seed
+/// @}
+}  // namespace RandomConstants
+
+/**
+ * @brief xoshiro128** pseudo-random number generator
+ *
+ * @details
+ * The state is 128 bits, so the sequence only repeats after 2^128 - 1 draws. Copies are
+ * allowed: a copy continues the same sequence, which lets a test predict the draws a
+ * module is about to make.
+ */
+class RandomGenerator
+{
+public:
+    /**
+     * @brief Construct a generator
+     *
+     * @param[in] seed Seed, expanded into the 128-bit state
+     */
+    explicit RandomGenerator(uint32_t seed = RandomConstants::DEFAULT_SEED);
+
+    /**
+     * @brief Restart the sequence from a seed
+     *
+     * @param[in] seed Seed, expanded into the 128-bit state
+     */
+    void seed(uint32_t seed);
+
+    /**
+     * @brief Draw 32 random bits
+     *
+     * @return uint32_t Next value of the sequence
+     */
+    uint32_t next();
+
+    /**
+     * @brief Draw a value below a bound, without modulo bias
+     *
+     * @param[in] bound Number of possible values
+     * @return uint32_t Value in [0, bound), 0 if bound is 0
+     */
+    uint32_t below(uint32_t bound);
+
+    /**
+     * @brief Draw a value in a range, as Arduino random(lo, hi) does
+     *
+     * @param[in] lo Smallest value
+     * @param[in] hi One past the largest value
+     * @return long Value in [lo, hi), lo if hi is not above lo
+     */
+    long range(long lo, long hi);
+
+    /**
+     * @brief Read a seed from the hardware
+     *
+     * @return uint32_t Ring oscillator noise on the RP2040, DEFAULT_SEED natively
+     */
+    static uint32_t hardwareSeed();
+
+private:
+    uint32_t m_state[4];  ///< xoshiro128 state, never all zero
+};
+
+/**
+ * @brief Global generator shared by all modules
+ *
+ * @note Seeded with DEFAULT_SEED until setup() reseeds it from hardwareSeed()
+ */
+extern RandomGenerator Rng;
+
+#endif  // Y_SERIES_USB_HUB_RANDOM_H
@@ -0,0 +1,25 @@
+/**
+ * @file SpriteData.cpp
+ * @brief Implementation of eye sprite clip storage for Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This file collects the generated sprite clip headers. The encoded frames stay in
+ * program memory (PROGMEM); only the small clip descriptors are referenced from here.
+ * The source frames of each clip are kept in assets/sprites/.
+ */
+
+#include "SpriteData.h"
+
+// Include the generated sprite clips
+// These are generated with .scripts/sprite_to_header.py
+#include "sprite_boot_spin.h"
+
+// Array of pointers to all sprite clips
+// The order of clips in this array must match the clip indices in SpriteData.h
+const EyeSpriteClip* const sprite_clips[NUM_SPRITE_CLIPS] = {&sprite_boot_spin};
+
+// Static assertion to ensure data consistency
+static_assert(sizeof(sprite_clips) / sizeof(sprite_clips[0]) == NUM_SPRITE_CLIPS,
+              "Mismatch between NUM_SPRITE_CLIPS and sprite_clips array size");
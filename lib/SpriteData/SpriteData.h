@@ -0,0 +1,50 @@
+/**
+ * @file SpriteData.h
+ * @brief Eye sprite clip storage for the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * This module provides the precompiled eye sprite clips stored in program memory
+ * (PROGMEM). Each clip is generated from a CSV or image frame sequence with
+ * `make sprite-to-header` and played by EyeAnimation::playSprite().
+ */
+
+#ifndef Y_SERIES_USB_HUB_SPRITE_DATA_H
+#define Y_SERIES_USB_HUB_SPRITE_DATA_H
+
+// System includes
+#include <Arduino.h>
+
+// Project includes
+#include <EyeSprite.h>
+
+/**
+ * @brief Number of available sprite clips in the system
+ */
+static constexpr uint8_t NUM_SPRITE_CLIPS = 1;
+
+/// @name Clip Indices
+/// @{
+static constexpr uint8_t SPRITE_BOOT_SPIN = 0;  ///< Blue comet circling the ring at start-up
+/// @}
+
+/**
+ * @brief Array of pointers to all sprite clips
+ *
+ * @note The order of clips in this array must match the clip indices above
+ */
+extern const EyeSpriteClip* const sprite_clips[NUM_SPRITE_CLIPS];
+
+/**
+ * @brief Get a sprite clip
+ *
+ * @param[in] index Index of the clip (0 to NUM_SPRITE_CLIPS-1)
+ * @return const EyeSpriteClip* Clip descriptor, or nullptr if index is invalid
+ */
+inline const EyeSpriteClip* getSpriteClip(uint8_t index)
+{
+    return (index < NUM_SPRITE_CLIPS) ? sprite_clips[index] : nullptr;
+}
+
+#endif  // Y_SERIES_USB_HUB_SPRITE_DATA_H
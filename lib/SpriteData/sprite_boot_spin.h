@@ -0,0 +1,65 @@
+// Auto-generated from boot_spin.csv
+#ifndef SPRITE_BOOT_SPIN_H
+#define SPRITE_BOOT_SPIN_H
+
+#include <Arduino.h>
+#include <EyeSprite.h>
+
+// 32 frames of 17 pixels, 582 bytes (1632 raw)
+const uint8_t sprite_boot_spin_data[] PROGMEM = {
+    0x80, 0x21, 0xdd, 0xf5, 0x0b, 0x83, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d,
+    0x10, 0x6e, 0x7a, 0x00, 0x00, 0xff, 0xff, 0x81, 0x10, 0x6e, 0x7a, 0x21,
+    0xdd, 0xf5, 0x0a, 0x82, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37,
+    0x3d, 0xff, 0x82, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5,
+    0x0a, 0x81, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0xff, 0x83, 0x04, 0x1b,
+    0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0x0a, 0x80,
+    0x00, 0x00, 0x00, 0xff, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08,
+    0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff, 0x00, 0x84, 0x00,
+    0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21,
+    0xdd, 0xf5, 0xff, 0x01, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08,
+    0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff, 0x02, 0x84, 0x00,
+    0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21,
+    0xdd, 0xf5, 0xff, 0x03, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08,
+    0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff, 0x04, 0x84, 0x00,
+    0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21,
+    0xdd, 0xf5, 0xff, 0x05, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08,
+    0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff, 0x06, 0x84, 0x00,
+    0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21,
+    0xdd, 0xf5, 0xff, 0x07, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08,
+    0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff, 0x08, 0x84, 0x00,
+    0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21,
+    0xdd, 0xf5, 0xff, 0x09, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08,
+    0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff, 0x0a, 0x84, 0x00,
+    0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21,
+    0xdd, 0xf5, 0xff, 0x80, 0x21, 0xdd, 0xf5, 0x0a, 0x83, 0x00, 0x00, 0x00,
+    0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0xff, 0x81, 0x10,
+    0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0x0a, 0x82, 0x00, 0x00, 0x00, 0x04, 0x1b,
+    0x1e, 0x08, 0x37, 0x3d, 0xff, 0x82, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a,
+    0x21, 0xdd, 0xf5, 0x0a, 0x81, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0xff,
+    0x83, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd,
+    0xf5, 0x0a, 0x80, 0x00, 0x00, 0x00, 0xff, 0x84, 0x00, 0x00, 0x00, 0x04,
+    0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff,
+    0x00, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10,
+    0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff, 0x01, 0x84, 0x00, 0x00, 0x00, 0x04,
+    0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff,
+    0x02, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10,
+    0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff, 0x03, 0x84, 0x00, 0x00, 0x00, 0x04,
+    0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff,
+    0x04, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10,
+    0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff, 0x05, 0x84, 0x00, 0x00, 0x00, 0x04,
+    0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff,
+    0x06, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10,
+    0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff, 0x07, 0x84, 0x00, 0x00, 0x00, 0x04,
+    0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff,
+    0x08, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10,
+    0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff, 0x09, 0x84, 0x00, 0x00, 0x00, 0x04,
+    0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10, 0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff,
+    0x0a, 0x84, 0x00, 0x00, 0x00, 0x04, 0x1b, 0x1e, 0x08, 0x37, 0x3d, 0x10,
+    0x6e, 0x7a, 0x21, 0xdd, 0xf5, 0xff,
+};
+
+// Clip descriptor: data, size, frames, ms per frame, pixels per frame
+const EyeSpriteClip sprite_boot_spin = {
+    sprite_boot_spin_data, sizeof(sprite_boot_spin_data), 32, 30, 17};
+
+#endif // SPRITE_BOOT_SPIN_H
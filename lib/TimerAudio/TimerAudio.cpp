@@ -35,6 +35,7 @@ TimerAudio::TimerAudio(uint8_t pinPos, uint8_t pinNeg, uint32_t sampleRate)
       m_currentWavData(nullptr),
       m_currentWavSize(0),
       m_currentPosition(0),
+      m_samplesPlayed(0),
       m_isPlaying(false),
       m_skipWavHeader(true)
 #ifdef ARDUINO_ARCH_RP2040
@@ -148,6 +149,7 @@ void TimerAudio::playWAV(uint8_t wavIndex)
 
     // Initialize playback
     m_currentPosition = 0;
+    m_samplesPlayed = 0;
     m_isPlaying = false;
 
     // CRITICAL: Verify data exists before attempting to play
@@ -230,6 +232,7 @@ void TimerAudio::updateSample()
     // Read next audio sample from PROGMEM
     uint8_t sample = pgm_read_byte((const void*)&m_currentWavData[m_currentPosition]);
     m_currentPosition++;
+    m_samplesPlayed++;
 #ifdef ARDUINO_ARCH_RP2040
     // Convert 8-bit WAV sample to differential PWM
     // WAV data is 0x80 centered (128), so we use it directly
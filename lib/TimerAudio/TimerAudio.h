@@ -121,6 +121,20 @@ public:
      * @return true if audio is playing, false otherwise
      */
     bool isPlaying() const { return m_isPlaying; }
+
+    /**
+     * @brief Get the number of samples output since playback started
+     *
+     * @return uint32_t Samples of the current or last sound, the clock shows are cued to
+     */
+    uint32_t getSamplesPlayed() const { return m_samplesPlayed; }
+
+    /**
+     * @brief Get the sample rate
+     *
+     * @return uint32_t Sample rate in Hz
+     */
+    uint32_t getSampleRate() const { return m_sampleRate; }
     /// @}
 
     /// @name Internal Methods (called by timer interrupt)
@@ -152,6 +166,7 @@ private:
     volatile const uint8_t* m_currentWavData;  ///< Pointer to current WAV data
     volatile size_t m_currentWavSize;          ///< Size of current WAV data
     volatile size_t m_currentPosition;         ///< Current playback position
+    volatile uint32_t m_samplesPlayed;         ///< Samples output since playback started
     volatile bool m_isPlaying;                 ///< True if audio is playing
     volatile bool m_skipWavHeader;             ///< True to skip WAV headers
     /// @}
@@ -5,8 +5,24 @@
 
 #include "Animation.h"
 #include "AnimationInputs.h"
+#include "BehaviorData.h"
+#include "BehaviorScript.h"
+#include "BehaviorVm.h"
+#include "Choreography.h"
+#include "Debouncer.h"
+#include "DomeLed.h"
 #include "EyeAnimation.h"
+#include "FrameStream.h"
+#include "HeadEstimator.h"
+#include "InputEvents.h"
+#include "InputTrace.h"
+#include "LedStrips.h"
 #include "Logger.h"
+#include "MotionPlanner.h"
+#include "MotorDriver.h"
+#include "Occupancy.h"
+#include "Random.h"
+#include <SpriteData.h>
 #include <WavData.h>
 #include <TimerAudio.h>
 
@@ -27,6 +43,18 @@
 
 #define NUMPIXELS 17
 
+// Optional accent strip per lightsaber port, enable with -DSABER_ACCENT_STRIPS
+#define NUM_SABER_STRIPS 4
+#define NUM_SABER_PIXELS 8
+static const uint8_t saberStripPins[NUM_SABER_STRIPS] = {2, 18, 19, 20};
+
+// Behavior logic and the eye output pass, which interpolates between its frames, run at
+// the rates of the power tier the occupancy estimate picks (100 Hz and 250 Hz when active)
+#define FRAME_STATS_INTERVAL_MS 10000        // How often eye frame rates are logged
+#define OCCUPANCY_REPORT_INTERVAL_MS 600000  // How often power tier residency is logged
+#define FAREWELL_DELAY_MS 1500               // Pause between the motion leaving and the goodbye
+#define GREETING_QUIET_MS 30000              // Quiet spell after which an arrival is greeted
+
 // Create AnimationPins with custom pin values
 AnimationPins customPins(PIN_EYE_NEOPIXEL, PIN_NECK_MOTOR_IN1, PIN_NECK_MOTOR_IN2, PIN_SENSOR_LEFT,
                          PIN_SENSOR_RIGHT, PIN_PIR_SENSOR, PIN_BUTTON_RECTANGLE, PIN_BUTTON_CIRCLE,
@@ -35,10 +63,88 @@ AnimationPins customPins(PIN_EYE_NEOPIXEL, PIN_NECK_MOTOR_IN1, PIN_NECK_MOTOR_IN
 
 Adafruit_NeoPixel neoPixel(NUMPIXELS, customPins.eyeNeck, NEO_GRB + NEO_KHZ800);
 EyeAnimation eyeAnimation(&neoPixel);
+LedStrips saberStrips;
+FrameStream frameStream;
+BehaviorVmLoader behaviorLoader;
+HeadEstimator headEstimator;
+OccupancyEstimator occupancy;
+Debouncer inputDebouncer(customPins);
+InputEdgeCapture inputEdges(customPins);
+InputTrace inputTrace;
+MotorDriver neckMotor(PIN_NECK_MOTOR_IN1, PIN_NECK_MOTOR_IN2);
+MotionPlanner neckPlanner(neckMotor, AnimationConstants::kMinSpeed);
+DomeLed domeLed(PIN_DOME_LED_GREEN);
 TimerAudio timerAudio(customPins.audioOutPos, customPins.audioOutNeg);
 AudioPlayer audioPlayer(&timerAudio);
 
 Animation animation(&eyeAnimation, &audioPlayer, customPins);
+ScriptScheduler behaviorScripts;
+
+// Sighs when the motion in front of the PIR sensor stops, unless it comes back
+class FarewellScript : public BehaviorScript
+{
+public:
+    explicit FarewellScript(Animation& animation) : m_animation(animation) {}
+
+protected:
+    void run() override
+    {
+        SCRIPT_BEGIN();
+        while (true)
+        {
+            SCRIPT_AWAIT_PIR_EDGE();
+            if (getPirSensor() != LOW)
+            {
+                continue;
+            }
+            SCRIPT_AWAIT_SOUND_DONE();
+            SCRIPT_SLEEP_MS(FAREWELL_DELAY_MS);
+            if (getPirSensor() == LOW)
+            {
+                m_animation.playShow(ShowTrigger::Sad);
+            }
+        }
+        SCRIPT_END();
+    }
+
+private:
+    Animation& m_animation;
+};
+
+// Greets motion arriving after a quiet spell, startled if it wakes the hub from sleep
+class GreetingScript : public BehaviorScript
+{
+public:
+    explicit GreetingScript(Animation& animation) : m_animation(animation) {}
+
+protected:
+    void run() override
+    {
+        SCRIPT_BEGIN();
+        while (true)
+        {
+            SCRIPT_AWAIT_PIR_EDGE();
+            if (getPirSensor() == LOW)
+            {
+                m_lastMotionTime = now();
+                continue;
+            }
+            if (now() - m_lastMotionTime >= AnimationConstants::kEyeResetInterval)
+            {
+                m_animation.playShow(ShowTrigger::Startled);
+            }
+            else if (now() - m_lastMotionTime >= GREETING_QUIET_MS)
+            {
+                m_animation.playShow(ShowTrigger::Greeting);
+            }
+        }
+        SCRIPT_END();
+    }
+
+private:
+    Animation& m_animation;
+    unsigned long m_lastMotionTime = 0;  // When the motion last left
+};
 
 void setup()
 {
@@ -49,16 +155,38 @@ void setup()
     Log.setLogLevel(LogLevel::INFO);
     Log.raw("Starting up...");
 
+    // A different seed on each power-up; logged so a run can be replayed in the simulator
+    const uint32_t seed = RandomGenerator::hardwareSeed();
+    Rng.seed(seed);
+    Log.info("Random seed %lu", static_cast<unsigned long>(seed));
+
     // LED Setup
     pinMode(customPins.domeLedGreen, OUTPUT);
     pinMode(customPins.domeLedBlue, OUTPUT);
+    if (domeLed.begin())
+    {
+        animation.setDomeLed(&domeLed);
+    }
 
     // Neopixel Setup
     neoPixel.begin();
     neoPixel.clear();
     neoPixel.show();
+#ifdef SABER_ACCENT_STRIPS
+    for (uint8_t i = 0; i < NUM_SABER_STRIPS; i++)
+    {
+        saberStrips.addStrip(saberStripPins[i], NUM_SABER_PIXELS);
+    }
+    if (saberStrips.begin())
+    {
+        eyeAnimation.setAccentStrips(&saberStrips);
+    }
+#endif
     eyeAnimation.setTopPixels(5, 4);
+    eyeAnimation.setInterpolation(true);
+    eyeAnimation.setFrameStream(&frameStream);
     eyeAnimation.setCurrentTime(millis());
+    eyeAnimation.playSprite(getSpriteClip(SPRITE_BOOT_SPIN));
     eyeAnimation.blink(300);
 
     // Sensor Setup
@@ -75,6 +203,26 @@ void setup()
     pinMode(customPins.neckMotorIn2, OUTPUT);
     analogWrite(customPins.neckMotorIn1, LOW);
     analogWrite(customPins.neckMotorIn2, LOW);
+    if (neckMotor.begin())
+    {
+        animation.setMotorDriver(&neckMotor);
+        if (neckPlanner.begin())
+        {
+            animation.setMotionPlanner(&neckPlanner);
+        }
+    }
+
+    // The inputs are debounced from a 1 kHz timer, which queues only clean edges for the
+    // animation. Raw edges are still taken by interrupt, so that running into a hall
+    // sensor stops the neck from there rather than after the debounce or a logic pass.
+    inputDebouncer.begin();
+    inputEdges.setQueueEdges(false);
+    inputEdges.setLimitStop(&neckPlanner, &neckMotor);
+    inputEdges.begin();
+
+    // Measure the head travel with a sweep between the hall sensors
+    headEstimator.startCalibration(millis());
+    animation.setHeadEstimator(&headEstimator);
 
     // Audio Setup
     pinMode(PIN_AMP_SHDWM, OUTPUT);
@@ -84,36 +232,207 @@ void setup()
     analogWrite(customPins.audioOutPos, 255);
     timerAudio.begin();
     audioPlayer.play(4);
+
+    // Scripted behaviors
+    behaviorScripts.spawn<FarewellScript>(animation);
+    behaviorScripts.spawn<GreetingScript>(animation);
+    behaviorScripts.logFootprints();
+
+    // Holding the circle button at power-up runs the built-in sentry program
+    if (digitalRead(customPins.buttonCircle) == LOW)
+    {
+        const BehaviorProgram* sentry = getBehaviorProgram(BEHAVIOR_SENTRY);
+        animation.runProgram(sentry->code, sentry->length);
+    }
+}
+
+// Print the input trace for replay on the host. The loop waits for the whole dump, which
+// only happens when asked for, so the trace cannot change halfway through it.
+static void dumpInputTrace()
+{
+    char line[InputTraceConstants::MIN_LINE_SIZE];
+    size_t length;
+    for (uint16_t i = 0; (length = inputTrace.formatDumpLine(i, line, sizeof(line))) > 0; i++)
+    {
+        Serial.write(reinterpret_cast<const uint8_t*>(line), length);
+    }
+    Log.info("Input trace: %u records, %lu overwritten", inputTrace.size(),
+             inputTrace.getOverwritten());
+}
+
+// Hand each byte from the USB serial port to the parsers: eye frames and behavior
+// programs use different sync bytes, so each skips the other's messages, and a trace
+// dump is asked for in plain text
+static void pollSerial(unsigned long nowUs)
+{
+    while (Serial.available() > 0)
+    {
+        const int byte = Serial.read();
+        if (byte < 0)
+        {
+            break;
+        }
+        frameStream.receive(static_cast<uint8_t>(byte), nowUs);
+        if (behaviorLoader.receive(static_cast<uint8_t>(byte)))
+        {
+            animation.runProgram(behaviorLoader.getProgram(), behaviorLoader.getProgramLength());
+        }
+        if (inputTrace.receive(static_cast<uint8_t>(byte)))
+        {
+            dumpInputTrace();
+        }
+    }
+}
+
+// Log the eye's logic and output frame rates, the output pass's share of the CPU and the
+// health of a host frame stream
+static void reportFrameStats(unsigned long now)
+{
+    static unsigned long lastReportTime = 0;
+    const unsigned long elapsed = now - lastReportTime;
+    if (elapsed < FRAME_STATS_INTERVAL_MS)
+    {
+        return;
+    }
+
+    const EyeFrameStats& stats = eyeAnimation.getFrameStats();
+    Log.info("Eye: logic %lu fps, output %lu fps, %lu skipped, output CPU %lu.%lu%%",
+             stats.logicFrames * 1000UL / elapsed, stats.outputFrames * 1000UL / elapsed,
+             stats.skippedFrames, stats.outputTimeUs / (elapsed * 10UL),
+             (stats.outputTimeUs / elapsed) % 10UL);
+    eyeAnimation.resetFrameStats();
+
+    const FrameStreamStats& stream = frameStream.getStats();
+    if (stream.received > 0 || stream.corrupt > 0)
+    {
+        Log.info("Stream: %lu received, %lu shown, %lu dropped, %lu stale, %lu corrupt, "
+                 "latency avg %lu us max %lu us",
+                 stream.received, stream.shown, stream.dropped, stream.stale, stream.corrupt,
+                 stream.shown > 0 ? static_cast<unsigned long>(stream.totalLatencyUs / stream.shown)
+                                  : 0UL,
+                 stream.maxLatencyUs);
+    }
+    frameStream.resetStats();
+    lastReportTime = now;
+}
+
+// Log the time spent in each power tier, as a share of the report interval
+static void reportOccupancy(unsigned long now)
+{
+    static unsigned long lastReportTime = 0;
+    const unsigned long elapsed = now - lastReportTime;
+    if (elapsed < OCCUPANCY_REPORT_INTERVAL_MS)
+    {
+        return;
+    }
+
+    unsigned long shares[static_cast<uint8_t>(PowerTier::Count)];
+    for (uint8_t i = 0; i < static_cast<uint8_t>(PowerTier::Count); i++)
+    {
+        shares[i] = occupancy.getResidencyMs(static_cast<PowerTier>(i)) * 100UL / elapsed;
+    }
+    Log.info("Occupancy: %lu arrivals, now %s; active %lu%%, settled %lu%%, quiet %lu%%, "
+             "asleep %lu%%",
+             occupancy.getArrivals(), getPowerTierName(occupancy.getTier()), shares[0],
+             shares[1], shares[2], shares[3]);
+    occupancy.resetResidency(now);
+    lastReportTime = now;
+}
+
+// Log each limit stop made from the edge interrupt with its edge-to-release latency
+static void reportLimitStops()
+{
+    static uint32_t lastLimitStops = 0;
+    if (inputEdges.getLimitStops() == lastLimitStops)
+    {
+        return;
+    }
+    lastLimitStops = inputEdges.getLimitStops();
+    Log.info("Limit stop %lu: %lu us from edge to release (max %lu us); %lu debounced edges, "
+             "%lu dropped",
+             lastLimitStops, inputEdges.getLastLimitLatencyUs(),
+             inputEdges.getMaxLimitLatencyUs(), inputDebouncer.getEdges(),
+             inputDebouncer.getQueue().getDropped());
+}
+
+// Keep the amplifier powered while the tier asks for it or a sound is playing, and shut
+// it down otherwise
+static void updateAmplifier(const PowerProfile& power)
+{
+    static bool enabled = true;
+    const bool enable = power.amplifier || timerAudio.isPlaying();
+    if (enable != enabled)
+    {
+        digitalWrite(PIN_AMP_SHDWM, enable ? HIGH : LOW);
+        enabled = enable;
+    }
 }
 
 static uint8_t nextSoundIndex = 1;
 void loop()
 {
-    // Read sensor inputs
-    AnimationInputs inputs = readInputs(customPins);
+    static unsigned long lastLogicTime = 0;
+    static PowerTier lastTier = PowerTier::Active;
+    static uint8_t pendingChanges = AnimationInputBits::ALL;
+    const unsigned long now = millis();
 
-    Log.debug("Sensors: L%d R%d P%d B%d C%d", inputs.sensorLeft, inputs.sensorRight,
-              inputs.pirSensor, inputs.buttonRectangle, inputs.buttonCircle);
+    // Debounced levels of all inputs; changes seen on passes that skip the logic are
+    // carried over to the next pass that runs it. Every change goes in the input trace.
+    AnimationInputs inputs = inputDebouncer.read();
+    pendingChanges |= inputs.changed;
+    inputTrace.record(inputs);
 
-    static unsigned long lastAudioPlayTime = 0;
-    static unsigned long lastToggleTime = 0;
+    // The PIR is checked on every pass: an edge restores the full rate at once and runs
+    // the logic on this pass, however slowly it was running
+    const bool pirEdge = occupancy.update(now, inputs.pirSensor == HIGH);
+    const PowerProfile& power = occupancy.getProfile();
+    if (occupancy.getTier() != lastTier)
+    {
+        Log.info("Power tier %s -> %s", getPowerTierName(lastTier),
+                 getPowerTierName(occupancy.getTier()));
+        lastTier = occupancy.getTier();
+    }
 
-    // Once every 3 seconds, play a 1-second tone
-    if (inputs.buttonRectangle == LOW && inputs.buttonCircle == LOW)
+    if (pirEdge || now - lastLogicTime >= power.logicIntervalMs)
     {
-        animation.stop();
-        if (!timerAudio.isPlaying())
+        lastLogicTime = now;
+        inputs.changed = pendingChanges;
+        pendingChanges = 0;
+
+        Log.debug("Sensors: L%d R%d P%d B%d C%d", inputs.sensorLeft, inputs.sensorRight,
+                  inputs.pirSensor, inputs.buttonRectangle, inputs.buttonCircle);
+
+        static unsigned long lastAudioPlayTime = 0;
+        static unsigned long lastToggleTime = 0;
+
+        // Once every 3 seconds, play a 1-second tone
+        if (inputs.buttonRectangle == LOW && inputs.buttonCircle == LOW)
         {
-            timerAudio.playWAV(nextSoundIndex++);
-            nextSoundIndex = nextSoundIndex % NUM_SOUND_FILES;
+            animation.stop(MotorStop::Brake);
+            if (!timerAudio.isPlaying())
+            {
+                timerAudio.playWAV(nextSoundIndex++);
+                nextSoundIndex = nextSoundIndex % NUM_SOUND_FILES;
+            }
         }
+        // Update animation
+        animation.update(inputs);
+        animation.consumeInputEvents(inputDebouncer.getQueue());
+        animation.performRotate();
+        animation.eyeBlink();
+        animation.updateSound();
+        behaviorScripts.update(now, inputs.pirSensor, audioPlayer.isPlaying());
     }
-    // Update animation
-    animation.update(inputs);
-    animation.performRotate();
-    animation.eyeBlink();
-    animation.updateSound();
 
-    // Sleep for 10ms - this is more power efficient than delay
-    Watchdog.sleep(10);
+    // Pick up frames and programs from a host, then show the newest or an in-between eye
+    // frame
+    pollSerial(micros());
+    eyeAnimation.renderInterpolated(millis());
+    updateAmplifier(power);
+    reportFrameStats(now);
+    reportOccupancy(now);
+    reportLimitStops();
+
+    // Sleep until the next output pass - this is more power efficient than delay
+    Watchdog.sleep(power.outputIntervalMs);
 }
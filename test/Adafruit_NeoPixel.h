@@ -24,6 +24,7 @@ public:
     virtual uint32_t getPixelColor(uint16_t n) const = 0;
 
     virtual uint16_t numPixels() const { return numLEDs; }
+    virtual bool canShow() { return true; }
 
 private:
     uint16_t numLEDs;
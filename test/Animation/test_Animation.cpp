@@ -3,10 +3,22 @@
 
 #include "Animation.h"
 #include "EyeAnimation.h"
+#include "Random.h"
 #include "mock_helpers.h"
 
 using namespace fakeit;
 
+// Advance Rng until its next draw below bound is the given value
+static void advanceRngToDraw(uint32_t bound, uint32_t draw)
+{
+    RandomGenerator next = Rng;
+    while (next.below(bound) != draw)
+    {
+        Rng.next();
+        next = Rng;
+    }
+}
+
 void test_animation_initialization()
 {
     std::cout << "  Running test_animation_initialization()" << std::endl;
@@ -75,13 +87,7 @@ void test_set_rotation_direction_random()
     // Create mock objects
     const AnimationPins pins = AnimationPins();
 
-    // Mock random number generator
-    When(OverloadedMethod(ArduinoFake(), random, long(long, long)))
-        .AlwaysDo(
-            [](long min, long max)
-            {
-                return 100;  // Return a small number to favor left direction
-            });
+    Rng.seed(RandomConstants::DEFAULT_SEED);
 
     // Create animation object
     Animation i(nullptr, nullptr, pins);
@@ -116,18 +122,13 @@ void test_perform_rotate()
     // Create mock objects
     const AnimationPins pins = AnimationPins();
 
-    // Mock random number generator to return a specific speed
-    When(OverloadedMethod(ArduinoFake(), random, long(long)))
-        .AlwaysDo(
-            [](long max)
-            {
-                return 200;  // Return a speed value
-            });
+    // Any movement cycle outlasts this call; starting one may play a random sound
+    Rng.seed(RandomConstants::DEFAULT_SEED);
     When(Method(ArduinoFake(), digitalWrite)).AlwaysReturn();
     When(Method(ArduinoFake(), analogWrite)).AlwaysReturn();
     When(Method(ArduinoFake(), millis)).AlwaysReturn(1000);
-    When(OverloadedMethod(ArduinoFake(), random, long(long, long))).AlwaysReturn(0);
     When(Method(audioPlayerMock, play)).AlwaysReturn(true);
+    When(Method(audioPlayerMock, playRandomSound)).AlwaysReturn(true);
 
     // Create animation object
     Animation i(nullptr, &audioPlayerMock.get(), pins);
@@ -380,9 +381,22 @@ void test_rotate()
         // Call rotate with stop
         animation.rotate(AnimationConstants::kMaxMotorSpeed, MotorDirection::Stop);
 
-        // Verify motor was stopped
+        // Verify motor was stopped; IN2 was already low, so it is not written again
         Verify(Method(ArduinoFake(), analogWrite).Using(pins.neckMotorIn1, 0)).Once();
-        Verify(Method(ArduinoFake(), analogWrite).Using(pins.neckMotorIn2, 0)).Once();
+        Verify(Method(ArduinoFake(), analogWrite).Using(pins.neckMotorIn2, 0)).Never();
+    }
+
+    // Test 4: Brake
+    {
+        animation.rotate(AnimationConstants::kMaxMotorSpeed, MotorDirection::Right);
+        ArduinoFake().ClearInvocationHistory();
+
+        // A brake holds both inputs high
+        animation.stop(MotorStop::Brake);
+
+        Verify(Method(ArduinoFake(), analogWrite).Using(pins.neckMotorIn1, 255)).Once();
+        Verify(Method(ArduinoFake(), analogWrite).Using(pins.neckMotorIn2, 255)).Once();
+        TEST_ASSERT_EQUAL(MotorDirection::Stop, animation.getMotorDirection());
     }
 }
 
@@ -399,14 +413,10 @@ void test_perform_rotate_backward_duration()
     // When(Method(audioPlayerMock, isPlaying)).AlwaysReturn(false);
     // When(Method(audioPlayerMock, stop)).AlwaysReturn();
     When(Method(ArduinoFake(), analogWrite)).AlwaysReturn();
-    When(OverloadedMethod(ArduinoFake(), random, long(long, long)))
-        .AlwaysDo(
-            [](long min, long max)
-            {
-                return min;  // Return minimum speed for consistent testing
-            });
+    Rng.seed(RandomConstants::DEFAULT_SEED);
     When(Method(ArduinoFake(), millis)).AlwaysReturn(0);
     When(Method(audioPlayerMock, play)).AlwaysReturn(true);
+    When(Method(audioPlayerMock, playRandomSound)).AlwaysReturn(true);
 
     // Create animation object
     Animation animation(nullptr, &audioPlayerMock.get(), pins);
@@ -479,8 +489,8 @@ void test_set_rotation_direction_bias()
                   << ", leftBias: " << tc.expectedLeftBias
                   << ", rightBias: " << tc.expectedRightBias << std::endl;
 
-        // Set random to always choose the first option (left)
-        When(OverloadedMethod(ArduinoFake(), random, long(long))).AlwaysReturn(1000);
+        // Draw the top of the range, which always chooses the right-hand option
+        advanceRngToDraw(1000, 999);
 
         // Call the method with debug output
         animation.setRotationDirection();
@@ -495,8 +505,8 @@ void test_set_rotation_direction_bias()
         // Verify left bias was applied (Clockwise)
         TEST_ASSERT_EQUAL(MotorDirection::Right, actualDirection);
 
-        // Set random to always choose the second option (right)
-        When(OverloadedMethod(ArduinoFake(), random, long(long))).AlwaysReturn(0);
+        // Draw the bottom of the range, which always chooses the left-hand option
+        advanceRngToDraw(1000, 0);
 
         animation.setRandomRotateTimer(0);
         // Call the method again
@@ -567,13 +577,9 @@ void test_handle_pir_triggered_with_stopped_motor()
     // Create mock objects
     Animation obj(nullptr, &audioPlayerMock.get(), AnimationPins());
     Mock<Animation> spy(obj);
-    When(OverloadedMethod(ArduinoFake(), random, long(long, long)))
-        .AlwaysDo(
-            [](long min, long max)
-            {
-                return 100;  // Return a small number to favor left direction
-            });
+    Rng.seed(RandomConstants::DEFAULT_SEED);
     When(Method(audioPlayerMock, play)).AlwaysReturn(true);
+    When(Method(audioPlayerMock, playRandomSound)).AlwaysReturn(true);
 
     // Set up test conditions
     Animation& animation = spy.get();
@@ -0,0 +1,150 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "Animation.h"
+#include "HostSimulator.h"
+
+// The simulated head position on the estimator's scale between the sensor edges
+static float gazePosition(const HostSimulator& sim)
+{
+    const float band = HostSimulator::kHallBand;
+    return (sim.getHeadPosition() - band) / (1.0f - 2.0f * band);
+}
+
+// Step until the gaze arrives, returning the virtual time it took
+static unsigned long stepUntilArrived(HostSimulator& sim, unsigned long timeoutMs)
+{
+    const unsigned long start = sim.now();
+    while (!sim.animation().hasArrived() && sim.now() - start < timeoutMs)
+    {
+        sim.step(HostSimulator::kTickMs);
+    }
+    return sim.now() - start;
+}
+
+void test_animation_gaze_needs_calibration()
+{
+    std::cout << "  Running test_animation_gaze_needs_calibration()" << std::endl;
+
+    // The calibration sweep owns the motor until the travel is known
+    HostSimulator sim;
+    TEST_ASSERT_FALSE(sim.animation().lookAt(0.5f));
+    TEST_ASSERT_FALSE(sim.animation().isGazing());
+
+    sim.step(5000);
+    TEST_ASSERT_TRUE(sim.headEstimator().isCalibrated());
+    TEST_ASSERT_TRUE(sim.animation().lookAt(0.5f));
+    TEST_ASSERT_TRUE(sim.animation().isGazing());
+}
+
+void test_animation_gaze_reaches_targets()
+{
+    std::cout << "  Running test_animation_gaze_reaches_targets()" << std::endl;
+
+    HostSimulator sim;
+    sim.step(5000);
+
+    // Each target is reached, the head stops there, and arrival is reported once stopped
+    for (const float target : {0.25f, 0.8f, 0.5f, 0.1f, 0.12f})
+    {
+        TEST_ASSERT_TRUE(sim.animation().lookAt(target));
+        TEST_ASSERT_FALSE(sim.animation().hasArrived());
+        const unsigned long elapsed = stepUntilArrived(sim, 5000);
+        std::cout << "    target " << target << ": head at " << gazePosition(sim) << " after "
+                  << elapsed << " ms" << std::endl;
+        TEST_ASSERT_TRUE(sim.animation().hasArrived());
+        TEST_ASSERT_FLOAT_WITHIN(0.03f, target, gazePosition(sim));
+        TEST_ASSERT_EQUAL(0, sim.snapshot().speed);
+        TEST_ASSERT_EQUAL(MotorDirection::Stop, sim.animation().getMotorDirection());
+    }
+}
+
+void test_animation_gaze_follows_duration()
+{
+    std::cout << "  Running test_animation_gaze_follows_duration()" << std::endl;
+
+    HostSimulator sim;
+    sim.step(5000);
+    TEST_ASSERT_TRUE(sim.animation().lookAt(0.1f));
+    stepUntilArrived(sim, 5000);
+
+    // A longer duration cruises slower, within the duty limits of the motor
+    TEST_ASSERT_TRUE(sim.animation().lookAt(0.9f));
+    const unsigned long fastMs = stepUntilArrived(sim, 5000);
+    TEST_ASSERT_TRUE(sim.animation().lookAt(0.1f, 1500));
+    const unsigned long slowMs = stepUntilArrived(sim, 5000);
+    std::cout << "    fastest " << fastMs << " ms, asked for 1500 ms: " << slowMs << " ms"
+              << std::endl;
+    TEST_ASSERT_TRUE(slowMs > fastMs);
+    TEST_ASSERT_UINT32_WITHIN(200, 1500, slowMs);
+}
+
+void test_animation_gaze_holds_until_released()
+{
+    std::cout << "  Running test_animation_gaze_holds_until_released()" << std::endl;
+
+    HostSimulator sim;
+    sim.step(5000);
+    sim.setPir(true);
+
+    // Motion in front of the PIR does not move the head off its target
+    TEST_ASSERT_TRUE(sim.animation().lookAt(0.4f));
+    stepUntilArrived(sim, 5000);
+    const float held = sim.getHeadPosition();
+    sim.step(20000);
+    TEST_ASSERT_TRUE(sim.animation().hasArrived());
+    TEST_ASSERT_EQUAL_FLOAT(held, sim.getHeadPosition());
+
+    // Released, the behaviors move it again
+    sim.animation().releaseGaze();
+    TEST_ASSERT_FALSE(sim.animation().isGazing());
+    sim.step(30000);
+    TEST_ASSERT_TRUE(sim.getHeadPosition() != held);
+}
+
+void test_animation_gaze_blocked_at_limit()
+{
+    std::cout << "  Running test_animation_gaze_blocked_at_limit()" << std::endl;
+
+    HostSimulator sim;
+    sim.step(5000);
+    TEST_ASSERT_TRUE(sim.animation().lookAt(0.5f));
+    stepUntilArrived(sim, 5000);
+
+    // Turned by hand, the head meets the right hall sensor before the planned move ends
+    sim.moveHeadByHand(0.85f);
+    TEST_ASSERT_TRUE(sim.animation().lookAt(0.8f));
+    const unsigned long start = sim.now();
+    while (sim.animation().isGazing() && !sim.animation().hasArrived() &&
+           !sim.animation().isBlocked() && sim.now() - start < 5000)
+    {
+        sim.step(HostSimulator::kTickMs);
+    }
+    std::cout << "    head at " << gazePosition(sim) << ", estimate "
+              << sim.headEstimator().getPosition() << std::endl;
+    TEST_ASSERT_TRUE(sim.animation().isBlocked());
+    TEST_ASSERT_FALSE(sim.animation().hasArrived());
+    TEST_ASSERT_TRUE(sim.snapshot().sensorRight);
+    TEST_ASSERT_EQUAL(0, sim.snapshot().speed);
+    TEST_ASSERT_EQUAL(MotorDirection::Stop, sim.animation().getMotorDirection());
+
+    // Halted at the sensor it was aiming for, the gaze has arrived
+    TEST_ASSERT_TRUE(sim.animation().lookAt(0.5f));
+    stepUntilArrived(sim, 5000);
+    sim.moveHeadByHand(0.6f);
+    TEST_ASSERT_TRUE(sim.animation().lookAt(1.0f));
+    stepUntilArrived(sim, 5000);
+    TEST_ASSERT_TRUE(sim.animation().hasArrived());
+    TEST_ASSERT_FALSE(sim.animation().isBlocked());
+    TEST_ASSERT_TRUE(sim.snapshot().sensorRight);
+}
+
+void runAnimationGazeTests()
+{
+    std::cout << "\n==== Starting Animation Gaze Tests ====" << std::endl;
+    RUN_TEST(test_animation_gaze_needs_calibration);
+    RUN_TEST(test_animation_gaze_reaches_targets);
+    RUN_TEST(test_animation_gaze_follows_duration);
+    RUN_TEST(test_animation_gaze_holds_until_released);
+    RUN_TEST(test_animation_gaze_blocked_at_limit);
+}
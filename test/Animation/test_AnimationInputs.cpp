@@ -2,27 +2,43 @@
 #include <unity.h>
 
 #include "Animation.h"
+#include "HostSimulator.h"
 #include "mock_helpers.h"
 
-void test_read_inputs_from_pins()
-{
-    std::cout << "  Running test_read_inputs_from_pins()" << std::endl;
-
-    // Create mock objects
-    const AnimationPins pins = AnimationPins();
+// Calls to digitalRead since the stub was installed
+static uint32_t digitalReadCalls = 0;
 
-    // Mock Arduino functions
+static void stubInputs()
+{
+    digitalReadCalls = 0;
     When(Method(ArduinoFake(), digitalRead))
         .AlwaysDo(
             [](uint8_t pin)
             {
-                return HIGH;  // All pins are high
+                digitalReadCalls++;
+                return HIGH;
             });
-    When(Method(ArduinoFake(), millis)).Do([]() { return 1000; });
+    When(Method(ArduinoFake(), millis)).AlwaysDo([]() { return 1000UL; });
+}
+
+void test_read_inputs_from_pins()
+{
+    std::cout << "  Running test_read_inputs_from_pins()" << std::endl;
+
+    // Create mock objects
+    const AnimationPins pins = AnimationPins();
+    stubInputs();
+    mockGpioPort = 0;
+    mock_gpio_put(pins.sensorLeft, true);
+    mock_gpio_put(pins.sensorRight, true);
+    mock_gpio_put(pins.pirSensor, true);
+    mock_gpio_put(pins.buttonRectangle, true);
+    mock_gpio_put(pins.buttonCircle, true);
 
     // Read inputs from pins
     std::cout << "Reading inputs from pins..." << std::endl;
-    AnimationInputs inputs = readInputs(pins);
+    InputReader reader(pins);
+    AnimationInputs inputs = reader.read();
 
     // Verify inputs were read correctly
     std::cout << "Verifying inputs were read correctly..." << std::endl;
@@ -32,11 +48,112 @@ void test_read_inputs_from_pins()
     TEST_ASSERT_EQUAL(HIGH, inputs.buttonRectangle);
     TEST_ASSERT_EQUAL(HIGH, inputs.buttonCircle);
     TEST_ASSERT_EQUAL(1000, inputs.currentTime);
+
+    // Each input comes from its own pin's bit, and pins that are not inputs are ignored
+    mockGpioPort = ~0U;
+    mock_gpio_put(pins.pirSensor, false);
+    mock_gpio_put(pins.buttonCircle, false);
+    inputs = reader.read();
+    TEST_ASSERT_EQUAL(HIGH, inputs.sensorLeft);
+    TEST_ASSERT_EQUAL(HIGH, inputs.sensorRight);
+    TEST_ASSERT_EQUAL(LOW, inputs.pirSensor);
+    TEST_ASSERT_EQUAL(HIGH, inputs.buttonRectangle);
+    TEST_ASSERT_EQUAL(LOW, inputs.buttonCircle);
+    TEST_ASSERT_EQUAL(0, digitalReadCalls);
+}
+
+void test_read_inputs_reports_changes()
+{
+    std::cout << "  Running test_read_inputs_reports_changes()" << std::endl;
+    const AnimationPins pins = AnimationPins();
+    stubInputs();
+    mockGpioPort = 0;
+    InputReader reader(pins);
+
+    // The first snapshot has nothing to compare against
+    TEST_ASSERT_EQUAL(AnimationInputBits::ALL, reader.read().changed);
+    TEST_ASSERT_EQUAL(0, reader.read().changed);
+
+    mock_gpio_put(pins.sensorRight, true);
+    mock_gpio_put(pins.buttonRectangle, true);
+    TEST_ASSERT_EQUAL(AnimationInputBits::SENSOR_RIGHT | AnimationInputBits::BUTTON_RECTANGLE,
+                      reader.read().changed);
+    TEST_ASSERT_EQUAL(0, reader.read().changed);
+
+    // A pin that is not an input is not a change
+    mock_gpio_put(pins.eyeNeck, true);
+    TEST_ASSERT_EQUAL(0, reader.read().changed);
+    mock_gpio_put(pins.sensorRight, false);
+    TEST_ASSERT_EQUAL(AnimationInputBits::SENSOR_RIGHT, reader.read().changed);
+
+    // Inputs built by hand, without a reader, always count as changed
+    AnimationInputs manual;
+    TEST_ASSERT_EQUAL(AnimationInputBits::ALL, manual.changed);
+}
+
+void test_update_skips_unchanged_inputs()
+{
+    std::cout << "  Running test_update_skips_unchanged_inputs()" << std::endl;
+    Animation animation(nullptr, nullptr, AnimationPins());
+    AnimationInputs inputs = {HIGH, LOW, HIGH, LOW, HIGH, 100};
+    animation.update(inputs);
+    TEST_ASSERT_EQUAL(LOW, animation.getInputSensorRight());
+    TEST_ASSERT_EQUAL(HIGH, animation.getInputPIRSensor());
+
+    // A snapshot with no changes keeps the stored states but still moves the time on
+    inputs = {LOW, HIGH, LOW, HIGH, LOW, 200};
+    inputs.changed = 0;
+    animation.update(inputs);
+    TEST_ASSERT_EQUAL(HIGH, animation.getInputSensorLeft());
+    TEST_ASSERT_EQUAL(LOW, animation.getInputSensorRight());
+    TEST_ASSERT_EQUAL(HIGH, animation.getInputPIRSensor());
+    TEST_ASSERT_EQUAL(200, animation.getCurrentTime());
+
+    inputs.changed = AnimationInputBits::PIR_SENSOR;
+    animation.update(inputs);
+    TEST_ASSERT_EQUAL(LOW, animation.getInputPIRSensor());
+}
+
+void test_read_inputs_once_per_tick()
+{
+    std::cout << "  Running test_read_inputs_once_per_tick()" << std::endl;
+    HostSimulator sim(1);
+    When(Method(ArduinoFake(), digitalRead))
+        .AlwaysDo(
+            [](uint8_t pin)
+            {
+                digitalReadCalls++;
+                return HIGH;
+            });
+    digitalReadCalls = 0;
+
+    // A minute of motion and button presses: one port read per Debouncer sample, however
+    // often the logic runs, and no pin reads
+    const uint32_t readsBefore = mockGpioPortReads;
+    const uint32_t ticksBefore = sim.getLogicTicks();
+    sim.setPir(true);
+    sim.step(20000);
+    sim.setButtons(true, false);
+    sim.step(1000);
+    sim.setButtons(false, false);
+    sim.setPir(false);
+    sim.step(39000);
+
+    const uint32_t ticks = sim.getLogicTicks() - ticksBefore;
+    const uint32_t reads = mockGpioPortReads - readsBefore;
+    std::cout << "    " << reads << " port reads over " << ticks << " logic ticks ("
+              << reads * AnimationInputBits::COUNT << " digitalReads before)" << std::endl;
+    TEST_ASSERT_TRUE(ticks > 0);
+    TEST_ASSERT_EQUAL(60000UL * 1000UL / DebouncerConstants::SAMPLE_US, reads);
+    TEST_ASSERT_EQUAL(0, digitalReadCalls);
 }
 
 void runAnimationInputsTests()
 {
     UNITY_BEGIN();
     RUN_TEST(test_read_inputs_from_pins);
+    RUN_TEST(test_read_inputs_reports_changes);
+    RUN_TEST(test_update_skips_unchanged_inputs);
+    RUN_TEST(test_read_inputs_once_per_tick);
     UNITY_END();
 }
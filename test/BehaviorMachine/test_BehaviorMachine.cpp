@@ -0,0 +1,352 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+#include <algorithm>
+#include <vector>
+
+#include "Animation.h"
+#include "BehaviorMachine.h"
+
+// Records every action and answers guards and timers from its fields
+class RecordingBehaviors : public BehaviorHandler
+{
+public:
+    void runBehaviorAction(BehaviorAction action) override { actions.push_back(action); }
+
+    bool checkBehaviorGuard(BehaviorGuard guard) const override
+    {
+        return guard == BehaviorGuard::Always || (guards & guardBit(guard)) != 0;
+    }
+
+    unsigned long getBehaviorTimer(BehaviorTimer timer) const override
+    {
+        return timers[static_cast<uint8_t>(timer)];
+    }
+
+    static uint8_t guardBit(BehaviorGuard guard)
+    {
+        return static_cast<uint8_t>(1U << static_cast<uint8_t>(guard));
+    }
+
+    std::vector<BehaviorAction> actions;
+    uint8_t guards = 0;
+    unsigned long timers[BehaviorMachineConstants::TIMER_COUNT] = {};
+};
+
+static void assertActions(const std::vector<BehaviorAction>& expected,
+                          const std::vector<BehaviorAction>& actual)
+{
+    TEST_ASSERT_EQUAL(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size() && i < actual.size(); i++)
+    {
+        TEST_ASSERT_EQUAL(expected[i], actual[i]);
+    }
+}
+
+// One main loop pass of the behaviors, with buttons released
+static void stepBehavior(Animation& animation, unsigned long time, int pir, int sensorLeft = HIGH,
+                         int sensorRight = HIGH)
+{
+    AnimationInputs inputs;
+    inputs.sensorLeft = sensorLeft;
+    inputs.sensorRight = sensorRight;
+    inputs.pirSensor = pir;
+    inputs.buttonRectangle = HIGH;
+    inputs.buttonCircle = HIGH;
+    inputs.currentTime = time;
+    animation.update(inputs);
+    animation.performRotate();
+}
+
+// One pass with the hall sensor ahead of the head active; returns the way it backs off
+static MotorDirection stepIntoLimit(Animation& animation, unsigned long time)
+{
+    const bool movingLeft = animation.getMotorDirection() == MotorDirection::Left;
+    stepBehavior(animation, time, HIGH, movingLeft ? LOW : HIGH, movingLeft ? HIGH : LOW);
+    return movingLeft ? MotorDirection::Right : MotorDirection::Left;
+}
+
+// Seed whose first movement cycle outlasts two backing-off periods, as the cycle test needs
+constexpr uint32_t kBehaviorSeed = 1;
+
+static void seedBehaviorRandom()
+{
+    When(Method(ArduinoFake(), analogWrite)).AlwaysReturn();
+    Rng.seed(kBehaviorSeed);
+}
+
+void test_behavior_machine_takes_every_row()
+{
+    std::cout << "  Running test_behavior_machine_takes_every_row()" << std::endl;
+
+    // Each row is taken from its own state with only its guard holding
+    for (const BehaviorMachineConstants::Transition& row : BehaviorMachineConstants::TRANSITIONS)
+    {
+        RecordingBehaviors handler;
+        handler.guards = RecordingBehaviors::guardBit(row.guard);
+        BehaviorMachine machine(handler, row.state);
+
+        TEST_ASSERT_TRUE(machine.dispatch(row.event));
+        TEST_ASSERT_EQUAL(1, machine.getEventCount());
+        if (row.target == BehaviorState::None)
+        {
+            // Internal: no exits or entries, only the action
+            TEST_ASSERT_EQUAL(row.state, machine.getState());
+            assertActions({row.action}, handler.actions);
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(row.target, machine.getState());
+            if (row.action != BehaviorAction::None)
+            {
+                TEST_ASSERT_TRUE(std::find(handler.actions.begin(), handler.actions.end(),
+                                           row.action) != handler.actions.end());
+            }
+        }
+    }
+}
+
+void test_behavior_machine_exits_and_enters_in_order()
+{
+    std::cout << "  Running test_behavior_machine_exits_and_enters_in_order()" << std::endl;
+
+    RecordingBehaviors handler;
+    BehaviorMachine machine(handler);
+    TEST_ASSERT_EQUAL(BehaviorState::Idle, machine.getState());
+    TEST_ASSERT_TRUE(handler.actions.empty());
+
+    // Into a substate: the transition action, then the entries from the outside in
+    TEST_ASSERT_TRUE(machine.dispatch(BehaviorEvent::PirRise));
+    TEST_ASSERT_EQUAL(BehaviorState::Scanning, machine.getState());
+    assertActions({BehaviorAction::StartCycle, BehaviorAction::Notice, BehaviorAction::Turn},
+                  handler.actions);
+
+    // Between siblings the shared parent is neither left nor entered again
+    handler.actions.clear();
+    TEST_ASSERT_TRUE(machine.dispatch(BehaviorEvent::Limit));
+    TEST_ASSERT_EQUAL(BehaviorState::Reacting, machine.getState());
+    assertActions({BehaviorAction::Halt, BehaviorAction::Reverse}, handler.actions);
+
+    // Out of a substate: the exits from the inside out
+    handler.actions.clear();
+    TEST_ASSERT_TRUE(machine.dispatch(BehaviorEvent::PirFall));
+    TEST_ASSERT_EQUAL(BehaviorState::Idle, machine.getState());
+    assertActions({BehaviorAction::Halt, BehaviorAction::Calm}, handler.actions);
+
+    // Up to the enclosing state: only the substate is left
+    handler.actions.clear();
+    machine.dispatch(BehaviorEvent::PirRise);
+    handler.guards = RecordingBehaviors::guardBit(BehaviorGuard::CycleOver);
+    handler.actions.clear();
+    TEST_ASSERT_TRUE(machine.dispatch(BehaviorEvent::Timeout));
+    TEST_ASSERT_EQUAL(BehaviorState::Alert, machine.getState());
+    assertActions({BehaviorAction::Halt, BehaviorAction::StartRest}, handler.actions);
+    TEST_ASSERT_EQUAL(5, machine.getEventCount());
+}
+
+void test_behavior_machine_inherits_parent_rows()
+{
+    std::cout << "  Running test_behavior_machine_inherits_parent_rows()" << std::endl;
+
+    for (const BehaviorState state : {BehaviorState::Scanning, BehaviorState::Reacting})
+    {
+        RecordingBehaviors handler;
+        BehaviorMachine machine(handler, state);
+        TEST_ASSERT_TRUE(machine.isIn(state));
+        TEST_ASSERT_TRUE(machine.isIn(BehaviorState::Alert));
+        TEST_ASSERT_FALSE(machine.isIn(BehaviorState::Idle));
+
+        // PirFall only has a row on Alert
+        TEST_ASSERT_TRUE(machine.dispatch(BehaviorEvent::PirFall));
+        TEST_ASSERT_EQUAL(BehaviorState::Idle, machine.getState());
+        TEST_ASSERT_FALSE(machine.isIn(BehaviorState::Alert));
+    }
+
+    // A parent is not in its substates
+    RecordingBehaviors handler;
+    BehaviorMachine machine(handler, BehaviorState::Alert);
+    TEST_ASSERT_FALSE(machine.isIn(BehaviorState::Scanning));
+    TEST_ASSERT_EQUAL(BehaviorState::Alert, BehaviorMachine::parentOf(BehaviorState::Reacting));
+    TEST_ASSERT_EQUAL(BehaviorState::None, BehaviorMachine::parentOf(BehaviorState::Alert));
+}
+
+void test_behavior_machine_reports_deadlines()
+{
+    std::cout << "  Running test_behavior_machine_reports_deadlines()" << std::endl;
+
+    RecordingBehaviors handler;
+    handler.timers[static_cast<uint8_t>(BehaviorTimer::Sleep)] = 500;
+    handler.timers[static_cast<uint8_t>(BehaviorTimer::Cycle)] = 300;
+    handler.timers[static_cast<uint8_t>(BehaviorTimer::Turn)] = 200;
+    handler.timers[static_cast<uint8_t>(BehaviorTimer::Steer)] = 100;
+
+    // Each state waits on the earliest of its own timers only
+    const struct
+    {
+        BehaviorState state;
+        unsigned long deadline;
+    } expected[] = {
+        {BehaviorState::Sleep, BehaviorMachineConstants::NO_DEADLINE},
+        {BehaviorState::Idle, 500},
+        {BehaviorState::Alert, 300},
+        {BehaviorState::Scanning, 100},
+        {BehaviorState::Reacting, 200},
+    };
+    for (const auto& entry : expected)
+    {
+        BehaviorMachine machine(handler, entry.state);
+        TEST_ASSERT_EQUAL(entry.deadline, machine.getNextDeadline());
+    }
+
+    // Nothing is dispatched before the deadline
+    BehaviorMachine machine(handler, BehaviorState::Reacting);
+    TEST_ASSERT_FALSE(machine.poll(199));
+    TEST_ASSERT_EQUAL(0, machine.getEventCount());
+    TEST_ASSERT_TRUE(handler.actions.empty());
+    TEST_ASSERT_TRUE(machine.poll(200));
+    TEST_ASSERT_EQUAL(BehaviorState::Scanning, machine.getState());
+
+    // Sleep waits for events only
+    BehaviorMachine sleeping(handler, BehaviorState::Sleep);
+    TEST_ASSERT_FALSE(sleeping.poll(~0UL - 1));
+}
+
+void test_behavior_machine_ignores_unhandled_events()
+{
+    std::cout << "  Running test_behavior_machine_ignores_unhandled_events()" << std::endl;
+
+    RecordingBehaviors handler;
+    BehaviorMachine machine(handler, BehaviorState::Sleep);
+    for (const BehaviorEvent event : {BehaviorEvent::PirFall, BehaviorEvent::Timeout,
+                                      BehaviorEvent::Limit, BehaviorEvent::Approach})
+    {
+        TEST_ASSERT_FALSE(machine.dispatch(event));
+    }
+    TEST_ASSERT_EQUAL(BehaviorState::Sleep, machine.getState());
+    TEST_ASSERT_EQUAL(0, machine.getEventCount());
+    TEST_ASSERT_TRUE(handler.actions.empty());
+
+    // A guarded row that does not hold falls through to the next one
+    BehaviorMachine scanning(handler, BehaviorState::Scanning);
+    TEST_ASSERT_TRUE(scanning.dispatch(BehaviorEvent::Timeout));
+    assertActions({BehaviorAction::Steer}, handler.actions);
+}
+
+void test_animation_behavior_cycle()
+{
+    std::cout << "  Running test_animation_behavior_cycle()" << std::endl;
+
+    seedBehaviorRandom();
+    Animation animation(nullptr, nullptr, AnimationPins());
+    TEST_ASSERT_EQUAL(BehaviorState::Idle, animation.getBehaviorState());
+
+    // Idle -> Scanning on motion: a random movement cycle, steering every interval
+    stepBehavior(animation, 1000, HIGH);
+    TEST_ASSERT_EQUAL(BehaviorState::Scanning, animation.getBehaviorState());
+    TEST_ASSERT_NOT_EQUAL(MotorDirection::Stop, animation.getMotorDirection());
+    TEST_ASSERT_EQUAL(1000 + AnimationConstants::kSteerInterval, animation.getNextDeadline());
+    const unsigned long cycleEnd = animation.getRandomRotateTimer();
+    TEST_ASSERT_GREATER_OR_EQUAL(1000 + AnimationConstants::kMinMovementDuration, cycleEnd);
+    TEST_ASSERT_LESS_THAN(1000 + AnimationConstants::kMaxMovementDuration, cycleEnd);
+
+    // The seed gives a cycle long enough to back off twice before it ends
+    const unsigned long firstLimit = cycleEnd - 2 * AnimationConstants::kMinDirectionTime - 50;
+    TEST_ASSERT_GREATER_THAN(1100, firstLimit);
+
+    // Scanning: the speed is updated on each steering deadline
+    stepBehavior(animation, 1100, HIGH);
+    TEST_ASSERT_EQUAL(1200, animation.getNextDeadline());
+    stepBehavior(animation, firstLimit - 50, HIGH);
+    TEST_ASSERT_EQUAL(BehaviorState::Scanning, animation.getBehaviorState());
+    TEST_ASSERT_EQUAL(cycleEnd, animation.getRandomRotateTimer());
+
+    // Scanning -> Reacting on the sensor ahead: back off the other way
+    const MotorDirection backOff = stepIntoLimit(animation, firstLimit);
+    TEST_ASSERT_EQUAL(BehaviorState::Reacting, animation.getBehaviorState());
+    TEST_ASSERT_EQUAL(backOff, animation.getMotorDirection());
+    TEST_ASSERT_EQUAL(firstLimit + AnimationConstants::kMinDirectionTime,
+                      animation.getNextDeadline());
+
+    // Reacting -> Scanning once backed off
+    stepBehavior(animation, firstLimit + AnimationConstants::kMinDirectionTime, HIGH);
+    TEST_ASSERT_EQUAL(BehaviorState::Scanning, animation.getBehaviorState());
+    TEST_ASSERT_NOT_EQUAL(MotorDirection::Stop, animation.getMotorDirection());
+
+    // Reacting -> Alert when the cycle ends while backing off: rest for a random time
+    stepIntoLimit(animation, firstLimit + AnimationConstants::kMinDirectionTime + 50);
+    TEST_ASSERT_EQUAL(BehaviorState::Reacting, animation.getBehaviorState());
+    stepBehavior(animation, cycleEnd, HIGH);
+    TEST_ASSERT_EQUAL(BehaviorState::Alert, animation.getBehaviorState());
+    TEST_ASSERT_EQUAL(MotorDirection::Stop, animation.getMotorDirection());
+    const unsigned long restEnd = animation.getNextDeadline();
+    TEST_ASSERT_GREATER_OR_EQUAL(cycleEnd + AnimationConstants::kMinMovementInterval, restEnd);
+    TEST_ASSERT_LESS_THAN(cycleEnd + AnimationConstants::kMaxMovementInterval, restEnd);
+
+    // Alert -> Scanning after the rest, Scanning -> Alert after the cycle
+    stepBehavior(animation, restEnd, HIGH);
+    TEST_ASSERT_EQUAL(BehaviorState::Scanning, animation.getBehaviorState());
+    TEST_ASSERT_NOT_EQUAL(MotorDirection::Stop, animation.getMotorDirection());
+    const unsigned long secondCycleEnd = animation.getRandomRotateTimer();
+    stepBehavior(animation, secondCycleEnd, HIGH);
+    TEST_ASSERT_EQUAL(BehaviorState::Alert, animation.getBehaviorState());
+    TEST_ASSERT_EQUAL(MotorDirection::Stop, animation.getMotorDirection());
+
+    // Alert -> Idle when the motion stops, Idle -> Sleep five minutes later
+    const unsigned long quietTime = secondCycleEnd + 1000;
+    stepBehavior(animation, quietTime, LOW);
+    TEST_ASSERT_EQUAL(BehaviorState::Idle, animation.getBehaviorState());
+    TEST_ASSERT_EQUAL(quietTime + AnimationConstants::kEyeResetInterval,
+                      animation.getNextDeadline());
+    stepBehavior(animation, quietTime + AnimationConstants::kEyeResetInterval, LOW);
+    TEST_ASSERT_EQUAL(BehaviorState::Sleep, animation.getBehaviorState());
+    TEST_ASSERT_EQUAL(BehaviorMachineConstants::NO_DEADLINE, animation.getNextDeadline());
+
+    // Sleep -> Scanning on motion
+    stepBehavior(animation, 400000, HIGH);
+    TEST_ASSERT_EQUAL(BehaviorState::Scanning, animation.getBehaviorState());
+
+    // Scanning -> Idle when the motion stops mid-cycle
+    stepBehavior(animation, 400050, LOW);
+    TEST_ASSERT_EQUAL(BehaviorState::Idle, animation.getBehaviorState());
+    TEST_ASSERT_EQUAL(MotorDirection::Stop, animation.getMotorDirection());
+}
+
+void test_animation_behavior_waits_for_deadlines()
+{
+    std::cout << "  Running test_animation_behavior_waits_for_deadlines()" << std::endl;
+
+    seedBehaviorRandom();
+    Animation animation(nullptr, nullptr, AnimationPins());
+
+    // Without motion a loop pass has nothing to do until it is time to sleep
+    for (unsigned long t = 0; t < 60000; t++)
+    {
+        stepBehavior(animation, t, LOW);
+    }
+    TEST_ASSERT_EQUAL(0, animation.getBehaviorEventCount());
+
+    // While scanning, only the steering interval is work until the cycle can end
+    stepBehavior(animation, 60000, HIGH);
+    const uint32_t events = animation.getBehaviorEventCount();
+    const unsigned long scanMs = AnimationConstants::kMinMovementDuration;
+    for (unsigned long t = 60001; t < 60000 + scanMs; t++)
+    {
+        const unsigned long deadline = animation.getNextDeadline();
+        const uint32_t before = animation.getBehaviorEventCount();
+        stepBehavior(animation, t, HIGH);
+        TEST_ASSERT_EQUAL(before + (t >= deadline ? 1 : 0), animation.getBehaviorEventCount());
+    }
+    TEST_ASSERT_EQUAL(events + scanMs / AnimationConstants::kSteerInterval - 1,
+                      animation.getBehaviorEventCount());
+}
+
+void runBehaviorMachineTests()
+{
+    std::cout << "\n==== Starting Behavior Machine Tests ====" << std::endl;
+    RUN_TEST(test_behavior_machine_takes_every_row);
+    RUN_TEST(test_behavior_machine_exits_and_enters_in_order);
+    RUN_TEST(test_behavior_machine_inherits_parent_rows);
+    RUN_TEST(test_behavior_machine_reports_deadlines);
+    RUN_TEST(test_behavior_machine_ignores_unhandled_events);
+    RUN_TEST(test_animation_behavior_cycle);
+    RUN_TEST(test_animation_behavior_waits_for_deadlines);
+}
@@ -0,0 +1,222 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "BehaviorScript.h"
+
+// Records the time of each wake-up, sleeping 250 ms in between, five times
+class CountdownScript : public BehaviorScript
+{
+public:
+    uint8_t wakes = 0;
+    unsigned long wakeTimes[5] = {};
+
+protected:
+    void run() override
+    {
+        SCRIPT_BEGIN();
+        while (wakes < 5)
+        {
+            wakeTimes[wakes++] = now();
+            SCRIPT_SLEEP_MS(250);
+        }
+        SCRIPT_END();
+    }
+};
+
+// Greets each arrival in front of the PIR sensor once its sound has finished
+class GreeterScript : public BehaviorScript
+{
+public:
+    uint8_t arrivals = 0;
+    uint8_t greetings = 0;
+    unsigned long lastGreetingTime = 0;
+
+protected:
+    void run() override
+    {
+        SCRIPT_BEGIN();
+        while (true)
+        {
+            SCRIPT_AWAIT_PIR_EDGE();
+            if (getPirSensor() != HIGH)
+            {
+                continue;
+            }
+            arrivals++;
+            SCRIPT_AWAIT_SOUND_DONE();
+            SCRIPT_SLEEP_MS(100);
+            greetings++;
+            lastGreetingTime = now();
+        }
+        SCRIPT_END();
+    }
+};
+
+// A script with a large frame, to fill the arena
+class BulkyScript : public BehaviorScript
+{
+public:
+    uint8_t history[64] = {};
+
+protected:
+    void run() override
+    {
+        SCRIPT_BEGIN();
+        SCRIPT_SLEEP_MS(1000);
+        SCRIPT_END();
+    }
+};
+
+void test_behavior_script_sleeps_in_virtual_time()
+{
+    std::cout << "  Running test_behavior_script_sleeps_in_virtual_time()" << std::endl;
+
+    ScriptScheduler scheduler;
+    CountdownScript* script = scheduler.spawn<CountdownScript>();
+    TEST_ASSERT_NOT_NULL(script);
+    TEST_ASSERT_EQUAL(ScriptWait::Start, script->getWait());
+
+    // Resumed only when a sleep ends, then once more to run off the end
+    uint32_t resumed = 0;
+    for (unsigned long t = 0; t <= 2000; t += 10)
+    {
+        resumed += scheduler.update(t, LOW, false);
+        if (t == 500)
+        {
+            TEST_ASSERT_EQUAL(ScriptWait::Time, script->getWait());
+            TEST_ASSERT_EQUAL(750, script->getWakeTime());
+        }
+    }
+    TEST_ASSERT_EQUAL(6, resumed);
+    TEST_ASSERT_TRUE(script->isDone());
+    TEST_ASSERT_EQUAL(5, script->wakes);
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        TEST_ASSERT_EQUAL(i * 250, script->wakeTimes[i]);
+    }
+
+    // A finished script is not resumed again until restarted
+    TEST_ASSERT_EQUAL(0, scheduler.update(5000, LOW, false));
+    script->wakes = 4;
+    script->restart();
+    TEST_ASSERT_EQUAL(1, scheduler.update(5000, LOW, false));
+    TEST_ASSERT_EQUAL(5, script->wakes);
+    TEST_ASSERT_EQUAL(5000, script->wakeTimes[4]);
+}
+
+void test_behavior_script_awaits_pir_and_sound()
+{
+    std::cout << "  Running test_behavior_script_awaits_pir_and_sound()" << std::endl;
+
+    ScriptScheduler scheduler;
+    GreeterScript* script = scheduler.spawn<GreeterScript>();
+    TEST_ASSERT_NOT_NULL(script);
+
+    // Waits on the PIR sensor; nothing else wakes it
+    scheduler.update(0, LOW, false);
+    TEST_ASSERT_EQUAL(ScriptWait::PirEdge, script->getWait());
+    TEST_ASSERT_EQUAL(0, scheduler.update(1000, LOW, true));
+    TEST_ASSERT_EQUAL(0, scheduler.update(2000, LOW, false));
+
+    // Motion arrives while a sound plays: the greeting waits for the sound, then 100 ms
+    TEST_ASSERT_EQUAL(1, scheduler.update(3000, HIGH, true));
+    TEST_ASSERT_EQUAL(1, script->arrivals);
+    TEST_ASSERT_EQUAL(ScriptWait::SoundDone, script->getWait());
+    TEST_ASSERT_EQUAL(0, scheduler.update(3500, HIGH, true));
+    TEST_ASSERT_EQUAL(1, scheduler.update(4000, HIGH, false));
+    TEST_ASSERT_EQUAL(ScriptWait::Time, script->getWait());
+    TEST_ASSERT_EQUAL(0, script->greetings);
+    scheduler.update(4100, HIGH, false);
+    TEST_ASSERT_EQUAL(1, script->greetings);
+    TEST_ASSERT_EQUAL(4100, script->lastGreetingTime);
+
+    // The motion leaving is an edge too, but not an arrival
+    TEST_ASSERT_EQUAL(1, scheduler.update(5000, LOW, false));
+    TEST_ASSERT_EQUAL(1, script->arrivals);
+    TEST_ASSERT_EQUAL(ScriptWait::PirEdge, script->getWait());
+
+    // In silence the next arrival is greeted after the 100 ms alone
+    scheduler.update(6000, HIGH, false);
+    scheduler.update(6010, HIGH, false);
+    scheduler.update(6100, HIGH, false);
+    TEST_ASSERT_EQUAL(2, script->arrivals);
+    TEST_ASSERT_EQUAL(2, script->greetings);
+    TEST_ASSERT_EQUAL(6100, script->lastGreetingTime);
+}
+
+void test_behavior_script_frames_fill_a_fixed_arena()
+{
+    std::cout << "  Running test_behavior_script_frames_fill_a_fixed_arena()" << std::endl;
+
+    ScriptScheduler scheduler;
+    TEST_ASSERT_NOT_NULL(scheduler.spawn<CountdownScript>());
+    TEST_ASSERT_NOT_NULL(scheduler.spawn<GreeterScript>());
+
+    // Frames are placed until the arena is full, never beyond it
+    uint8_t bulky = 0;
+    while (scheduler.spawn<BulkyScript>() != nullptr)
+    {
+        bulky++;
+    }
+    TEST_ASSERT_GREATER_THAN(0, bulky);
+    TEST_ASSERT_EQUAL(2 + bulky, scheduler.getScriptCount());
+    TEST_ASSERT_LESS_OR_EQUAL(BehaviorScriptConstants::ARENA_BYTES, scheduler.getArenaUsed());
+    TEST_ASSERT_LESS_OR_EQUAL(BehaviorScriptConstants::MAX_SCRIPTS, scheduler.getScriptCount());
+
+    // The footprint of each suspended script is its frame
+    TEST_ASSERT_EQUAL(sizeof(CountdownScript), scheduler.getFootprint(0));
+    TEST_ASSERT_EQUAL(sizeof(GreeterScript), scheduler.getFootprint(1));
+    TEST_ASSERT_EQUAL(sizeof(BulkyScript), scheduler.getFootprint(2));
+    TEST_ASSERT_EQUAL(0, scheduler.getFootprint(scheduler.getScriptCount()));
+    std::cout << "    frames: countdown " << sizeof(CountdownScript) << " B, greeter "
+              << sizeof(GreeterScript) << " B, bulky " << sizeof(BulkyScript) << " B; arena "
+              << scheduler.getArenaUsed() << " of " << BehaviorScriptConstants::ARENA_BYTES
+              << " B" << std::endl;
+
+    scheduler.update(0, LOW, false);
+    scheduler.logFootprints();
+}
+
+void test_behavior_script_hour_of_virtual_time()
+{
+    std::cout << "  Running test_behavior_script_hour_of_virtual_time()" << std::endl;
+
+    // A script sleeping one second at a time is resumed 3600 times in an hour of 10 ms
+    // loop passes; the other 356400 passes cost only the check of its wake-up time
+    class Heartbeat : public BehaviorScript
+    {
+    public:
+        uint32_t beats = 0;
+
+    protected:
+        void run() override
+        {
+            SCRIPT_BEGIN();
+            while (true)
+            {
+                beats++;
+                SCRIPT_SLEEP_MS(1000);
+            }
+            SCRIPT_END();
+        }
+    };
+
+    ScriptScheduler scheduler;
+    Heartbeat* heartbeat = scheduler.spawn<Heartbeat>();
+    uint32_t resumed = 0;
+    for (unsigned long t = 0; t < 3600000UL; t += 10)
+    {
+        resumed += scheduler.update(t, LOW, false);
+    }
+    TEST_ASSERT_EQUAL(3600, resumed);
+    TEST_ASSERT_EQUAL(3600, heartbeat->beats);
+}
+
+void runBehaviorScriptTests()
+{
+    std::cout << "\n==== Starting Behavior Script Tests ====" << std::endl;
+    RUN_TEST(test_behavior_script_sleeps_in_virtual_time);
+    RUN_TEST(test_behavior_script_awaits_pir_and_sound);
+    RUN_TEST(test_behavior_script_frames_fill_a_fixed_arena);
+    RUN_TEST(test_behavior_script_hour_of_virtual_time);
+}
@@ -0,0 +1,367 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include <chrono>
+
+#include "BehaviorData.h"
+#include "BehaviorVm.h"
+#include "HostSimulator.h"
+#include "Random.h"
+
+// Records what a program drives and serves it the sensors set by the test
+class RecordingVmHost : public BehaviorVmHost
+{
+public:
+    int8_t direction = 0;
+    uint8_t speed = 0;
+    VmEye eye = VmEye::Active;
+    uint8_t eyeArgument = 0;
+    int sound = -1;
+    uint8_t dome = 0;
+    uint8_t sensors = 0;
+    uint32_t calls = 0;
+
+    void vmMotor(int8_t newDirection, uint8_t newSpeed) override
+    {
+        direction = newDirection;
+        speed = newSpeed;
+        calls++;
+    }
+    void vmEye(VmEye mode, uint8_t argument) override
+    {
+        eye = mode;
+        eyeArgument = argument;
+        calls++;
+    }
+    void vmSound(uint8_t index) override
+    {
+        sound = index;
+        calls++;
+    }
+    void vmDome(uint8_t level) override
+    {
+        dome = level;
+        calls++;
+    }
+    uint8_t vmSensors() const override { return sensors; }
+};
+
+static constexpr uint8_t sensorBit(VmSensor sensor)
+{
+    return 1 << static_cast<uint8_t>(sensor);
+}
+
+void test_behavior_vm_runs_instructions()
+{
+    std::cout << "  Running test_behavior_vm_runs_instructions()" << std::endl;
+
+    // motor right 120; eye blink 300; sound 3; dome 200; wait 500; motor stop; end
+    const uint8_t program[] = {0x01, 0x01, 120,  0x02, 0x03, 30,   0x03, 0x03,
+                               0x04, 200,  0x05, 0xF4, 0x01, 0x01, 0x00, 0x00, 0x00};
+    RecordingVmHost host;
+    BehaviorVm vm(host);
+    TEST_ASSERT_FALSE(vm.isRunning());
+    TEST_ASSERT_EQUAL(0, vm.tick(0));
+    TEST_ASSERT_TRUE(vm.load(program, sizeof(program)));
+    TEST_ASSERT_TRUE(vm.isRunning());
+
+    // Runs up to and including the wait
+    TEST_ASSERT_EQUAL(5, vm.tick(1000));
+    TEST_ASSERT_EQUAL(1, host.direction);
+    TEST_ASSERT_EQUAL(120, host.speed);
+    TEST_ASSERT_EQUAL(VmEye::Blink, host.eye);
+    TEST_ASSERT_EQUAL(30, host.eyeArgument);
+    TEST_ASSERT_EQUAL(3, host.sound);
+    TEST_ASSERT_EQUAL(200, host.dome);
+
+    // Waits 500 ms, then stops the motor and ends
+    TEST_ASSERT_EQUAL(0, vm.tick(1499));
+    TEST_ASSERT_EQUAL(4, host.calls);
+    TEST_ASSERT_EQUAL(2, vm.tick(1500));
+    TEST_ASSERT_EQUAL(0, host.direction);
+    TEST_ASSERT_FALSE(vm.isRunning());
+    TEST_ASSERT_EQUAL(7, vm.getInstructionCount());
+    TEST_ASSERT_EQUAL(0, vm.tick(2000));
+
+    // A random wait is the draw Rng is about to make, within its range inclusive
+    const uint8_t randomWait[] = {0x06, 0x64, 0x00, 0xC8, 0x00, 0x00};
+    for (uint8_t i = 0; i < 20; i++)
+    {
+        RandomGenerator expected = Rng;
+        const unsigned long waitMs = expected.range(100, 201);
+        TEST_ASSERT_TRUE(vm.load(randomWait, sizeof(randomWait)));
+        TEST_ASSERT_EQUAL(1, vm.tick(0));
+        TEST_ASSERT_EQUAL(0, vm.tick(waitMs - 1));
+        TEST_ASSERT_EQUAL(1, vm.tick(waitMs));
+        TEST_ASSERT_FALSE(vm.isRunning());
+    }
+}
+
+void test_behavior_vm_branches_on_sensors()
+{
+    std::cout << "  Running test_behavior_vm_branches_on_sensors()" << std::endl;
+
+    // 0: until pir; 2: if not left goto 11; 6: dome 1; 8: goto 13; 11: dome 2; 13: end
+    const uint8_t code[] = {0x09, 0x00, 0x08, 0x81, 0x0B, 0x00, 0x04,
+                            0x01, 0x07, 0x0D, 0x00, 0x04, 0x02, 0x00};
+    RecordingVmHost host;
+    BehaviorVm vm(host);
+    TEST_ASSERT_TRUE(vm.load(code, sizeof(code)));
+
+    // Waits for the PIR sensor, however long it takes
+    TEST_ASSERT_EQUAL(1, vm.tick(0));
+    TEST_ASSERT_EQUAL(0, vm.tick(10000));
+    host.sensors = sensorBit(VmSensor::Left);
+    TEST_ASSERT_EQUAL(0, vm.tick(20000));
+
+    // With the head on the left sensor the branch is not taken
+    host.sensors |= sensorBit(VmSensor::Pir);
+    TEST_ASSERT_EQUAL(4, vm.tick(30000));
+    TEST_ASSERT_EQUAL(1, host.dome);
+    TEST_ASSERT_FALSE(vm.isRunning());
+
+    // Away from it the branch is taken, and a condition that already holds does not wait
+    host.sensors = sensorBit(VmSensor::Pir);
+    TEST_ASSERT_TRUE(vm.load(code, sizeof(code)));
+    TEST_ASSERT_EQUAL(4, vm.tick(40000));
+    TEST_ASSERT_EQUAL(2, host.dome);
+    TEST_ASSERT_FALSE(vm.isRunning());
+}
+
+void test_behavior_vm_rejects_bad_programs()
+{
+    std::cout << "  Running test_behavior_vm_rejects_bad_programs()" << std::endl;
+
+    const uint8_t unknownOpcode[] = {0x0A};
+    const uint8_t truncated[] = {0x05, 0x10};
+    const uint8_t jumpIntoOperand[] = {0x05, 0x10, 0x00, 0x07, 0x01, 0x00};
+    const uint8_t jumpPastEnd[] = {0x07, 0x03, 0x00};
+    const uint8_t badEye[] = {0x02, 0x05, 0x00};
+    const uint8_t badSensor[] = {0x09, 0x05};
+    const uint8_t backwardsRange[] = {0x06, 0xC8, 0x00, 0x64, 0x00};
+    static uint8_t tooLong[BehaviorVmConstants::MAX_PROGRAM_SIZE + 1] = {};
+    TEST_ASSERT_FALSE(BehaviorVm::validate(unknownOpcode, sizeof(unknownOpcode)));
+    TEST_ASSERT_FALSE(BehaviorVm::validate(truncated, sizeof(truncated)));
+    TEST_ASSERT_FALSE(BehaviorVm::validate(jumpIntoOperand, sizeof(jumpIntoOperand)));
+    TEST_ASSERT_FALSE(BehaviorVm::validate(jumpPastEnd, sizeof(jumpPastEnd)));
+    TEST_ASSERT_FALSE(BehaviorVm::validate(badEye, sizeof(badEye)));
+    TEST_ASSERT_FALSE(BehaviorVm::validate(badSensor, sizeof(badSensor)));
+    TEST_ASSERT_FALSE(BehaviorVm::validate(backwardsRange, sizeof(backwardsRange)));
+    TEST_ASSERT_FALSE(BehaviorVm::validate(tooLong, sizeof(tooLong)));
+    TEST_ASSERT_TRUE(BehaviorVm::validate(tooLong, BehaviorVmConstants::MAX_PROGRAM_SIZE));
+
+    // The built-in programs are valid
+    for (uint8_t i = 0; i < NUM_BEHAVIOR_PROGRAMS; i++)
+    {
+        const BehaviorProgram* program = getBehaviorProgram(i);
+        TEST_ASSERT_TRUE(BehaviorVm::validate(program->code, program->length));
+    }
+
+    // An invalid program leaves the running one alone
+    const uint8_t idle[] = {0x05, 0x10, 0x27, 0x07, 0x00, 0x00};
+    RecordingVmHost host;
+    BehaviorVm vm(host);
+    TEST_ASSERT_TRUE(vm.load(idle, sizeof(idle)));
+    vm.tick(0);
+    TEST_ASSERT_FALSE(vm.load(jumpIntoOperand, sizeof(jumpIntoOperand)));
+    TEST_ASSERT_TRUE(vm.isRunning());
+    TEST_ASSERT_EQUAL(3, vm.getPc());
+
+    // An empty program stops it
+    TEST_ASSERT_TRUE(vm.load(nullptr, 0));
+    TEST_ASSERT_FALSE(vm.isRunning());
+}
+
+void test_behavior_vm_yields_after_step_budget()
+{
+    std::cout << "  Running test_behavior_vm_yields_after_step_budget()" << std::endl;
+
+    // loop: dome 1; goto loop - never waits
+    const uint8_t program[] = {0x04, 0x01, 0x07, 0x00, 0x00};
+    RecordingVmHost host;
+    BehaviorVm vm(host);
+    TEST_ASSERT_TRUE(vm.load(program, sizeof(program)));
+    for (unsigned long t = 0; t < 10; t++)
+    {
+        TEST_ASSERT_EQUAL(BehaviorVmConstants::MAX_STEPS_PER_TICK, vm.tick(t));
+    }
+    TEST_ASSERT_TRUE(vm.isRunning());
+    TEST_ASSERT_EQUAL(10 * BehaviorVmConstants::MAX_STEPS_PER_TICK, vm.getInstructionCount());
+    TEST_ASSERT_EQUAL(5 * BehaviorVmConstants::MAX_STEPS_PER_TICK, host.calls);
+}
+
+void test_behavior_vm_loader_double_buffers()
+{
+    std::cout << "  Running test_behavior_vm_loader_double_buffers()" << std::endl;
+
+    const uint8_t first[] = {0x04, 0x10, 0x00};
+    const uint8_t second[] = {0x04, 0x20, 0x05, 0x64, 0x00, 0x00};
+    uint8_t message[BehaviorVmConstants::MAX_MESSAGE_SIZE];
+    BehaviorVmLoader loader;
+    TEST_ASSERT_EQUAL(0, loader.getProgramLength());
+
+    // Log text and a stray sync byte before the message are skipped
+    const char noise[] = "hello \xB5 world";
+    for (const char c : noise)
+    {
+        TEST_ASSERT_FALSE(loader.receive(static_cast<uint8_t>(c)));
+    }
+    size_t length = BehaviorVmLoader::encode(first, sizeof(first), message);
+    TEST_ASSERT_EQUAL(BehaviorVmConstants::HEADER_SIZE + sizeof(first) + 1, length);
+    for (size_t i = 0; i < length; i++)
+    {
+        TEST_ASSERT_EQUAL(i == length - 1, loader.receive(message[i]));
+    }
+    const uint8_t* firstCode = loader.getProgram();
+    TEST_ASSERT_EQUAL(sizeof(first), loader.getProgramLength());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(first, firstCode, sizeof(first));
+
+    // The VM runs the first program while the second arrives; a corrupt copy is rejected
+    RecordingVmHost host;
+    BehaviorVm vm(host);
+    TEST_ASSERT_TRUE(vm.load(loader.getProgram(), loader.getProgramLength()));
+    length = BehaviorVmLoader::encode(second, sizeof(second), message);
+    message[5] ^= 0xFF;
+    for (size_t i = 0; i < length; i++)
+    {
+        TEST_ASSERT_FALSE(loader.receive(message[i]));
+    }
+    TEST_ASSERT_EQUAL(1, loader.getRejectedCount());
+    message[5] ^= 0xFF;
+    bool loaded = false;
+    for (size_t i = 0; i < length; i++)
+    {
+        loaded = loader.receive(message[i]);
+        // The running program is never written over
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(first, firstCode, sizeof(first));
+    }
+    TEST_ASSERT_TRUE(loaded);
+    TEST_ASSERT_TRUE(loader.getProgram() != firstCode);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(second, loader.getProgram(), sizeof(second));
+    TEST_ASSERT_TRUE(vm.load(loader.getProgram(), loader.getProgramLength()));
+    vm.tick(0);
+    TEST_ASSERT_EQUAL(0x20, host.dome);
+
+    // A valid message holding an invalid program is rejected too
+    const uint8_t invalid[] = {0x07, 0x05, 0x00};
+    length = BehaviorVmLoader::encode(invalid, sizeof(invalid), message);
+    for (size_t i = 0; i < length; i++)
+    {
+        TEST_ASSERT_FALSE(loader.receive(message[i]));
+    }
+    TEST_ASSERT_EQUAL(2, loader.getRejectedCount());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(second, loader.getProgram(), sizeof(second));
+
+    // An empty program is a stop request
+    length = BehaviorVmLoader::encode(nullptr, 0, message);
+    bool stopped = false;
+    for (size_t i = 0; i < length; i++)
+    {
+        stopped = loader.receive(message[i]);
+    }
+    TEST_ASSERT_TRUE(stopped);
+    TEST_ASSERT_EQUAL(0, loader.getProgramLength());
+    TEST_ASSERT_EQUAL(3, loader.getLoadedCount());
+}
+
+void test_behavior_vm_sentry_in_simulator()
+{
+    std::cout << "  Running test_behavior_vm_sentry_in_simulator()" << std::endl;
+
+    HostSimulator sim(3);
+    while (sim.headEstimator().isCalibrating() && sim.now() < 30000)
+    {
+        sim.step(HostSimulator::kTickMs);
+    }
+    const BehaviorProgram* sentry = getBehaviorProgram(BEHAVIOR_SENTRY);
+    TEST_ASSERT_TRUE(sim.runProgram(sentry->code, sentry->length));
+
+    // Alone, the sentry sweeps from sensor to sensor without reaching the end stops
+    const uint32_t hitsBefore = sim.getLimitHits();
+    bool sawLeft = false;
+    bool sawRight = false;
+    for (unsigned long elapsed = 0; elapsed < 20000; elapsed += HostSimulator::kTickMs)
+    {
+        sim.step(HostSimulator::kTickMs);
+        sawLeft |= sim.snapshot().sensorLeft;
+        sawRight |= sim.snapshot().sensorRight;
+    }
+    TEST_ASSERT_TRUE(sawLeft && sawRight);
+    TEST_ASSERT_EQUAL(hitsBefore, sim.getLimitHits());
+    TEST_ASSERT_TRUE(sim.animation().isRunningProgram());
+
+    // A visitor stops the head and lights the dome until they leave
+    sim.setPir(true);
+    sim.step(1000);
+    TEST_ASSERT_EQUAL(MotorDirection::Stop, sim.snapshot().direction);
+    TEST_ASSERT_EQUAL(255, sim.snapshot().domeLed);
+    sim.step(10000);
+    TEST_ASSERT_EQUAL(255, sim.snapshot().domeLed);
+    sim.setPir(false);
+    sim.step(2000);
+    TEST_ASSERT_EQUAL(0, sim.snapshot().domeLed);
+    TEST_ASSERT_TRUE(sim.snapshot().direction != MotorDirection::Stop);
+
+    // Stopping the program hands the head back to the behavior machine
+    sim.animation().stopProgram();
+    sim.step(HostSimulator::kTickMs);
+    TEST_ASSERT_FALSE(sim.animation().isRunningProgram());
+    TEST_ASSERT_EQUAL(MotorDirection::Stop, sim.snapshot().direction);
+}
+
+void test_behavior_vm_benchmark()
+{
+    std::cout << "  Running test_behavior_vm_benchmark()" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    using Nanoseconds = std::chrono::duration<double, std::nano>;
+    RecordingVmHost host;
+    BehaviorVm vm(host);
+
+    // Cost per instruction: a loop that never waits, testing a sensor on every pass
+    // loop: dome 1; if circle goto loop; motor right 90; goto loop
+    const uint8_t busy[] = {0x04, 0x01, 0x08, 0x04, 0x00, 0x00,
+                            0x01, 0x01, 0x5A, 0x07, 0x00, 0x00};
+    const uint32_t numTicks = 100000;
+    TEST_ASSERT_TRUE(vm.load(busy, sizeof(busy)));
+    Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < numTicks; i++)
+    {
+        vm.tick(i);
+    }
+    const double instructionNs =
+        Nanoseconds(Clock::now() - start).count() / vm.getInstructionCount();
+    TEST_ASSERT_EQUAL(numTicks * BehaviorVmConstants::MAX_STEPS_PER_TICK,
+                      vm.getInstructionCount());
+
+    // Cost per tick of the sentry program, mostly checking on a wait
+    const BehaviorProgram* sentry = getBehaviorProgram(BEHAVIOR_SENTRY);
+    TEST_ASSERT_TRUE(vm.load(sentry->code, sentry->length));
+    const uint32_t countBefore = vm.getInstructionCount();
+    start = Clock::now();
+    for (uint32_t i = 0; i < numTicks; i++)
+    {
+        host.sensors = (i / 500) % 4 == 0 ? sensorBit(VmSensor::Left) : 0;
+        vm.tick(i * 10UL);
+    }
+    const double tickNs = Nanoseconds(Clock::now() - start).count() / numTicks;
+    std::cout << "    " << instructionNs << " ns per instruction, " << tickNs
+              << " ns per sentry tick (" << (vm.getInstructionCount() - countBefore) / numTicks
+              << "." << (vm.getInstructionCount() - countBefore) * 10 / numTicks % 10
+              << " instructions)" << std::endl;
+
+    // Timing is reported, not asserted
+    TEST_ASSERT_TRUE(vm.isRunning());
+}
+
+void runBehaviorVmTests()
+{
+    std::cout << "\n==== Starting Behavior VM Tests ====" << std::endl;
+    RUN_TEST(test_behavior_vm_runs_instructions);
+    RUN_TEST(test_behavior_vm_branches_on_sensors);
+    RUN_TEST(test_behavior_vm_rejects_bad_programs);
+    RUN_TEST(test_behavior_vm_yields_after_step_budget);
+    RUN_TEST(test_behavior_vm_loader_double_buffers);
+    RUN_TEST(test_behavior_vm_sentry_in_simulator);
+    RUN_TEST(test_behavior_vm_benchmark);
+}
@@ -0,0 +1,269 @@
+#include <ArduinoFake.h>
+#include <algorithm>
+#include <unity.h>
+
+#include "Choreography.h"
+#include "HostSimulator.h"
+
+// Records the cues a show fires and serves it a sample clock set by the test
+class RecordingShowHost : public ShowHost
+{
+public:
+    ShowAction actions[ChoreographyConstants::MAX_CUES] = {};
+    uint8_t numFired = 0;
+    bool playing = false;
+    uint32_t samples = 0;
+
+    void showCue(const ShowCue& cue) override
+    {
+        actions[numFired++] = cue.action;
+        if (cue.action == ShowAction::Sound)
+        {
+            playing = true;
+            samples = 0;
+        }
+    }
+    bool showAudioClock(uint8_t sound, ShowAudioClock& clock) const override
+    {
+        clock.samples = samples;
+        clock.sampleRate = TimerAudioConstants::DEFAULT_SAMPLE_RATE;
+        return playing && sound == 3;
+    }
+
+    // Set the sample clock to a time into the sound, a multiple of 20 ms for whole samples
+    void setSoundTime(uint32_t ms)
+    {
+        samples = ms * TimerAudioConstants::DEFAULT_SAMPLE_RATE / 1000;
+    }
+};
+
+void test_choreography_shows_are_valid()
+{
+    std::cout << "  Running test_choreography_shows_are_valid()" << std::endl;
+
+    // Every show is sorted, cues one sound and drives all four tracks
+    for (uint8_t t = 0; t < static_cast<uint8_t>(ShowTrigger::Count); t++)
+    {
+        const Show* show = getShow(static_cast<ShowTrigger>(t));
+        TEST_ASSERT_NOT_NULL(show);
+        TEST_ASSERT_TRUE(ShowPlayer::validate(show));
+
+        uint8_t tracks = 0;
+        uint8_t sounds = 0;
+        for (uint8_t i = 0; i < show->numCues; i++)
+        {
+            tracks |= 1 << static_cast<uint8_t>(getShowTrack(show->cues[i].action));
+            sounds += show->cues[i].action == ShowAction::Sound ? 1 : 0;
+        }
+        TEST_ASSERT_EQUAL_HEX8(0x0F, tracks);
+        TEST_ASSERT_EQUAL(1, sounds);
+    }
+    TEST_ASSERT_NULL(getShow(ShowTrigger::Count));
+
+    // Unsorted cues and cues past the end are rejected
+    const ShowCue unsorted[] = {{100, ShowAction::Blink, 0, 100}, {50, ShowAction::Release, 0, 0}};
+    const Show backwards = {"backwards", unsorted, 2, 200};
+    const Show tooShort = {"too short", unsorted, 1, 80};
+    RecordingShowHost host;
+    ShowPlayer player(host);
+    TEST_ASSERT_FALSE(ShowPlayer::validate(nullptr));
+    TEST_ASSERT_FALSE(player.play(&backwards, 0));
+    TEST_ASSERT_FALSE(player.play(&tooShort, 0));
+    TEST_ASSERT_FALSE(player.isPlaying());
+}
+
+void test_choreography_fires_cues_in_order()
+{
+    std::cout << "  Running test_choreography_fires_cues_in_order()" << std::endl;
+
+    const ShowCue cues[] = {{0, ShowAction::Blink, 0, 100},
+                            {100, ShowAction::NextColor, 0, 0},
+                            {100, ShowAction::DomeLevel, 200, 0},
+                            {250, ShowAction::Release, 0, 0}};
+    const Show show = {"test", cues, 4, 300};
+    RecordingShowHost host;
+    ShowPlayer player(host);
+    TEST_ASSERT_FALSE(player.update(0));
+
+    // Without a sound the show follows the millisecond clock
+    TEST_ASSERT_TRUE(player.play(&show, 1000));
+    TEST_ASSERT_TRUE(player.update(1000));
+    TEST_ASSERT_EQUAL(1, host.numFired);
+    TEST_ASSERT_TRUE(player.update(1099));
+    TEST_ASSERT_EQUAL(1, host.numFired);
+    TEST_ASSERT_TRUE(player.update(1104));
+    TEST_ASSERT_EQUAL(3, host.numFired);
+    TEST_ASSERT_EQUAL(ShowAction::NextColor, host.actions[1]);
+    TEST_ASSERT_EQUAL(ShowAction::DomeLevel, host.actions[2]);
+    TEST_ASSERT_EQUAL(4000, player.getMaxLatenessUs());
+    TEST_ASSERT_FALSE(player.isFollowingAudio());
+
+    // The last cue fires, and the show is over at its duration
+    TEST_ASSERT_TRUE(player.update(1250));
+    TEST_ASSERT_EQUAL(4, host.numFired);
+    TEST_ASSERT_TRUE(player.update(1299));
+    TEST_ASSERT_FALSE(player.update(1300));
+    TEST_ASSERT_FALSE(player.isPlaying());
+    TEST_ASSERT_EQUAL(4, player.getCuesFired());
+    TEST_ASSERT_EQUAL(2000, player.getAverageLatenessUs());
+    TEST_ASSERT_TRUE(player.getShow() == &show);
+}
+
+void test_choreography_follows_sample_clock()
+{
+    std::cout << "  Running test_choreography_follows_sample_clock()" << std::endl;
+
+    const ShowCue cues[] = {{50, ShowAction::Sound, 3, 0},
+                            {150, ShowAction::Blink, 0, 100},
+                            {400, ShowAction::DomeLevel, 255, 0}};
+    const Show show = {"test", cues, 3, 600};
+    RecordingShowHost host;
+    ShowPlayer player(host);
+    TEST_ASSERT_TRUE(player.play(&show, 0));
+
+    // The sound cue fires late; the clock restarts from its cue time at the first sample
+    TEST_ASSERT_TRUE(player.update(58));
+    TEST_ASSERT_EQUAL(1, host.numFired);
+    TEST_ASSERT_TRUE(player.isFollowingAudio());
+    TEST_ASSERT_EQUAL(50000, player.getShowTimeUs());
+
+    // Cues wait for the samples, not the millisecond clock
+    host.setSoundTime(80);
+    TEST_ASSERT_TRUE(player.update(170));
+    TEST_ASSERT_EQUAL(1, host.numFired);
+    TEST_ASSERT_EQUAL(130000, player.getShowTimeUs());
+    host.setSoundTime(100);
+    TEST_ASSERT_TRUE(player.update(180));
+    TEST_ASSERT_EQUAL(2, host.numFired);
+    TEST_ASSERT_EQUAL(ShowAction::Blink, host.actions[1]);
+
+    // Once the sound ends the clock carries on from the last sample time
+    host.setSoundTime(240);
+    TEST_ASSERT_TRUE(player.update(310));
+    host.playing = false;
+    TEST_ASSERT_TRUE(player.update(320));
+    TEST_ASSERT_FALSE(player.isFollowingAudio());
+    TEST_ASSERT_EQUAL(300000, player.getShowTimeUs());
+    TEST_ASSERT_TRUE(player.update(419));
+    TEST_ASSERT_EQUAL(2, host.numFired);
+    TEST_ASSERT_TRUE(player.update(420));
+    TEST_ASSERT_EQUAL(3, host.numFired);
+    TEST_ASSERT_TRUE(player.update(619));
+    TEST_ASSERT_FALSE(player.update(620));
+
+    // Timed by the samples, only the sound cue itself was late
+    TEST_ASSERT_EQUAL(8000, player.getMaxLatenessUs());
+}
+
+void test_choreography_greeting_in_simulator()
+{
+    std::cout << "  Running test_choreography_greeting_in_simulator()" << std::endl;
+
+    HostSimulator sim(5);
+    TEST_ASSERT_FALSE(sim.animation().playShow(ShowTrigger::Greeting));
+    while (sim.headEstimator().isCalibrating() && sim.now() < 30000)
+    {
+        sim.step(HostSimulator::kTickMs);
+    }
+    TEST_ASSERT_TRUE(sim.animation().playShow(ShowTrigger::Greeting));
+    TEST_ASSERT_EQUAL(255, sim.snapshot().domeLed);
+    TEST_ASSERT_TRUE(sim.animation().isGazing());
+
+    // Every cue after the sound starts fires within one loop tick of its time on the
+    // sample clock the simulator runs the audio on
+    const Show* show = sim.animation().getShowPlayer().getShow();
+    const uint32_t sampleRate = TimerAudioConstants::DEFAULT_SAMPLE_RATE;
+    uint32_t soundCueMs = 0;
+    uint8_t aligned = 0;
+    uint32_t maxOffsetUs = 0;
+    bool moved = false;
+    while (sim.animation().isPlayingShow() && sim.now() < 40000)
+    {
+        const uint8_t firedBefore = sim.animation().getShowPlayer().getCuesFired();
+        const bool soundPlaying = sim.audio().isPlaying() && soundCueMs > 0;
+        const uint32_t samplesBefore = sim.audio().getSamplesPlayed();
+        sim.step(HostSimulator::kTickMs);
+        moved |= sim.snapshot().speed > 0;
+
+        const uint8_t firedAfter = sim.animation().getShowPlayer().getCuesFired();
+        for (uint8_t i = firedBefore; i < firedAfter; i++)
+        {
+            const ShowCue& cue = show->cues[i];
+            if (cue.action == ShowAction::Sound)
+            {
+                soundCueMs = cue.timeMs;
+                TEST_ASSERT_EQUAL(cue.a, sim.snapshot().clip);
+            }
+            else if (soundPlaying)
+            {
+                const uint32_t audioUs = static_cast<uint32_t>(
+                    soundCueMs * 1000ULL + samplesBefore * 1000000ULL / sampleRate);
+                const uint32_t cueUs = cue.timeMs * 1000UL;
+                TEST_ASSERT_TRUE(audioUs >= cueUs);
+                maxOffsetUs = std::max(maxOffsetUs, audioUs - cueUs);
+                aligned++;
+            }
+        }
+    }
+    std::cout << "    " << static_cast<int>(aligned) << " cues on the sample clock, up to "
+              << maxOffsetUs << " us after their time; all cues up to "
+              << sim.animation().getShowPlayer().getMaxLatenessUs() << " us late" << std::endl;
+    TEST_ASSERT_FALSE(sim.animation().isPlayingShow());
+    TEST_ASSERT_EQUAL(show->numCues, sim.animation().getShowPlayer().getCuesFired());
+    TEST_ASSERT_TRUE(aligned >= 5);
+    TEST_ASSERT_TRUE(maxOffsetUs < HostSimulator::kTickMs * 1000UL);
+    TEST_ASSERT_TRUE(sim.animation().getShowPlayer().getMaxLatenessUs() <
+                     HostSimulator::kTickMs * 1000UL);
+    TEST_ASSERT_TRUE(moved);
+
+    // The show hands the head back when it is over
+    TEST_ASSERT_FALSE(sim.animation().isGazing());
+}
+
+void test_choreography_shows_in_simulator()
+{
+    std::cout << "  Running test_choreography_shows_in_simulator()" << std::endl;
+
+    HostSimulator sim(9);
+    sim.step(5000);
+
+    // Each show plays through on time and ends with the head released
+    for (uint8_t t = 0; t < static_cast<uint8_t>(ShowTrigger::Count); t++)
+    {
+        const Show* show = getShow(static_cast<ShowTrigger>(t));
+        TEST_ASSERT_TRUE(sim.animation().playShow(static_cast<ShowTrigger>(t)));
+        const unsigned long start = sim.now();
+        while (sim.animation().isPlayingShow() && sim.now() - start < 5000)
+        {
+            sim.step(HostSimulator::kTickMs);
+        }
+        const ShowPlayer& player = sim.animation().getShowPlayer();
+        std::cout << "    " << show->name << ": " << sim.now() - start << " ms, cues up to "
+                  << player.getMaxLatenessUs() << " us late, " << player.getAverageLatenessUs()
+                  << " us on average" << std::endl;
+        TEST_ASSERT_FALSE(sim.animation().isPlayingShow());
+        TEST_ASSERT_EQUAL(show->numCues, player.getCuesFired());
+        TEST_ASSERT_TRUE(player.getMaxLatenessUs() < HostSimulator::kTickMs * 1000UL);
+        TEST_ASSERT_UINT32_WITHIN(2 * HostSimulator::kTickMs, show->durationMs,
+                                  sim.now() - start);
+        TEST_ASSERT_FALSE(sim.animation().isGazing());
+    }
+
+    // The sad show ends with the dome off; a show cut short hands everything back
+    TEST_ASSERT_EQUAL(0, sim.snapshot().domeLed);
+    TEST_ASSERT_TRUE(sim.animation().playShow(ShowTrigger::Greeting));
+    sim.step(500);
+    sim.animation().stopShow();
+    TEST_ASSERT_FALSE(sim.animation().isPlayingShow());
+    TEST_ASSERT_FALSE(sim.animation().isGazing());
+}
+
+void runChoreographyTests()
+{
+    std::cout << "\n==== Starting Choreography Tests ====" << std::endl;
+    RUN_TEST(test_choreography_shows_are_valid);
+    RUN_TEST(test_choreography_fires_cues_in_order);
+    RUN_TEST(test_choreography_follows_sample_clock);
+    RUN_TEST(test_choreography_greeting_in_simulator);
+    RUN_TEST(test_choreography_shows_in_simulator);
+}
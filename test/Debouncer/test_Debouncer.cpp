@@ -0,0 +1,251 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include <chrono>
+#include <cstring>
+
+#include "Debouncer.h"
+#include "Random.h"
+
+// Bounce traces sampled at 1 kHz, one character per sample ('1' = HIGH), all the same
+// length, shaped after hall sensor chatter and contact bounce. Each input makes at most
+// one clean press or pass and release.
+static const char* const kBounceTraces[AnimationInputBits::COUNT] = {
+    // Left hall sensor: the magnet passes the band edge slowly and the output chatters
+    "111111111111101101110100100000000000000000000000000000000000000010010110111111111111",
+    // Right hall sensor: quiet throughout
+    "111111111111111111111111111111111111111111111111111111111111111111111111111111111111",
+    // PIR: driven output, a single glitch before the real rise
+    "000000001000000000000111111111111111111111111111111111111111111111111111111111111111",
+    // Rectangle button: contact bounce on press and on release
+    "111111111111111110101100100000000000000000000000000000000010110101111111111111111111",
+    // Circle button: a short, bouncy tap
+    "111111111111111111111111111110100100000000001011011111111111111111111111111111111111",
+};
+
+// Edges each input should make once debounced: one per clean transition
+static const uint8_t kExpectedEdges[AnimationInputBits::COUNT] = {2, 0, 1, 2, 2};
+
+static uint8_t traceLevels(size_t sample)
+{
+    uint8_t levels = 0;
+    for (uint8_t i = 0; i < AnimationInputBits::COUNT; i++)
+    {
+        if (kBounceTraces[i][sample] == '1')
+        {
+            levels |= 1U << i;
+        }
+    }
+    return levels;
+}
+
+void test_debouncer_filters_bounce_traces()
+{
+    std::cout << "  Running test_debouncer_filters_bounce_traces()" << std::endl;
+    const size_t length = strlen(kBounceTraces[0]);
+    for (uint8_t i = 1; i < AnimationInputBits::COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(length, strlen(kBounceTraces[i]));
+    }
+
+    Debouncer debouncer{AnimationPins()};
+    debouncer.prime(traceLevels(0));
+    uint32_t rawEdges[AnimationInputBits::COUNT] = {};
+    uint32_t edges[AnimationInputBits::COUNT] = {};
+    for (size_t t = 1; t < length; t++)
+    {
+        const uint8_t rawChanged = traceLevels(t) ^ traceLevels(t - 1);
+        const uint8_t flipped = debouncer.sample(traceLevels(t), t * 1000UL);
+        for (uint8_t i = 0; i < AnimationInputBits::COUNT; i++)
+        {
+            rawEdges[i] += (rawChanged >> i) & 1U;
+            edges[i] += (flipped >> i) & 1U;
+        }
+    }
+
+    for (uint8_t i = 0; i < AnimationInputBits::COUNT; i++)
+    {
+        std::cout << "    input " << static_cast<int>(i) << ": " << rawEdges[i]
+                  << " raw edges, " << edges[i] << " debounced" << std::endl;
+        TEST_ASSERT_EQUAL_UINT32(kExpectedEdges[i], edges[i]);
+    }
+    TEST_ASSERT_EQUAL(traceLevels(length - 1), debouncer.getLevels());
+
+    // Every debounced edge was queued with its pin and new level, in time order
+    const AnimationPins pins;
+    InputEventQueue& queue = debouncer.getQueue();
+    TEST_ASSERT_EQUAL(debouncer.getEdges(), queue.size());
+    InputEvent event;
+    uint32_t lastTime = 0;
+    uint8_t circleEdges = 0;
+    while (queue.pop(event))
+    {
+        TEST_ASSERT_TRUE(event.timeUs >= lastTime);
+        lastTime = event.timeUs;
+        if (event.pin == pins.buttonCircle)
+        {
+            TEST_ASSERT_EQUAL(circleEdges == 0 ? LOW : HIGH, event.level);
+            circleEdges++;
+        }
+    }
+    TEST_ASSERT_EQUAL(2, circleEdges);
+}
+
+void test_debouncer_matches_per_input_counters()
+{
+    std::cout << "  Running test_debouncer_matches_per_input_counters()" << std::endl;
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    // Random thresholds and noisy inputs against one plain counter per input
+    Debouncer debouncer{AnimationPins()};
+    uint8_t thresholds[AnimationInputBits::COUNT];
+    for (uint8_t i = 0; i < AnimationInputBits::COUNT; i++)
+    {
+        thresholds[i] = static_cast<uint8_t>(Rng.range(1, DebouncerConstants::MAX_THRESHOLD + 1));
+        debouncer.setThreshold(1U << i, thresholds[i]);
+        TEST_ASSERT_EQUAL(thresholds[i], debouncer.getThreshold(i));
+    }
+    debouncer.prime(0);
+
+    uint8_t reference = 0;
+    uint8_t counts[AnimationInputBits::COUNT] = {};
+    uint8_t levels = 0;
+    for (uint32_t t = 0; t < 100000; t++)
+    {
+        // Each input holds for a random spell, sometimes shorter than its threshold
+        if (Rng.below(8) == 0)
+        {
+            levels ^= 1U << Rng.below(AnimationInputBits::COUNT);
+        }
+        uint8_t expected = 0;
+        for (uint8_t i = 0; i < AnimationInputBits::COUNT; i++)
+        {
+            const uint8_t bit = 1U << i;
+            counts[i] = (levels & bit) != (reference & bit) ? counts[i] + 1 : 0;
+            if (counts[i] == thresholds[i])
+            {
+                reference ^= bit;
+                counts[i] = 0;
+                expected |= bit;
+            }
+        }
+        TEST_ASSERT_EQUAL_HEX8(expected, debouncer.sample(levels, t));
+        TEST_ASSERT_EQUAL_HEX8(reference, debouncer.getLevels());
+        while (!debouncer.getQueue().isEmpty())
+        {
+            InputEvent event;
+            debouncer.getQueue().pop(event);
+        }
+    }
+}
+
+void test_debouncer_thresholds()
+{
+    std::cout << "  Running test_debouncer_thresholds()" << std::endl;
+    Debouncer debouncer{AnimationPins()};
+    TEST_ASSERT_EQUAL(DebouncerConstants::SENSOR_THRESHOLD, debouncer.getThreshold(0));
+    TEST_ASSERT_EQUAL(DebouncerConstants::PIR_THRESHOLD, debouncer.getThreshold(2));
+    TEST_ASSERT_EQUAL(DebouncerConstants::BUTTON_THRESHOLD, debouncer.getThreshold(4));
+
+    debouncer.setThreshold(AnimationInputBits::PIR_SENSOR, 0);
+    TEST_ASSERT_EQUAL(1, debouncer.getThreshold(2));
+    debouncer.setThreshold(AnimationInputBits::PIR_SENSOR, 200);
+    TEST_ASSERT_EQUAL(DebouncerConstants::MAX_THRESHOLD, debouncer.getThreshold(2));
+
+    // A new level flips on exactly the threshold-th sample in a row
+    debouncer.setThreshold(AnimationInputBits::BUTTON_CIRCLE, 5);
+    debouncer.prime(AnimationInputBits::BUTTON_CIRCLE);
+    for (uint8_t i = 1; i < 5; i++)
+    {
+        TEST_ASSERT_EQUAL(0, debouncer.sample(0, i));
+    }
+    TEST_ASSERT_EQUAL(AnimationInputBits::BUTTON_CIRCLE, debouncer.sample(0, 5));
+
+    // A sample back at the debounced level restarts the count
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        debouncer.sample(AnimationInputBits::BUTTON_CIRCLE, 10 + i);
+    }
+    debouncer.sample(0, 20);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_EQUAL(0, debouncer.sample(AnimationInputBits::BUTTON_CIRCLE, 30 + i));
+    }
+    TEST_ASSERT_EQUAL(AnimationInputBits::BUTTON_CIRCLE,
+                      debouncer.sample(AnimationInputBits::BUTTON_CIRCLE, 40));
+}
+
+void test_debouncer_samples_port_and_reports_changes()
+{
+    std::cout << "  Running test_debouncer_samples_port_and_reports_changes()" << std::endl;
+    When(Method(ArduinoFake(), millis)).AlwaysDo([]() { return 500UL; });
+    const AnimationPins pins;
+    mockGpioPort = 0;
+    mock_gpio_put(pins.buttonRectangle, true);
+    mock_gpio_put(pins.buttonCircle, true);
+
+    Debouncer debouncer(pins);
+    TEST_ASSERT_TRUE(debouncer.begin());
+    AnimationInputs inputs = debouncer.read();
+    TEST_ASSERT_EQUAL(AnimationInputBits::ALL, inputs.changed);
+    TEST_ASSERT_EQUAL(HIGH, inputs.buttonRectangle);
+    TEST_ASSERT_EQUAL(LOW, inputs.pirSensor);
+    TEST_ASSERT_EQUAL(500, inputs.currentTime);
+
+    // One port read per sample, and a press shows once it has held for the threshold
+    mock_gpio_put(pins.buttonRectangle, false);
+    const uint32_t readsBefore = mockGpioPortReads;
+    for (uint8_t i = 0; i < DebouncerConstants::BUTTON_THRESHOLD - 1; i++)
+    {
+        debouncer.tick();
+    }
+    TEST_ASSERT_EQUAL(0, debouncer.read().changed);
+    debouncer.tick();
+    TEST_ASSERT_EQUAL_UINT32(DebouncerConstants::BUTTON_THRESHOLD,
+                             mockGpioPortReads - readsBefore);
+    inputs = debouncer.read();
+    TEST_ASSERT_EQUAL(AnimationInputBits::BUTTON_RECTANGLE, inputs.changed);
+    TEST_ASSERT_EQUAL(LOW, inputs.buttonRectangle);
+
+    InputEvent event;
+    TEST_ASSERT_TRUE(debouncer.getQueue().pop(event));
+    TEST_ASSERT_EQUAL(pins.buttonRectangle, event.pin);
+    TEST_ASSERT_EQUAL(LOW, event.level);
+    TEST_ASSERT_EQUAL_UINT32(DebouncerConstants::BUTTON_THRESHOLD * DebouncerConstants::SAMPLE_US,
+                             event.timeUs);
+}
+
+void test_debouncer_benchmark()
+{
+    std::cout << "  Running test_debouncer_benchmark()" << std::endl;
+    Debouncer debouncer{AnimationPins()};
+    debouncer.prime(0);
+    const uint32_t kSamples = 1000000;
+    uint32_t state = 1;
+    uint32_t flips = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t t = 0; t < kSamples; t++)
+    {
+        state = state * 1103515245u + 12345u;
+        flips += debouncer.sample(static_cast<uint8_t>(state >> 24), t) != 0;
+        InputEvent event;
+        while (debouncer.getQueue().pop(event))
+        {
+        }
+    }
+    const double ns = std::chrono::duration<double, std::nano>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    std::cout << "    " << ns / kSamples << " ns per sample of all inputs (" << flips
+              << " samples with edges)" << std::endl;
+}
+
+void runDebouncerTests()
+{
+    std::cout << "\n==== Starting Debouncer Tests ====" << std::endl;
+    RUN_TEST(test_debouncer_filters_bounce_traces);
+    RUN_TEST(test_debouncer_matches_per_input_counters);
+    RUN_TEST(test_debouncer_thresholds);
+    RUN_TEST(test_debouncer_samples_port_and_reports_changes);
+    RUN_TEST(test_debouncer_benchmark);
+}
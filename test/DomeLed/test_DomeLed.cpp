@@ -0,0 +1,162 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "Animation.h"
+#include "AudioPlayer.h"
+#include "DomeLed.h"
+#include "EyeAnimation.h"
+#include "NeoPixelRecorder.h"
+#include "Random.h"
+#include "TimerAudio.h"
+
+// The curve is fixed at compile time and lives in flash
+static_assert(DomeLedConstants::BREATH_CURVE[0] == 0, "Breath starts at the low level");
+static_assert(DomeLedConstants::BREATH_CURVE[DomeLedConstants::CURVE_SIZE / 2] == 255,
+              "Breath peaks halfway");
+
+void test_dome_led_breath_curve_shape()
+{
+    std::cout << "  Running test_dome_led_breath_curve_shape()" << std::endl;
+
+    const auto& curve = DomeLedConstants::BREATH_CURVE;
+    const uint16_t half = DomeLedConstants::CURVE_SIZE / 2;
+
+    // Rises monotonically to the peak, then falls back as a mirror image
+    for (uint16_t i = 1; i <= half; i++)
+    {
+        TEST_ASSERT_TRUE(curve[i] >= curve[i - 1]);
+        TEST_ASSERT_EQUAL(curve[i], curve[(DomeLedConstants::CURVE_SIZE - i) %
+                                          DomeLedConstants::CURVE_SIZE]);
+    }
+
+    // Eases in and out: small steps near the ends, the largest in the middle of the ramp
+    TEST_ASSERT_TRUE(curve[4] - curve[0] < curve[half / 2 + 2] - curve[half / 2 - 2]);
+    TEST_ASSERT_TRUE(curve[half] - curve[half - 4] < curve[half / 2 + 2] - curve[half / 2 - 2]);
+}
+
+void test_dome_led_breathes_between_levels()
+{
+    std::cout << "  Running test_dome_led_breathes_between_levels()" << std::endl;
+
+    DomeLed led(4);
+    TEST_ASSERT_TRUE(led.begin());
+    led.breathe(100, 200, 1000);
+
+    led.tick();
+    TEST_ASSERT_EQUAL(static_cast<int>(DomeLedMode::Breathing), static_cast<int>(led.getMode()));
+    TEST_ASSERT_UINT32_WITHIN(1, 1000 / DomeLedConstants::TICK_MS, led.getTicksPerBreath());
+    TEST_ASSERT_EQUAL(100, led.getLevel());
+
+    // One breath covers both levels and every duty is the gamma-corrected level
+    uint8_t minLevel = 255;
+    uint8_t maxLevel = 0;
+    for (uint32_t i = 1; i < led.getTicksPerBreath(); i++)
+    {
+        led.tick();
+        minLevel = std::min(minLevel, led.getLevel());
+        maxLevel = std::max(maxLevel, led.getLevel());
+        TEST_ASSERT_EQUAL(HsvColor::gamma8(led.getLevel()), led.getDuty());
+    }
+    TEST_ASSERT_EQUAL(100, minLevel);
+    TEST_ASSERT_EQUAL(200, maxLevel);
+
+    // The next breath starts over from the low level
+    led.tick();
+    TEST_ASSERT_UINT32_WITHIN(1, 100, led.getLevel());
+}
+
+void test_dome_led_pattern_changes()
+{
+    std::cout << "  Running test_dome_led_pattern_changes()" << std::endl;
+
+    DomeLed led(4);
+    led.begin();
+
+    // Nothing changes until the next tick picks up the pattern
+    led.setLevel(40);
+    TEST_ASSERT_EQUAL(static_cast<int>(DomeLedMode::Off), static_cast<int>(led.getMode()));
+
+    // Steady levels are ramped to rather than jumped to
+    led.tick();
+    TEST_ASSERT_EQUAL(static_cast<int>(DomeLedMode::Steady), static_cast<int>(led.getMode()));
+    TEST_ASSERT_EQUAL(DomeLedConstants::RAMP_STEP, led.getLevel());
+    for (uint8_t i = 0; i < 20; i++)
+    {
+        led.tick();
+    }
+    TEST_ASSERT_EQUAL(40, led.getLevel());
+    TEST_ASSERT_EQUAL(HsvColor::gamma8(40), led.getDuty());
+
+    // Setting the running pattern again does not restart the breath
+    led.breathe();
+    for (uint8_t i = 0; i < 50; i++)
+    {
+        led.tick();
+        led.breathe();
+    }
+    TEST_ASSERT_TRUE(led.getLevel() > DomeLedConstants::DEFAULT_LOW_LEVEL);
+
+    // Off fades down to dark and stays there
+    led.off();
+    led.tick();
+    TEST_ASSERT_TRUE(led.getLevel() > 0);
+    for (uint8_t i = 0; i < 255 / DomeLedConstants::RAMP_STEP + 1; i++)
+    {
+        led.tick();
+    }
+    TEST_ASSERT_EQUAL(0, led.getLevel());
+    TEST_ASSERT_EQUAL(0, led.getDuty());
+    TEST_ASSERT_EQUAL(0, led.getTicksPerBreath());
+}
+
+void test_animation_drives_dome_led_pattern()
+{
+    std::cout << "  Running test_animation_drives_dome_led_pattern()" << std::endl;
+
+    // Count dome writes; the motor pins may still be written
+    static uint32_t domeWrites;
+    domeWrites = 0;
+    When(Method(ArduinoFake(), analogWrite))
+        .AlwaysDo(
+            [](uint8_t pin, int)
+            {
+                if (pin == AnimationPins().domeLedGreen)
+                {
+                    domeWrites++;
+                }
+            });
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    NeoPixelRecorder pixels;
+    EyeAnimation eye(&pixels);
+    TimerAudio timerAudio(AnimationPins().audioOutPos, AnimationPins().audioOutNeg);
+    AudioPlayer audio(&timerAudio);
+    Animation animation(&eye, &audio, AnimationPins());
+    DomeLed led(AnimationPins().domeLedGreen);
+    animation.setDomeLed(&led);
+
+    AnimationInputs inputs = {HIGH, HIGH, HIGH, HIGH, HIGH, 5000};
+    animation.update(inputs);
+    animation.performRotate();
+    led.tick();
+    TEST_ASSERT_EQUAL(static_cast<int>(DomeLedMode::Breathing), static_cast<int>(led.getMode()));
+
+    inputs.pirSensor = LOW;
+    inputs.currentTime = 5010;
+    animation.update(inputs);
+    animation.performRotate();
+    led.tick();
+    TEST_ASSERT_EQUAL(static_cast<int>(DomeLedMode::Off), static_cast<int>(led.getMode()));
+
+    // The driver owns the pin, so the loop never writes it
+    TEST_ASSERT_EQUAL(0, domeWrites);
+}
+
+void runDomeLedTests()
+{
+    std::cout << "\n==== Starting Dome LED Tests ====" << std::endl;
+    RUN_TEST(test_dome_led_breath_curve_shape);
+    RUN_TEST(test_dome_led_breathes_between_levels);
+    RUN_TEST(test_dome_led_pattern_changes);
+    RUN_TEST(test_animation_drives_dome_led_pattern);
+}
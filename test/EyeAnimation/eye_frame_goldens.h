@@ -0,0 +1,17 @@
+#ifndef EYE_FRAME_GOLDENS_H
+#define EYE_FRAME_GOLDENS_H
+
+#include <stdint.h>
+
+// Stream hashes recorded by NeoPixelRecorder for the scripted runs in
+// test_EyeAnimationFrames.cpp, each started with Rng at RandomConstants::DEFAULT_SEED. A
+// mismatch means the rendered frames changed; if the change is intended, update the value
+// with the hash printed by the failing test.
+namespace EyeFrameGoldens
+{
+constexpr uint32_t SOLID_BLINK = 0x6E3A860E;
+constexpr uint32_t RAINBOW = 0x79223ADF;
+constexpr uint32_t ANIMATION_SCRIPTED = 0x4560BC80;
+}  // namespace EyeFrameGoldens
+
+#endif  // EYE_FRAME_GOLDENS_H
@@ -0,0 +1,132 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "Animation.h"
+#include "EyeAnimation.h"
+#include "NeoPixelRecorder.h"
+#include "Random.h"
+#include "eye_frame_goldens.h"
+
+using namespace fakeit;
+
+static void reportFrameRate(const char* name, const NeoPixelRecorder& recorder,
+                            unsigned long durationMs)
+{
+    std::cout << "    " << name << ": " << recorder.getFrameCount() << " frames, "
+              << recorder.getFramesPerSecond(durationMs) << " frames/s, "
+              << recorder.getPixelWritesPerSecond(durationMs)
+              << " pixel writes/s, stream hash 0x" << std::hex << recorder.getStreamHash()
+              << std::dec << std::endl;
+}
+
+// One step of a scripted input sequence, held until the given time
+struct FrameScriptStep
+{
+    unsigned long untilMs;
+    int8_t pirSensor;
+    int8_t buttonRectangle;
+    int8_t buttonCircle;
+};
+
+void test_eye_frames_solid_blink_golden()
+{
+    std::cout << "  Running test_eye_frames_solid_blink_golden()" << std::endl;
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    NeoPixelRecorder recorder;
+    EyeAnimation eye(&recorder);
+    eye.setTopPixels(5, 4);
+    eye.setCurrentTime(0);
+    eye.blink(300);
+
+    // 20 seconds of the solid eye at the 10 ms loop rate, including blink sequences
+    const unsigned long durationMs = 20000;
+    for (unsigned long t = 0; t < durationMs; t += 10)
+    {
+        recorder.setTime(t);
+        eye.setCurrentTime(t);
+        eye.updateActiveColor();
+    }
+
+    reportFrameRate("solid+blink", recorder, durationMs);
+    TEST_ASSERT_EQUAL(durationMs / 10, recorder.getFrameCount());
+    TEST_ASSERT_EQUAL_HEX32(EyeFrameGoldens::SOLID_BLINK, recorder.getStreamHash());
+}
+
+void test_eye_frames_rainbow_golden()
+{
+    std::cout << "  Running test_eye_frames_rainbow_golden()" << std::endl;
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    NeoPixelRecorder recorder;
+    EyeAnimation eye(&recorder);
+    eye.setTopPixels(5, 4);
+
+    const unsigned long durationMs = 5000;
+    for (unsigned long t = 0; t < durationMs; t += 10)
+    {
+        recorder.setTime(t);
+        eye.setCurrentTime(t);
+        eye.updateRainbowColor();
+    }
+
+    reportFrameRate("rainbow", recorder, durationMs);
+    TEST_ASSERT_EQUAL(durationMs / 10, recorder.getFrameCount());
+    TEST_ASSERT_EQUAL_HEX32(EyeFrameGoldens::RAINBOW, recorder.getStreamHash());
+}
+
+void test_animation_frames_scripted_golden()
+{
+    std::cout << "  Running test_animation_frames_scripted_golden()" << std::endl;
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+    When(Method(ArduinoFake(), analogWrite)).AlwaysReturn();
+
+    // Idle, motion, color change, rainbow, then long enough without motion to sleep
+    const FrameScriptStep script[] = {
+        {2000, LOW, HIGH, HIGH},   {5000, HIGH, HIGH, HIGH},  {5100, HIGH, LOW, HIGH},
+        {12000, HIGH, HIGH, HIGH}, {14000, LOW, HIGH, HIGH},  {15000, LOW, HIGH, LOW},
+        {320000, LOW, HIGH, HIGH},
+    };
+
+    NeoPixelRecorder recorder;
+    EyeAnimation eye(&recorder);
+    eye.setTopPixels(5, 4);
+    Animation animation(&eye, nullptr, AnimationPins());
+
+    size_t step = 0;
+    const unsigned long durationMs = script[sizeof(script) / sizeof(script[0]) - 1].untilMs;
+    for (unsigned long t = 0; t < durationMs; t += 10)
+    {
+        while (t >= script[step].untilMs)
+        {
+            step++;
+        }
+        AnimationInputs inputs;
+        inputs.sensorLeft = HIGH;
+        inputs.sensorRight = HIGH;
+        inputs.pirSensor = script[step].pirSensor;
+        inputs.buttonRectangle = script[step].buttonRectangle;
+        inputs.buttonCircle = script[step].buttonCircle;
+        inputs.currentTime = t;
+
+        recorder.setTime(t);
+        animation.update(inputs);
+        animation.performRotate();
+        animation.eyeBlink();
+    }
+
+    reportFrameRate("animation", recorder, durationMs);
+    TEST_ASSERT_GREATER_THAN(0, recorder.getFrameCount());
+    TEST_ASSERT_EQUAL_HEX32(EyeFrameGoldens::ANIMATION_SCRIPTED, recorder.getStreamHash());
+
+    // The eye goes dark and stops refreshing once it falls asleep
+    TEST_ASSERT_LESS_THAN(durationMs - 1000, recorder.getFrames().back().time);
+}
+
+void runEyeAnimationFramesTests()
+{
+    std::cout << "\n==== Starting Eye Animation Frame Tests ====" << std::endl;
+    RUN_TEST(test_eye_frames_solid_blink_golden);
+    RUN_TEST(test_eye_frames_rainbow_golden);
+    RUN_TEST(test_animation_frames_scripted_golden);
+}
@@ -0,0 +1,191 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "EyeAnimation.h"
+#include "NeoPixelRecorder.h"
+#include "Random.h"
+
+// Reference blend: unpack, blend each channel, repack
+static uint32_t referenceLerpColor(uint32_t from, uint32_t to, uint16_t weight)
+{
+    uint32_t result = 0;
+    for (uint8_t shift = 0; shift <= 16; shift += 8)
+    {
+        const uint32_t a = (from >> shift) & 0xFF;
+        const uint32_t b = (to >> shift) & 0xFF;
+        result |= (((a * (256 - weight) + b * weight) >> 8) & 0xFF) << shift;
+    }
+    return result;
+}
+
+// Recorder whose driver can be held busy, like a strip still latching its last frame
+class BusyRecorder : public NeoPixelRecorder
+{
+public:
+    bool canShow() override { return !m_busy; }
+    void setBusy(bool busy) { m_busy = busy; }
+
+private:
+    bool m_busy = false;
+};
+
+void test_lerp_color_matches_reference()
+{
+    std::cout << "  Running test_lerp_color_matches_reference()" << std::endl;
+
+    // Every channel pair at the extremes, across every weight
+    const uint32_t colors[] = {0x000000, 0xFFFFFF, 0xFF0000, 0x00FF00, 0x0000FF,
+                               0x21DDF5, 0x0BBD39, 0x80FF01, 0x7F007F, 0x010101};
+    for (uint16_t weight = 0; weight <= EyeAnimationConstants::LERP_WEIGHT_MAX; weight++)
+    {
+        for (uint32_t from : colors)
+        {
+            for (uint32_t to : colors)
+            {
+                TEST_ASSERT_EQUAL_HEX32(referenceLerpColor(from, to, weight),
+                                        EyeAnimation::lerpColor(from, to, weight));
+            }
+        }
+    }
+
+    // Random colors and weights, with both endpoints reproduced exactly
+    uint32_t state = 3;
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        state = state * 1664525u + 1013904223u;
+        const uint32_t from = state >> 8;
+        state = state * 1664525u + 1013904223u;
+        const uint32_t to = state >> 8;
+        const uint16_t weight = static_cast<uint16_t>(state % 257);
+        TEST_ASSERT_EQUAL_HEX32(referenceLerpColor(from, to, weight),
+                                EyeAnimation::lerpColor(from, to, weight));
+        TEST_ASSERT_EQUAL_HEX32(from, EyeAnimation::lerpColor(from, to, 0));
+        TEST_ASSERT_EQUAL_HEX32(to, EyeAnimation::lerpColor(from, to, 256));
+    }
+}
+
+void test_eye_interpolation_blends_between_keyframes()
+{
+    std::cout << "  Running test_eye_interpolation_blends_between_keyframes()" << std::endl;
+
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    NeoPixelRecorder recorder;
+    EyeAnimation eye(&recorder);
+    eye.setBrightness(255);
+    eye.setInterpolation(true);
+    recorder.reset();
+
+    // Logical updates only compose keyframes
+    eye.setCurrentTime(0);
+    eye.setActiveColor(EyeAnimationConstants::COLOR_BLUE);
+    eye.updateActiveColor();
+    TEST_ASSERT_EQUAL(0, recorder.getFrameCount());
+
+    // The first keyframe is shown as is, and only once
+    TEST_ASSERT_TRUE(eye.renderInterpolated(0));
+    TEST_ASSERT_FALSE(eye.renderInterpolated(4));
+    TEST_ASSERT_EQUAL_HEX32(EyeAnimationConstants::COLOR_BLUE, recorder.getPixelColor(0));
+
+    // Across the next logical interval the output moves from blue to green
+    eye.setCurrentTime(10);
+    eye.setActiveColor(EyeAnimationConstants::COLOR_GREEN);
+    eye.updateActiveColor();
+    for (unsigned long t = 10; t <= 20; t += 2)
+    {
+        const uint16_t weight = static_cast<uint16_t>((t - 10) * 256 / 10);
+        TEST_ASSERT_TRUE(eye.renderInterpolated(t));
+        TEST_ASSERT_EQUAL_HEX32(EyeAnimation::lerpColor(EyeAnimationConstants::COLOR_BLUE,
+                                                        EyeAnimationConstants::COLOR_GREEN, weight),
+                                recorder.getPixelColor(0));
+        TEST_ASSERT_EQUAL_HEX32(EyeAnimation::lerpColor(0x0000FF, 0x00FF00, weight),
+                                recorder.getPixelColor(EyeAnimationConstants::NUM_PIXELS_IN_RING));
+    }
+
+    // Past the interval the newer keyframe holds without rewriting the LEDs
+    TEST_ASSERT_FALSE(eye.renderInterpolated(25));
+    TEST_ASSERT_EQUAL_HEX32(EyeAnimationConstants::COLOR_GREEN, recorder.getPixelColor(0));
+
+    // Sleeping goes dark on the next output pass instead of fading
+    eye.setCurrentTime(30);
+    eye.sleep();
+    TEST_ASSERT_TRUE(eye.renderInterpolated(30));
+    TEST_ASSERT_EQUAL_HEX32(0, recorder.getPixelColor(0));
+
+    const EyeFrameStats& stats = eye.getFrameStats();
+    TEST_ASSERT_EQUAL(3, stats.logicFrames);
+    TEST_ASSERT_EQUAL(8, stats.outputFrames);
+    TEST_ASSERT_EQUAL(stats.outputFrames, recorder.getFrameCount());
+}
+
+void test_eye_interpolation_outputs_faster_than_logic()
+{
+    std::cout << "  Running test_eye_interpolation_outputs_faster_than_logic()" << std::endl;
+
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    NeoPixelRecorder recorder;
+    EyeAnimation eye(&recorder);
+    eye.setInterpolation(true);
+    eye.resetFrameStats();
+    recorder.reset();
+
+    // One second of rainbow: behavior at 100 Hz, output pass every 2 ms
+    for (unsigned long t = 0; t < 1000; t += 2)
+    {
+        if (t % 10 == 0)
+        {
+            eye.setCurrentTime(t);
+            eye.updateRainbowColor();
+        }
+        eye.renderInterpolated(t);
+    }
+
+    const EyeFrameStats& stats = eye.getFrameStats();
+    std::cout << "    logic " << stats.logicFrames << " fps, output " << stats.outputFrames
+              << " fps" << std::endl;
+    TEST_ASSERT_EQUAL(100, stats.logicFrames);
+    TEST_ASSERT_GREATER_OR_EQUAL(4 * stats.logicFrames, stats.outputFrames);
+    TEST_ASSERT_EQUAL(0, stats.skippedFrames);
+    TEST_ASSERT_EQUAL(stats.outputFrames, recorder.getFrameCount());
+}
+
+void test_eye_interpolation_waits_for_idle_driver()
+{
+    std::cout << "  Running test_eye_interpolation_waits_for_idle_driver()" << std::endl;
+
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    BusyRecorder recorder;
+    EyeAnimation eye(&recorder);
+    eye.setCurrentTime(0);
+    recorder.reset();
+
+    // Without interpolation every logical frame is shown directly
+    eye.updateActiveColor();
+    TEST_ASSERT_FALSE(eye.renderInterpolated(0));
+    TEST_ASSERT_EQUAL(1, eye.getFrameStats().logicFrames);
+    TEST_ASSERT_EQUAL(1, eye.getFrameStats().outputFrames);
+
+    // A busy driver drops the output pass, which is retried once it is idle
+    eye.setInterpolation(true);
+    eye.updateActiveColor();
+    recorder.setBusy(true);
+    TEST_ASSERT_FALSE(eye.renderInterpolated(0));
+    TEST_ASSERT_EQUAL(1, eye.getFrameStats().skippedFrames);
+    TEST_ASSERT_EQUAL(1, recorder.getFrameCount());
+
+    recorder.setBusy(false);
+    TEST_ASSERT_TRUE(eye.renderInterpolated(0));
+    TEST_ASSERT_EQUAL(2, recorder.getFrameCount());
+    TEST_ASSERT_EQUAL(2, eye.getFrameStats().outputFrames);
+}
+
+void runEyeAnimationInterpolationTests()
+{
+    std::cout << "\n==== Starting Eye Animation Interpolation Tests ====" << std::endl;
+    RUN_TEST(test_lerp_color_matches_reference);
+    RUN_TEST(test_eye_interpolation_blends_between_keyframes);
+    RUN_TEST(test_eye_interpolation_outputs_faster_than_logic);
+    RUN_TEST(test_eye_interpolation_waits_for_idle_driver);
+}
@@ -0,0 +1,177 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "Animation.h"
+#include "AudioPlayer.h"
+#include "EyeAnimation.h"
+#include "NeoPixelRecorder.h"
+#include "Random.h"
+#include "TimerAudio.h"
+
+
+// Step one eye through its own timeline, starting startMs after the shared clock
+static void stepEye(EyeAnimation& eye, NeoPixelRecorder& recorder, unsigned long t,
+                    unsigned long startMs)
+{
+    if (t < startMs)
+    {
+        return;
+    }
+    recorder.setTime(t);
+    eye.setCurrentTime(t);
+    eye.updateActiveColor();
+}
+
+static bool isRingDimmed(const NeoPixelRecorder& recorder)
+{
+    const uint32_t open =
+        EyeAnimation::scaleColor(EyeAnimationConstants::COLOR_BLUE,
+                                 EyeAnimationConstants::DEFAULT_BRIGHTNESS);
+    for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS_IN_RING; i++)
+    {
+        if (recorder.getPixelColor(i) != open)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void test_two_eyes_blink_independently()
+{
+    std::cout << "  Running test_two_eyes_blink_independently()" << std::endl;
+
+    const unsigned long durationMs = 20000;
+    const unsigned long lateStartMs = 130;
+    const unsigned long starts[2] = {0, lateStartMs};
+
+    // Side by side on the same clock, each eye draws its own blink schedule from Rng, and
+    // the same seed reproduces both streams
+    uint32_t hashes[2][2];
+    for (uint32_t(&run)[2] : hashes)
+    {
+        Rng.seed(RandomConstants::DEFAULT_SEED);
+        NeoPixelRecorder pixels[2];
+        EyeAnimation left(&pixels[0]);
+        EyeAnimation right(&pixels[1]);
+        EyeAnimation* eyes[2] = {&left, &right};
+        bool wasDimmed[2] = {};
+        uint32_t blinks[2] = {};
+        for (unsigned long t = 0; t < durationMs; t += 10)
+        {
+            for (uint8_t e = 0; e < 2; e++)
+            {
+                stepEye(*eyes[e], pixels[e], t, starts[e]);
+                const bool dimmed = t >= starts[e] && isRingDimmed(pixels[e]);
+                blinks[e] += dimmed && !wasDimmed[e] ? 1 : 0;
+                wasDimmed[e] = dimmed;
+            }
+        }
+        run[0] = pixels[0].getStreamHash();
+        run[1] = pixels[1].getStreamHash();
+        TEST_ASSERT_GREATER_THAN(1, blinks[0]);
+        TEST_ASSERT_GREATER_THAN(1, blinks[1]);
+    }
+
+    TEST_ASSERT_NOT_EQUAL(hashes[0][0], hashes[0][1]);
+    TEST_ASSERT_EQUAL_HEX32(hashes[0][0], hashes[1][0]);
+    TEST_ASSERT_EQUAL_HEX32(hashes[0][1], hashes[1][1]);
+}
+
+void test_follower_eye_blinks_with_offset()
+{
+    std::cout << "  Running test_follower_eye_blinks_with_offset()" << std::endl;
+
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+    const unsigned long offsetMs = 60;
+
+    NeoPixelRecorder leaderPixels;
+    NeoPixelRecorder followerPixels;
+    EyeAnimation leader(&leaderPixels);
+    EyeAnimation follower(&followerPixels);
+    follower.followBlinks(&leader, offsetMs);
+
+    // Every leader blink, scheduled or explicit, is mirrored offsetMs later
+    leader.setCurrentTime(0);
+    leader.blink(300);
+    unsigned long leaderDims = 0;
+    unsigned long followerDims = 0;
+    bool leaderWasDimmed = false;
+    bool followerWasDimmed = false;
+    unsigned long firstLeaderDim = 0;
+    unsigned long firstFollowerDim = 0;
+    for (unsigned long t = 0; t < 10000; t += 10)
+    {
+        stepEye(leader, leaderPixels, t, 0);
+        stepEye(follower, followerPixels, t, 0);
+
+        const bool leaderDimmed = isRingDimmed(leaderPixels);
+        const bool followerDimmed = isRingDimmed(followerPixels);
+        if (leaderDimmed && !leaderWasDimmed)
+        {
+            firstLeaderDim = leaderDims == 0 ? t : firstLeaderDim;
+            leaderDims++;
+        }
+        if (followerDimmed && !followerWasDimmed)
+        {
+            firstFollowerDim = followerDims == 0 ? t : firstFollowerDim;
+            followerDims++;
+        }
+        leaderWasDimmed = leaderDimmed;
+        followerWasDimmed = followerDimmed;
+    }
+
+    TEST_ASSERT_GREATER_THAN(1, leaderDims);
+    TEST_ASSERT_EQUAL(leaderDims, followerDims);
+    TEST_ASSERT_EQUAL(firstLeaderDim + offsetMs, firstFollowerDim);
+}
+
+void test_animation_drives_several_eyes()
+{
+    std::cout << "  Running test_animation_drives_several_eyes()" << std::endl;
+
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    NeoPixelRecorder pixels[AnimationConstants::kMaxEyes];
+    EyeAnimation first(&pixels[0]);
+    EyeAnimation second(&pixels[1]);
+    EyeAnimation third(&pixels[2]);
+    EyeAnimation fourth(&pixels[3]);
+    TimerAudio timerAudio(AnimationPins().audioOutPos, AnimationPins().audioOutNeg);
+    AudioPlayer audio(&timerAudio);
+    Animation animation(&first, &audio, AnimationPins());
+
+    TEST_ASSERT_EQUAL(1, animation.getNumEyes());
+    TEST_ASSERT_FALSE(animation.addEye(nullptr));
+    TEST_ASSERT_TRUE(animation.addEye(&second));
+    TEST_ASSERT_TRUE(animation.addEye(&third));
+    TEST_ASSERT_TRUE(animation.addEye(&fourth));
+    TEST_ASSERT_FALSE(animation.addEye(&first));
+    TEST_ASSERT_EQUAL(AnimationConstants::kMaxEyes, animation.getNumEyes());
+
+    // Every eye is updated on each pass
+    for (NeoPixelRecorder& recorder : pixels)
+    {
+        recorder.reset();
+    }
+    AnimationInputs inputs = {HIGH, HIGH, LOW, HIGH, HIGH, 0};
+    for (unsigned long t = 0; t < 1000; t += 10)
+    {
+        inputs.currentTime = t;
+        animation.update(inputs);
+        animation.eyeBlink();
+    }
+    for (const NeoPixelRecorder& recorder : pixels)
+    {
+        TEST_ASSERT_EQUAL(100, recorder.getFrameCount());
+        TEST_ASSERT_EQUAL_HEX32(pixels[0].getStreamHash(), recorder.getStreamHash());
+    }
+}
+
+void runEyeAnimationMultiEyeTests()
+{
+    std::cout << "\n==== Starting Eye Animation Multi-Eye Tests ====" << std::endl;
+    RUN_TEST(test_two_eyes_blink_independently);
+    RUN_TEST(test_follower_eye_blinks_with_offset);
+    RUN_TEST(test_animation_drives_several_eyes);
+}
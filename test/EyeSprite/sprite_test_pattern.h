@@ -0,0 +1,25 @@
+// Auto-generated from test_pattern.csv
+#ifndef SPRITE_TEST_PATTERN_H
+#define SPRITE_TEST_PATTERN_H
+
+#include <Arduino.h>
+#include <EyeSprite.h>
+
+// 6 frames of 17 pixels, 97 bytes (306 raw)
+const uint8_t sprite_test_pattern_data[] PROGMEM = {
+    0x43, 0xff, 0x00, 0x00, 0x43, 0x00, 0xff, 0x00, 0x03, 0x84, 0x12, 0x34,
+    0x56, 0x65, 0x43, 0x21, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0x09, 0x80, 0x01, 0x02, 0x03, 0xff, 0x90, 0x11, 0x11,
+    0x11, 0x22, 0x22, 0x22, 0x33, 0x33, 0x33, 0x44, 0x44, 0x44, 0x55, 0x55,
+    0x55, 0x66, 0x66, 0x66, 0x77, 0x77, 0x77, 0x88, 0x88, 0x88, 0x99, 0x99,
+    0x99, 0xaa, 0xaa, 0xaa, 0xbb, 0xbb, 0xbb, 0xcc, 0xcc, 0xcc, 0xdd, 0xdd,
+    0xdd, 0xee, 0xee, 0xee, 0xff, 0xff, 0xff, 0x01, 0x01, 0x01, 0x02, 0x02,
+    0x02, 0xff, 0x0f, 0x80, 0xff, 0xff, 0xff, 0xff, 0x50, 0x00, 0x00, 0x00,
+    0xff,
+};
+
+// Clip descriptor: data, size, frames, ms per frame, pixels per frame
+const EyeSpriteClip sprite_test_pattern = {
+    sprite_test_pattern_data, sizeof(sprite_test_pattern_data), 6, 50, 17};
+
+#endif // SPRITE_TEST_PATTERN_H
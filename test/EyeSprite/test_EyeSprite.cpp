@@ -0,0 +1,165 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "EyeAnimation.h"
+#include "EyeSprite.h"
+#include "EyeSprite/sprite_test_pattern.h"
+#include "NeoPixelRecorder.h"
+#include "Random.h"
+#include "SpriteData.h"
+
+// Source frames of sprite_test_pattern.h, as listed in test_pattern.csv
+static const uint32_t kTestPatternFrames[6][EyeAnimationConstants::NUM_PIXELS] = {
+    {0xFF0000, 0xFF0000, 0xFF0000, 0xFF0000, 0x00FF00, 0x00FF00, 0x00FF00, 0x00FF00, 0x000000,
+     0x000000, 0x000000, 0x000000, 0x123456, 0x654321, 0xABCDEF, 0xFEDCBA, 0x0000FF},
+    {0xFF0000, 0xFF0000, 0xFF0000, 0xFF0000, 0x00FF00, 0x00FF00, 0x00FF00, 0x00FF00, 0x000000,
+     0x000000, 0x000000, 0x000000, 0x123456, 0x654321, 0xABCDEF, 0xFEDCBA, 0x0000FF},
+    {0xFF0000, 0xFF0000, 0xFF0000, 0xFF0000, 0x00FF00, 0x00FF00, 0x00FF00, 0x00FF00, 0x000000,
+     0x000000, 0x010203, 0x000000, 0x123456, 0x654321, 0xABCDEF, 0xFEDCBA, 0x0000FF},
+    {0x111111, 0x222222, 0x333333, 0x444444, 0x555555, 0x666666, 0x777777, 0x888888, 0x999999,
+     0xAAAAAA, 0xBBBBBB, 0xCCCCCC, 0xDDDDDD, 0xEEEEEE, 0xFFFFFF, 0x010101, 0x020202},
+    {0x111111, 0x222222, 0x333333, 0x444444, 0x555555, 0x666666, 0x777777, 0x888888, 0x999999,
+     0xAAAAAA, 0xBBBBBB, 0xCCCCCC, 0xDDDDDD, 0xEEEEEE, 0xFFFFFF, 0x010101, 0xFFFFFF},
+    {0}};
+
+// Source frame of the boot spin clip: a four pixel comet, each tail pixel at half the
+// brightness of the one ahead of it, around a blue center
+static void bootSpinFrame(uint16_t index, uint32_t* frame)
+{
+    for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS_IN_RING; i++)
+    {
+        frame[i] = 0;
+    }
+    for (uint8_t tail = 0; tail < 4; tail++)
+    {
+        const uint32_t head = EyeAnimationConstants::COLOR_BLUE;
+        const uint16_t pixel = (index + EyeAnimationConstants::NUM_PIXELS_IN_RING - tail) %
+                               EyeAnimationConstants::NUM_PIXELS_IN_RING;
+        frame[pixel] = ((((head >> 16) & 0xFF) >> tail) << 16) |
+                       ((((head >> 8) & 0xFF) >> tail) << 8) | ((head & 0xFF) >> tail);
+    }
+    frame[EyeAnimationConstants::NUM_PIXELS_IN_RING] = 0x0000FF;
+}
+
+void test_sprite_decodes_frame_exact()
+{
+    std::cout << "  Running test_sprite_decodes_frame_exact()" << std::endl;
+
+    // Every operation round-trips to the source frame
+    EyeSpriteDecoder decoder;
+    decoder.start(&sprite_test_pattern);
+    uint32_t frame[EyeAnimationConstants::NUM_PIXELS] = {0};
+    for (uint16_t f = 0; f < sprite_test_pattern.numFrames; f++)
+    {
+        TEST_ASSERT_FALSE(decoder.isFinished());
+        TEST_ASSERT_TRUE(decoder.decodeNext(frame, EyeAnimationConstants::NUM_PIXELS));
+        TEST_ASSERT_EQUAL_HEX32_ARRAY(kTestPatternFrames[f], frame,
+                                      EyeAnimationConstants::NUM_PIXELS);
+    }
+    TEST_ASSERT_TRUE(decoder.isFinished());
+    TEST_ASSERT_FALSE(decoder.decodeNext(frame, EyeAnimationConstants::NUM_PIXELS));
+
+    // The shipped clips decode to their source frames as well
+    const EyeSpriteClip* boot = getSpriteClip(SPRITE_BOOT_SPIN);
+    TEST_ASSERT_NOT_NULL(boot);
+    TEST_ASSERT_NULL(getSpriteClip(NUM_SPRITE_CLIPS));
+    TEST_ASSERT_EQUAL(EyeAnimationConstants::NUM_PIXELS, boot->numPixels);
+    TEST_ASSERT_TRUE(boot->size < boot->numFrames * boot->numPixels * 3u);
+    decoder.start(boot);
+    std::fill(frame, frame + EyeAnimationConstants::NUM_PIXELS, 0);
+    uint32_t expected[EyeAnimationConstants::NUM_PIXELS];
+    for (uint16_t f = 0; f < boot->numFrames; f++)
+    {
+        bootSpinFrame(f, expected);
+        TEST_ASSERT_TRUE(decoder.decodeNext(frame, EyeAnimationConstants::NUM_PIXELS));
+        TEST_ASSERT_EQUAL_HEX32_ARRAY(expected, frame, EyeAnimationConstants::NUM_PIXELS);
+    }
+}
+
+void test_sprite_stops_on_corrupt_clip()
+{
+    std::cout << "  Running test_sprite_stops_on_corrupt_clip()" << std::endl;
+
+    uint32_t frame[EyeAnimationConstants::NUM_PIXELS] = {0};
+
+    // A literal whose colors run past the end of the data
+    static const uint8_t truncated[] PROGMEM = {0x81, 0x11, 0x22, 0x33, 0x44};
+    const EyeSpriteClip truncatedClip = {truncated, sizeof(truncated), 1, 10, 17};
+    EyeSpriteDecoder decoder;
+    decoder.start(&truncatedClip);
+    TEST_ASSERT_FALSE(decoder.decodeNext(frame, EyeAnimationConstants::NUM_PIXELS));
+    TEST_ASSERT_TRUE(decoder.isFinished());
+    TEST_ASSERT_EQUAL_HEX32(0, frame[0]);
+
+    // An unknown operation
+    static const uint8_t unknown[] PROGMEM = {0xC0, 0x11, 0x22, 0x33, 0xFF};
+    const EyeSpriteClip unknownClip = {unknown, sizeof(unknown), 1, 10, 17};
+    decoder.start(&unknownClip);
+    TEST_ASSERT_FALSE(decoder.decodeNext(frame, EyeAnimationConstants::NUM_PIXELS));
+
+    // Pixels beyond the buffer are skipped rather than written
+    static const uint8_t wide[] PROGMEM = {0x42, 0x11, 0x22, 0x33, 0xFF};
+    const EyeSpriteClip wideClip = {wide, sizeof(wide), 1, 10, 3};
+    uint32_t small[4] = {0, 0, 0, 0xDEAD};
+    decoder.start(&wideClip);
+    TEST_ASSERT_TRUE(decoder.decodeNext(small, 2));
+    TEST_ASSERT_EQUAL_HEX32(0x112233, small[1]);
+    TEST_ASSERT_EQUAL_HEX32(0, small[2]);
+    TEST_ASSERT_EQUAL_HEX32(0xDEAD, small[3]);
+}
+
+void test_eye_plays_sprite_at_clip_rate()
+{
+    std::cout << "  Running test_eye_plays_sprite_at_clip_rate()" << std::endl;
+
+    // No blink within the clip
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    NeoPixelRecorder recorder;
+    EyeAnimation eye(&recorder);
+    eye.setBrightness(255);
+    eye.setCurrentTime(1000);
+    eye.playSprite(&sprite_test_pattern);
+    TEST_ASSERT_TRUE(eye.isPlayingSprite());
+
+    // Each frame is shown for frameMs, decoded at the eye's own update rate
+    const unsigned long clipMs = sprite_test_pattern.numFrames * sprite_test_pattern.frameMs;
+    for (unsigned long t = 0; t < clipMs; t += 10)
+    {
+        eye.setCurrentTime(1000 + t);
+        eye.updateActiveColor();
+        const uint16_t f = t / sprite_test_pattern.frameMs;
+        for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS; i++)
+        {
+            TEST_ASSERT_EQUAL_HEX32(kTestPatternFrames[f][i], recorder.getPixelColor(i));
+        }
+    }
+
+    // Once the clip is over the eye goes back to its color
+    eye.setCurrentTime(1000 + clipMs);
+    eye.updateActiveColor();
+    TEST_ASSERT_FALSE(eye.isPlayingSprite());
+    TEST_ASSERT_EQUAL_HEX32(EyeAnimationConstants::COLOR_BLUE, recorder.getPixelColor(0));
+
+    // A looping clip starts over from black, even after a gap of several passes
+    eye.playSprite(&sprite_test_pattern, true);
+    eye.setCurrentTime(1000 + clipMs + 3 * clipMs + 2 * sprite_test_pattern.frameMs);
+    eye.updateRainbowColor();
+    TEST_ASSERT_TRUE(eye.isPlayingSprite());
+    for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX32(kTestPatternFrames[2][i], recorder.getPixelColor(i));
+    }
+
+    // Sleeping stops the clip
+    eye.sleep();
+    TEST_ASSERT_FALSE(eye.isPlayingSprite());
+}
+
+void runEyeSpriteTests()
+{
+    std::cout << "\n==== Starting Eye Sprite Tests ====" << std::endl;
+    RUN_TEST(test_sprite_decodes_frame_exact);
+    RUN_TEST(test_sprite_stops_on_corrupt_clip);
+    RUN_TEST(test_eye_plays_sprite_at_clip_rate);
+}
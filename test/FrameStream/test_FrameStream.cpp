@@ -0,0 +1,223 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "EyeAnimation.h"
+#include "FrameStream.h"
+#include "NeoPixelRecorder.h"
+#include "Random.h"
+
+// A test frame whose colors depend on its sequence number
+static void makeStreamPixels(uint16_t sequence, uint32_t* pixels)
+{
+    for (uint8_t i = 0; i < FrameStreamConstants::MAX_PIXELS; i++)
+    {
+        pixels[i] = (static_cast<uint32_t>(sequence & 0xFF) << 16) | (i << 8) | (0xFF - i);
+    }
+}
+
+// Encode a test frame and feed it to the stream, as the USB port would deliver it
+static void sendStreamFrame(FrameStream& stream, uint16_t sequence, unsigned long nowUs)
+{
+    uint32_t pixels[FrameStreamConstants::MAX_PIXELS];
+    makeStreamPixels(sequence, pixels);
+    uint8_t message[FrameStreamConstants::MAX_MESSAGE_SIZE];
+    const size_t length = FrameStream::encode(sequence, sequence * 16667UL, pixels,
+                                              FrameStreamConstants::MAX_PIXELS, message);
+    stream.receive(message, length, nowUs);
+}
+
+void test_frame_stream_loopback()
+{
+    std::cout << "  Running test_frame_stream_loopback()" << std::endl;
+
+    FrameStream stream;
+    TEST_ASSERT_FALSE(stream.isActive(0));
+    TEST_ASSERT_NULL(stream.take(0));
+
+    // Messages split at every possible point, with line noise in between, decode exactly
+    uint32_t pixels[FrameStreamConstants::MAX_PIXELS];
+    uint8_t message[FrameStreamConstants::MAX_MESSAGE_SIZE];
+    const uint8_t noise[] = {0x00, 0xA5, 0x13, 0x5A, 0xA5};
+    for (uint16_t sequence = 1; sequence <= 20; sequence++)
+    {
+        makeStreamPixels(sequence, pixels);
+        const uint8_t numPixels = 1 + sequence % FrameStreamConstants::MAX_PIXELS;
+        const size_t length = FrameStream::encode(sequence, 1000000UL + sequence, pixels,
+                                                  numPixels, message);
+        TEST_ASSERT_EQUAL(FrameStreamConstants::HEADER_SIZE + 3 * numPixels + 1, length);
+
+        const unsigned long nowUs = sequence * 10000UL;
+        stream.receive(noise, sizeof(noise), nowUs);
+        const size_t split = sequence % length;
+        stream.receive(message, split, nowUs);
+        TEST_ASSERT_NULL(stream.take(nowUs));
+        stream.receive(message + split, length - split, nowUs + 100);
+
+        TEST_ASSERT_TRUE(stream.isActive(nowUs + 100));
+        const StreamFrame* frame = stream.take(nowUs + 350);
+        TEST_ASSERT_NOT_NULL(frame);
+        TEST_ASSERT_EQUAL(sequence, frame->sequence);
+        TEST_ASSERT_EQUAL(1000000UL + sequence, frame->hostTimeUs);
+        TEST_ASSERT_EQUAL(numPixels, frame->numPixels);
+        TEST_ASSERT_EQUAL_HEX32_ARRAY(pixels, frame->pixels, numPixels);
+        TEST_ASSERT_NULL(stream.take(nowUs + 400));  // Each frame is taken once
+    }
+
+    const FrameStreamStats& stats = stream.getStats();
+    TEST_ASSERT_EQUAL(20, stats.received);
+    TEST_ASSERT_EQUAL(20, stats.shown);
+    TEST_ASSERT_EQUAL(0, stats.dropped);
+    TEST_ASSERT_EQUAL(0, stats.corrupt);
+    TEST_ASSERT_EQUAL(250, stats.lastLatencyUs);
+    TEST_ASSERT_EQUAL(250, stats.maxLatencyUs);
+    TEST_ASSERT_EQUAL(20 * 250, stats.totalLatencyUs);
+}
+
+void test_frame_stream_drops_stale_frames()
+{
+    std::cout << "  Running test_frame_stream_drops_stale_frames()" << std::endl;
+
+    FrameStream stream;
+
+    // Two frames between render ticks: only the newest is shown
+    sendStreamFrame(stream, 10, 1000);
+    sendStreamFrame(stream, 11, 2000);
+    const StreamFrame* frame = stream.take(2500);
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_EQUAL(11, frame->sequence);
+    TEST_ASSERT_EQUAL(1, stream.getStats().dropped);
+    TEST_ASSERT_EQUAL(500, stream.getStats().lastLatencyUs);
+
+    // Duplicates and late frames never replace a newer one
+    sendStreamFrame(stream, 11, 3000);
+    sendStreamFrame(stream, 9, 3000);
+    TEST_ASSERT_NULL(stream.take(3500));
+    TEST_ASSERT_EQUAL(2, stream.getStats().stale);
+
+    // Sequence numbers wrap around
+    FrameStream wrapping;
+    sendStreamFrame(wrapping, 0xFFFF, 4000);
+    TEST_ASSERT_EQUAL(0xFFFF, wrapping.take(4000)->sequence);
+    sendStreamFrame(wrapping, 0, 5000);
+    TEST_ASSERT_EQUAL(0, wrapping.take(5000)->sequence);
+    TEST_ASSERT_EQUAL(0, wrapping.getStats().stale);
+
+    // A large jump back is a restarted host, and after a pause any sequence starts over
+    sendStreamFrame(stream, 1000, 6000);
+    sendStreamFrame(stream, 3, 7000);
+    TEST_ASSERT_EQUAL(3, stream.take(7000)->sequence);
+    sendStreamFrame(stream, 1, 7000 + FrameStreamConstants::TIMEOUT_US);
+    TEST_ASSERT_EQUAL(1, stream.take(7000 + FrameStreamConstants::TIMEOUT_US)->sequence);
+    TEST_ASSERT_EQUAL(2, stream.getStats().stale);
+    TEST_ASSERT_FALSE(stream.isActive(7000 + 2 * FrameStreamConstants::TIMEOUT_US));
+}
+
+void test_frame_stream_rejects_corrupt_messages()
+{
+    std::cout << "  Running test_frame_stream_rejects_corrupt_messages()" << std::endl;
+
+    FrameStream stream;
+    uint32_t pixels[FrameStreamConstants::MAX_PIXELS];
+    uint8_t message[FrameStreamConstants::MAX_MESSAGE_SIZE];
+    makeStreamPixels(1, pixels);
+    const size_t length =
+        FrameStream::encode(1, 0, pixels, FrameStreamConstants::MAX_PIXELS, message);
+    TEST_ASSERT_EQUAL(0, FrameStream::encode(1, 0, pixels, 0, message + length));
+
+    // Any flipped bit fails the checksum
+    for (size_t i = 2; i < length; i++)
+    {
+        uint8_t damaged[FrameStreamConstants::MAX_MESSAGE_SIZE];
+        std::copy(message, message + length, damaged);
+        damaged[i] ^= 0x10;
+        stream.receive(damaged, length, 0);
+        TEST_ASSERT_NULL(stream.take(0));
+    }
+    TEST_ASSERT_EQUAL(length - 2, stream.getStats().corrupt);
+
+    // Too many pixels is rejected before any pixel is stored
+    const uint8_t oversized[] = {FrameStreamConstants::SYNC_0, FrameStreamConstants::SYNC_1,
+                                 FrameStreamConstants::MAX_PIXELS + 1};
+    stream.receive(oversized, sizeof(oversized), 0);
+    TEST_ASSERT_EQUAL(length - 1, stream.getStats().corrupt);
+
+    // The parser recovers on the next intact message
+    stream.receive(message, length, 0);
+    TEST_ASSERT_NOT_NULL(stream.take(0));
+    TEST_ASSERT_EQUAL(1, stream.getStats().received);
+}
+
+void test_eye_shows_streamed_frames()
+{
+    std::cout << "  Running test_eye_shows_streamed_frames()" << std::endl;
+
+    static unsigned long nowUs;
+    nowUs = 0;
+    When(Method(ArduinoFake(), micros)).AlwaysDo([]() { return nowUs; });
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    NeoPixelRecorder recorder;
+    EyeAnimation eye(&recorder);
+    FrameStream stream;
+    eye.setFrameStream(&stream);
+    eye.setInterpolation(true);
+    recorder.reset();
+
+    // One second of a 60 FPS stream against 100 Hz logic and a 250 Hz output pass
+    uint16_t sequence = 0;
+    for (unsigned long t = 0; t < 1000000; t += 1000)
+    {
+        nowUs = t;
+        if (t >= (sequence * 1000000UL) / 60)
+        {
+            sendStreamFrame(stream, sequence++, nowUs);
+        }
+        if (t % 10000 == 0)
+        {
+            eye.setCurrentTime(t / 1000);
+            eye.updateActiveColor();
+        }
+        if (t % 4000 == 0)
+        {
+            eye.renderInterpolated(t / 1000);
+        }
+    }
+
+    // Every frame reached the LEDs once, within one output pass, scaled by the brightness
+    const FrameStreamStats& stats = stream.getStats();
+    std::cout << "    " << stats.shown << " shown, " << stats.dropped << " dropped, latency avg "
+              << stats.totalLatencyUs / stats.shown << " us, max " << stats.maxLatencyUs << " us"
+              << std::endl;
+    TEST_ASSERT_EQUAL(60, stats.received);
+    TEST_ASSERT_EQUAL(60, stats.shown);
+    TEST_ASSERT_EQUAL(0, stats.dropped);
+    TEST_ASSERT_TRUE(stats.maxLatencyUs < 4000);
+    TEST_ASSERT_EQUAL(stats.shown, recorder.getFrameCount());
+    uint32_t pixels[FrameStreamConstants::MAX_PIXELS];
+    makeStreamPixels(sequence - 1, pixels);
+    for (uint16_t i = 0; i < EyeAnimationConstants::NUM_PIXELS; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX32(
+            EyeAnimation::scaleColor(pixels[i], EyeAnimationConstants::DEFAULT_BRIGHTNESS),
+            recorder.getPixelColor(i));
+    }
+
+    // When the host stops, the eye's own animation returns
+    nowUs += FrameStreamConstants::TIMEOUT_US;
+    eye.setCurrentTime(nowUs / 1000);
+    eye.updateActiveColor();
+    TEST_ASSERT_TRUE(eye.renderInterpolated(nowUs / 1000));
+    TEST_ASSERT_EQUAL_HEX32(
+        EyeAnimation::scaleColor(EyeAnimationConstants::COLOR_BLUE,
+                                 EyeAnimationConstants::DEFAULT_BRIGHTNESS),
+        recorder.getPixelColor(0));
+}
+
+void runFrameStreamTests()
+{
+    std::cout << "\n==== Starting Frame Stream Tests ====" << std::endl;
+    RUN_TEST(test_frame_stream_loopback);
+    RUN_TEST(test_frame_stream_drops_stale_frames);
+    RUN_TEST(test_frame_stream_rejects_corrupt_messages);
+    RUN_TEST(test_eye_shows_streamed_frames);
+}
@@ -0,0 +1,198 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "HeadEstimator.h"
+#include "HostSimulator.h"
+
+// Convert the simulator's head position to the estimator's scale between the sensor edges
+static float simToEstimate(float headPosition)
+{
+    return (headPosition - HostSimulator::kHallBand) / (1.0f - 2.0f * HostSimulator::kHallBand);
+}
+
+// A neck whose speed is proportional to the duty, between sensors 5% wide
+struct TestNeck
+{
+    static constexpr float kTravelPerDutyMs = 1.0f / 150000.0f;
+    static constexpr float kBand = 0.05f;
+    float position = 0.5f;
+
+    bool left() const { return position <= kBand; }
+    bool right() const { return position >= 1.0f - kBand; }
+    float estimateScale() const { return (position - kBand) / (1.0f - 2.0f * kBand); }
+    void drive(int16_t duty, unsigned long ms)
+    {
+        position = std::min(1.0f, std::max(0.0f, position + duty * kTravelPerDutyMs * ms));
+    }
+};
+
+void test_head_estimator_calibration_sweep()
+{
+    std::cout << "  Running test_head_estimator_calibration_sweep()" << std::endl;
+
+    HeadEstimator estimator;
+    TestNeck neck;
+    TEST_ASSERT_FALSE(estimator.isCalibrated());
+    TEST_ASSERT_EQUAL(0, estimator.getCalibrationDirection());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, estimator.getConfidence());
+
+    // The sweep seeks the left sensor, then times the travel to the right one
+    estimator.startCalibration(0);
+    unsigned long now = 0;
+    int16_t duty = 0;
+    int8_t lastDirection = 0;
+    uint8_t directionChanges = 0;
+    while (estimator.isCalibrating() && now < 20000)
+    {
+        neck.drive(duty, 10);
+        now += 10;
+        estimator.update(now, duty, neck.left(), neck.right());
+        const int8_t direction = estimator.getCalibrationDirection();
+        directionChanges += direction != lastDirection;
+        lastDirection = direction;
+        duty = direction * HeadEstimatorConstants::CALIBRATION_DUTY;
+    }
+    TEST_ASSERT_EQUAL(HeadCalibration::Calibrated, estimator.getCalibration());
+    TEST_ASSERT_EQUAL(3, directionChanges);  // Left, right, then released
+    TEST_ASSERT_TRUE(neck.right());
+    const float travelDutyMs = (1.0f - 2.0f * TestNeck::kBand) / TestNeck::kTravelPerDutyMs;
+    TEST_ASSERT_FLOAT_WITHIN(10.0f * HeadEstimatorConstants::CALIBRATION_DUTY, travelDutyMs,
+                             estimator.getTravelDutyMs());
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, estimator.getPosition());
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, estimator.getConfidence());
+
+    // Dead reckoning at another duty follows the head, losing confidence as it goes
+    for (int i = 0; i < 80; i++)
+    {
+        neck.drive(-60, 10);
+        now += 10;
+        estimator.update(now, -60, neck.left(), neck.right());
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, neck.estimateScale(), estimator.getPosition());
+    TEST_ASSERT_TRUE(estimator.getConfidence() < 1.0f);
+    TEST_ASSERT_TRUE(estimator.getConfidence() >= HeadEstimatorConstants::MIN_CONFIDENCE);
+    TEST_ASSERT_FALSE(estimator.isNearLimit(-1));
+    TEST_ASSERT_FALSE(estimator.isNearLimit(0));
+
+    // Approaching the left sensor counts as near it, and reaching it re-anchors
+    while (!neck.left())
+    {
+        neck.drive(-60, 10);
+        now += 10;
+        estimator.update(now, -60, neck.left(), neck.right());
+        TEST_ASSERT_TRUE(estimator.isNearLimit(-1) ||
+                         neck.estimateScale() > HeadEstimatorConstants::LIMIT_MARGIN - 0.02f);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, estimator.getPosition());
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, estimator.getConfidence());
+    TEST_ASSERT_FALSE(estimator.isNearLimit(1));
+}
+
+void test_head_estimator_calibration_times_out()
+{
+    std::cout << "  Running test_head_estimator_calibration_times_out()" << std::endl;
+
+    // A sensor that never fires ends the sweep instead of driving forever
+    HeadEstimator estimator;
+    estimator.startCalibration(1000);
+    unsigned long now = 1000;
+    while (estimator.isCalibrating() && now < 30000)
+    {
+        now += 10;
+        estimator.update(now, -HeadEstimatorConstants::CALIBRATION_DUTY, false, false);
+    }
+    TEST_ASSERT_EQUAL(HeadCalibration::Failed, estimator.getCalibration());
+    TEST_ASSERT_EQUAL(1000 + HeadEstimatorConstants::CALIBRATION_TIMEOUT_MS + 10, now);
+    TEST_ASSERT_EQUAL(0, estimator.getCalibrationDirection());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, estimator.getConfidence());
+
+    // A full traverse made by the normal behavior calibrates it after all
+    estimator.update(now += 10, 100, true, false);
+    estimator.update(now += 10, 100, false, false);
+    estimator.update(now += 1500, 100, false, true);
+    TEST_ASSERT_EQUAL(HeadCalibration::Calibrated, estimator.getCalibration());
+    TEST_ASSERT_EQUAL_FLOAT(150000.0f, estimator.getTravelDutyMs());
+}
+
+void test_head_estimator_tracks_simulated_head()
+{
+    std::cout << "  Running test_head_estimator_tracks_simulated_head()" << std::endl;
+
+    HostSimulator sim;
+    const HeadEstimator& estimator = sim.headEstimator();
+
+    // Calibration runs at start up, without motion in front of the PIR
+    sim.step(5000);
+    TEST_ASSERT_EQUAL(HeadCalibration::Calibrated, estimator.getCalibration());
+    const float travelDutyMs = (1.0f - 2.0f * HostSimulator::kHallBand) * 255.0f * 1000.0f /
+                               HostSimulator::kTravelPerSecondAtFullDuty;
+    TEST_ASSERT_FLOAT_WITHIN(0.02f * travelDutyMs, travelDutyMs, estimator.getTravelDutyMs());
+    TEST_ASSERT_EQUAL(MotorDirection::Stop, sim.snapshot().direction);
+
+    // Two minutes of motion: a confident estimate stays close to the real head
+    sim.setPir(true);
+    float maxError = 0.0f;
+    uint32_t confidentTicks = 0;
+    for (unsigned long t = 0; t < 120000; t += HostSimulator::kTickMs)
+    {
+        sim.step(HostSimulator::kTickMs);
+        const SimSnapshot snap = sim.snapshot();
+        if (snap.estimateConfidence >= HeadEstimatorConstants::MIN_CONFIDENCE)
+        {
+            const float actual = std::min(1.0f, std::max(0.0f, simToEstimate(snap.headPosition)));
+            maxError = std::max(maxError, std::fabs(snap.estimatedPosition - actual));
+            confidentTicks++;
+        }
+    }
+    std::cout << "    " << confidentTicks << " confident ticks, max error " << maxError
+              << ", travel " << estimator.getTravelDutyMs() << " duty-ms" << std::endl;
+    TEST_ASSERT_TRUE(confidentTicks > 120000 / HostSimulator::kTickMs / 2);
+    TEST_ASSERT_TRUE(maxError < 0.05f);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f * travelDutyMs, travelDutyMs, estimator.getTravelDutyMs());
+}
+
+void test_animation_slows_near_limits()
+{
+    std::cout << "  Running test_animation_slows_near_limits()" << std::endl;
+
+    HostSimulator sim;
+    sim.step(5000);
+    sim.setPir(true);
+
+    // Whenever the estimate was trusted, the head reached the hall sensor slowed to within a
+    // slew step of minimum speed; from the faster random speeds the planner's S-curve is
+    // still finishing when the sensor trips
+    const int16_t slowDuty =
+        AnimationConstants::kMinSpeed + MotorDriverConstants::DEFAULT_SLEW_PER_TICK;
+    uint32_t arrivals = 0;
+    uint32_t slowArrivals = 0;
+    bool wasOnSensor = true;
+    bool wasConfident = false;
+    for (unsigned long t = 0; t < 120000; t += HostSimulator::kTickMs)
+    {
+        sim.step(HostSimulator::kTickMs);
+        const SimSnapshot snap = sim.snapshot();
+        const bool onSensor = snap.sensorLeft || snap.sensorRight;
+        if (onSensor && !wasOnSensor && wasConfident)
+        {
+            const int16_t duty = sim.animation().getMotorDuty();
+            arrivals++;
+            slowArrivals += (duty < 0 ? -duty : duty) <= slowDuty;
+        }
+        wasOnSensor = onSensor;
+        wasConfident = snap.estimateConfidence >= HeadEstimatorConstants::MIN_CONFIDENCE;
+    }
+    std::cout << "    " << slowArrivals << " of " << arrivals
+              << " confident limit arrivals near minimum speed" << std::endl;
+    TEST_ASSERT_TRUE(arrivals >= 3);
+    TEST_ASSERT_EQUAL(arrivals, slowArrivals);
+}
+
+void runHeadEstimatorTests()
+{
+    std::cout << "\n==== Starting Head Estimator Tests ====" << std::endl;
+    RUN_TEST(test_head_estimator_calibration_sweep);
+    RUN_TEST(test_head_estimator_calibration_times_out);
+    RUN_TEST(test_head_estimator_tracks_simulated_head);
+    RUN_TEST(test_animation_slows_near_limits);
+}
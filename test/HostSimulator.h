@@ -0,0 +1,446 @@
+#ifndef HOST_SIMULATOR_H
+#define HOST_SIMULATOR_H
+
+#include <Arduino.h>
+#include <ArduinoFake.h>
+
+#include "Animation.h"
+#include "AudioPlayer.h"
+#include "Debouncer.h"
+#include "EyeAnimation.h"
+#include "HeadEstimator.h"
+#include "InputEvents.h"
+#include "InputTrace.h"
+#include "MotionPlanner.h"
+#include "MotorDriver.h"
+#include "NeoPixelRecorder.h"
+#include "Occupancy.h"
+#include "Random.h"
+#include "TimerAudio.h"
+
+using namespace fakeit;
+
+// Snapshot of everything a host-side viewer needs to draw one frame
+struct SimSnapshot
+{
+    unsigned long timeMs;      // Virtual time of the snapshot (ms)
+    uint32_t pixels[17];       // Eye ring colors (0x00RRGGBB)
+    MotorDirection direction;  // Commanded neck direction
+    uint8_t speed;             // Duty the motor driver is applying
+    float headPosition;        // 0.0 = left hall sensor, 1.0 = right
+    float estimatedPosition;   // HeadEstimator position, 0.0 = left sensor edge, 1.0 = right
+    float estimateConfidence;  // HeadEstimator confidence (0.0-1.0)
+    bool sensorLeft;           // Left hall sensor active
+    bool sensorRight;          // Right hall sensor active
+    bool pir;                  // PIR output
+    uint8_t domeLed;           // Dome LED PWM duty
+    int clip;                  // Playing sound index, or -1
+    size_t frames;             // Eye frames shown so far
+};
+
+// Runs Animation, EyeAnimation and AudioPlayer against virtual time on the host. The
+// neck is modeled as a motor whose speed follows the PWM duty between two hall sensors
+// and hard end stops, driven by a MotionPlanner and a MotorDriver each clocked at its
+// own rate and tracked by a HeadEstimator that calibrates at start up as on the device.
+// Audio is clocked at the TimerAudio sample rate, and the PIR and buttons are driven by
+// the caller. Every input goes through a Debouncer sampled at 1 kHz, which the main
+// loop reads on every tick and whose edges the logic drains, as on the device. An
+// OccupancyEstimator follows the debounced PIR; with duty cycling on, the logic runs at
+// its power tier's rate instead of on every tick, and on any tick with a PIR edge. With
+// edge interrupts on, sensor and button edges also go through an InputEdgeCapture as
+// the GPIO interrupt would deliver them, at the driver's 1 ms rate, and a hall sensor
+// edge stops the neck from there. Either way, the time from a hall sensor edge the head
+// runs into to the release of the bridge is measured. The debounced inputs of every
+// tick can be recorded to an InputTrace as on the device, and a trace can be replayed
+// in place of the head model, the caller's inputs and the Debouncer. The seed
+// restarts the shared Rng, so a run is reproducible from it. Only one simulator may be
+// active at a time because Rng and the ArduinoFake stubs it installs are global.
+class HostSimulator
+{
+public:
+    static constexpr unsigned long kTickMs = 10;               // Main loop period (ms)
+    static constexpr float kTravelPerSecondAtFullDuty = 1.5f;  // Head travel at duty 255
+    static constexpr uint8_t kStallDuty = 40;                  // Motor does not turn below this
+    static constexpr float kHallBand = 0.03f;                  // Hall sensor active zone per end
+
+    explicit HostSimulator(uint32_t seed = 1)
+        : m_pixels(17),
+          m_eye(&m_pixels),
+          m_timerAudio(AnimationPins().audioOutPos, AnimationPins().audioOutNeg),
+          m_audio(&m_timerAudio),
+          m_animation(&m_eye, &m_audio, AnimationPins()),
+          m_motor(AnimationPins().neckMotorIn1, AnimationPins().neckMotorIn2),
+          m_planner(m_motor, AnimationConstants::kMinSpeed),
+          m_debouncer(AnimationPins()),
+          m_edges(AnimationPins()),
+          m_now(0),
+          m_headPosition(0.5f),
+          m_pir(LOW),
+          m_buttonRectangle(HIGH),
+          m_buttonCircle(HIGH),
+          m_domeLed(0),
+          m_limitHits(0),
+          m_dutyCycling(false),
+          m_nextLogicTime(0),
+          m_logicTicks(0),
+          m_edgeInterrupts(false),
+          m_sensorLeftActive(false),
+          m_sensorRightActive(false),
+          m_limitPending(false),
+          m_limitEdgeMs(0),
+          m_limitArrivals(0),
+          m_maxLimitLatencyMs(0),
+          m_maxLimitOvershoot(0.0f),
+          m_recorder(nullptr),
+          m_replay(nullptr),
+          m_replayStartMs(0),
+          m_replayLevels(0),
+          m_replayReadLevels(0),
+          m_pendingChanges(AnimationInputBits::ALL)
+    {
+        s_active = this;
+        Rng.seed(seed);
+        // The stubs outlive the simulator, so they check that one is still active
+        When(Method(ArduinoFake(), analogWrite))
+            .AlwaysDo(
+                [](uint8_t pin, int value)
+                {
+                    if (s_active)
+                    {
+                        s_active->onAnalogWrite(pin, value);
+                    }
+                });
+        When(Method(ArduinoFake(), millis))
+            .AlwaysDo([]() { return s_active ? s_active->m_now : 0UL; });
+
+        m_motor.begin();
+        m_planner.begin();
+        writeInputPins();
+        m_debouncer.begin();
+        m_edges.setQueueEdges(false);
+        m_animation.setMotorDriver(&m_motor);
+        m_animation.setMotionPlanner(&m_planner);
+        m_headEstimator.startCalibration(0);
+        m_animation.setHeadEstimator(&m_headEstimator);
+
+        m_pixels.setKeepFrames(false);
+        m_eye.setTopPixels(5, 4);
+        m_eye.setCurrentTime(0);
+        m_eye.blink(300);
+    }
+
+    ~HostSimulator() { s_active = nullptr; }
+
+    // Prevent copying and assignment
+    HostSimulator(const HostSimulator&) = delete;
+    HostSimulator& operator=(const HostSimulator&) = delete;
+
+    // Inputs, held until changed (true = motion detected / button pressed)
+    void setPir(bool motion)
+    {
+        setInput(m_pir, AnimationPins().pirSensor, motion ? HIGH : LOW);
+    }
+    void setButtons(bool rectangle, bool circle)
+    {
+        setInput(m_buttonRectangle, AnimationPins().buttonRectangle, rectangle ? LOW : HIGH);
+        setInput(m_buttonCircle, AnimationPins().buttonCircle, circle ? LOW : HIGH);
+    }
+
+    // Capture edges as the GPIO interrupt does, and stop the neck at a hall sensor from there
+    void setEdgeInterrupts(bool enabled)
+    {
+        m_edgeInterrupts = enabled;
+        m_edges.setLimitStop(enabled ? &m_planner : nullptr, enabled ? &m_motor : nullptr);
+    }
+
+    // Run the logic at the power tier's rate, as loop() in main.cpp does
+    void setDutyCycling(bool enabled) { m_dutyCycling = enabled; }
+
+    // Turn the head by hand, without the HeadEstimator seeing the travel
+    void moveHeadByHand(float position) { m_headPosition = position; }
+
+    // Record the debounced inputs of every tick, or stop recording with nullptr
+    void setRecorder(InputTrace* trace) { m_recorder = trace; }
+
+    // Take every input from a trace, from now on, instead of the head model and the
+    // setters, or go back to those with nullptr
+    void setReplay(InputTracePlayer* player)
+    {
+        m_replay = player;
+        m_replayStartMs = m_now;
+        m_replayReadLevels = m_debouncer.getLevels();
+    }
+
+    // Advance virtual time by whole main-loop ticks
+    void step(unsigned long durationMs)
+    {
+        for (unsigned long elapsed = 0; elapsed < durationMs; elapsed += kTickMs)
+        {
+            tick();
+        }
+    }
+
+    SimSnapshot snapshot() const
+    {
+        SimSnapshot snap;
+        snap.timeMs = m_now;
+        for (uint16_t i = 0; i < 17; i++)
+        {
+            snap.pixels[i] = m_pixels.getPixelColor(i);
+        }
+        snap.direction = m_animation.getMotorDirection();
+        const int16_t duty = m_motor.getOutput();
+        snap.speed = static_cast<uint8_t>(duty < 0 ? -duty : duty);
+        snap.headPosition = m_headPosition;
+        snap.estimatedPosition = m_headEstimator.getPosition();
+        snap.estimateConfidence = m_headEstimator.getConfidence();
+        snap.sensorLeft = isSensorLeftActive();
+        snap.sensorRight = isSensorRightActive();
+        snap.pir = m_pir == HIGH;
+        snap.domeLed = m_domeLed;
+        snap.clip = m_audio.isPlaying() ? m_audio.getCurrentSoundIndex() : -1;
+        snap.frames = m_pixels.getFrameCount();
+        return snap;
+    }
+
+    // Run a behavior program in place of the behavior machine, as loaded over serial
+    bool runProgram(const uint8_t* code, uint16_t length)
+    {
+        return m_animation.runProgram(code, length);
+    }
+
+    unsigned long now() const { return m_now; }
+    float getHeadPosition() const { return m_headPosition; }
+    uint32_t getLimitHits() const { return m_limitHits; }
+    Animation& animation() { return m_animation; }
+    HeadEstimator& headEstimator() { return m_headEstimator; }
+    MotionPlanner& planner() { return m_planner; }
+    MotorDriver& motor() { return m_motor; }
+    OccupancyEstimator& occupancy() { return m_occupancy; }
+    uint32_t getLogicTicks() const { return m_logicTicks; }
+    InputEdgeCapture& edges() { return m_edges; }
+    Debouncer& debouncer() { return m_debouncer; }
+
+    // Hall sensor edges the head ran into, and the worst time from such an edge to the
+    // release of the bridge and the worst travel past the sensor edge in that time
+    uint32_t getLimitArrivals() const { return m_limitArrivals; }
+    unsigned long getMaxLimitLatencyMs() const { return m_maxLimitLatencyMs; }
+    float getMaxLimitOvershoot() const { return m_maxLimitOvershoot; }
+    EyeAnimation& eye() { return m_eye; }
+    AudioPlayer& audio() { return m_audio; }
+    NeoPixelRecorder& pixels() { return m_pixels; }
+
+private:
+    void tick()
+    {
+        // Same order as loop() in main.cpp: the debounced inputs are read and recorded on
+        // every pass, and changes on passes that skip the logic carry over to the next one
+        AnimationInputs inputs = readInputs();
+        m_pendingChanges |= inputs.changed;
+        if (m_recorder != nullptr)
+        {
+            m_recorder->record(inputs);
+        }
+        const bool pirEdge = m_occupancy.update(m_now, inputs.pirSensor == HIGH);
+        if (!m_dutyCycling || pirEdge || static_cast<long>(m_now - m_nextLogicTime) >= 0)
+        {
+            m_nextLogicTime = m_now + m_occupancy.getProfile().logicIntervalMs;
+            m_logicTicks++;
+            inputs.changed = m_pendingChanges;
+            m_pendingChanges = 0;
+            runLogic(inputs);
+        }
+
+        advanceAudio();
+        for (unsigned long ms = 0; ms < kTickMs; ms += MotorDriverConstants::TICK_MS)
+        {
+            if (ms % MotionPlannerConstants::TICK_MS == 0)
+            {
+                m_planner.tick();
+            }
+            m_motor.tick();
+            advanceHead(m_motor.getOutput(), MotorDriverConstants::TICK_MS);
+            trackLimits(m_now + ms + MotorDriverConstants::TICK_MS);
+            if (m_replay == nullptr)
+            {
+                writeInputPins();
+                m_debouncer.tick();
+            }
+        }
+        m_now += kTickMs;
+    }
+
+    // The debounced inputs, or the levels of the trace being replayed, which were
+    // recorded after the Debouncer
+    AnimationInputs readInputs()
+    {
+        if (m_replay == nullptr)
+        {
+            return m_debouncer.read();
+        }
+        m_replayLevels = m_replay->levelsAt(m_now - m_replayStartMs);
+        m_pir = (m_replayLevels & AnimationInputBits::PIR_SENSOR) != 0 ? HIGH : LOW;
+        m_buttonRectangle =
+            (m_replayLevels & AnimationInputBits::BUTTON_RECTANGLE) != 0 ? HIGH : LOW;
+        m_buttonCircle = (m_replayLevels & AnimationInputBits::BUTTON_CIRCLE) != 0 ? HIGH : LOW;
+        const uint8_t changed = m_replayLevels ^ m_replayReadLevels;
+        m_replayReadLevels = m_replayLevels;
+        return unpackInputs(m_replayLevels, m_now, changed);
+    }
+
+    // Drive the input pins the Debouncer samples from the head model and the setters
+    void writeInputPins()
+    {
+        const AnimationPins pins;
+        mock_gpio_put(pins.sensorLeft, !isSensorLeftActive());
+        mock_gpio_put(pins.sensorRight, !isSensorRightActive());
+        mock_gpio_put(pins.pirSensor, m_pir == HIGH);
+        mock_gpio_put(pins.buttonRectangle, m_buttonRectangle == HIGH);
+        mock_gpio_put(pins.buttonCircle, m_buttonCircle == HIGH);
+    }
+
+    void runLogic(const AnimationInputs& inputs)
+    {
+        m_pixels.setTime(m_now);
+        m_animation.update(inputs);
+        if (m_replay == nullptr)
+        {
+            m_animation.consumeInputEvents(m_debouncer.getQueue());
+        }
+        m_animation.performRotate();
+        m_animation.eyeBlink();
+        m_animation.updateSound();
+    }
+
+    // Clock the sample timer for one tick's worth of samples while a clip plays
+    void advanceAudio()
+    {
+        const uint32_t samples = TimerAudioConstants::DEFAULT_SAMPLE_RATE * kTickMs / 1000;
+        for (uint32_t i = 0; i < samples && m_timerAudio.isPlaying(); i++)
+        {
+            m_timerAudio.updateSample();
+        }
+    }
+
+    // Integrate head position from the H-bridge duty, positive to the right
+    void advanceHead(int16_t duty, unsigned long ms)
+    {
+        const int magnitude = duty < 0 ? -duty : duty;
+        if (magnitude < kStallDuty)
+        {
+            return;
+        }
+        m_headPosition += duty / 255.0f * kTravelPerSecondAtFullDuty * ms / 1000.0f;
+        if (m_headPosition <= 0.0f || m_headPosition >= 1.0f)
+        {
+            m_headPosition = m_headPosition <= 0.0f ? 0.0f : 1.0f;
+            m_limitHits++;
+        }
+    }
+
+    // Hold a new level and deliver its edge when edge interrupts are on
+    void setInput(int8_t& input, uint8_t pin, int8_t level)
+    {
+        if (m_edgeInterrupts && level != input)
+        {
+            m_edges.handleEdge(pin, level, m_now * 1000UL);
+        }
+        input = level;
+    }
+
+    // Watch the hall sensors at the driver rate. An edge into the sensor the head is moving
+    // toward starts a limit arrival, which ends when the bridge is released.
+    void trackLimits(unsigned long timeMs)
+    {
+        const int16_t duty = m_motor.getOutput();
+        if (m_limitPending && duty == 0)
+        {
+            m_limitPending = false;
+            m_maxLimitLatencyMs = std::max(m_maxLimitLatencyMs, timeMs - m_limitEdgeMs);
+            const float overshoot = m_headPosition < 0.5f ? kHallBand - m_headPosition
+                                                          : m_headPosition - (1.0f - kHallBand);
+            m_maxLimitOvershoot = std::max(m_maxLimitOvershoot, overshoot);
+        }
+
+        const AnimationPins pins;
+        const bool left = isSensorLeftActive();
+        const bool right = isSensorRightActive();
+        if (left != m_sensorLeftActive)
+        {
+            m_sensorLeftActive = left;
+            onSensorEdge(pins.sensorLeft, left, left && duty < 0, timeMs);
+        }
+        if (right != m_sensorRightActive)
+        {
+            m_sensorRightActive = right;
+            onSensorEdge(pins.sensorRight, right, right && duty > 0, timeMs);
+        }
+    }
+
+    void onSensorEdge(uint8_t pin, bool active, bool arrival, unsigned long timeMs)
+    {
+        if (arrival)
+        {
+            m_limitPending = true;
+            m_limitEdgeMs = timeMs;
+            m_limitArrivals++;
+        }
+        if (m_edgeInterrupts)
+        {
+            m_edges.handleEdge(pin, active ? LOW : HIGH, timeMs * 1000UL);
+        }
+    }
+
+    bool isSensorLeftActive() const { return m_headPosition <= kHallBand; }
+    bool isSensorRightActive() const { return m_headPosition >= 1.0f - kHallBand; }
+
+    void onAnalogWrite(uint8_t pin, int value)
+    {
+        if (pin == AnimationPins().domeLedGreen)
+        {
+            m_domeLed = static_cast<uint8_t>(value);
+        }
+    }
+
+    // Simulator the global ArduinoFake stubs forward to, or nullptr once it is destroyed
+    static inline HostSimulator* s_active = nullptr;
+
+    NeoPixelRecorder m_pixels;
+    EyeAnimation m_eye;
+    TimerAudio m_timerAudio;
+    AudioPlayer m_audio;
+    Animation m_animation;
+    MotorDriver m_motor;
+    MotionPlanner m_planner;
+    HeadEstimator m_headEstimator;
+    OccupancyEstimator m_occupancy;
+    Debouncer m_debouncer;
+    InputEdgeCapture m_edges;
+
+    unsigned long m_now;
+    float m_headPosition;
+    int8_t m_pir;
+    int8_t m_buttonRectangle;
+    int8_t m_buttonCircle;
+    uint8_t m_domeLed;
+    uint32_t m_limitHits;
+    bool m_dutyCycling;
+    unsigned long m_nextLogicTime;
+    uint32_t m_logicTicks;
+    bool m_edgeInterrupts;
+    bool m_sensorLeftActive;
+    bool m_sensorRightActive;
+    bool m_limitPending;
+    unsigned long m_limitEdgeMs;
+    uint32_t m_limitArrivals;
+    unsigned long m_maxLimitLatencyMs;
+    float m_maxLimitOvershoot;
+    InputTrace* m_recorder;
+    InputTracePlayer* m_replay;
+    unsigned long m_replayStartMs;
+    uint8_t m_replayLevels;
+    uint8_t m_replayReadLevels;
+    uint8_t m_pendingChanges;
+};
+
+#endif  // HOST_SIMULATOR_H
@@ -0,0 +1,91 @@
+#include <ArduinoFake.h>
+#include <algorithm>
+#include <unity.h>
+
+#include "HostSimulator.h"
+
+void test_host_simulator_head_stays_between_stops()
+{
+    std::cout << "  Running test_host_simulator_head_stays_between_stops()" << std::endl;
+
+    HostSimulator sim;
+    sim.setPir(true);
+
+    // Two minutes of continuous motion keeps the neck moving between the hall sensors
+    float minPosition = 1.0f;
+    float maxPosition = 0.0f;
+    bool turnedLeft = false;
+    bool turnedRight = false;
+    for (unsigned long t = 0; t < 120000; t += HostSimulator::kTickMs)
+    {
+        sim.step(HostSimulator::kTickMs);
+        const SimSnapshot snap = sim.snapshot();
+        minPosition = std::min(minPosition, snap.headPosition);
+        maxPosition = std::max(maxPosition, snap.headPosition);
+        turnedLeft |= snap.direction == MotorDirection::Left;
+        turnedRight |= snap.direction == MotorDirection::Right;
+    }
+
+    TEST_ASSERT_TRUE(turnedLeft);
+    TEST_ASSERT_TRUE(turnedRight);
+    TEST_ASSERT_TRUE(minPosition >= 0.0f && maxPosition <= 1.0f);
+    TEST_ASSERT_TRUE(maxPosition - minPosition > 0.1f);
+
+    // The eye refreshes on every 10 ms loop tick while awake
+    TEST_ASSERT_EQUAL(120000 / HostSimulator::kTickMs, sim.pixels().getFrameCount());
+    TEST_ASSERT_EQUAL(120000, sim.now());
+}
+
+void test_host_simulator_plays_clip_in_virtual_time()
+{
+    std::cout << "  Running test_host_simulator_plays_clip_in_virtual_time()" << std::endl;
+
+    HostSimulator sim;
+    TEST_ASSERT_EQUAL(-1, sim.snapshot().clip);
+
+    // A short press of the rectangle button starts a random clip once it is debounced,
+    // on the following tick
+    sim.setButtons(true, false);
+    sim.step(HostSimulator::kTickMs);
+    sim.setButtons(false, false);
+    sim.step(HostSimulator::kTickMs);
+    const int clip = sim.snapshot().clip;
+    TEST_ASSERT_GREATER_THAN(0, clip);
+
+    // The clip ends after its samples have been clocked out at the sample rate
+    unsigned long playedMs = 0;
+    while (sim.snapshot().clip == clip && playedMs < 60000)
+    {
+        sim.step(HostSimulator::kTickMs);
+        playedMs += HostSimulator::kTickMs;
+    }
+    const unsigned long expectedMs =
+        getWavSize(clip) * 1000 / TimerAudioConstants::DEFAULT_SAMPLE_RATE;
+    TEST_ASSERT_EQUAL(-1, sim.snapshot().clip);
+    TEST_ASSERT_UINT32_WITHIN(2 * HostSimulator::kTickMs, expectedMs, playedMs);
+}
+
+void test_host_simulator_is_reproducible()
+{
+    std::cout << "  Running test_host_simulator_is_reproducible()" << std::endl;
+
+    uint32_t hashes[2];
+    for (uint32_t& hash : hashes)
+    {
+        HostSimulator sim(7);
+        sim.setPir(true);
+        sim.step(30000);
+        sim.setPir(false);
+        sim.step(10000);
+        hash = sim.pixels().getStreamHash();
+    }
+    TEST_ASSERT_EQUAL_HEX32(hashes[0], hashes[1]);
+}
+
+void runHostSimulatorTests()
+{
+    std::cout << "\n==== Starting Host Simulator Tests ====" << std::endl;
+    RUN_TEST(test_host_simulator_head_stays_between_stops);
+    RUN_TEST(test_host_simulator_plays_clip_in_virtual_time);
+    RUN_TEST(test_host_simulator_is_reproducible);
+}
@@ -0,0 +1,162 @@
+#include <ArduinoFake.h>
+#include <chrono>
+#include <cmath>
+#include <unity.h>
+
+#include "EyeAnimation.h"
+#include "HsvColor.h"
+#include "NeoPixelRecorder.h"
+#include "Random.h"
+
+// Floating-point HSV reference with the same hue convention (0-65535 = one turn)
+static void referenceHsv(uint16_t hue, uint8_t sat, uint8_t val, float rgb[3])
+{
+    const float h = hue / 65536.0f * 6.0f;
+    const float s = sat / 255.0f;
+    const float v = val / 255.0f;
+    const int sector = static_cast<int>(h) % 6;
+    const float f = h - std::floor(h);
+
+    const float p = v * (1.0f - s);
+    const float q = v * (1.0f - s * f);
+    const float t = v * (1.0f - s * (1.0f - f));
+    const float table[6][3] = {{v, t, p}, {q, v, p}, {p, v, t}, {p, q, v}, {t, p, v}, {v, p, q}};
+    for (uint8_t c = 0; c < 3; c++)
+    {
+        rgb[c] = table[sector][c] * 255.0f;
+    }
+}
+
+void test_hsv_primary_hues_are_exact()
+{
+    std::cout << "  Running test_hsv_primary_hues_are_exact()" << std::endl;
+
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, HsvColor::toRgb(HsvColorConstants::HUE_RED));
+    TEST_ASSERT_EQUAL_HEX32(0xFFFF00, HsvColor::toRgb(HsvColorConstants::HUE_YELLOW));
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, HsvColor::toRgb(HsvColorConstants::HUE_GREEN));
+    TEST_ASSERT_EQUAL_HEX32(0x00FFFF, HsvColor::toRgb(HsvColorConstants::HUE_CYAN));
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, HsvColor::toRgb(HsvColorConstants::HUE_BLUE));
+    TEST_ASSERT_EQUAL_HEX32(0xFF00FF, HsvColor::toRgb(HsvColorConstants::HUE_MAGENTA));
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, HsvColor::toRgb(65535));
+
+    // No saturation is white scaled by value, no value is off
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, HsvColor::toRgb(12345, 0, 255));
+    TEST_ASSERT_EQUAL_HEX32(0x000000, HsvColor::toRgb(12345, 255, 0));
+}
+
+void test_hsv_matches_float_reference()
+{
+    std::cout << "  Running test_hsv_matches_float_reference()" << std::endl;
+
+    // Sweep hue finely and saturation/value coarsely, tracking the worst channel error
+    float maxError = 0.0f;
+    double totalError = 0.0;
+    uint32_t samples = 0;
+    for (uint32_t hue = 0; hue < 65536; hue += 97)
+    {
+        for (uint16_t sat = 0; sat < 256; sat += 15)
+        {
+            for (uint16_t val = 0; val < 256; val += 15)
+            {
+                float expected[3];
+                referenceHsv(hue, sat, val, expected);
+                const uint32_t color = HsvColor::toRgb(hue, sat, val);
+                const uint8_t actual[3] = {static_cast<uint8_t>(color >> 16),
+                                           static_cast<uint8_t>(color >> 8),
+                                           static_cast<uint8_t>(color)};
+                for (uint8_t c = 0; c < 3; c++)
+                {
+                    const float error = std::fabs(actual[c] - expected[c]);
+                    maxError = std::max(maxError, error);
+                    totalError += error;
+                    samples++;
+                }
+            }
+        }
+    }
+
+    std::cout << "    max error " << maxError << ", mean error " << totalError / samples
+              << " (of 255)" << std::endl;
+    TEST_ASSERT_TRUE(maxError <= 2.5f);
+    TEST_ASSERT_TRUE(totalError / samples < 1.0);
+}
+
+void test_hsv_gamma_table()
+{
+    std::cout << "  Running test_hsv_gamma_table()" << std::endl;
+
+    for (uint16_t i = 0; i < 256; i++)
+    {
+        const long expected = std::lround(std::pow(i / 255.0, 2.6) * 255.0);
+        TEST_ASSERT_EQUAL(expected, HsvColor::gamma8(i));
+    }
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, HsvColor::gamma32(0xFF0000));
+    TEST_ASSERT_EQUAL_HEX32(0x2AFF00, HsvColor::gamma32(0x80FF01));
+    TEST_ASSERT_EQUAL_HEX32(HsvColor::gamma32(HsvColor::toRgb(1000, 200, 180)),
+                            HsvColor::toRgbGamma(1000, 200, 180));
+}
+
+void test_hsv_conversion_benchmark()
+{
+    std::cout << "  Running test_hsv_conversion_benchmark()" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    using Nanoseconds = std::chrono::duration<double, std::nano>;
+    const uint32_t numColors = 1000000;
+    uint32_t integerSum = 0;
+    float floatSum = 0.0f;
+
+    const Clock::time_point floatStart = Clock::now();
+    for (uint32_t i = 0; i < numColors; i++)
+    {
+        float rgb[3];
+        referenceHsv(static_cast<uint16_t>(i * 37), static_cast<uint8_t>(i), 200, rgb);
+        floatSum += rgb[0] + rgb[1] + rgb[2];
+    }
+    const Clock::time_point integerStart = Clock::now();
+    for (uint32_t i = 0; i < numColors; i++)
+    {
+        integerSum += HsvColor::toRgb(static_cast<uint16_t>(i * 37), static_cast<uint8_t>(i), 200);
+    }
+    const Clock::time_point end = Clock::now();
+
+    const double floatNs = Nanoseconds(integerStart - floatStart).count() / numColors;
+    const double integerNs = Nanoseconds(end - integerStart).count() / numColors;
+    std::cout << "    per color: float " << floatNs << " ns, integer " << integerNs << " ns"
+              << std::endl;
+
+    // Keep both loops observable; timing is reported, not asserted
+    TEST_ASSERT_TRUE(integerSum != 0 && floatSum > 0.0f);
+}
+
+void test_eye_animation_active_color_from_hsv()
+{
+    std::cout << "  Running test_eye_animation_active_color_from_hsv()" << std::endl;
+
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    NeoPixelRecorder recorder;
+    EyeAnimation eye(&recorder);
+    eye.setBrightness(255);
+    eye.setCurrentTime(0);
+
+    eye.setActiveColorHsv(HsvColorConstants::HUE_MAGENTA, 255, 128);
+    eye.updateActiveColor();
+    TEST_ASSERT_EQUAL_HEX32(HsvColor::toRgb(HsvColorConstants::HUE_MAGENTA, 255, 128),
+                            recorder.getPixelColor(0));
+
+    eye.setActiveColorHsv(HsvColorConstants::HUE_CYAN, 128, 255, true);
+    eye.updateActiveColor();
+    TEST_ASSERT_EQUAL_HEX32(HsvColor::toRgbGamma(HsvColorConstants::HUE_CYAN, 128, 255),
+                            recorder.getPixelColor(0));
+}
+
+void runHsvColorTests()
+{
+    std::cout << "\n==== Starting HsvColor Tests ====" << std::endl;
+    RUN_TEST(test_hsv_primary_hues_are_exact);
+    RUN_TEST(test_hsv_matches_float_reference);
+    RUN_TEST(test_hsv_gamma_table);
+    RUN_TEST(test_hsv_conversion_benchmark);
+    RUN_TEST(test_eye_animation_active_color_from_hsv);
+}
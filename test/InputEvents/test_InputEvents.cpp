@@ -0,0 +1,167 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "HostSimulator.h"
+#include "InputEvents.h"
+
+static void ignoreBridge()
+{
+    When(Method(ArduinoFake(), analogWrite)).AlwaysDo([](uint8_t pin, int value) {});
+}
+
+void test_input_queue_keeps_order_and_counts_drops()
+{
+    std::cout << "  Running test_input_queue_keeps_order_and_counts_drops()" << std::endl;
+    InputEventQueue queue;
+    InputEvent event = {0, 0, LOW};
+    TEST_ASSERT_TRUE(queue.isEmpty());
+    TEST_ASSERT_FALSE(queue.pop(event));
+
+    // Several laps of the ring come out in order
+    uint32_t next = 0;
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        TEST_ASSERT_TRUE(queue.push({i, static_cast<uint8_t>(i % 30), HIGH}));
+        if (i % 7 == 6)
+        {
+            while (queue.pop(event))
+            {
+                TEST_ASSERT_EQUAL_UINT32(next++, event.timeUs);
+            }
+        }
+    }
+    while (queue.pop(event))
+    {
+        TEST_ASSERT_EQUAL_UINT32(next++, event.timeUs);
+    }
+    TEST_ASSERT_EQUAL_UINT32(200, next);
+
+    // A full queue keeps its oldest edges and counts the rest
+    for (uint32_t i = 0; i < InputEventsConstants::QUEUE_CAPACITY + 3; i++)
+    {
+        queue.push({i, 0, LOW});
+    }
+    TEST_ASSERT_EQUAL(InputEventsConstants::QUEUE_CAPACITY, queue.size());
+    TEST_ASSERT_EQUAL_UINT32(3, queue.getDropped());
+    TEST_ASSERT_TRUE(queue.pop(event));
+    TEST_ASSERT_EQUAL_UINT32(0, event.timeUs);
+}
+
+void test_input_capture_stops_at_limit_ahead()
+{
+    std::cout << "  Running test_input_capture_stops_at_limit_ahead()" << std::endl;
+    ignoreBridge();
+    const AnimationPins pins;
+    MotorDriver driver(pins.neckMotorIn1, pins.neckMotorIn2);
+    InputEdgeCapture capture(pins);
+    capture.setLimitStop(nullptr, &driver);
+    capture.begin();
+
+    driver.drive(-200);
+    for (uint8_t i = 0; i < 40; i++)
+    {
+        driver.tick();
+    }
+    TEST_ASSERT_TRUE(driver.getOutput() < 0);
+
+    // The sensor behind the head, and the one ahead leaving, do not stop it
+    capture.handleEdge(pins.sensorRight, LOW, 1000);
+    capture.handleEdge(pins.sensorLeft, HIGH, 2000);
+    driver.tick();
+    TEST_ASSERT_TRUE(driver.getOutput() < 0);
+    TEST_ASSERT_EQUAL_UINT32(0, capture.getLimitStops());
+
+    // The sensor ahead releases the bridge on the driver's next tick, timed from the edge
+    // on the host's tick clock
+    const uint32_t edgeUs = 41 * MotorDriverConstants::TICK_US;
+    capture.handleEdge(pins.sensorLeft, LOW, edgeUs);
+    TEST_ASSERT_EQUAL_UINT32(1, capture.getLimitStops());
+    driver.tick();
+    TEST_ASSERT_EQUAL(0, driver.getOutput());
+    TEST_ASSERT_TRUE(driver.getRest() == MotorStop::Brake);
+    TEST_ASSERT_EQUAL_UINT32(MotorDriverConstants::TICK_US, capture.getLastLimitLatencyUs());
+    TEST_ASSERT_EQUAL_UINT32(MotorDriverConstants::TICK_US, capture.getMaxLimitLatencyUs());
+
+    // Every edge was queued, in order
+    InputEventQueue& queue = capture.getQueue();
+    TEST_ASSERT_EQUAL(3, queue.size());
+    InputEvent event;
+    queue.pop(event);
+    TEST_ASSERT_EQUAL(pins.sensorRight, event.pin);
+    queue.pop(event);
+    queue.pop(event);
+    TEST_ASSERT_EQUAL(pins.sensorLeft, event.pin);
+    TEST_ASSERT_EQUAL(LOW, event.level);
+    TEST_ASSERT_EQUAL_UINT32(edgeUs, event.timeUs);
+}
+
+void test_input_events_hold_taps_for_one_update()
+{
+    std::cout << "  Running test_input_events_hold_taps_for_one_update()" << std::endl;
+    ignoreBridge();
+    const AnimationPins pins;
+    Animation animation(nullptr, nullptr, pins);
+    InputEventQueue queue;
+
+    AnimationInputs inputs = {HIGH, HIGH, LOW, HIGH, HIGH, 100};
+    animation.update(inputs);
+
+    // A press and release between two passes still shows as a press on the next one
+    queue.push({150000, pins.buttonCircle, LOW});
+    queue.push({153000, pins.buttonCircle, HIGH});
+    queue.push({160000, pins.pirSensor, HIGH});
+    TEST_ASSERT_EQUAL(3, animation.consumeInputEvents(queue));
+    TEST_ASSERT_TRUE(queue.isEmpty());
+    TEST_ASSERT_EQUAL(LOW, animation.getInputButtonCircle());
+    TEST_ASSERT_EQUAL(HIGH, animation.getInputPIRSensor());
+
+    // The following snapshot restores the levels, even one that reports no change
+    inputs.currentTime = 200;
+    inputs.changed = 0;
+    animation.update(inputs);
+    TEST_ASSERT_EQUAL(HIGH, animation.getInputButtonCircle());
+    TEST_ASSERT_EQUAL(LOW, animation.getInputPIRSensor());
+}
+
+void test_input_events_limit_latency_simulated()
+{
+    std::cout << "  Running test_input_events_limit_latency_simulated()" << std::endl;
+
+    // Two minutes of sweeping between the sensors, polled and with edge interrupts
+    unsigned long latencyMs[2] = {};
+    float overshoot[2] = {};
+    for (uint8_t interrupts = 0; interrupts < 2; interrupts++)
+    {
+        HostSimulator sim(1);
+        sim.setEdgeInterrupts(interrupts != 0);
+        sim.setPir(true);
+        sim.step(120000);
+        TEST_ASSERT_TRUE(sim.getLimitArrivals() > 0);
+        latencyMs[interrupts] = sim.getMaxLimitLatencyMs();
+        overshoot[interrupts] = sim.getMaxLimitOvershoot();
+        std::cout << "    " << (interrupts ? "interrupt" : "polled") << ": "
+                  << sim.getLimitArrivals() << " limit arrivals, worst edge to release "
+                  << latencyMs[interrupts] << " ms, worst overshoot "
+                  << overshoot[interrupts] * 100.0f << "% of travel" << std::endl;
+        if (interrupts)
+        {
+            TEST_ASSERT_TRUE(sim.edges().getLimitStops() > 0);
+            TEST_ASSERT_TRUE(sim.edges().getMaxLimitLatencyUs() <= MotorDriverConstants::TICK_US);
+            TEST_ASSERT_EQUAL_UINT32(0, sim.edges().getQueue().getDropped());
+        }
+    }
+
+    // From the interrupt the bridge is released on the next driver tick
+    TEST_ASSERT_TRUE(latencyMs[1] <= MotorDriverConstants::TICK_MS);
+    TEST_ASSERT_TRUE(latencyMs[1] < latencyMs[0]);
+    TEST_ASSERT_TRUE(overshoot[1] <= overshoot[0]);
+}
+
+void runInputEventsTests()
+{
+    std::cout << "\n==== Starting Input Events Tests ====" << std::endl;
+    RUN_TEST(test_input_queue_keeps_order_and_counts_drops);
+    RUN_TEST(test_input_capture_stops_at_limit_ahead);
+    RUN_TEST(test_input_events_hold_taps_for_one_update);
+    RUN_TEST(test_input_events_limit_latency_simulated);
+}
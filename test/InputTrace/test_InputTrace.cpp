@@ -0,0 +1,236 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include <chrono>
+#include <string>
+
+#include "HostSimulator.h"
+#include "InputTrace.h"
+#include "Random.h"
+
+// Whole serial dump of a trace, as the device prints it
+static std::string dumpTrace(const InputTrace& trace)
+{
+    std::string text;
+    char line[InputTraceConstants::MIN_LINE_SIZE];
+    size_t length;
+    for (uint16_t i = 0; (length = trace.formatDumpLine(i, line, sizeof(line))) > 0; i++)
+    {
+        text.append(line, length);
+    }
+    return text;
+}
+
+void test_input_trace_records_changes()
+{
+    std::cout << "  Running test_input_trace_records_changes()" << std::endl;
+    InputTrace trace;
+    TEST_ASSERT_FALSE(trace.isStarted());
+
+    // The first call sets the base, and unchanged levels are not recorded
+    const uint8_t idle = AnimationInputBits::BUTTON_RECTANGLE | AnimationInputBits::BUTTON_CIRCLE |
+                         AnimationInputBits::SENSOR_LEFT | AnimationInputBits::SENSOR_RIGHT;
+    const uint8_t seen = idle | AnimationInputBits::PIR_SENSOR;
+    const uint8_t tapped = seen & ~AnimationInputBits::BUTTON_CIRCLE;
+    const uint8_t shift = InputTraceConstants::DELTA_BITS;
+    trace.record(idle, 1000);
+    trace.record(idle, 1010);
+    TEST_ASSERT_TRUE(trace.isStarted());
+    TEST_ASSERT_EQUAL(0, trace.size());
+    TEST_ASSERT_EQUAL(1000, trace.getBaseTime());
+    TEST_ASSERT_EQUAL_HEX8(idle, trace.getBaseLevels());
+
+    // A PIR rise 25 ms later, a tap 40 ms after that, then an hour of quiet
+    trace.record(unpackInputs(seen, 1025, 0));
+    trace.record(seen, 1030);
+    trace.record(tapped, 1065);
+    trace.record(seen, 1200);
+    trace.record(idle, 1200 + 3600000UL + 7);
+    TEST_ASSERT_EQUAL(1200 + 3600000UL + 7, trace.getEndTime());
+
+    TEST_ASSERT_EQUAL_HEX16((AnimationInputBits::PIR_SENSOR << shift) | 25, trace.getRecord(0));
+    TEST_ASSERT_EQUAL_HEX16((AnimationInputBits::BUTTON_CIRCLE << shift) | 40, trace.getRecord(1));
+    TEST_ASSERT_EQUAL(135, InputTrace::getRecordDurationMs(trace.getRecord(2)));
+
+    // The hour goes in a few gap records, whose times add up with the change after them
+    TEST_ASSERT_TRUE(trace.size() <= 6);
+    uint32_t total = 0;
+    for (uint16_t i = 0; i < trace.size(); i++)
+    {
+        total += InputTrace::getRecordDurationMs(trace.getRecord(i));
+    }
+    TEST_ASSERT_EQUAL_UINT32(trace.getEndTime() - trace.getBaseTime(), total);
+    std::cout << "    4 changes over an hour in " << trace.size() << " records" << std::endl;
+
+    // The player gives the levels at any time from the start
+    InputTracePlayer player(trace);
+    TEST_ASSERT_EQUAL(trace.getEndTime() - trace.getBaseTime(), player.getDurationMs());
+    TEST_ASSERT_EQUAL_HEX8(idle, player.levelsAt(24));
+    TEST_ASSERT_EQUAL_HEX8(seen, player.levelsAt(25));
+    TEST_ASSERT_EQUAL_HEX8(tapped, player.levelsAt(100));
+    TEST_ASSERT_EQUAL_HEX8(seen, player.levelsAt(3600000UL));
+    TEST_ASSERT_EQUAL_HEX8(idle, player.levelsAt(player.getDurationMs()));
+    TEST_ASSERT_EQUAL(trace.size(), player.getPlayed());
+}
+
+void test_input_trace_ring_folds_oldest()
+{
+    std::cout << "  Running test_input_trace_ring_folds_oldest()" << std::endl;
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+    InputTrace trace;
+    uint8_t levels = 0;
+    unsigned long now = 0;
+    trace.record(levels, now);
+    const uint32_t kChanges = InputTraceConstants::CAPACITY + 1000;
+    for (uint32_t i = 0; i < kChanges; i++)
+    {
+        now += 1 + Rng.below(2000);
+        levels ^= static_cast<uint8_t>(1 + Rng.below(AnimationInputBits::ALL));
+        trace.record(levels, now);
+    }
+
+    // The newest changes are kept, and the base moved up to the oldest of them
+    TEST_ASSERT_EQUAL(InputTraceConstants::CAPACITY, trace.size());
+    TEST_ASSERT_EQUAL_UINT32(kChanges - InputTraceConstants::CAPACITY, trace.getOverwritten());
+    TEST_ASSERT_EQUAL(now, trace.getEndTime());
+    TEST_ASSERT_TRUE(trace.getBaseTime() > 0);
+    InputTracePlayer player(trace);
+    TEST_ASSERT_EQUAL_HEX8(levels, player.levelsAt(now - trace.getBaseTime()));
+
+    trace.clear();
+    TEST_ASSERT_FALSE(trace.isStarted());
+    TEST_ASSERT_EQUAL(0, trace.size());
+    TEST_ASSERT_EQUAL(0, trace.getOverwritten());
+}
+
+void test_input_trace_dump_round_trip()
+{
+    std::cout << "  Running test_input_trace_dump_round_trip()" << std::endl;
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+    InputTrace trace;
+    uint8_t levels = AnimationInputBits::BUTTON_CIRCLE;
+    unsigned long now = 123456;
+    trace.record(levels, now);
+    for (uint16_t i = 0; i < 37; i++)
+    {
+        now += Rng.below(5000);
+        levels ^= static_cast<uint8_t>(1U << Rng.below(AnimationInputBits::COUNT));
+        trace.record(levels, now);
+    }
+
+    // Log lines ahead of the dump are skipped
+    const std::string dump = dumpTrace(trace);
+    const std::string text = "[INFO] Power tier active -> settled\r\n" + dump;
+    InputTrace parsed;
+    TEST_ASSERT_TRUE(parsed.parseDump(text.c_str()));
+    TEST_ASSERT_EQUAL(trace.size(), parsed.size());
+    TEST_ASSERT_EQUAL(trace.getBaseTime(), parsed.getBaseTime());
+    TEST_ASSERT_EQUAL_HEX8(trace.getBaseLevels(), parsed.getBaseLevels());
+    TEST_ASSERT_EQUAL(trace.getEndTime(), parsed.getEndTime());
+    for (uint16_t i = 0; i < trace.size(); i++)
+    {
+        TEST_ASSERT_EQUAL_HEX16(trace.getRecord(i), parsed.getRecord(i));
+    }
+    TEST_ASSERT_EQUAL_STRING(dump.c_str(), dumpTrace(parsed).c_str());
+
+    // A cut-off dump or a missing header leaves the trace empty
+    InputTrace broken;
+    TEST_ASSERT_FALSE(broken.parseDump(dump.substr(0, dump.size() / 2).c_str()));
+    TEST_ASSERT_FALSE(broken.isStarted());
+    TEST_ASSERT_EQUAL(0, broken.size());
+    TEST_ASSERT_FALSE(broken.parseDump("0801 0802\nEND\n"));
+
+    // The request is found in a byte stream, with or without a carriage return
+    const char* stream = "!tr!trace\r\nxx!trace\n";
+    uint8_t requests = 0;
+    for (const char* c = stream; *c != '\0'; c++)
+    {
+        requests += trace.receive(static_cast<uint8_t>(*c)) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL(2, requests);
+}
+
+void test_input_trace_record_cost()
+{
+    std::cout << "  Running test_input_trace_record_cost()" << std::endl;
+    InputTrace trace;
+    AnimationInputs inputs = unpackInputs(AnimationInputBits::ALL, 0, 0);
+
+    // One loop pass in a hundred sees a change, more than the device ever does
+    const uint32_t kPasses = 1000000;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t pass = 0; pass < kPasses; pass++)
+    {
+        inputs.currentTime = pass;
+        if (pass % 100 == 0)
+        {
+            inputs.pirSensor ^= 1;
+        }
+        trace.record(inputs);
+    }
+    const double ns =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "    " << ns / kPasses << " ns per loop pass recorded (" << trace.size()
+              << " records held)" << std::endl;
+    TEST_ASSERT_EQUAL(InputTraceConstants::CAPACITY, trace.size());
+}
+
+void test_input_trace_replay_reproduces_run()
+{
+    std::cout << "  Running test_input_trace_replay_reproduces_run()" << std::endl;
+    const uint32_t kSeed = 42;
+    const unsigned long kDurationMs = 10UL * 60UL * 1000UL;
+
+    // Record the inputs of a run with visitors and button presses
+    InputTrace trace;
+    SimSnapshot recorded;
+    {
+        HostSimulator sim(kSeed);
+        sim.setRecorder(&trace);
+        while (sim.now() < kDurationMs)
+        {
+            const unsigned long second = sim.now() / 1000;
+            sim.setPir(second % 90 < 20);
+            sim.setButtons(second % 170 == 30, second % 230 == 100);
+            sim.step(HostSimulator::kTickMs);
+        }
+        recorded = sim.snapshot();
+    }
+    std::cout << "    " << kDurationMs / 60000 << " min run: " << trace.size() << " records"
+              << std::endl;
+
+    // Replaying the dumped trace with the same seed reproduces the run
+    InputTrace parsed;
+    TEST_ASSERT_TRUE(parsed.parseDump(dumpTrace(trace).c_str()));
+    InputTracePlayer player(parsed);
+    HostSimulator sim(kSeed);
+    sim.setReplay(&player);
+    const auto start = std::chrono::steady_clock::now();
+    while (sim.now() < kDurationMs)
+    {
+        sim.step(HostSimulator::kTickMs);
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const SimSnapshot replayed = sim.snapshot();
+
+    TEST_ASSERT_EQUAL(parsed.size(), player.getPlayed());
+    TEST_ASSERT_EQUAL(recorded.frames, replayed.frames);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(recorded.pixels, replayed.pixels, 17);
+    TEST_ASSERT_EQUAL(recorded.direction, replayed.direction);
+    TEST_ASSERT_EQUAL(recorded.speed, replayed.speed);
+    TEST_ASSERT_EQUAL_FLOAT(recorded.headPosition, replayed.headPosition);
+    TEST_ASSERT_EQUAL(recorded.clip, replayed.clip);
+    std::cout << "    replay: " << kDurationMs / 3600000.0 / seconds
+              << " simulated hours per second" << std::endl;
+}
+
+void runInputTraceTests()
+{
+    std::cout << "\n==== Starting InputTrace Tests ====" << std::endl;
+    RUN_TEST(test_input_trace_records_changes);
+    RUN_TEST(test_input_trace_ring_folds_oldest);
+    RUN_TEST(test_input_trace_dump_round_trip);
+    RUN_TEST(test_input_trace_record_cost);
+    RUN_TEST(test_input_trace_replay_reproduces_run);
+}
@@ -0,0 +1,104 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "EyeAnimation.h"
+#include "LedStrips.h"
+#include "NeoPixelRecorder.h"
+#include "Random.h"
+
+using namespace fakeit;
+
+void test_led_strips_add_strip_limits()
+{
+    std::cout << "  Running test_led_strips_add_strip_limits()" << std::endl;
+
+    LedStrips strips;
+
+    // Reject empty and oversized strips
+    TEST_ASSERT_EQUAL(-1, strips.addStrip(2, 0));
+    TEST_ASSERT_EQUAL(-1, strips.addStrip(2, LedStripsConstants::MAX_PIXELS_PER_STRIP + 1));
+
+    // Fill every slot, then reject one more
+    for (uint8_t i = 0; i < LedStripsConstants::MAX_STRIPS; i++)
+    {
+        TEST_ASSERT_EQUAL(i, strips.addStrip(i, 8));
+    }
+    TEST_ASSERT_EQUAL(-1, strips.addStrip(10, 8));
+    TEST_ASSERT_EQUAL(LedStripsConstants::MAX_STRIPS, strips.numStrips());
+    TEST_ASSERT_TRUE(strips.begin());
+}
+
+void test_led_strips_records_per_strip_frames()
+{
+    std::cout << "  Running test_led_strips_records_per_strip_frames()" << std::endl;
+
+    LedStrips strips;
+    strips.addStrip(2, 4);
+    strips.addStrip(18, 8);
+    strips.begin();
+
+    // Nothing is shown before the first frame
+    TEST_ASSERT_EQUAL(0, strips.getFrameCount(0));
+
+    strips.fill(0, 0x112233);
+    strips.setPixelColor(1, 7, 0xFF000080);  // White byte is masked off
+    strips.setPixelColor(1, 8, 0x123456);    // Out of range, ignored
+    TEST_ASSERT_TRUE(strips.show());
+
+    // Both strips refresh together and keep their own frames
+    TEST_ASSERT_EQUAL(1, strips.getFrameCount(0));
+    TEST_ASSERT_EQUAL(1, strips.getFrameCount(1));
+    TEST_ASSERT_EQUAL_HEX32(0x112233, strips.getLastFrame(0)[3]);
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strips.getLastFrame(1)[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x000080, strips.getLastFrame(1)[7]);
+
+    // Later edits to the render buffer don't touch the recorded frame
+    strips.clear();
+    TEST_ASSERT_EQUAL_HEX32(0x112233, strips.getLastFrame(0)[0]);
+    TEST_ASSERT_EQUAL_HEX32(0, strips.getPixelColor(0, 0));
+    TEST_ASSERT_EQUAL(0, strips.getDroppedFrames());
+}
+
+void test_eye_animation_mirrors_to_accent_strips()
+{
+    std::cout << "  Running test_eye_animation_mirrors_to_accent_strips()" << std::endl;
+
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+
+    NeoPixelRecorder ring;
+    LedStrips strips;
+    strips.addStrip(2, 8);
+    strips.addStrip(18, 16);
+    strips.begin();
+
+    EyeAnimation eye(&ring);
+    eye.setAccentStrips(&strips);
+    eye.setCurrentTime(0);
+    eye.updateActiveColor();
+
+    // Every strip shows the same composited frame as the eye
+    TEST_ASSERT_EQUAL(1, ring.getFrameCount());
+    TEST_ASSERT_EQUAL(1, strips.getFrameCount(0));
+    TEST_ASSERT_EQUAL(1, strips.getFrameCount(1));
+    for (uint16_t i = 0; i < 16; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX32(ring.getPixelColor(i), strips.getLastFrame(1)[i]);
+    }
+    for (uint16_t i = 0; i < 8; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX32(ring.getPixelColor(i * 2), strips.getLastFrame(0)[i]);
+    }
+
+    // Sleeping blanks the strips along with the eye
+    eye.sleep();
+    TEST_ASSERT_EQUAL(2, strips.getFrameCount(0));
+    TEST_ASSERT_EQUAL_HEX32(0, strips.getLastFrame(0)[0]);
+}
+
+void runLedStripsTests()
+{
+    std::cout << "\n==== Starting LedStrips Tests ====" << std::endl;
+    RUN_TEST(test_led_strips_add_strip_limits);
+    RUN_TEST(test_led_strips_records_per_strip_frames);
+    RUN_TEST(test_eye_animation_mirrors_to_accent_strips);
+}
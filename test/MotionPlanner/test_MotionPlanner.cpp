@@ -0,0 +1,321 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include <chrono>
+#include <cmath>
+
+#include "Animation.h"
+#include "MotionPlanner.h"
+#include "MotorDriver.h"
+
+// Both tables are built at compile time and live in flash
+static_assert(MotionPlannerConstants::S_CURVE[0] == 0, "A ramp starts at its first speed");
+static_assert(MotionPlannerConstants::S_CURVE[MotionPlannerConstants::CURVE_SEGMENTS] ==
+                  MotionPlannerConstants::CURVE_ONE,
+              "A ramp ends at its target speed");
+static_assert(MotionPlannerConstants::RAMP_TICKS[0] == 0, "No change needs no ramp");
+
+// Worst per-tick speed change and change of that change seen over a run, in duty
+struct ProfileBounds
+{
+    float maxStep = 0.0f;
+    float maxStepChange = 0.0f;
+    int32_t lastSpeed = 0;
+    int32_t lastStep = 0;
+
+    void tick(MotionPlanner& planner)
+    {
+        planner.tick();
+        const int32_t step = planner.getSpeedQ8() - lastSpeed;
+        maxStep = std::max(maxStep, std::fabs(step / 256.0f));
+        maxStepChange = std::max(maxStepChange, std::fabs((step - lastStep) / 256.0f));
+        lastSpeed = planner.getSpeedQ8();
+        lastStep = step;
+    }
+};
+
+// One planner tick with the driver clocked underneath it at its own rate
+static void tickWithDriver(MotionPlanner& planner, MotorDriver& driver)
+{
+    planner.tick();
+    for (uint16_t ms = 0; ms < MotionPlannerConstants::TICK_MS; ms += MotorDriverConstants::TICK_MS)
+    {
+        driver.tick();
+    }
+}
+
+void test_motion_planner_tables()
+{
+    std::cout << "  Running test_motion_planner_tables()" << std::endl;
+
+    const auto& curve = MotionPlannerConstants::S_CURVE;
+    const uint16_t half = MotionPlannerConstants::CURVE_SEGMENTS / 2;
+
+    // The S-curve rises monotonically and is point-symmetric about its middle
+    for (uint16_t i = 1; i <= MotionPlannerConstants::CURVE_SEGMENTS; i++)
+    {
+        TEST_ASSERT_TRUE(curve[i] >= curve[i - 1]);
+        TEST_ASSERT_INT_WITHIN(1, MotionPlannerConstants::CURVE_ONE,
+                               curve[i] + curve[MotionPlannerConstants::CURVE_SEGMENTS - i]);
+    }
+    TEST_ASSERT_EQUAL(MotionPlannerConstants::CURVE_ONE / 2, curve[half]);
+
+    // Larger speed changes never take fewer ticks
+    for (uint16_t delta = 1; delta <= MotionPlannerConstants::MAX_DUTY; delta++)
+    {
+        TEST_ASSERT_TRUE(MotionPlannerConstants::RAMP_TICKS[delta] >=
+                         MotionPlannerConstants::RAMP_TICKS[delta - 1]);
+    }
+}
+
+void test_motion_planner_limits_acceleration_and_jerk()
+{
+    std::cout << "  Running test_motion_planner_limits_acceleration_and_jerk()" << std::endl;
+
+    When(Method(ArduinoFake(), analogWrite)).AlwaysReturn();
+    MotorDriver driver(1, 2);
+    MotionPlanner planner(driver);
+    TEST_ASSERT_TRUE(planner.begin());
+    ProfileBounds bounds;
+
+    // Full speed, a reversal through rest, and a stop, each run to completion
+    for (const int16_t duty : {255, 40, -180, 0})
+    {
+        planner.setSpeed(duty);
+        for (uint32_t i = 0; i < 3 * MotionPlannerConstants::CONTROL_RATE_HZ; i++)
+        {
+            bounds.tick(planner);
+        }
+        TEST_ASSERT_EQUAL(duty, planner.getOutput());
+    }
+
+    const float accelPerTick = static_cast<float>(MotionPlannerConstants::MAX_ACCEL) /
+                               MotionPlannerConstants::CONTROL_RATE_HZ;
+    const float jerkPerTick = static_cast<float>(MotionPlannerConstants::MAX_JERK) /
+                              (MotionPlannerConstants::CONTROL_RATE_HZ *
+                               MotionPlannerConstants::CONTROL_RATE_HZ);
+    std::cout << "    max step " << bounds.maxStep << " duty/tick (limit " << accelPerTick
+              << "), max step change " << bounds.maxStepChange << " (limit " << jerkPerTick << ")"
+              << std::endl;
+    TEST_ASSERT_TRUE(bounds.maxStep <= accelPerTick);
+    TEST_ASSERT_TRUE(bounds.maxStepChange <= jerkPerTick);
+}
+
+void test_motion_planner_steps_over_min_duty()
+{
+    std::cout << "  Running test_motion_planner_steps_over_min_duty()" << std::endl;
+
+    When(Method(ArduinoFake(), analogWrite)).AlwaysReturn();
+    MotorDriver driver(1, 2);
+    MotionPlanner planner(driver, 80);
+    planner.begin();
+
+    // Starting from rest jumps straight to the minimum duty, then ramps above it
+    planner.setSpeed(112);
+    planner.tick();
+    TEST_ASSERT_EQUAL(80, planner.getOutput());
+    for (uint32_t i = 0; i < MotionPlannerConstants::CONTROL_RATE_HZ; i++)
+    {
+        planner.tick();
+        TEST_ASSERT_TRUE(planner.getOutput() >= 80 && planner.getOutput() <= 112);
+    }
+    TEST_ASSERT_EQUAL(112, planner.getOutput());
+
+    // A reversal ramps down to the minimum, stops for a tick, and never drives below it
+    planner.setSpeed(-112);
+    bool sawRest = false;
+    for (uint32_t i = 0; i < MotionPlannerConstants::CONTROL_RATE_HZ; i++)
+    {
+        planner.tick();
+        const int16_t duty = planner.getOutput();
+        TEST_ASSERT_TRUE(duty == 0 || duty >= 80 || duty <= -80);
+        TEST_ASSERT_TRUE(duty >= 0 || sawRest);
+        sawRest |= duty == 0;
+    }
+    TEST_ASSERT_TRUE(sawRest);
+    TEST_ASSERT_EQUAL(-112, planner.getOutput());
+
+    // A halt wins over a command set before the next tick, which then starts from rest
+    planner.halt();
+    planner.setSpeed(112);
+    planner.tick();
+    TEST_ASSERT_EQUAL(80, planner.getOutput());
+
+    // Halt drops the output at once
+    planner.halt();
+    planner.tick();
+    TEST_ASSERT_EQUAL(0, planner.getOutput());
+    TEST_ASSERT_FALSE(planner.isMoving());
+    TEST_ASSERT_EQUAL(MotionMode::Halt, planner.getMode());
+}
+
+void test_motion_planner_move_stops_at_distance()
+{
+    std::cout << "  Running test_motion_planner_move_stops_at_distance()" << std::endl;
+
+    When(Method(ArduinoFake(), analogWrite)).AlwaysReturn();
+    MotorDriver driver(1, 2);
+    MotionPlanner planner(driver, 80);
+    driver.begin();
+    planner.begin();
+
+    // Long moves reach the cruise duty, short ones do not; all end within one tick of
+    // the minimum duty of their distance, less what the driver's slew from rest takes
+    const int32_t tolerance = 80 * MotionPlannerConstants::TICK_MS;
+    for (const int32_t distance : {60000, -60000, 12000, -2000})
+    {
+        planner.takeTravel();
+        planner.moveBy(distance, 112);
+        int16_t peak = 0;
+        uint32_t ticks = 0;
+        do
+        {
+            tickWithDriver(planner, driver);
+            peak = std::max<int16_t>(peak, std::abs(planner.getOutput()));
+        } while (planner.isMoving() && ++ticks < 10 * MotionPlannerConstants::CONTROL_RATE_HZ);
+
+        // Let the driver's dead time run out before the next move
+        while (driver.isInDeadTime())
+        {
+            driver.tick();
+        }
+
+        const int32_t travel = planner.takeTravel();
+        std::cout << "    move " << distance << ": travel " << travel << ", peak duty " << peak
+                  << std::endl;
+        TEST_ASSERT_FALSE(planner.isMoving());
+        TEST_ASSERT_INT32_WITHIN(tolerance, distance, travel);
+        TEST_ASSERT_TRUE(peak <= 112);
+        TEST_ASSERT_TRUE(std::abs(distance) < 20000 || peak == 112);
+    }
+
+    // The same move sent twice in a row travels twice, and is not settled until it ends
+    for (uint8_t move = 0; move < 2; move++)
+    {
+        planner.moveBy(4000, 112);
+        TEST_ASSERT_FALSE(planner.isSettled());
+        uint32_t ticks = 0;
+        do
+        {
+            tickWithDriver(planner, driver);
+            if (ticks == 0)
+            {
+                TEST_ASSERT_FALSE(planner.isSettled());
+            }
+        } while (!planner.isSettled() && ++ticks < 10 * MotionPlannerConstants::CONTROL_RATE_HZ);
+        while (driver.isInDeadTime())
+        {
+            driver.tick();
+        }
+        TEST_ASSERT_TRUE(planner.isSettled());
+        TEST_ASSERT_INT32_WITHIN(tolerance, 4000, planner.takeTravel());
+    }
+
+    // A move cut short by a halt runs again when it is sent again
+    planner.moveBy(8000, 112);
+    for (uint8_t i = 0; i < 20; i++)
+    {
+        tickWithDriver(planner, driver);
+    }
+    planner.halt(MotorStop::Brake);
+    tickWithDriver(planner, driver);
+    TEST_ASSERT_FALSE(planner.isMoving());
+    planner.moveBy(8000, 112);
+    tickWithDriver(planner, driver);
+    TEST_ASSERT_TRUE(planner.isMoving());
+}
+
+void test_motion_planner_repeated_speed_keeps_ramp()
+{
+    std::cout << "  Running test_motion_planner_repeated_speed_keeps_ramp()" << std::endl;
+
+    When(Method(ArduinoFake(), analogWrite)).AlwaysReturn();
+    MotorDriver driver(1, 2);
+    MotionPlanner once(driver);
+    MotionPlanner everyTick(driver);
+
+    // Setting the same speed on every tick ramps exactly like setting it once
+    once.setSpeed(200);
+    for (uint32_t i = 0; i < MotionPlannerConstants::CONTROL_RATE_HZ; i++)
+    {
+        everyTick.setSpeed(200);
+        once.tick();
+        everyTick.tick();
+        TEST_ASSERT_EQUAL(once.getSpeedQ8(), everyTick.getSpeedQ8());
+    }
+    TEST_ASSERT_EQUAL(200, everyTick.getOutput());
+
+    // After a halt, the same speed starts again
+    everyTick.halt();
+    everyTick.tick();
+    TEST_ASSERT_EQUAL(0, everyTick.getOutput());
+    everyTick.setSpeed(200);
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        everyTick.tick();
+    }
+    TEST_ASSERT_TRUE(everyTick.getOutput() > 0);
+}
+
+// The float bell curve Animation::handlePirTriggered() uses without a planner
+static int bellCurveSpeed(uint32_t directionDuration)
+{
+    const float t = std::min(directionDuration, AnimationConstants::kSpeedRampTime) /
+                    static_cast<float>(AnimationConstants::kSpeedRampTime);
+    const float speedBias = expf(-12.0f * (t - 0.5f) * (t - 0.5f));
+    return AnimationConstants::kMinSpeed +
+           static_cast<int>((AnimationConstants::kMaxMotorSpeed - AnimationConstants::kMinSpeed) *
+                            speedBias);
+}
+
+void test_motion_planner_tick_benchmark()
+{
+    std::cout << "  Running test_motion_planner_tick_benchmark()" << std::endl;
+
+    using Clock = std::chrono::steady_clock;
+    using Nanoseconds = std::chrono::duration<double, std::nano>;
+    const uint32_t numTicks = 1000000;
+    When(Method(ArduinoFake(), analogWrite)).AlwaysReturn();
+    MotorDriver driver(1, 2);
+    MotionPlanner planner(driver, 80);
+    planner.begin();
+    int64_t plannerSum = 0;
+    int64_t floatSum = 0;
+
+    const Clock::time_point floatStart = Clock::now();
+    for (uint32_t i = 0; i < numTicks; i++)
+    {
+        floatSum += bellCurveSpeed(i % (2 * AnimationConstants::kSpeedRampTime));
+    }
+    const Clock::time_point plannerStart = Clock::now();
+    for (uint32_t i = 0; i < numTicks; i++)
+    {
+        // Keep the planner ramping back and forth
+        if (i % 400 == 0)
+        {
+            planner.setSpeed((i / 400) % 2 ? -255 : 255);
+        }
+        planner.tick();
+        plannerSum += planner.getOutput();
+    }
+    const Clock::time_point end = Clock::now();
+
+    const double floatNs = Nanoseconds(plannerStart - floatStart).count() / numTicks;
+    const double plannerNs = Nanoseconds(end - plannerStart).count() / numTicks;
+    std::cout << "    per update: float bell curve " << floatNs << " ns, planner tick " << plannerNs
+              << " ns" << std::endl;
+
+    // Keep both loops observable; timing is reported, not asserted
+    TEST_ASSERT_TRUE(floatSum != 0 && plannerSum != INT64_MIN);
+}
+
+void runMotionPlannerTests()
+{
+    std::cout << "\n==== Starting Motion Planner Tests ====" << std::endl;
+    RUN_TEST(test_motion_planner_tables);
+    RUN_TEST(test_motion_planner_limits_acceleration_and_jerk);
+    RUN_TEST(test_motion_planner_steps_over_min_duty);
+    RUN_TEST(test_motion_planner_move_stops_at_distance);
+    RUN_TEST(test_motion_planner_repeated_speed_keeps_ramp);
+    RUN_TEST(test_motion_planner_tick_benchmark);
+}
@@ -0,0 +1,203 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "MotorDriver.h"
+
+// Levels last written to the two H-bridge inputs
+static int bridgeIn1;
+static int bridgeIn2;
+
+static void recordBridge()
+{
+    bridgeIn1 = 0;
+    bridgeIn2 = 0;
+    When(Method(ArduinoFake(), analogWrite))
+        .AlwaysDo(
+            [](uint8_t pin, int value)
+            {
+                if (pin == 1)
+                {
+                    bridgeIn1 = value;
+                }
+                else if (pin == 2)
+                {
+                    bridgeIn2 = value;
+                }
+            });
+}
+
+void test_motor_driver_never_reverses_directly()
+{
+    std::cout << "  Running test_motor_driver_never_reverses_directly()" << std::endl;
+
+    recordBridge();
+    MotorDriver driver(1, 2);
+    TEST_ASSERT_TRUE(driver.begin());
+
+    // Random drives, reversals and stops, each held for a random number of ticks
+    uint32_t state = 1;
+    int lastDirection = 0;
+    uint32_t restTicks = 0;
+    uint32_t reversals = 0;
+    int16_t lastOutput = 0;
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        state = state * 1103515245u + 12345u;
+        if ((state >> 16) % 40 == 0)
+        {
+            const int16_t duty = static_cast<int16_t>((state >> 8) % 511) - 255;
+            if (duty % 5 == 0)
+            {
+                driver.stop(duty % 2 ? MotorStop::Brake : MotorStop::Coast);
+            }
+            else
+            {
+                driver.drive(duty);
+            }
+        }
+        driver.tick();
+
+        // Both inputs are only ever high together as a brake
+        TEST_ASSERT_TRUE(bridgeIn1 == 0 || bridgeIn2 == 0 ||
+                         (bridgeIn1 == MotorDriverConstants::FULL_DUTY &&
+                          bridgeIn2 == MotorDriverConstants::FULL_DUTY));
+
+        // Driving the other way only follows a full dead time at rest
+        const int direction = bridgeIn2 > 0 && bridgeIn1 == 0   ? 1
+                              : bridgeIn1 > 0 && bridgeIn2 == 0 ? -1
+                                                                : 0;
+        if (direction == 0)
+        {
+            restTicks++;
+        }
+        else
+        {
+            if (direction != lastDirection && lastDirection != 0)
+            {
+                TEST_ASSERT_TRUE(restTicks * MotorDriverConstants::TICK_MS >=
+                                 MotorDriverConstants::DEFAULT_DEAD_TIME_MS);
+                reversals++;
+            }
+            lastDirection = direction;
+            restTicks = 0;
+        }
+
+        // The duty only jumps when it drops to rest
+        const int16_t output = driver.getOutput();
+        const int step = std::abs(output - lastOutput);
+        TEST_ASSERT_TRUE(output == 0 || step <= MotorDriverConstants::DEFAULT_SLEW_PER_TICK);
+        lastOutput = output;
+    }
+    std::cout << "    reversals checked: " << reversals << std::endl;
+    TEST_ASSERT_TRUE(reversals > 100);
+}
+
+void test_motor_driver_full_reverse()
+{
+    std::cout << "  Running test_motor_driver_full_reverse()" << std::endl;
+
+    recordBridge();
+    MotorDriver driver(1, 2, MotorStop::Brake);
+    driver.begin();
+
+    // Slews up to full duty
+    driver.drive(255);
+    for (uint32_t i = 0; i < 255 / MotorDriverConstants::DEFAULT_SLEW_PER_TICK + 1; i++)
+    {
+        driver.tick();
+    }
+    TEST_ASSERT_EQUAL(255, driver.getOutput());
+    TEST_ASSERT_EQUAL(0, bridgeIn1);
+    TEST_ASSERT_EQUAL(255, bridgeIn2);
+
+    // Full reverse brakes for the dead time, then slews up from rest the other way
+    driver.drive(-255);
+    const uint32_t deadTicks =
+        MotorDriverConstants::DEFAULT_DEAD_TIME_MS / MotorDriverConstants::TICK_MS;
+    for (uint32_t i = 0; i < deadTicks; i++)
+    {
+        driver.tick();
+        TEST_ASSERT_EQUAL(0, driver.getOutput());
+        TEST_ASSERT_EQUAL(MotorStop::Brake, driver.getRest());
+        TEST_ASSERT_EQUAL(255, bridgeIn1);
+        TEST_ASSERT_EQUAL(255, bridgeIn2);
+    }
+    driver.tick();
+    TEST_ASSERT_FALSE(driver.isInDeadTime());
+    TEST_ASSERT_EQUAL(-MotorDriverConstants::DEFAULT_SLEW_PER_TICK, driver.getOutput());
+    TEST_ASSERT_EQUAL(MotorDriverConstants::DEFAULT_SLEW_PER_TICK, bridgeIn1);
+    TEST_ASSERT_EQUAL(0, bridgeIn2);
+}
+
+void test_motor_driver_stop_modes()
+{
+    std::cout << "  Running test_motor_driver_stop_modes()" << std::endl;
+
+    recordBridge();
+    MotorDriver driver(1, 2);
+    driver.begin();
+    TEST_ASSERT_EQUAL(0, bridgeIn1);
+    TEST_ASSERT_EQUAL(0, bridgeIn2);
+
+    // Brake shorts the motor on the next tick, without a slew
+    driver.drive(-200);
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        driver.tick();
+    }
+    driver.stop(MotorStop::Brake);
+    driver.tick();
+    TEST_ASSERT_EQUAL(0, driver.getOutput());
+    TEST_ASSERT_EQUAL(MotorStop::Brake, driver.getRest());
+    TEST_ASSERT_EQUAL(255, bridgeIn1);
+    TEST_ASSERT_EQUAL(255, bridgeIn2);
+
+    // Coast releases both inputs, and holding the stop keeps the bridge at rest
+    driver.drive(100);
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        driver.tick();
+    }
+    driver.stop();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        driver.tick();
+        TEST_ASSERT_EQUAL(0, bridgeIn1);
+        TEST_ASSERT_EQUAL(0, bridgeIn2);
+    }
+    TEST_ASSERT_EQUAL(MotorStop::Coast, driver.getRest());
+    TEST_ASSERT_FALSE(driver.isInDeadTime());
+}
+
+void test_motor_driver_travel()
+{
+    std::cout << "  Running test_motor_driver_travel()" << std::endl;
+
+    When(Method(ArduinoFake(), analogWrite)).AlwaysReturn();
+    MotorDriver driver(1, 2);
+    driver.begin();
+
+    // Travel is what was applied, slew and dead time included
+    int32_t applied = 0;
+    for (const int16_t duty : {120, -60, 0, 255})
+    {
+        driver.drive(duty);
+        for (uint32_t i = 0; i < 200; i++)
+        {
+            driver.tick();
+            applied += driver.getOutput() * MotorDriverConstants::TICK_MS;
+        }
+        TEST_ASSERT_EQUAL(duty, driver.getOutput());
+    }
+    TEST_ASSERT_EQUAL(applied, driver.takeTravel());
+    TEST_ASSERT_EQUAL(0, driver.takeTravel());
+}
+
+void runMotorDriverTests()
+{
+    std::cout << "\n==== Starting Motor Driver Tests ====" << std::endl;
+    RUN_TEST(test_motor_driver_never_reverses_directly);
+    RUN_TEST(test_motor_driver_full_reverse);
+    RUN_TEST(test_motor_driver_stop_modes);
+    RUN_TEST(test_motor_driver_travel);
+}
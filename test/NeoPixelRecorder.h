@@ -0,0 +1,122 @@
+#ifndef NEOPIXEL_RECORDER_H
+#define NEOPIXEL_RECORDER_H
+
+#include <Arduino.h>
+#include <vector>
+
+#include "Adafruit_NeoPixel.h"
+
+// Native Adafruit_NeoPixel that keeps a real pixel buffer and records every show().
+// Each frame is hashed with FNV-1a together with its virtual timestamp, and the frame
+// hashes are chained into a single stream hash that can be compared against a golden.
+class NeoPixelRecorder : public Adafruit_NeoPixel
+{
+public:
+    static constexpr uint16_t kMaxPixels = 32;
+
+    struct Frame
+    {
+        unsigned long time;  // Virtual time of the show() call (ms)
+        uint32_t hash;       // FNV-1a hash of the pixel colors
+    };
+
+    explicit NeoPixelRecorder(uint16_t numPixels = 17)
+        : Adafruit_NeoPixel(numPixels, 0, 0),
+          m_count(numPixels < kMaxPixels ? numPixels : kMaxPixels),
+          m_keepFrames(true)
+    {
+        reset();
+    }
+
+    void begin() override {}
+
+    void show() override
+    {
+        uint32_t hash = kFnvOffset;
+        for (uint16_t i = 0; i < m_count; i++)
+        {
+            hash = fnv1a(hash, m_colors[i]);
+        }
+        m_frameCount++;
+        if (m_keepFrames)
+        {
+            m_frames.push_back({m_time, hash});
+        }
+        m_streamHash = fnv1a(fnv1a(m_streamHash, static_cast<uint32_t>(m_time)), hash);
+    }
+
+    void setPixelColor(uint16_t n, uint32_t c) override
+    {
+        m_pixelWrites++;
+        if (n < m_count)
+        {
+            m_colors[n] = c;
+        }
+    }
+
+    void clear() override
+    {
+        for (uint16_t i = 0; i < kMaxPixels; i++)
+        {
+            m_colors[i] = 0;
+        }
+    }
+
+    uint32_t getPixelColor(uint16_t n) const override { return n < m_count ? m_colors[n] : 0; }
+
+    // Virtual clock used to timestamp frames
+    void setTime(unsigned long time) { m_time = time; }
+
+    // Long simulations only need the counters and stream hash, not every frame
+    void setKeepFrames(bool keep) { m_keepFrames = keep; }
+
+    void reset()
+    {
+        clear();
+        m_frames.clear();
+        m_frameCount = 0;
+        m_pixelWrites = 0;
+        m_streamHash = kFnvOffset;
+        m_time = 0;
+    }
+
+    const std::vector<Frame>& getFrames() const { return m_frames; }
+    size_t getFrameCount() const { return m_frameCount; }
+    uint32_t getPixelWrites() const { return m_pixelWrites; }
+    uint32_t getStreamHash() const { return m_streamHash; }
+
+    // Frames and pixel writes per simulated second over a run of the given length
+    float getFramesPerSecond(unsigned long durationMs) const
+    {
+        return durationMs ? m_frameCount * 1000.0f / durationMs : 0.0f;
+    }
+    float getPixelWritesPerSecond(unsigned long durationMs) const
+    {
+        return durationMs ? m_pixelWrites * 1000.0f / durationMs : 0.0f;
+    }
+
+    static uint32_t fnv1a(uint32_t hash, uint32_t value)
+    {
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= kFnvPrime;
+        }
+        return hash;
+    }
+
+private:
+    static constexpr uint32_t kFnvOffset = 0x811C9DC5;
+    static constexpr uint32_t kFnvPrime = 0x01000193;
+
+    uint16_t m_count;
+    bool m_keepFrames;
+    uint32_t m_colors[kMaxPixels];
+    std::vector<Frame> m_frames;
+    size_t m_frameCount;
+    uint32_t m_pixelWrites;
+    uint32_t m_streamHash;
+    unsigned long m_time;
+};
+
+#endif  // NEOPIXEL_RECORDER_H
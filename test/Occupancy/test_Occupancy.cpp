@@ -0,0 +1,178 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "HostSimulator.h"
+#include "Occupancy.h"
+
+// Time in seconds at which an estimator left alone after one arrival drops below a tier
+static uint32_t secondsUntilBelow(OccupancyEstimator& estimator, PowerTier tier, uint32_t& now)
+{
+    while (estimator.getTier() <= tier && now < 3600)
+    {
+        now++;
+        estimator.update(now * 1000UL, false);
+    }
+    return now;
+}
+
+void test_occupancy_single_arrival_steps_down()
+{
+    std::cout << "  Running test_occupancy_single_arrival_steps_down()" << std::endl;
+    OccupancyEstimator estimator;
+    TEST_ASSERT_FALSE(estimator.update(0, false));
+    TEST_ASSERT_EQUAL(OccupancyConstants::ARRIVAL, estimator.getActivity());
+    TEST_ASSERT_TRUE(estimator.getTier() == PowerTier::Active);
+
+    // One arrival's activity crosses each threshold at the time noted in Occupancy.h
+    uint32_t now = 0;
+    TEST_ASSERT_UINT32_WITHIN(2, 74, secondsUntilBelow(estimator, PowerTier::Active, now));
+    TEST_ASSERT_TRUE(estimator.getTier() == PowerTier::Settled);
+    TEST_ASSERT_UINT32_WITHIN(2, 355, secondsUntilBelow(estimator, PowerTier::Settled, now));
+    TEST_ASSERT_TRUE(estimator.getTier() == PowerTier::Quiet);
+    TEST_ASSERT_UINT32_WITHIN(2, 710, secondsUntilBelow(estimator, PowerTier::Quiet, now));
+    TEST_ASSERT_TRUE(estimator.getTier() == PowerTier::Asleep);
+    TEST_ASSERT_EQUAL(3, estimator.getTierChanges());
+
+    // The activity reaches 0 rather than stalling on the rounding
+    estimator.update(now * 1000UL + 3600000UL, false);
+    TEST_ASSERT_EQUAL(0, estimator.getActivity());
+    TEST_ASSERT_FALSE(getPowerProfile(PowerTier::Asleep).amplifier);
+    TEST_ASSERT_TRUE(getPowerProfile(PowerTier::Active).amplifier);
+    TEST_ASSERT_EQUAL_STRING("asleep", getPowerTierName(estimator.getTier()));
+}
+
+void test_occupancy_edge_restores_active()
+{
+    std::cout << "  Running test_occupancy_edge_restores_active()" << std::endl;
+    OccupancyEstimator estimator;
+    estimator.update(0, false);
+    estimator.update(1000000, false);
+    TEST_ASSERT_TRUE(estimator.getTier() == PowerTier::Asleep);
+
+    // A rising edge is Active at once, and stays so while the PIR is high
+    TEST_ASSERT_TRUE(estimator.update(1000004, true));
+    TEST_ASSERT_TRUE(estimator.getTier() == PowerTier::Active);
+    TEST_ASSERT_EQUAL(1, estimator.getArrivals());
+    TEST_ASSERT_FALSE(estimator.update(1600000, true));
+    TEST_ASSERT_TRUE(estimator.getTier() == PowerTier::Active);
+
+    // Leaving after a long stay still counts as someone having just been there
+    TEST_ASSERT_TRUE(estimator.update(1600004, false));
+    TEST_ASSERT_TRUE(estimator.getTier() == PowerTier::Active);
+    TEST_ASSERT_EQUAL(OccupancyConstants::ARRIVAL, estimator.getActivity());
+}
+
+void test_occupancy_busy_room_stays_active()
+{
+    std::cout << "  Running test_occupancy_busy_room_stays_active()" << std::endl;
+
+    // Ten visits over five minutes, then nobody
+    OccupancyEstimator busy;
+    unsigned long now = 0;
+    busy.update(now, false);
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        busy.update(now, true);
+        now += 5000;
+        busy.update(now, false);
+        now += 25000;
+    }
+    TEST_ASSERT_EQUAL(10, busy.getArrivals());
+
+    const unsigned long left = now;
+    while (busy.getTier() == PowerTier::Active && now - left < 3600000UL)
+    {
+        now += 1000;
+        busy.update(now, false);
+    }
+    std::cout << "    Active for " << (now - left) / 1000 << " s after a busy room empties"
+              << std::endl;
+    TEST_ASSERT_TRUE(now - left > 300000UL);
+    TEST_ASSERT_TRUE(busy.getActivity() >= OccupancyConstants::SETTLED_LEVEL);
+}
+
+void test_occupancy_independent_of_update_rate()
+{
+    std::cout << "  Running test_occupancy_independent_of_update_rate()" << std::endl;
+    OccupancyEstimator fast;
+    OccupancyEstimator slow;
+
+    // The same visits seen every 10 ms and every 500 ms agree at each whole second
+    for (unsigned long now = 0; now <= 1200000UL; now += 10)
+    {
+        const bool motion = (now / 1000) % 200 < 20;
+        fast.update(now, motion);
+        if (now % 500 == 0)
+        {
+            slow.update(now, motion);
+        }
+        if (now % 1000 == 0)
+        {
+            TEST_ASSERT_EQUAL(fast.getActivity(), slow.getActivity());
+            TEST_ASSERT_TRUE(fast.getTier() == slow.getTier());
+        }
+    }
+
+    // Every millisecond is counted toward exactly one tier
+    uint32_t total = 0;
+    for (uint8_t t = 0; t < static_cast<uint8_t>(PowerTier::Count); t++)
+    {
+        total += fast.getResidencyMs(static_cast<PowerTier>(t));
+        TEST_ASSERT_UINT32_WITHIN(500, fast.getResidencyMs(static_cast<PowerTier>(t)),
+                                  slow.getResidencyMs(static_cast<PowerTier>(t)));
+    }
+    TEST_ASSERT_EQUAL(1200000UL, total);
+
+    fast.resetResidency(1200000UL);
+    fast.update(1201000UL, false);
+    TEST_ASSERT_EQUAL(1000, fast.getResidencyMs(fast.getTier()));
+}
+
+void test_occupancy_duty_cycles_simulator()
+{
+    std::cout << "  Running test_occupancy_duty_cycles_simulator()" << std::endl;
+    HostSimulator sim(11);
+    sim.setDutyCycling(true);
+
+    // A visit, then the room stays empty for half an hour
+    sim.setPir(true);
+    sim.step(20000);
+    const uint32_t visitTicks = sim.getLogicTicks();
+    TEST_ASSERT_EQUAL(20000 / HostSimulator::kTickMs, visitTicks);
+    sim.setPir(false);
+    sim.occupancy().resetResidency(sim.now());
+    sim.step(1800000);
+    const uint32_t emptyTicks = sim.getLogicTicks() - visitTicks;
+    TEST_ASSERT_TRUE(sim.occupancy().getTier() == PowerTier::Asleep);
+    TEST_ASSERT_TRUE(emptyTicks < 1800000 / HostSimulator::kTickMs / 2);
+
+    std::cout << "    Empty room: " << emptyTicks << " logic ticks instead of "
+              << 1800000 / HostSimulator::kTickMs << "; residency";
+    for (uint8_t t = 0; t < static_cast<uint8_t>(PowerTier::Count); t++)
+    {
+        const PowerTier tier = static_cast<PowerTier>(t);
+        std::cout << " " << getPowerTierName(tier) << " "
+                  << sim.occupancy().getResidencyMs(tier) * 100UL / 1800000UL << "%";
+    }
+    std::cout << std::endl;
+
+    // Someone returning is handled on the very next tick after the PIR is debounced
+    sim.setPir(true);
+    sim.step(HostSimulator::kTickMs);
+    TEST_ASSERT_TRUE(sim.occupancy().getTier() == PowerTier::Asleep);
+    const uint32_t before = sim.getLogicTicks();
+    sim.step(HostSimulator::kTickMs);
+    TEST_ASSERT_EQUAL(before + 1, sim.getLogicTicks());
+    TEST_ASSERT_TRUE(sim.occupancy().getTier() == PowerTier::Active);
+    TEST_ASSERT_EQUAL(2, sim.occupancy().getArrivals());
+}
+
+void runOccupancyTests()
+{
+    std::cout << "\n==== Starting Occupancy Tests ====" << std::endl;
+    RUN_TEST(test_occupancy_single_arrival_steps_down);
+    RUN_TEST(test_occupancy_edge_restores_active);
+    RUN_TEST(test_occupancy_busy_room_stays_active);
+    RUN_TEST(test_occupancy_independent_of_update_rate);
+    RUN_TEST(test_occupancy_duty_cycles_simulator);
+}
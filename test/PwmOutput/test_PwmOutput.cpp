@@ -0,0 +1,129 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include "Animation.h"
+#include "PwmOutput.h"
+#include "Random.h"
+
+void test_pwm_output_writes_on_change()
+{
+    std::cout << "  Running test_pwm_output_writes_on_change()" << std::endl;
+
+    // Record what reaches the pin
+    static int pinWrites;
+    static int lastValue;
+    pinWrites = 0;
+    lastValue = -1;
+    When(Method(ArduinoFake(), analogWrite))
+        .AlwaysDo(
+            [](uint8_t pin, int value)
+            {
+                pinWrites += pin == 5;
+                lastValue = value;
+            });
+    const uint32_t totalBefore = PwmOutput::getTotalWriteCount();
+
+    PwmOutput output(5);
+    TEST_ASSERT_EQUAL(PwmOutputConstants::UNKNOWN_LEVEL, output.getLevel());
+
+    // The first write always reaches the pin, repeats of the same level do not
+    TEST_ASSERT_TRUE(output.write(0));
+    TEST_ASSERT_FALSE(output.write(0));
+    TEST_ASSERT_TRUE(output.write(128));
+    TEST_ASSERT_FALSE(output.write(128));
+    TEST_ASSERT_EQUAL(128, output.getLevel());
+    TEST_ASSERT_EQUAL(2, pinWrites);
+    TEST_ASSERT_EQUAL(128, lastValue);
+
+    // After something else drove the pin, the cached level is forgotten
+    output.invalidate();
+    TEST_ASSERT_TRUE(output.write(128));
+
+    TEST_ASSERT_EQUAL(3, pinWrites);
+    TEST_ASSERT_EQUAL(3, output.getWriteCount());
+    TEST_ASSERT_EQUAL(3, PwmOutput::getTotalWriteCount() - totalBefore);
+}
+
+// Frequency a slice runs at with a config
+static double sliceFrequencyHz(uint32_t clockHz, const PwmSliceConfig& config)
+{
+    return clockHz * 16.0 / (config.divider16 * (config.wrap + 1.0));
+}
+
+void test_pwm_output_slice_config()
+{
+    std::cout << "  Running test_pwm_output_slice_config()" << std::endl;
+
+    // 1 kHz from the RP2040's usual clocks needs a divider past 255 with an 8-bit counter,
+    // so the counter is widened just enough and levels are scaled to it
+    for (const uint32_t clockHz : {125000000UL, 133000000UL, 200000000UL})
+    {
+        const PwmSliceConfig config = PwmOutput::computeSliceConfig(clockHz, 1000);
+        std::cout << "    " << clockHz / 1000000 << " MHz: divider " << config.divider16 / 16.0
+                  << ", wrap " << config.wrap << std::endl;
+        TEST_ASSERT_TRUE(config.levelShift > 0);
+        TEST_ASSERT_EQUAL(((PwmOutputConstants::PWM_WRAP + 1) << config.levelShift) - 1,
+                          config.wrap);
+        TEST_ASSERT_TRUE(config.divider16 <= PwmOutputConstants::MAX_DIVIDER_16THS);
+        TEST_ASSERT_TRUE(config.divider16 > PwmOutputConstants::MAX_DIVIDER_16THS / 2);
+        TEST_ASSERT_FLOAT_WITHIN(5.0, 1000.0, sliceFrequencyHz(clockHz, config));
+    }
+
+    // A frequency the 8-bit counter reaches keeps it
+    PwmSliceConfig config = PwmOutput::computeSliceConfig(125000000UL, 20000);
+    TEST_ASSERT_EQUAL(0, config.levelShift);
+    TEST_ASSERT_EQUAL(PwmOutputConstants::PWM_WRAP, config.wrap);
+    TEST_ASSERT_FLOAT_WITHIN(200.0, 20000.0, sliceFrequencyHz(125000000UL, config));
+
+    // Frequencies out of reach clamp the divider to its range
+    config = PwmOutput::computeSliceConfig(125000000UL, 1);
+    TEST_ASSERT_EQUAL(PwmOutputConstants::MAX_LEVEL_SHIFT, config.levelShift);
+    TEST_ASSERT_EQUAL(PwmOutputConstants::MAX_DIVIDER_16THS, config.divider16);
+    config = PwmOutput::computeSliceConfig(125000000UL, 1000000);
+    TEST_ASSERT_EQUAL(0, config.levelShift);
+    TEST_ASSERT_EQUAL(PwmOutputConstants::MIN_DIVIDER_16THS, config.divider16);
+}
+
+void test_animation_output_writes_per_second()
+{
+    std::cout << "  Running test_animation_output_writes_per_second()" << std::endl;
+
+    // Reproducible random speeds and intervals
+    Rng.seed(RandomConstants::DEFAULT_SEED);
+    When(Method(ArduinoFake(), analogWrite)).AlwaysReturn();
+
+    // Motor and dome LED driven from the main loop, without a planner or a DomeLed driver
+    Animation animation(nullptr, nullptr, AnimationPins());
+    const unsigned long tickMs = 10;
+    const unsigned long phaseMs = 60000;
+    unsigned long now = 0;
+    uint32_t writesPerSecond[2] = {};
+    for (const uint8_t pir : {HIGH, LOW})
+    {
+        const uint32_t before = PwmOutput::getTotalWriteCount();
+        for (unsigned long end = now + phaseMs; now < end; now += tickMs)
+        {
+            AnimationInputs inputs = {HIGH, HIGH, pir, HIGH, HIGH, now};
+            animation.update(inputs);
+            animation.performRotate();
+        }
+        writesPerSecond[pir == HIGH ? 0 : 1] =
+            (PwmOutput::getTotalWriteCount() - before) * 1000 / phaseMs;
+    }
+    std::cout << "    hardware writes per simulated second: active " << writesPerSecond[0]
+              << ", idle " << writesPerSecond[1] << " (loop runs " << 1000 / tickMs << "/s)"
+              << std::endl;
+
+    // Three channels used to be written on every loop tick; now only changes are
+    TEST_ASSERT_TRUE(writesPerSecond[0] > 0);
+    TEST_ASSERT_TRUE(writesPerSecond[0] <= 1000 / tickMs / 2);
+    TEST_ASSERT_EQUAL(0, writesPerSecond[1]);
+}
+
+void runPwmOutputTests()
+{
+    std::cout << "\n==== Starting PWM Output Tests ====" << std::endl;
+    RUN_TEST(test_pwm_output_writes_on_change);
+    RUN_TEST(test_pwm_output_slice_config);
+    RUN_TEST(test_animation_output_writes_per_second);
+}
@@ -0,0 +1,126 @@
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#include <chrono>
+#include <cstdlib>
+
+#include "Random.h"
+
+void test_random_matches_reference_sequence()
+{
+    std::cout << "  Running test_random_matches_reference_sequence()" << std::endl;
+
+    // First outputs of xoshiro128** from the seeded state, computed independently
+    RandomGenerator generator;
+    TEST_ASSERT_EQUAL_HEX32(0x9190299E, generator.next());
+    TEST_ASSERT_EQUAL_HEX32(0xC1017B27, generator.next());
+    TEST_ASSERT_EQUAL_HEX32(0xE3AF522F, generator.next());
+    TEST_ASSERT_EQUAL_HEX32(0x7D71FB05, generator.next());
+    generator.seed(12345);
+    TEST_ASSERT_EQUAL_HEX32(0x1EEA3CC1, generator.next());
+    TEST_ASSERT_EQUAL_HEX32(0x1A40A62E, generator.next());
+
+    // Reseeding restarts the sequence, and a copy carries it on
+    generator.seed(RandomConstants::DEFAULT_SEED);
+    TEST_ASSERT_EQUAL_HEX32(0x9190299E, generator.next());
+    RandomGenerator copy = generator;
+    for (uint8_t i = 0; i < 100; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX32(generator.next(), copy.next());
+    }
+
+    // Natively the hardware seed is the fixed one, so runs are reproducible
+    TEST_ASSERT_EQUAL(RandomConstants::DEFAULT_SEED, RandomGenerator::hardwareSeed());
+}
+
+void test_random_bounded_draws_are_unbiased()
+{
+    std::cout << "  Running test_random_bounded_draws_are_unbiased()" << std::endl;
+    RandomGenerator generator(7);
+
+    TEST_ASSERT_EQUAL(0, generator.below(0));
+    TEST_ASSERT_EQUAL(0, generator.below(1));
+    TEST_ASSERT_EQUAL(42, generator.range(42, 42));
+    TEST_ASSERT_EQUAL(42, generator.range(42, 10));
+
+    // Each of six values within 3% of an even share; chi-squared well under its 0.1% bound
+    const uint32_t draws = 60000;
+    uint32_t counts[6] = {};
+    for (uint32_t i = 0; i < draws; i++)
+    {
+        counts[generator.below(6)]++;
+    }
+    double chiSquared = 0.0;
+    for (const uint32_t count : counts)
+    {
+        TEST_ASSERT_UINT32_WITHIN(draws / 6 * 3 / 100, draws / 6, count);
+        const double error = static_cast<double>(count) - draws / 6.0;
+        chiSquared += error * error / (draws / 6.0);
+    }
+    TEST_ASSERT_TRUE(chiSquared < 20.5);
+
+    // A bound of 3/4 of the range, where the modulo would pick the lower third twice as
+    // often as the upper two thirds, splits evenly
+    const uint32_t bound = 0xC0000000UL;
+    uint32_t lowerThird = 0;
+    for (uint32_t i = 0; i < draws; i++)
+    {
+        const uint32_t value = generator.below(bound);
+        TEST_ASSERT_TRUE(value < bound);
+        lowerThird += value < bound / 3 ? 1 : 0;
+    }
+    TEST_ASSERT_UINT32_WITHIN(draws / 100, draws / 3, lowerThird);
+
+    // Ranges hit both ends and nothing outside, as Arduino random(lo, hi) does
+    long lowest = 0;
+    long highest = -100;
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        const long value = generator.range(-100, -90);
+        lowest = value < lowest ? value : lowest;
+        highest = value > highest ? value : highest;
+    }
+    TEST_ASSERT_EQUAL(-100, lowest);
+    TEST_ASSERT_EQUAL(-91, highest);
+}
+
+void test_random_benchmark()
+{
+    std::cout << "  Running test_random_benchmark()" << std::endl;
+    using Clock = std::chrono::steady_clock;
+    using Nanoseconds = std::chrono::duration<double, std::nano>;
+
+    // The blink delay draw, against the C library random() and modulo that Arduino
+    // random(lo, hi) is built on
+    const uint32_t numDraws = 1000000;
+    RandomGenerator generator;
+    uint32_t sum = 0;
+    Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < numDraws; i++)
+    {
+        sum += static_cast<uint32_t>(generator.range(2000, 8000));
+    }
+    const double generatorNs = Nanoseconds(Clock::now() - start).count() / numDraws;
+
+    srandom(1);
+    uint32_t librarySum = 0;
+    start = Clock::now();
+    for (uint32_t i = 0; i < numDraws; i++)
+    {
+        librarySum += static_cast<uint32_t>(2000 + ::random() % (8000 - 2000));
+    }
+    const double libraryNs = Nanoseconds(Clock::now() - start).count() / numDraws;
+
+    std::cout << "    RandomGenerator::range " << generatorNs << " ns per draw, C library random() "
+              << libraryNs << " ns per draw" << std::endl;
+    TEST_ASSERT_UINT32_WITHIN(numDraws / 100 * 5000, numDraws * 5000, sum);
+    TEST_ASSERT_UINT32_WITHIN(numDraws / 100 * 5000, numDraws * 5000, librarySum);
+}
+
+void runRandomTests()
+{
+    std::cout << "\n==== Starting Random Tests ====" << std::endl;
+    RUN_TEST(test_random_matches_reference_sequence);
+    RUN_TEST(test_random_bounded_draws_are_unbiased);
+    RUN_TEST(test_random_benchmark);
+}
@@ -0,0 +1,28 @@
+#ifndef MOCK_HARDWARE_GPIO_H
+#define MOCK_HARDWARE_GPIO_H
+
+#include <stdint.h>
+
+// Mock GPIO port for native environment: tests set the pin levels and count port reads
+inline uint32_t mockGpioPort = 0;       // Level of every GPIO, bit n for GPIO n
+inline uint32_t mockGpioPortReads = 0;  // Calls to gpio_get_all
+
+static inline uint32_t gpio_get_all()
+{
+    mockGpioPortReads++;
+    return mockGpioPort;
+}
+
+static inline void mock_gpio_put(uint8_t pin, bool value)
+{
+    if (value)
+    {
+        mockGpioPort |= 1U << pin;
+    }
+    else
+    {
+        mockGpioPort &= ~(1U << pin);
+    }
+}
+
+#endif  // MOCK_HARDWARE_GPIO_H
@@ -11,10 +11,34 @@
 // Include all test files
 #include "Animation/test_Animation.cpp"
 #include "Animation/test_AnimationInputs.cpp"
+#include "Animation/test_AnimationGaze.cpp"
 #include "AudioPlayer/test_AudioPlayer.cpp"
 #include "Logger/test_Logger.cpp"
 #include "WavData/test_WavData.cpp"
 #include "EyeAnimation/test_EyeAnimation.cpp"
+#include "EyeAnimation/test_EyeAnimationFrames.cpp"
+#include "EyeAnimation/test_EyeAnimationScale.cpp"
+#include "EyeAnimation/test_EyeAnimationInterpolation.cpp"
+#include "EyeAnimation/test_EyeAnimationMultiEye.cpp"
+#include "LedStrips/test_LedStrips.cpp"
+#include "HostSimulator/test_HostSimulator.cpp"
+#include "HsvColor/test_HsvColor.cpp"
+#include "DomeLed/test_DomeLed.cpp"
+#include "EyeSprite/test_EyeSprite.cpp"
+#include "FrameStream/test_FrameStream.cpp"
+#include "HeadEstimator/test_HeadEstimator.cpp"
+#include "MotionPlanner/test_MotionPlanner.cpp"
+#include "PwmOutput/test_PwmOutput.cpp"
+#include "MotorDriver/test_MotorDriver.cpp"
+#include "BehaviorMachine/test_BehaviorMachine.cpp"
+#include "BehaviorScript/test_BehaviorScript.cpp"
+#include "BehaviorVm/test_BehaviorVm.cpp"
+#include "Choreography/test_Choreography.cpp"
+#include "Occupancy/test_Occupancy.cpp"
+#include "Random/test_Random.cpp"
+#include "InputEvents/test_InputEvents.cpp"
+#include "Debouncer/test_Debouncer.cpp"
+#include "InputTrace/test_InputTrace.cpp"
 
 int main(int argc, char** argv)
 {
@@ -26,5 +50,29 @@ int main(int argc, char** argv)
     runLoggerTests();
     runWavDataTests();
     runEyeAnimationTests();
+    runLedStripsTests();
+    runEyeAnimationFramesTests();
+    runEyeAnimationScaleTests();
+    runEyeAnimationInterpolationTests();
+    runEyeAnimationMultiEyeTests();
+    runHostSimulatorTests();
+    runHsvColorTests();
+    runDomeLedTests();
+    runEyeSpriteTests();
+    runFrameStreamTests();
+    runHeadEstimatorTests();
+    runMotionPlannerTests();
+    runAnimationGazeTests();
+    runPwmOutputTests();
+    runMotorDriverTests();
+    runBehaviorMachineTests();
+    runBehaviorScriptTests();
+    runBehaviorVmTests();
+    runChoreographyTests();
+    runOccupancyTests();
+    runRandomTests();
+    runInputEventsTests();
+    runDebouncerTests();
+    runInputTraceTests();
     return UNITY_END();
 }
@@ -0,0 +1,327 @@
+/**
+ * @file main.cpp
+ * @brief Live terminal renderer for the host simulation of the Y-Series USB Hub
+ * @author Scott Zelenka
+ * @date 2026-10-17
+ *
+ * @details
+ * Runs the firmware's Animation, EyeAnimation and AudioPlayer in virtual time through
+ * HostSimulator and draws the eye ring as 24-bit ANSI color blocks together with the
+ * neck motor, hall sensors, head position estimate, PIR, dome LED and the current sound
+ * clip.
+ *
+ * The simulated firmware runs on the main thread and only publishes a snapshot after
+ * each loop tick. Formatting and writing to the terminal happen on a separate render
+ * thread, so terminal I/O never shows up in the per-tick timing.
+ *
+ * Usage: sim [--speed N] [--duration S] [--seed N] [--program FILE]
+ *   --speed N       Virtual seconds per real second (default 1, 0 = as fast as possible)
+ *   --duration S    Virtual seconds to simulate (default 120)
+ *   --seed N        Seed for firmware randomness and visitor traffic (default 1)
+ *   --program FILE  Behavior program from behavior_compiler.py --binary to run in place
+ *                   of the built-in behaviors
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "HostSimulator.h"
+
+namespace
+{
+/// @name Renderer Settings
+/// @{
+constexpr int kRingGrid = 9;                    ///< Ring is drawn on a 9x9 cell grid
+constexpr int kRingRadius = 4;                  ///< Radius of the ring in cells
+constexpr int kRenderIntervalMs = 33;           ///< About 30 terminal refreshes per second
+constexpr int kBarWidth = 32;                   ///< Width of the speed and position bars
+constexpr unsigned long kFrameWindowMs = 1000;  ///< Window for the eye frame rate
+/// @}
+
+struct Options
+{
+    double speed = 1.0;
+    unsigned long durationMs = 120000;
+    uint32_t seed = 1;
+    const char* program = nullptr;
+};
+
+// State shared between the simulation and render threads
+struct SharedState
+{
+    std::mutex mutex;
+    SimSnapshot snapshot{};
+    double hostUsPerTick = 0.0;
+    double frameRate = 0.0;
+    std::atomic<bool> done{false};
+};
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--speed") == 0 && hasValue)
+        {
+            options.speed = std::strtod(argv[++i], nullptr);
+        }
+        else if (std::strcmp(argv[i], "--duration") == 0 && hasValue)
+        {
+            options.durationMs = static_cast<unsigned long>(std::strtod(argv[++i], nullptr) * 1000);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+        {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--program") == 0 && hasValue)
+        {
+            options.program = argv[++i];
+        }
+        else
+        {
+            std::fprintf(stderr,
+                         "Usage: %s [--speed N] [--duration S] [--seed N] [--program FILE]\n",
+                         argv[0]);
+            return false;
+        }
+    }
+    return options.speed >= 0.0;
+}
+
+void appendColorCell(std::string& out, uint32_t color)
+{
+    char cell[40];
+    std::snprintf(cell, sizeof(cell), "\x1b[48;2;%u;%u;%um  \x1b[0m", (color >> 16) & 0xFF,
+                  (color >> 8) & 0xFF, color & 0xFF);
+    out += cell;
+}
+
+void appendBar(std::string& out, float fill, char mark)
+{
+    const int filled = static_cast<int>(std::lround(fill * kBarWidth));
+    out += '[';
+    for (int i = 0; i < kBarWidth; i++)
+    {
+        out += i < filled ? mark : ' ';
+    }
+    out += ']';
+}
+
+// Draw the 16 ring pixels clockwise from the top with the center pixel in the middle
+std::string renderRing(const SimSnapshot& snap)
+{
+    int grid[kRingGrid][kRingGrid];
+    for (auto& row : grid)
+    {
+        for (int& cell : row)
+        {
+            cell = -1;
+        }
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        const double angle = i * 2.0 * M_PI / 16.0 - M_PI / 2.0;
+        const int col = kRingRadius + static_cast<int>(std::lround(kRingRadius * std::cos(angle)));
+        const int row = kRingRadius + static_cast<int>(std::lround(kRingRadius * std::sin(angle)));
+        grid[row][col] = i;
+    }
+    grid[kRingRadius][kRingRadius] = 16;
+
+    std::string out;
+    for (const auto& row : grid)
+    {
+        out += "  ";
+        for (int cell : row)
+        {
+            if (cell < 0)
+            {
+                out += "  ";
+            }
+            else
+            {
+                appendColorCell(out, snap.pixels[cell]);
+            }
+        }
+        out += "\x1b[K\n";
+    }
+    return out;
+}
+
+std::string renderStatus(const SimSnapshot& snap, double hostUsPerTick, double frameRate,
+                         double speed)
+{
+    char line[160];
+    std::string out;
+
+    char rate[16];
+    std::snprintf(rate, sizeof(rate), speed > 0.0 ? "%gx" : "max", speed);
+    std::snprintf(line, sizeof(line), "  time  %8.2f s   speed %s   host %.1f us/tick\x1b[K\n",
+                  snap.timeMs / 1000.0, rate, hostUsPerTick);
+    out += line;
+
+    const char* arrow = snap.direction == MotorDirection::Left    ? "<< left "
+                        : snap.direction == MotorDirection::Right ? ">> right"
+                                                                  : "-- stop ";
+    std::snprintf(line, sizeof(line), "  motor %s duty %3u ", arrow, snap.speed);
+    out += line;
+    appendBar(out, snap.speed / 255.0f, '=');
+    out += "\x1b[K\n";
+
+    out += "  head  ";
+    out += snap.sensorLeft ? "L*" : "L ";
+    std::string track(kBarWidth, '-');
+    const int headCol = static_cast<int>(std::lround(snap.headPosition * (kBarWidth - 1)));
+    track[headCol] = 'O';
+    out += "[" + track + "]";
+    out += snap.sensorRight ? "*R" : " R";
+    std::snprintf(line, sizeof(line), "  estimate %4.2f (%3.0f%%)", snap.estimatedPosition,
+                  snap.estimateConfidence * 100.0f);
+    out += line;
+    out += "\x1b[K\n";
+
+    const std::string clip = snap.clip >= 0 ? std::to_string(snap.clip) : "-";
+    std::snprintf(line, sizeof(line),
+                  "  pir   %-6s dome %3u  clip %-4s eye %zu frames, %.0f/s\x1b[K\n",
+                  snap.pir ? "motion" : "idle", snap.domeLed, clip.c_str(), snap.frames, frameRate);
+    out += line;
+    return out;
+}
+
+void renderLoop(SharedState& shared, double speed)
+{
+    std::fputs("\x1b[2J\x1b[?25l", stdout);
+    while (true)
+    {
+        const bool last = shared.done.load();
+        SimSnapshot snap;
+        double hostUsPerTick;
+        double frameRate;
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            snap = shared.snapshot;
+            hostUsPerTick = shared.hostUsPerTick;
+            frameRate = shared.frameRate;
+        }
+
+        const std::string screen = "\x1b[H" + renderRing(snap) + "\n" +
+                                   renderStatus(snap, hostUsPerTick, frameRate, speed);
+        std::fputs(screen.c_str(), stdout);
+        std::fflush(stdout);
+
+        if (last)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(kRenderIntervalMs));
+    }
+    std::fputs("\x1b[?25h\n", stdout);
+}
+
+// Visitors walk up at random intervals and stay a while, driving the PIR sensor
+class VisitorTraffic
+{
+public:
+    explicit VisitorTraffic(uint32_t seed) : m_rng(seed), m_present(false), m_nextChangeMs(0) {}
+
+    bool update(unsigned long nowMs)
+    {
+        if (nowMs >= m_nextChangeMs)
+        {
+            m_present = !m_present;
+            std::uniform_int_distribution<unsigned long> stay(3000, 20000);
+            std::uniform_int_distribution<unsigned long> away(5000, 40000);
+            m_nextChangeMs = nowMs + (m_present ? stay(m_rng) : away(m_rng));
+        }
+        return m_present;
+    }
+
+private:
+    std::mt19937 m_rng;
+    bool m_present;
+    unsigned long m_nextChangeMs;
+};
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
+    HostSimulator sim(options.seed);
+
+    // The program runs once the head estimator's calibration sweep is done
+    std::vector<uint8_t> program;
+    if (options.program != nullptr)
+    {
+        std::ifstream file(options.program, std::ios::binary);
+        program.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (!file.is_open() || program.empty() ||
+            program.size() > BehaviorVmConstants::MAX_PROGRAM_SIZE ||
+            !sim.runProgram(program.data(), static_cast<uint16_t>(program.size())))
+        {
+            std::fprintf(stderr, "Cannot run behavior program %s\n", options.program);
+            return 1;
+        }
+    }
+    VisitorTraffic traffic(options.seed);
+    SharedState shared;
+    std::thread renderer(renderLoop, std::ref(shared), options.speed);
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    double busyUs = 0.0;
+    unsigned long ticks = 0;
+    size_t windowFrames = 0;
+    unsigned long windowStartMs = 0;
+    double frameRate = 0.0;
+
+    while (sim.now() < options.durationMs)
+    {
+        sim.setPir(traffic.update(sim.now()));
+
+        // Only the firmware tick itself is timed
+        const Clock::time_point tickStart = Clock::now();
+        sim.step(HostSimulator::kTickMs);
+        busyUs += std::chrono::duration<double, std::micro>(Clock::now() - tickStart).count();
+        ticks++;
+
+        const SimSnapshot snap = sim.snapshot();
+        if (snap.timeMs - windowStartMs >= kFrameWindowMs)
+        {
+            frameRate = (snap.frames - windowFrames) * 1000.0 / (snap.timeMs - windowStartMs);
+            windowFrames = snap.frames;
+            windowStartMs = snap.timeMs;
+        }
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.snapshot = snap;
+            shared.hostUsPerTick = busyUs / ticks;
+            shared.frameRate = frameRate;
+        }
+
+        if (options.speed > 0.0)
+        {
+            const std::chrono::duration<double, std::milli> target(sim.now() / options.speed);
+            std::this_thread::sleep_until(start +
+                                          std::chrono::duration_cast<Clock::duration>(target));
+        }
+    }
+
+    shared.done = true;
+    renderer.join();
+    return 0;
+}